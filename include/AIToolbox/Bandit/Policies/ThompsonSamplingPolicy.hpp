@@ -58,17 +58,25 @@ namespace AIToolbox::Bandit {
             /**
              * @brief This function returns the probability of taking the specified action.
              *
-             * WARNING: In this class the only way to compute the true
-             * probability of selecting the input action is via numerical
-             * integration, since we're dealing with |A| Normal random
-             * variables. To avoid having to do this, we simply sample a lot
-             * and return an approximation of the times the input action was
-             * actually selected. This makes this function very very SLOW. Do
-             * not call at will!!
+             * The probability of selecting an action is the probability
+             * that its sample is the highest among |A| Normal random
+             * variables. This is computed by numerically integrating over
+             * the actions' Normal distributions, with Gauss-Legendre
+             * quadrature on pieces sized by the width of each posterior.
+             *
+             * The real line is split at each action's mean +- 8 standard
+             * deviations, giving up to 17|A| pieces of 8 nodes each, and
+             * every node evaluates the PDF and CDF of all actions. The
+             * computation thus takes O(|A|^2) exp/erfc evaluations, which
+             * becomes expensive with many actions.
+             *
+             * The probabilities of all actions are computed together and
+             * cached, so that subsequent calls only cost a lookup until the
+             * next call to stepUpdateP().
              *
              * @param a The selected action.
              *
-             * @return This function returns an approximation of the probability of choosing the input action.
+             * @return This function returns the probability of choosing the input action.
              */
             virtual double getActionProbability(const size_t & a) const override;
 
@@ -79,16 +87,24 @@ namespace AIToolbox::Bandit {
              * repeated need to access the same policy values in an
              * efficient manner.
              *
-             * WARNING: This can be really expensive, as it does pretty much
-             * the same work as getActionProbability(). It shouldn't be slower
-             * than that call though, so if you do need the overall policy,
-             * do call this method.
+             * This function shares its cache with getActionProbability(),
+             * so it only computes the policy if stepUpdateP() has been
+             * called since the last computation.
              */
             virtual Vector getPolicy() const override;
 
         private:
+            /**
+             * @brief This function computes the probabilities of all actions and caches them.
+             */
+            void computePolicy() const;
+
             // Average reward/tries per action
             std::vector<std::pair<double, unsigned>> experience_;
+
+            // Cached policy, valid until the next update.
+            mutable Vector policy_;
+            mutable bool cacheValid_;
     };
 }
 
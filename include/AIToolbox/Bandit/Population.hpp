@@ -0,0 +1,232 @@
+#ifndef AI_TOOLBOX_BANDIT_POPULATION_HEADER_FILE
+#define AI_TOOLBOX_BANDIT_POPULATION_HEADER_FILE
+
+#include <cstdint>
+
+#include <AIToolbox/Types.hpp>
+
+namespace AIToolbox::Bandit {
+    /**
+     * @brief This class keeps track of many independent bandits at once.
+     *
+     * When a very large number of independent bandits need to be run (for
+     * example one per user), creating a separate policy object for each of
+     * them wastes a lot of memory, since each object carries its own
+     * vectors and random engine.
+     *
+     * This class instead stores the experience of all arms of all bandit
+     * instances in two contiguous arrays: the average reward of each arm
+     * (in single precision), and the number of times each arm was pulled.
+     * This amounts to 8 bytes per arm. The arms of each instance are
+     * adjacent in memory, so that both updates and sampling for an
+     * instance touch a single cache line for small action spaces.
+     *
+     * Actions can be sampled for any instance following either a greedy
+     * policy (as Bandit::GreedyPolicy) or Thompson sampling (as
+     * Bandit::ThompsonSamplingPolicy).
+     *
+     * All batched functions take a random engine as a parameter, and only
+     * touch the instances they are given. Thus different threads can work
+     * on disjoint ranges of instances in parallel, each with its own
+     * engine, without any synchronization.
+     */
+    class Population {
+        public:
+            using AverageTable = Matrix2Df;
+            using CountTable   = Eigen::Matrix<std::uint32_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * @param n The number of bandit instances.
+             * @param a The number of arms of each bandit.
+             */
+            Population(size_t n, size_t a);
+
+            /**
+             * @brief This function updates an instance with the result of an action.
+             *
+             * We simply keep a rolling average for each arm of each
+             * instance.
+             *
+             * @param i The instance to update.
+             * @param a The action taken.
+             * @param r The reward obtained.
+             */
+            void stepUpdateP(size_t i, size_t a, double r);
+
+            /**
+             * @brief This function updates a batch of instances.
+             *
+             * The three ranges must have the same length, and contain
+             * respectively the instances, the actions taken and the
+             * rewards obtained.
+             *
+             * The same instance can appear multiple times in the batch,
+             * in which case the updates are applied in order.
+             *
+             * @tparam IIt The iterator type of the instances.
+             * @tparam AIt The iterator type of the actions.
+             * @tparam RIt The iterator type of the rewards.
+             * @param iBegin The beginning of the instances range.
+             * @param iEnd The end of the instances range.
+             * @param aBegin The beginning of the actions range.
+             * @param rBegin The beginning of the rewards range.
+             */
+            template <typename IIt, typename AIt, typename RIt>
+            void stepUpdateP(IIt iBegin, IIt iEnd, AIt aBegin, RIt rBegin);
+
+            /**
+             * @brief This function samples greedily an action for an instance.
+             *
+             * If multiple actions have the same average reward, one of
+             * them is chosen at random.
+             *
+             * @param i The instance to sample for.
+             *
+             * @return The chosen action.
+             */
+            size_t sampleGreedyAction(size_t i) const;
+
+            /**
+             * @brief This function samples an action for an instance using Thompson sampling.
+             *
+             * Each arm is estimated through a Normal distribution centered
+             * on its average, with standard deviation 1/(tries+1).
+             *
+             * @param i The instance to sample for.
+             *
+             * @return The chosen action.
+             */
+            size_t sampleThompsonAction(size_t i) const;
+
+            /**
+             * @brief This function samples greedily an action for a range of instances.
+             *
+             * For each instance in [begin, end), the chosen action is
+             * written in the output range.
+             *
+             * This function only reads the instances in the range, and
+             * uses the input random engine, so it can be called
+             * concurrently on disjoint ranges.
+             *
+             * @tparam OIt The iterator type of the output.
+             * @param begin The first instance to sample for.
+             * @param end The instance after the last to sample for.
+             * @param out The beginning of the output range.
+             * @param rnd The random engine to use.
+             */
+            template <typename OIt>
+            void sampleGreedyActions(size_t begin, size_t end, OIt out, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function samples an action with Thompson sampling for a range of instances.
+             *
+             * For each instance in [begin, end), the chosen action is
+             * written in the output range.
+             *
+             * This function only reads the instances in the range, and
+             * uses the input random engine, so it can be called
+             * concurrently on disjoint ranges.
+             *
+             * @tparam OIt The iterator type of the output.
+             * @param begin The first instance to sample for.
+             * @param end The instance after the last to sample for.
+             * @param out The beginning of the output range.
+             * @param rnd The random engine to use.
+             */
+            template <typename OIt>
+            void sampleThompsonActions(size_t begin, size_t end, OIt out, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function resets all experience for all instances.
+             */
+            void reset();
+
+            /**
+             * @brief This function returns the average reward of an arm of an instance.
+             *
+             * @param i The instance.
+             * @param a The arm.
+             *
+             * @return The average reward obtained by the arm.
+             */
+            double getAverage(size_t i, size_t a) const;
+
+            /**
+             * @brief This function returns the number of times an arm of an instance was pulled.
+             *
+             * @param i The instance.
+             * @param a The arm.
+             *
+             * @return The number of pulls of the arm.
+             */
+            unsigned long getTries(size_t i, size_t a) const;
+
+            /**
+             * @brief This function returns the table of averages of all instances.
+             *
+             * Each row contains the averages of a single instance.
+             *
+             * @return The averages table.
+             */
+            const AverageTable & getAverages() const;
+
+            /**
+             * @brief This function returns the table of tries of all instances.
+             *
+             * Each row contains the tries of a single instance.
+             *
+             * @return The tries table.
+             */
+            const CountTable & getTries() const;
+
+            /**
+             * @brief This function returns the number of bandit instances.
+             *
+             * @return The number of instances.
+             */
+            size_t getN() const;
+
+            /**
+             * @brief This function returns the number of arms of each bandit.
+             *
+             * @return The number of arms.
+             */
+            size_t getA() const;
+
+        private:
+            size_t sampleGreedy(size_t i, RandomEngine & rnd) const;
+            size_t sampleThompson(size_t i, Vectorf & buffer, RandomEngine & rnd) const;
+
+            size_t N, A;
+
+            AverageTable averages_;
+            CountTable tries_;
+
+            mutable Vectorf buffer_;
+            mutable RandomEngine rand_;
+    };
+
+    template <typename IIt, typename AIt, typename RIt>
+    void Population::stepUpdateP(IIt iBegin, const IIt iEnd, AIt aBegin, RIt rBegin) {
+        for ( ; iBegin != iEnd; ++iBegin, ++aBegin, ++rBegin )
+            stepUpdateP(*iBegin, *aBegin, *rBegin);
+    }
+
+    template <typename OIt>
+    void Population::sampleGreedyActions(size_t begin, const size_t end, OIt out, RandomEngine & rnd) const {
+        for ( ; begin < end; ++begin, ++out )
+            *out = sampleGreedy(begin, rnd);
+    }
+
+    template <typename OIt>
+    void Population::sampleThompsonActions(size_t begin, const size_t end, OIt out, RandomEngine & rnd) const {
+        // We allocate the noise buffer once for the whole range.
+        Vectorf buffer(A);
+        for ( ; begin < end; ++begin, ++out )
+            *out = sampleThompson(begin, buffer, rnd);
+    }
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_FACTORED_BANDIT_UCVE_HEADER_FILE
 
 #include "AIToolbox/Factored/Bandit/Types.hpp"
+#include "AIToolbox/Factored/Utils/Core.hpp"
 #include "AIToolbox/Factored/Utils/FactorGraph.hpp"
 
 namespace AIToolbox::Factored::Bandit {
@@ -32,8 +33,12 @@ namespace AIToolbox::Factored::Bandit {
             // Tag - Vector pair
             using Entry = std::tuple<PartialAction, V>;
             using Entries = std::vector<Entry>;
+            // Same as Entry, but used internally, where tags are created
+            // and merged for every cross-sum.
+            using SmallEntry = std::tuple<SmallPartialAction, V>;
+            using SmallEntries = std::vector<SmallEntry>;
             // Action -> (Tag + Vector)
-            using Rule = std::tuple<PartialAction, Entries>;
+            using Rule = std::tuple<SmallPartialAction, SmallEntries>;
             using Rules = std::vector<Rule>;
 
             using Result = Entry;
@@ -72,7 +77,7 @@ namespace AIToolbox::Factored::Bandit {
                     const auto & a = std::get<0>(rule);
                     auto & rules = graph_.getFactor(a.first)->getData().rules;
 
-                    rules.emplace_back(a, Entries{std::make_tuple(PartialAction(), std::get<1>(rule))});
+                    rules.emplace_back(toSmallPartialFactors(a), SmallEntries{std::make_tuple(SmallPartialAction(), std::get<1>(rule))});
                 }
                 // Start solving process.
                 return start();
@@ -112,7 +117,7 @@ namespace AIToolbox::Factored::Bandit {
              *
              * @return The iterator that separates dominated elements with the non-pruned.
              */
-            Entries::iterator boundPrune(Entries::iterator begin, Entries::iterator end, double x_l, double x_u);
+            SmallEntries::iterator boundPrune(SmallEntries::iterator begin, SmallEntries::iterator end, double x_l, double x_u);
 
             /**
              * @brief This function allows ordering and sorting of Rules to allow for merging.
@@ -131,7 +136,7 @@ namespace AIToolbox::Factored::Bandit {
 
             Action A;
             Graph graph_;
-            std::vector<Entries> finalFactors_;
+            std::vector<SmallEntries> finalFactors_;
             double logtA_;
     };
 }
@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_FACTORED_BANDIT_VARIABLE_ELIMINATION_HEADER_FILE
 
 #include "AIToolbox/Factored/Bandit/Types.hpp"
+#include "AIToolbox/Factored/Utils/Core.hpp"
 #include "AIToolbox/Factored/Utils/FactorGraph.hpp"
 
 namespace AIToolbox::Factored::Bandit {
@@ -41,9 +42,12 @@ namespace AIToolbox::Factored::Bandit {
     class VariableElimination {
         public:
             // action of subset of agents, tags of processed actions, value of rule
-            using Entry = std::pair<double, PartialAction>;
+            //
+            // Rules are created and discarded by the thousands during the
+            // elimination, so we keep their actions in small buffers.
+            using Entry = std::pair<double, SmallPartialAction>;
 
-            using Rule = std::pair<PartialAction, Entry>;
+            using Rule = std::pair<SmallPartialAction, Entry>;
             using Rules = std::vector<Rule>;
 
             using Result = std::tuple<Action, double>;
@@ -76,7 +80,7 @@ namespace AIToolbox::Factored::Bandit {
                 // Should we reset the graph?
                 for (const auto & rule : inputRules) {
                     auto it = graph_.getFactor(rule.action.first);
-                    it->getData().rules.emplace_back(rule.action, Entry{rule.value, PartialAction()});
+                    it->getData().rules.emplace_back(toSmallPartialFactors(rule.action), Entry{rule.value, SmallPartialAction()});
                 }
                 return start();
             }
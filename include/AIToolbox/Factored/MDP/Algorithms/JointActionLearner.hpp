@@ -153,6 +153,7 @@ namespace AIToolbox::Factored::MDP {
 
             AIToolbox::MDP::QFunction singleQFun_;
             PartialFactorsEnumerator jointActions_;
+            PartialIndexEncoder jointIndex_;
 
             AIToolbox::MDP::QLearning qLearning_;
     };
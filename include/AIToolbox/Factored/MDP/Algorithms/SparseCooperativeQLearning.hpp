@@ -169,6 +169,10 @@ namespace AIToolbox::Factored::MDP {
             Action A;
             double discount_, alpha_;
             FactoredContainer<QFunctionRule> rules_;
+
+            // Buffers reused by stepUpdateQ to avoid allocating at each step.
+            Factors stateAction_;
+            std::vector<double> beforeQ_, afterQ_, updates_;
     };
 }
 
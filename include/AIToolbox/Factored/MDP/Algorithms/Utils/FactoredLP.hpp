@@ -80,7 +80,7 @@ namespace AIToolbox::Factored::MDP {
              */
             void removeState(size_t s, LP & lp);
 
-            using Rule = std::tuple<PartialState, size_t>;
+            using Rule = std::tuple<SmallPartialState, size_t>;
             using Rules = std::vector<Rule>;
             using Graph = FactorGraph<Rules>;
 
@@ -6,6 +6,17 @@
 #include <vector>
 #include <utility>
 
+// GCC 11+ reports a false -Wstringop-overread when inlining small_vector
+// copies that spill to the heap.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wstringop-overread"
+#include <boost/container/small_vector.hpp>
+#pragma GCC diagnostic pop
+#else
+#include <boost/container/small_vector.hpp>
+#endif
+
 namespace AIToolbox::Factored {
     /**
      * @name Factored Basic Types
@@ -45,6 +56,12 @@ namespace AIToolbox::Factored {
      * the indeces of the original Factor which are being taken into
      * consideration, and the second vector contains their values.
      *
+     * SmallPartialFactors is the same pair, but its vectors store up to a
+     * few elements inline. Algorithms which create many short-lived
+     * PartialFactors internally (like VariableElimination) use it to
+     * avoid allocating memory for each of them; conversions to and from
+     * PartialFactors are in Factored/Utils/Core.hpp.
+     *
      * An additional definition which can be useful in case of
      * multi-objective MDPs is the Rewards one, which contains a vector of
      * rewards, one per factored action. Multi-objective MDPs happen when
@@ -61,11 +78,15 @@ namespace AIToolbox::Factored {
 
     using Factors = std::vector<size_t>;
     using PartialFactors = std::pair<std::vector<size_t>, std::vector<size_t>>;
+    using SmallFactors = boost::container::small_vector<size_t, 8>;
+    using SmallPartialFactors = std::pair<SmallFactors, SmallFactors>;
 
     using State = Factors;
     using PartialState = PartialFactors;
     using Action = Factors;
     using PartialAction = PartialFactors;
+    using SmallPartialState = SmallPartialFactors;
+    using SmallPartialAction = SmallPartialFactors;
     using Rewards = Vector;
 
     // @}
@@ -80,6 +80,70 @@ namespace AIToolbox::Factored {
      */
     void inplace_merge(PartialFactors * plhs, const PartialFactors & rhs);
 
+    /**
+     * @brief This function converts PartialFactors into the equivalent SmallPartialFactors.
+     *
+     * @param pf The PartialFactors to be converted.
+     *
+     * @return A SmallPartialFactors equivalent to the input.
+     */
+    SmallPartialFactors toSmallPartialFactors(const PartialFactors & pf);
+
+    /**
+     * @brief This function converts SmallPartialFactors into the equivalent PartialFactors.
+     *
+     * @param pf The SmallPartialFactors to be converted.
+     *
+     * @return A PartialFactors equivalent to the input.
+     */
+    PartialFactors toPartialFactors(const SmallPartialFactors & pf);
+
+    /**
+     * @brief This function removes the specified factor from the input SmallPartialFactors.
+     *
+     * \sa removeFactor(const PartialFactors &, size_t)
+     *
+     * @param pf The SmallPartialFactors to modify.
+     * @param f The factor to be removed.
+     *
+     * @return A new SmallPartialFactors that does not contain the input factor.
+     */
+    SmallPartialFactors removeFactor(const SmallPartialFactors & pf, size_t f);
+
+    /**
+     * @brief This function returns whether the common factors in the inputs match in value.
+     *
+     * \sa match(const PartialFactors &, const PartialFactors &)
+     *
+     * @param lhs The left hand side.
+     * @param rhs The right hand side.
+     *
+     * @return True if all factors in common between the inputs match in value, false otherwise.
+     */
+    bool match(const PartialFactors & lhs, const SmallPartialFactors & rhs);
+
+    /**
+     * @brief This function merges two SmallPartialFactors together.
+     *
+     * \sa merge(const PartialFactors &, const PartialFactors &)
+     *
+     * @param lhs The left hand side.
+     * @param rhs The right hand side.
+     *
+     * @return A new SmallPartialFactors containing all keys from both inputs and their respective values.
+     */
+    SmallPartialFactors merge(const SmallPartialFactors & lhs, const SmallPartialFactors & rhs);
+
+    /**
+     * @brief This function merges the second SmallPartialFactors into the first.
+     *
+     * \sa inplace_merge(PartialFactors *, const PartialFactors &)
+     *
+     * @param plhs The left hand side to be modified.
+     * @param rhs The right hand side.
+     */
+    void inplace_merge(SmallPartialFactors * plhs, const SmallPartialFactors & rhs);
+
     /**
      * @brief This function returns the multiplication of all elements of the input factor.
      *
@@ -132,6 +196,18 @@ namespace AIToolbox::Factored {
      */
     Factors toFactors(size_t F, const PartialFactors & pf);
 
+    /**
+     * @brief This function converts SmallPartialFactors into the equivalent Factors structure.
+     *
+     * \sa toFactors(size_t, const PartialFactors &)
+     *
+     * @param F The size of the Factors to be returned.
+     * @param pf The SmallPartialFactors to be converted.
+     *
+     * @return Factors containing all values of the input.
+     */
+    Factors toFactors(size_t F, const SmallPartialFactors & pf);
+
     /**
      * @brief This function converts an index into the equivalent Factors, within the specified factor space.
      *
@@ -230,6 +306,106 @@ namespace AIToolbox::Factored {
      */
     size_t toIndexPartial(const Factors & space, const PartialFactors & f);
 
+    /**
+     * @brief This class converts Factors and PartialFactors into indices for a fixed set of factors.
+     *
+     * The toIndex() and toIndexPartial() functions recompute the
+     * mixed-radix multipliers of the factor space on each call, and need
+     * to walk the whole space. This class instead precomputes them once
+     * for a given set of factor ids, so that encoding becomes a single
+     * pass over the ids, and decoding writes in place without allocating.
+     *
+     * Additionally, the multipliers can be used directly to update an
+     * index when a single factor changes, which avoids re-encoding
+     * entirely in loops that enumerate the values of a single factor.
+     */
+    class PartialIndexEncoder {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor encodes all factors of the input space.
+             *
+             * @param space The factor space.
+             */
+            PartialIndexEncoder(const Factors & space);
+
+            /**
+             * @brief Partial constructor.
+             *
+             * This constructor encodes only the factors with the input ids,
+             * in the order given. The resulting indices are the same as
+             * the ones returned by toIndexPartial().
+             *
+             * @param space The factor space.
+             * @param ids The ids of the factors to encode.
+             */
+            PartialIndexEncoder(const Factors & space, std::vector<size_t> ids);
+
+            /**
+             * @brief This function encodes the values of the selected factors from a full Factors.
+             *
+             * @param f The full Factors to read from.
+             *
+             * @return The index of the selected values.
+             */
+            size_t encode(const Factors & f) const;
+
+            /**
+             * @brief This function encodes the values of a PartialFactors.
+             *
+             * The input must contain exactly the factors of this encoder,
+             * in the same order. This is not checked.
+             *
+             * @param pf The PartialFactors to encode.
+             *
+             * @return The index of the input values.
+             */
+            size_t encode(const PartialFactors & pf) const;
+
+            /**
+             * @brief This function decodes an index into the selected factors of a full Factors.
+             *
+             * Only the selected factors of the output are written, and no
+             * allocation is performed. The output must already have the
+             * size of the whole factor space.
+             *
+             * @param id The index to decode.
+             * @param f The output Factors.
+             */
+            void decode(size_t id, Factors * f) const;
+
+            /**
+             * @brief This function returns the multiplier of the i-th selected factor.
+             *
+             * Changing the value of the i-th selected factor by one
+             * changes the index by this amount.
+             *
+             * @param i The position of the factor in the ids of this encoder.
+             *
+             * @return The multiplier of the factor.
+             */
+            size_t getMultiplier(size_t i) const;
+
+            /**
+             * @brief This function returns the number of possible indices.
+             *
+             * @return The product of the sizes of all selected factors.
+             */
+            size_t size() const;
+
+            /**
+             * @brief This function returns the ids of the selected factors.
+             *
+             * @return The ids of the selected factors.
+             */
+            const std::vector<size_t> & getIds() const;
+
+        private:
+            std::vector<size_t> ids_, sizes_, multipliers_;
+            size_t size_;
+    };
+
     /**
      * @brief This class enumerates all possible values for a PartialFactors.
      *
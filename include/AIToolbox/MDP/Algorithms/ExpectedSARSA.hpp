@@ -199,6 +199,9 @@ namespace AIToolbox::MDP {
             double discount_;
 
             QFunction & q_;
+
+            // Buffer for the action probabilities of the policy.
+            Vector probs_;
     };
 
     template <typename M, typename>
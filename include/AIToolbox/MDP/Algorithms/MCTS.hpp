@@ -3,9 +3,12 @@
 
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/Algorithms/Utils/RolloutBatch.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/Impl/Seeder.hpp>
 
+#include <deque>
+#include <limits>
 #include <unordered_map>
 
 namespace AIToolbox::MDP {
@@ -42,6 +45,27 @@ namespace AIToolbox::MDP {
      * for the action that has been performed and its respective new state.
      * Then it simply makes that root branch the new root, and starts
      * again.
+     *
+     * Optionally, MCTS can use a transposition table rather than a tree.
+     * In this mode nodes are keyed on their state and depth, so that the
+     * same state reached through different paths at the same depth shares
+     * its node and its UCT statistics. This turns the tree into a DAG,
+     * which can save a lot of simulations in domains where many action
+     * sequences lead to the same states (like grid worlds). The table is
+     * bounded in size: when a new node would not fit, the least recently
+     * used nodes are evicted to make room. Nodes used by the current
+     * simulation (or batch) are never evicted; if all nodes are, the new
+     * node is not stored and its value is estimated by the rollout alone.
+     *
+     * Optionally, MCTS can also evaluate leaves in batches (see
+     * setBatchSize()). In this mode each round descends the tree
+     * multiple times, collecting the new leaves, and then runs all their
+     * rollouts together in lockstep with a RolloutBatch, which can use the
+     * batch sampling interface of the model if available. The returns are
+     * then backed up along all the recorded paths. While descending,
+     * visit counts are updated immediately, so that the UCT bonus spreads
+     * the descents of a round over different branches; the values are
+     * only updated once the round is complete.
      */
     template <typename M>
     class MCTS {
@@ -61,9 +85,11 @@ namespace AIToolbox::MDP {
             using ActionNodes = std::vector<ActionNode>;
 
             struct StateNode {
-                StateNode() : N(0) {}
+                StateNode() : N(0), lastUse(0) {}
                 ActionNodes children;
                 unsigned N;
+                // Last simulation that used this node, in transposition mode.
+                unsigned lastUse;
             };
 
             /**
@@ -75,6 +101,21 @@ namespace AIToolbox::MDP {
              */
             MCTS(const M& m, unsigned iterations, double exp);
 
+            /**
+             * @brief Transposition table constructor.
+             *
+             * This constructor enables the transposition table mode when
+             * maxTableNodes is greater than zero.
+             *
+             * \sa setMaxTableNodes()
+             *
+             * @param m The MDP model that MCTS will operate upon.
+             * @param iterations The number of episodes to run before completion.
+             * @param exp The exploration constant. This parameter is VERY important to determine the final MCTS performance.
+             * @param maxTableNodes The maximum number of nodes in the transposition table.
+             */
+            MCTS(const M& m, unsigned iterations, double exp, size_t maxTableNodes);
+
             /**
              * @brief This function resets the internal graph and samples for the provided state and horizon.
              *
@@ -125,6 +166,33 @@ namespace AIToolbox::MDP {
              */
             void setExploration(double exp);
 
+            /**
+             * @brief This function sets the maximum size of the transposition table.
+             *
+             * A value of zero disables the transposition table, and MCTS
+             * builds a normal tree. Otherwise, all nodes below the root
+             * are stored in a table keyed on their state and depth.
+             *
+             * Changing this parameter discards the current graph, so that
+             * the next call to sampleAction() will start from scratch.
+             *
+             * @param maxNodes The new maximum number of nodes in the table.
+             */
+            void setMaxTableNodes(size_t maxNodes);
+
+            /**
+             * @brief This function sets the number of leaves evaluated together.
+             *
+             * The default of 1 disables batching; 0 is treated as 1.
+             *
+             * When the transposition table is enabled, nodes used in the
+             * current round cannot be evicted, so the table should be
+             * comfortably larger than the batch size times the horizon.
+             *
+             * @param batchSize The new batch size.
+             */
+            void setBatchSize(unsigned batchSize);
+
             /**
              * @brief This function returns the MDP generative model being used.
              *
@@ -139,6 +207,31 @@ namespace AIToolbox::MDP {
              */
             const StateNode& getGraph() const;
 
+            /**
+             * @brief This function returns the transposition table.
+             *
+             * Nodes are keyed by depth * S + state, where the depth is
+             * counted from the first root of the current episode. The table
+             * is empty when the transposition table mode is disabled.
+             *
+             * @return The transposition table.
+             */
+            const StateNodes& getTable() const;
+
+            /**
+             * @brief This function returns the maximum size of the transposition table.
+             *
+             * @return The maximum number of nodes in the table, or zero if disabled.
+             */
+            size_t getMaxTableNodes() const;
+
+            /**
+             * @brief This function returns the number of leaves evaluated together.
+             *
+             * @return The batch size.
+             */
+            unsigned getBatchSize() const;
+
             /**
              * @brief This function returns the number of iterations performed to plan for an action.
              *
@@ -161,11 +254,42 @@ namespace AIToolbox::MDP {
 
             StateNode graph_;
 
+            // Transposition table data
+            size_t maxTableNodes_;
+            unsigned rootDepth_, epoch_;
+            StateNodes table_;
+            // Keys of the table nodes in the order they were used, with the
+            // epoch of each use. An entry is stale if its node has been
+            // used again since, or has been removed.
+            std::deque<std::pair<size_t, unsigned>> lru_;
+
+            // Batched simulation data
+            struct PathStep {
+                ActionNode * node;
+                double rew;
+                // Visit count of the node after this visit.
+                unsigned n;
+            };
+            static constexpr size_t NoRollout = std::numeric_limits<size_t>::max();
+
+            unsigned batchSize_;
+            std::vector<PathStep> steps_;
+            // Offset of each path in steps_, and id of its rollout.
+            std::vector<std::pair<size_t, size_t>> paths_;
+            RolloutBatch rollouts_;
+
             mutable RandomEngine rand_;
 
             // Private Methods
+            void resetGraph();
+            void touch(size_t key, StateNode & node);
+            bool makeRoom();
+            StateNodes & getNodes(ActionNode & aNode);
+            size_t makeKey(size_t s1, unsigned depth) const;
             size_t runSimulation(size_t s, unsigned horizon);
             double simulate(StateNode & sn, size_t s, unsigned horizon);
+            void runBatch(size_t s, unsigned k);
+            void descend(size_t s);
             double rollout(size_t s, unsigned horizon);
 
             template <typename Iterator>
@@ -177,20 +301,54 @@ namespace AIToolbox::MDP {
 
     template <typename M>
     MCTS<M>::MCTS(const M& m, const unsigned iter, const double exp) :
+            MCTS(m, iter, exp, 0) {}
+
+    template <typename M>
+    MCTS<M>::MCTS(const M& m, const unsigned iter, const double exp, const size_t maxTableNodes) :
             model_(m), S(model_.getS()), A(model_.getA()), iterations_(iter),
-            exploration_(exp), graph_(), rand_(Impl::Seeder::getSeed()) {}
+            exploration_(exp), graph_(), maxTableNodes_(maxTableNodes), rootDepth_(0),
+            epoch_(0), batchSize_(1), rand_(Impl::Seeder::getSeed()) {}
 
     template <typename M>
-    size_t MCTS<M>::sampleAction(const size_t s, const unsigned horizon) {
-        // Reset graph
+    void MCTS<M>::resetGraph() {
         graph_ = StateNode();
         graph_.children.resize(A);
 
+        table_.clear();
+        lru_.clear();
+        rootDepth_ = 0;
+        epoch_ = 0;
+    }
+
+    template <typename M>
+    size_t MCTS<M>::sampleAction(const size_t s, const unsigned horizon) {
+        resetGraph();
+
         return runSimulation(s, horizon);
     }
 
     template <typename M>
     size_t MCTS<M>::sampleAction(const size_t a, const size_t s1, const unsigned horizon) {
+        if ( maxTableNodes_ ) {
+            // The new root is the node of s1 one level below the current
+            // one; in a DAG it does not matter which action reached it.
+            auto it = table_.find((rootDepth_ + 1) * S + s1);
+            if ( it == table_.end() )
+                return sampleAction(s1, horizon);
+
+            graph_ = std::move(it->second);
+            graph_.children.resize(A);
+            ++rootDepth_;
+
+            // Nodes at or above the new root depth can't be reached anymore.
+            // Their entries in lru_ are now stale, and will be skipped.
+            for ( auto jt = table_.begin(); jt != table_.end(); ) {
+                if ( jt->first / S <= rootDepth_ ) jt = table_.erase(jt);
+                else ++jt;
+            }
+            return runSimulation(s1, horizon);
+        }
+
         auto & states = graph_.children[a].children;
 
         auto it = states.find(s1);
@@ -218,8 +376,19 @@ namespace AIToolbox::MDP {
 
         maxDepth_ = horizon;
 
-        for (unsigned i = 0; i < iterations_; ++i )
-            simulate(graph_, s, 0);
+        for (unsigned i = 0; i < iterations_; ) {
+            // Nodes used in the current epoch are never evicted, so that
+            // the nodes on the current paths stay valid.
+            ++epoch_;
+            if ( batchSize_ == 1 ) {
+                simulate(graph_, s, 0);
+                ++i;
+            } else {
+                const auto k = std::min(batchSize_, iterations_ - i);
+                runBatch(s, k);
+                i += k;
+            }
+        }
 
         auto begin = std::begin(graph_.children);
         return std::distance(begin, findBestA(begin, std::end(graph_.children)));
@@ -239,13 +408,17 @@ namespace AIToolbox::MDP {
 
         // We only go deeper if needed (maxDepth_ is always at least 1).
         if ( depth + 1 < maxDepth_ && !model_.isTerminal(s1) ) {
-            const auto end = std::end(aNode.children);
-            auto it = aNode.children.find(s1);
+            auto & nodes = getNodes(aNode);
+            const size_t key = makeKey(s1, depth + 1);
+
+            const auto end = std::end(nodes);
+            auto it = nodes.find(key);
 
             double futureRew;
             if ( it == end ) {
-                // Touch node to create it
-                aNode.children[s1];
+                // Touch node to create it, if the table has room for it.
+                if ( !maxTableNodes_ ) nodes[key];
+                else if ( makeRoom() ) touch(key, nodes[key]);
                 futureRew = rollout(s1, depth + 1);
             }
             else {
@@ -255,6 +428,7 @@ namespace AIToolbox::MDP {
                 // already has memory this should not do anything in
                 // any case.
                 it->second.children.resize(A);
+                if ( maxTableNodes_ ) touch(key, it->second);
                 futureRew = simulate( it->second, s1, depth + 1 );
             }
 
@@ -268,6 +442,126 @@ namespace AIToolbox::MDP {
         return rew;
     }
 
+    template <typename M>
+    void MCTS<M>::runBatch(const size_t s, const unsigned k) {
+        steps_.clear();
+        paths_.clear();
+        rollouts_.clear();
+
+        for ( unsigned j = 0; j < k; ++j )
+            descend(s);
+
+        rollouts_.run(model_, maxDepth_, rand_);
+
+        // Backups are done in the same order as the descents, so that the
+        // recorded visit counts produce the exact running averages.
+        const auto discount = model_.getDiscount();
+        for ( size_t p = 0; p < paths_.size(); ++p ) {
+            const auto [begin, id] = paths_[p];
+            const auto end = p + 1 < paths_.size() ? paths_[p+1].first : steps_.size();
+
+            double rew = id == NoRollout ? 0.0 : rollouts_.getValue(id);
+            for ( auto i = end; i > begin; --i ) {
+                const auto & step = steps_[i-1];
+                rew = step.rew + discount * rew;
+                step.node->V += ( rew - step.node->V ) / static_cast<double>(step.n);
+            }
+        }
+    }
+
+    template <typename M>
+    void MCTS<M>::descend(size_t s) {
+        paths_.emplace_back(steps_.size(), NoRollout);
+
+        StateNode * sn = &graph_;
+        for ( unsigned depth = 0; ; ++depth ) {
+            sn->N++;
+
+            auto begin = std::begin(sn->children);
+            const size_t a = std::distance(begin, findBestBonusA(begin, std::end(sn->children), sn->N));
+
+            const auto [s1, rew] = model_.sampleSR(s, a);
+
+            // The visit is counted immediately, so the next descents in
+            // the batch see a lower exploration bonus for this action.
+            auto & aNode = sn->children[a];
+            steps_.push_back({&aNode, rew, ++aNode.N});
+
+            if ( depth + 1 >= maxDepth_ || model_.isTerminal(s1) )
+                return;
+
+            auto & nodes = getNodes(aNode);
+            const size_t key = makeKey(s1, depth + 1);
+
+            auto it = nodes.find(key);
+            if ( it == std::end(nodes) ) {
+                if ( !maxTableNodes_ ) nodes[key];
+                else if ( makeRoom() ) touch(key, nodes[key]);
+                paths_.back().second = rollouts_.add(s1, depth + 1);
+                return;
+            }
+            // Node references in unordered_maps are stable, children are
+            // only ever resized from empty, and nodes used in this batch
+            // are never evicted, so the pointers stored in steps_ remain
+            // valid for the whole batch.
+            it->second.children.resize(A);
+            if ( maxTableNodes_ ) touch(key, it->second);
+            sn = &it->second;
+            s = s1;
+        }
+    }
+
+    template <typename M>
+    typename MCTS<M>::StateNodes & MCTS<M>::getNodes(ActionNode & aNode) {
+        // In transposition mode all nodes live in the table, otherwise
+        // they are children of the action node.
+        return maxTableNodes_ ? table_ : aNode.children;
+    }
+
+    template <typename M>
+    size_t MCTS<M>::makeKey(const size_t s1, const unsigned depth) const {
+        return maxTableNodes_ ? (rootDepth_ + depth) * S + s1 : s1;
+    }
+
+    template <typename M>
+    void MCTS<M>::touch(const size_t key, StateNode & node) {
+        node.lastUse = epoch_;
+        lru_.emplace_back(key, epoch_);
+
+        // Every use adds an entry, so we drop the stale ones once they
+        // dominate the queue. This keeps the queue size linear in the
+        // table size, at an amortized constant cost per use.
+        if ( lru_.size() > 4 * maxTableNodes_ ) {
+            std::deque<std::pair<size_t, unsigned>> fresh;
+            for ( const auto & [k, e] : lru_ ) {
+                const auto it = table_.find(k);
+                if ( it != table_.end() && it->second.lastUse == e )
+                    fresh.emplace_back(k, e);
+            }
+            lru_ = std::move(fresh);
+        }
+    }
+
+    template <typename M>
+    bool MCTS<M>::makeRoom() {
+        // Since nodes only refer to each other through their keys, any
+        // node can be evicted without invalidating the others. We only
+        // need to spare the ones used in the current epoch, which are
+        // at the back of the queue.
+        while ( table_.size() >= maxTableNodes_ ) {
+            if ( lru_.empty() || lru_.front().second == epoch_ )
+                return false;
+
+            const auto [key, e] = lru_.front();
+            lru_.pop_front();
+
+            const auto it = table_.find(key);
+            if ( it != table_.end() && it->second.lastUse == e )
+                table_.erase(it);
+        }
+        return true;
+    }
+
     template <typename M>
     double MCTS<M>::rollout(size_t s, unsigned depth) {
         double rew = 0.0, totalRew = 0.0, gamma = 1.0;
@@ -327,6 +621,17 @@ namespace AIToolbox::MDP {
         exploration_ = exp;
     }
 
+    template <typename M>
+    void MCTS<M>::setMaxTableNodes(const size_t maxNodes) {
+        maxTableNodes_ = maxNodes;
+        resetGraph();
+    }
+
+    template <typename M>
+    void MCTS<M>::setBatchSize(const unsigned batchSize) {
+        batchSize_ = std::max(1u, batchSize);
+    }
+
     template <typename M>
     const M& MCTS<M>::getModel() const {
         return model_;
@@ -337,6 +642,21 @@ namespace AIToolbox::MDP {
         return graph_;
     }
 
+    template <typename M>
+    const typename MCTS<M>::StateNodes& MCTS<M>::getTable() const {
+        return table_;
+    }
+
+    template <typename M>
+    size_t MCTS<M>::getMaxTableNodes() const {
+        return maxTableNodes_;
+    }
+
+    template <typename M>
+    unsigned MCTS<M>::getBatchSize() const {
+        return batchSize_;
+    }
+
     template <typename M>
     unsigned MCTS<M>::getIterations() const {
         return iterations_;
@@ -0,0 +1,290 @@
+#ifndef AI_TOOLBOX_MDP_TOPOLOGICAL_VALUE_ITERATION_HEADER_FILE
+#define AI_TOOLBOX_MDP_TOPOLOGICAL_VALUE_ITERATION_HEADER_FILE
+
+#include <algorithm>
+
+#include <AIToolbox/Impl/Logging.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/TypeTraits.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class applies topological value iteration on a Model.
+     *
+     * Standard ValueIteration backs up every state at every sweep, until
+     * the whole ValueFunction has converged. In models where the
+     * transition graph is composed of many strongly connected components
+     * (SCCs), this wastes a lot of work: once all the successors of a
+     * component have converged, the component can be solved on its own,
+     * and never touched again.
+     *
+     * This algorithm first computes the SCC decomposition of the graph
+     * containing an edge s -> s' whenever any action can transition from
+     * s to s'. It then solves each component in reverse topological
+     * order (so all states a component depends upon are already solved),
+     * performing asynchronous (Gauss-Seidel) backups over the states of
+     * the component until its local variation drops below the tolerance.
+     *
+     * Components made of a single state without a self-loop are solved
+     * exactly with a single backup. On acyclic models, every state is
+     * thus backed up exactly once. As with ValueIteration, a horizon of
+     * zero performs no backups at all.
+     *
+     * Components are grouped in levels: a component's level is one more
+     * than the highest level among the components it can transition to.
+     * Components in the same level never depend on each other, so each
+     * level is solved in parallel on the default Executor (see
+     * Executor::getDefault()). The result does not depend on the number
+     * of workers.
+     *
+     * Note that the meaning of the horizon is different from
+     * ValueIteration: here it bounds the number of sweeps performed on
+     * each component, rather than the global number of sweeps. Thus, the
+     * result is only equivalent to ValueIteration in the infinite horizon
+     * case.
+     *
+     * This algorithm works best with sparse models (like
+     * MDP::SparseModel), as both the graph construction and the backups
+     * only iterate over non-zero transitions.
+     */
+    class TopologicalValueIteration {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * The tolerance parameter must be >= 0.0, otherwise the
+             * constructor will throw an std::invalid_argument. The
+             * tolerance parameter sets the convergence criterion of each
+             * component. A tolerance of 0.0 forces the algorithm to
+             * perform a number of sweeps equal to the horizon on every
+             * component which contains a cycle.
+             *
+             * @param horizon The maximum number of sweeps to perform on each component.
+             * @param tolerance The tolerance factor to stop iterating on a component.
+             */
+            TopologicalValueIteration(unsigned horizon, double tolerance = 0.001);
+
+            /**
+             * @brief This function applies topological value iteration on an MDP to solve it.
+             *
+             * The algorithm is constrained by the currently set parameters.
+             *
+             * @tparam M The type of the solvable MDP.
+             * @param m The MDP that needs to be solved.
+             * @return A tuple containing the maximum variation over all
+             *         components for the ValueFunction, the ValueFunction
+             *         and the QFunction for the Model.
+             */
+            template <typename M, typename = std::enable_if_t<is_model_v<M>>>
+            std::tuple<double, ValueFunction, QFunction> operator()(const M & m);
+
+            /**
+             * @brief This function sets the tolerance parameter.
+             *
+             * The tolerance parameter must be >= 0.0, otherwise the
+             * function will throw an std::invalid_argument.
+             *
+             * @param t The new tolerance parameter.
+             */
+            void setTolerance(double t);
+
+            /**
+             * @brief This function sets the horizon parameter.
+             *
+             * @param h The new horizon parameter.
+             */
+            void setHorizon(unsigned h);
+
+            /**
+             * @brief This function will return the currently set tolerance parameter.
+             *
+             * @return The currently set tolerance parameter.
+             */
+            double getTolerance() const;
+
+            /**
+             * @brief This function will return the current horizon parameter.
+             *
+             * @return The currently set horizon parameter.
+             */
+            unsigned getHorizon() const;
+
+            /**
+             * @brief This function returns the number of components found during the last solve.
+             *
+             * @return The number of strongly connected components of the last solved model.
+             */
+            size_t getComponentsNumber() const;
+
+            /**
+             * @brief This function returns the number of levels found during the last solve.
+             *
+             * All components in the same level are solved in parallel.
+             *
+             * @return The number of levels of components of the last solved model.
+             */
+            size_t getLevelsNumber() const;
+
+        private:
+            /**
+             * @brief This function calls the input function for each non-zero transition from s with a.
+             *
+             * @param model The model to inspect.
+             * @param s The initial state.
+             * @param a The action.
+             * @param f The function to call with the final state and its probability.
+             */
+            template <typename M, typename F>
+            static void forEachSuccessor(const M & model, size_t s, size_t a, F f);
+
+            /**
+             * @brief This function computes the SCCs of the graph stored in graphOffsets_ and graph_.
+             *
+             * The components are stored in components_ in reverse
+             * topological order, so that each component only depends on
+             * itself and the ones before it.
+             *
+             * @param S The number of nodes in the graph.
+             */
+            void computeComponents(size_t S);
+
+            /**
+             * @brief This function groups the components in levels that can be solved in parallel.
+             *
+             * The ids of the components are stored in levels_, with
+             * levels in the order in which they must be solved.
+             *
+             * @param S The number of nodes in the graph.
+             */
+            void computeLevels(size_t S);
+
+            // Parameters
+            double tolerance_;
+            unsigned horizon_;
+
+            // Successor graph in CSR format.
+            std::vector<size_t> graphOffsets_, graph_;
+            // Components: states, and the offsets of each component.
+            std::vector<size_t> components_, componentOffsets_;
+            // Levels: component ids, and the offsets of each level.
+            std::vector<size_t> levels_, levelOffsets_;
+    };
+
+    template <typename M, typename F>
+    void TopologicalValueIteration::forEachSuccessor(const M & model, const size_t s, const size_t a, F f) {
+        if constexpr(is_model_eigen_v<M>) {
+            using TM = remove_cv_ref_t<decltype(model.getTransitionFunction(a))>;
+            const auto & t = model.getTransitionFunction(a);
+            if constexpr(std::is_base_of_v<Eigen::SparseMatrixBase<TM>, TM>) {
+                static_assert(TM::IsRowMajor, "TopologicalValueIteration requires row-major sparse transition matrices.");
+                for ( typename TM::InnerIterator it(t, s); it; ++it )
+                    f(static_cast<size_t>(it.col()), static_cast<double>(it.value()));
+            } else {
+                for ( size_t s1 = 0; s1 < static_cast<size_t>(t.cols()); ++s1 )
+                    if ( t(s, s1) != 0 ) f(s1, static_cast<double>(t(s, s1)));
+            }
+        } else {
+            for ( size_t s1 = 0; s1 < model.getS(); ++s1 ) {
+                const double p = model.getTransitionProbability(s, a, s1);
+                if ( p != 0.0 ) f(s1, p);
+            }
+        }
+    }
+
+    template <typename M, typename>
+    std::tuple<double, ValueFunction, QFunction> TopologicalValueIteration::operator()(const M & model) {
+        const size_t S = model.getS();
+        const size_t A = model.getA();
+        const double discount = model.getDiscount();
+
+        // Build the union transition graph. Duplicates are removed with a
+        // marker on the last state that added them.
+        graphOffsets_.resize(S + 1);
+        graph_.clear();
+        {
+            std::vector<size_t> marker(S, S);
+            for ( size_t s = 0; s < S; ++s ) {
+                graphOffsets_[s] = graph_.size();
+                for ( size_t a = 0; a < A; ++a ) {
+                    forEachSuccessor(model, s, a, [&](const size_t s1, double) {
+                        if ( marker[s1] == s ) return;
+                        marker[s1] = s;
+                        graph_.push_back(s1);
+                    });
+                }
+            }
+            graphOffsets_[S] = graph_.size();
+        }
+        computeComponents(S);
+        computeLevels(S);
+        AI_LOGGER(AI_SEVERITY_INFO, "Found " << getComponentsNumber() << " components in " << getLevelsNumber() << " levels");
+
+        const auto & ir = getImmediateRewards(model);
+
+        auto v = makeValueFunction(S);
+        auto & values = v.values;
+        QFunction q = makeQFunction(S, A);
+
+        const auto backup = [&](const size_t s) {
+            for ( size_t a = 0; a < A; ++a ) {
+                double sum = 0.0;
+                forEachSuccessor(model, s, a, [&](const size_t s1, const double p) {
+                    sum += p * values[s1];
+                });
+                q(s, a) = ir(s, a) + discount * sum;
+            }
+            const double old = values[s];
+            values[s] = q.row(s).maxCoeff();
+            return std::abs(values[s] - old);
+        };
+
+        const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
+        // Each component writes only to its own states and variation.
+        std::vector<double> variations(getComponentsNumber(), 0.0);
+        const auto solve = [&](const size_t c) {
+            const auto begin = components_.begin() + componentOffsets_[c];
+            const auto end   = components_.begin() + componentOffsets_[c+1];
+
+            // Acyclic single states are solved exactly, unless we are not
+            // allowed any backup at all.
+            if ( end - begin == 1 && horizon_ > 0 ) {
+                const auto s = *begin;
+                const auto gb = graph_.begin() + graphOffsets_[s], ge = graph_.begin() + graphOffsets_[s+1];
+                if ( std::find(gb, ge, s) == ge ) {
+                    backup(s);
+                    return;
+                }
+            }
+
+            double variation = tolerance_ * 2;
+            unsigned timestep = 0;
+            while ( timestep < horizon_ && (!useTolerance || variation > tolerance_) ) {
+                ++timestep;
+                variation = 0.0;
+                for ( auto it = begin; it != end; ++it )
+                    variation = std::max(variation, backup(*it));
+            }
+            if ( useTolerance )
+                variations[c] = variation;
+        };
+
+        const auto executor = Executor::getDefault();
+        for ( size_t l = 0; l + 1 < levelOffsets_.size(); ++l ) {
+            executor->parallelFor(levelOffsets_[l], levelOffsets_[l+1], [&](const size_t i) {
+                solve(levels_[i]);
+            });
+        }
+        const double maxVariation = variations.size() ? *std::max_element(variations.begin(), variations.end()) : 0.0;
+
+        // Set the actions; the values already match the QFunction.
+        bellmanOperatorInline(q, &v);
+
+        return std::make_tuple(maxVariation, std::move(v), std::move(q));
+    }
+}
+
+#endif
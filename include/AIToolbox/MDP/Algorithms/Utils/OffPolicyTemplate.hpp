@@ -244,6 +244,9 @@ namespace AIToolbox::MDP {
 
         protected:
             const PolicyInterface & target_;
+
+            // Buffer for the action probabilities of the target policy.
+            Vector probs_;
     };
 
     /**
@@ -351,9 +354,8 @@ namespace AIToolbox::MDP {
 
     template <typename Derived>
     void OffPolicyEvaluation<Derived>::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const double rew) {
-        auto expectedQ = 0.0;
-        for (size_t a = 0; a < A; ++a)
-            expectedQ += q_(s1, a) * target_.getActionProbability(s1, a);
+        target_.getActionProbabilities(s1, &probs_);
+        const double expectedQ = q_.row(s1) * probs_;
 
         const auto error = alpha_ * ( rew + discount_ * expectedQ - q_(s, a) );
         const auto traceDiscount = discount_ * static_cast<Derived*>(this)->getTraceDiscount(s, a, s1, rew);
@@ -395,7 +397,7 @@ namespace AIToolbox::MDP {
         const double discount, const double alpha, const double tolerance
     ) :
         Parent(behaviour, discount, alpha, tolerance),
-        target_(target) {}
+        target_(target), probs_(this->A) {}
 
     template <typename Derived>
     OffPolicyControl<Derived>::OffPolicyControl(
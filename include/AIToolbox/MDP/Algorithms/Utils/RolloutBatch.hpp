@@ -0,0 +1,144 @@
+#ifndef AI_TOOLBOX_MDP_ROLLOUT_BATCH_HEADER_FILE
+#define AI_TOOLBOX_MDP_ROLLOUT_BATCH_HEADER_FILE
+
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class runs many random-policy rollouts in lockstep.
+     *
+     * Online planners like MCTS and POMCP evaluate new leaves by
+     * following a random policy until the horizon (or a terminal state)
+     * is reached, and using the discounted return as the value estimate.
+     * Running these one at a time spends most of the time in per-step
+     * overhead: a function call and a random number draw for every
+     * transition.
+     *
+     * This class instead collects a batch of starting states, and then
+     * advances all their rollouts one step at a time. At each step the
+     * random actions for all active rollouts are drawn together, and the
+     * transitions are sampled with a single call to the model's
+     * sampleSRBatch() if it provides one (see
+     * MDP::is_batch_generative_model). Rollouts which terminate are
+     * removed from the active set, so that each step only works on live
+     * rollouts.
+     *
+     * All buffers are kept between batches, so after the first batch no
+     * allocations are performed.
+     */
+    class RolloutBatch {
+        public:
+            /**
+             * @brief This function adds a new rollout to the batch.
+             *
+             * @param s The state to start the rollout from.
+             * @param depth The depth of the state, which is counted towards the horizon.
+             *
+             * @return The id of the rollout, to retrieve its value later.
+             */
+            size_t add(size_t s, unsigned depth);
+
+            /**
+             * @brief This function removes all rollouts from the batch.
+             */
+            void clear();
+
+            /**
+             * @brief This function returns the number of rollouts in the batch.
+             *
+             * @return The number of rollouts.
+             */
+            size_t size() const;
+
+            /**
+             * @brief This function runs all rollouts in the batch until the horizon.
+             *
+             * Each rollout follows a uniform random policy from its
+             * starting state, until its depth reaches maxDepth or it
+             * reaches a terminal state.
+             *
+             * @tparam M The type of the generative model.
+             * @param model The model to sample from.
+             * @param maxDepth The depth at which the rollouts stop.
+             * @param rnd The random engine used to pick the actions.
+             */
+            template <typename M, typename = std::enable_if_t<is_generative_model_v<M>>>
+            void run(const M & model, unsigned maxDepth, RandomEngine & rnd);
+
+            /**
+             * @brief This function returns the discounted return of a rollout.
+             *
+             * This is only valid after run() has been called.
+             *
+             * @param id The id of the rollout, as returned by add().
+             *
+             * @return The discounted return of the rollout.
+             */
+            double getValue(size_t id) const;
+
+        private:
+            // Per-rollout data
+            std::vector<size_t> states_;
+            std::vector<unsigned> depths_;
+            std::vector<double> values_, gammas_;
+
+            // Per-step data, only for active rollouts
+            std::vector<size_t> active_, current_, actions_, next_;
+            std::vector<double> rewards_;
+    };
+
+    template <typename M, typename>
+    void RolloutBatch::run(const M & model, const unsigned maxDepth, RandomEngine & rnd) {
+        const size_t N = states_.size();
+        const double discount = model.getDiscount();
+
+        values_.assign(N, 0.0);
+        gammas_.assign(N, 1.0);
+
+        active_.clear();
+        for ( size_t i = 0; i < N; ++i )
+            if ( depths_[i] < maxDepth )
+                active_.push_back(i);
+
+        std::uniform_int_distribution<size_t> generator(0, model.getA() - 1);
+        while ( active_.size() ) {
+            const size_t K = active_.size();
+            current_.resize(K);
+            actions_.resize(K);
+            next_.resize(K);
+            rewards_.resize(K);
+
+            for ( size_t j = 0; j < K; ++j ) {
+                current_[j] = states_[active_[j]];
+                actions_[j] = generator(rnd);
+            }
+
+            if constexpr(is_batch_generative_model_v<M>) {
+                model.sampleSRBatch(K, current_.data(), actions_.data(), next_.data(), rewards_.data());
+            } else {
+                for ( size_t j = 0; j < K; ++j )
+                    std::tie(next_[j], rewards_[j]) = model.sampleSR(current_[j], actions_[j]);
+            }
+
+            // Accumulate and compact the active set in place.
+            size_t kept = 0;
+            for ( size_t j = 0; j < K; ++j ) {
+                const size_t i = active_[j];
+                values_[i] += gammas_[i] * rewards_[j];
+                states_[i] = next_[j];
+
+                if ( ++depths_[i] >= maxDepth || model.isTerminal(next_[j]) )
+                    continue;
+
+                gammas_[i] *= discount;
+                active_[kept++] = i;
+            }
+            active_.resize(kept);
+        }
+    }
+}
+
+#endif
@@ -8,6 +8,8 @@
 #include <AIToolbox/Utils/Probability.hpp>
 
 namespace AIToolbox::MDP {
+    class ShardedModel;
+
     /**
      * @brief This class applies the value iteration algorithm on a Model.
      *
@@ -23,6 +25,18 @@ namespace AIToolbox::MDP {
      *
      * This implementation in particular is ported from the MATLAB
      * MDPToolbox (although it is simplified).
+     *
+     * Models that store their tables in single precision (like
+     * MDP::ModelT<float> or MDP::SparseModelT<float>) are supported: the
+     * Bellman backups read their tables in their own precision, while the
+     * value and QFunctions are kept in double, so that the tolerance
+     * criterion behaves as for double precision models.
+     *
+     * The backups are split over blocks of states, and run on the
+     * default Executor (see Executor::getDefault()).
+     *
+     * A ShardedModel can also be solved, even if its tables do not fit in
+     * memory: see operator()(const ShardedModel &).
      */
     class ValueIteration {
         public:
@@ -62,6 +76,27 @@ namespace AIToolbox::MDP {
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
             std::tuple<double, ValueFunction, QFunction> operator()(const M & m);
 
+            /**
+             * @brief This function applies value iteration on an MDP stored on disk.
+             *
+             * Each iteration streams all shards of the model once, while
+             * only the value and QFunctions are kept in memory. The shards
+             * are processed in parallel on the default Executor, and each
+             * worker prefetches the shard it is likely to process next, so
+             * that reading from disk overlaps with the backups. Using an
+             * Executor with less workers reduces the number of shards
+             * which are read at once.
+             *
+             * The results are the same as the ones obtained by solving
+             * the same model in memory.
+             *
+             * @param m The MDP that needs to be solved.
+             * @return A tuple containing the maximum variation for the
+             *         ValueFunction, the ValueFunction and the QFunction for
+             *         the Model.
+             */
+            std::tuple<double, ValueFunction, QFunction> operator()(const ShardedModel & m);
+
             /**
              * @brief This function sets the tolerance parameter.
              *
@@ -147,10 +182,8 @@ namespace AIToolbox::MDP {
                 v1_ = vParameter_;
         }
 
-        const auto & ir = [&]{
-            if constexpr (is_model_eigen_v<M>) return model.getRewardFunction();
-            else return computeImmediateRewards(model);
-        }();
+        const auto & ir = getImmediateRewards(model);
+        const auto executor = Executor::getDefault();
 
         unsigned timestep = 0;
         double variation = tolerance_ * 2; // Make it bigger
@@ -168,7 +201,10 @@ namespace AIToolbox::MDP {
 
             // We apply the discount directly on the values vector.
             val1 *= model.getDiscount();
-            q = computeQFunction(model, val1, ir);
+            // We start from the immediate rewards in the memory of q, and
+            // move it through the backup so it is never reallocated.
+            q = ir;
+            q = computeQFunction(model, val1, std::move(q), *executor);
 
             // Compute the new value function (note that also val1 is overwritten)
             bellmanOperatorInline(q, &v1_);
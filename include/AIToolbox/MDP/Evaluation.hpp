@@ -0,0 +1,139 @@
+#ifndef AI_TOOLBOX_MDP_EVALUATION_HEADER_FILE
+#define AI_TOOLBOX_MDP_EVALUATION_HEADER_FILE
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/Utils/Evaluation.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This function estimates the value of an agent by running episodes on a model.
+     *
+     * This function runs the input number of episodes, each starting from
+     * the input state and lasting until a terminal state is reached or
+     * until the horizon runs out. It reports the mean discounted return
+     * over all episodes, its 95% confidence interval, and the average time
+     * taken by the agent to select each action.
+     *
+     * The agent can be anything with a `size_t sampleAction(size_t s)`
+     * method, like any MDP policy, or an online planner like MCTS. Online
+     * planners are called with sampleAction(s, horizon) on the first step
+     * of each episode, and with sampleAction(a, s1, horizon) afterwards,
+     * where horizon is the number of steps remaining in the episode.
+     *
+     * Agents are built by calling makeAgent(worker) once for each worker
+     * of the Executor, before any episode is run; each agent is then only
+     * used by the worker with the same index within this call, in
+     * sequence, even if other threads are using the same Executor. Since agents (and models) own
+     * their random engines, agents which keep a reference to a model to
+     * sample it (like MCTS) must each be given their own copy of it.
+     *
+     * If the model provides its transition probabilities (i.e. if it
+     * satisfies is_model), episodes are run in parallel, and the model is
+     * only read: transitions are sampled with the RandomEngine of each
+     * worker. Models like Model and SparseModel are sampled through their
+     * sampleSR(s, a, rnd); for the others the next state is drawn from
+     * the transition probabilities, and rewards are the expected rewards
+     * of each transition. In deterministic mode, together with
+     * Impl::Seeder::setRootSeed(), this makes the results reproducible.
+     *
+     * Otherwise, the model can only be sampled through its own sampleSR(),
+     * which is not thread-safe, so all episodes are run serially on the
+     * calling thread, with a single agent.
+     *
+     * @tparam M The type of the model to evaluate the agent on.
+     * @tparam MakeAgent The type of the function building the agents.
+     * @param model The model to evaluate the agent on.
+     * @param makeAgent A function taking a worker index and returning an agent.
+     * @param s The state each episode starts from.
+     * @param episodes The number of episodes to run.
+     * @param horizon The maximum number of steps of each episode.
+     * @param e The Executor used to run the episodes.
+     *
+     * @return The results of the evaluation.
+     */
+    template <typename M, typename MakeAgent, typename = std::enable_if_t<is_generative_model_v<M>>>
+    EvaluationResults evaluatePolicy(const M & model, MakeAgent makeAgent, size_t s, size_t episodes, unsigned horizon, Executor & e = *Executor::getDefault()) {
+        using Agent = std::decay_t<decltype(makeAgent(0u))>;
+        using Clock = std::chrono::steady_clock;
+
+        if ( s >= model.getS() ) throw std::invalid_argument("The starting state given to MDP::evaluatePolicy is out of range.");
+
+        const unsigned workers = is_model_v<M> ? e.getConcurrency() : 1;
+
+        // The agents are built in order on the calling thread, so that
+        // seeds are assigned deterministically.
+        std::vector<std::unique_ptr<Agent>> agents;
+        agents.reserve(workers);
+        for ( unsigned w = 0; w < workers; ++w )
+            agents.emplace_back(new Agent(makeAgent(w)));
+
+        std::vector<double> returns(episodes), seconds(workers, 0.0);
+        std::vector<size_t> steps(workers, 0);
+
+        const auto runEpisode = [&](const size_t i, const unsigned w, auto sampleSR) {
+            auto & agent = *agents[w];
+            size_t s0 = s, a = 0;
+            double ret = 0.0, discount = 1.0;
+
+            for ( unsigned t = 0; t < horizon && !model.isTerminal(s0); ++t ) {
+                const auto start = Clock::now();
+                if constexpr (Impl::is_online_planner_v<Agent>) {
+                    if ( t == 0 ) a = agent.sampleAction(s0, horizon);
+                    else          a = agent.sampleAction(a, s0, horizon - t);
+                } else {
+                    a = agent.sampleAction(s0);
+                }
+                seconds[w] += std::chrono::duration<double>(Clock::now() - start).count();
+
+                const auto [s1, r] = sampleSR(s0, a);
+                ret += discount * r;
+                discount *= model.getDiscount();
+                s0 = s1;
+                ++steps[w];
+            }
+            returns[i] = ret;
+        };
+
+        if constexpr (is_model_v<M>) {
+            // The worker index is given by parallelFor, which guarantees
+            // that no other thread uses it for this call at the same time.
+            e.parallelFor(0, episodes, [&](const size_t i, const unsigned w) {
+                auto & rnd = e.getRandomEngine();
+                runEpisode(i, w, [&](const size_t s0, const size_t a) {
+                    if constexpr (Impl::has_engine_sampleSR_v<M>) {
+                        return model.sampleSR(s0, a, rnd);
+                    } else {
+                        const auto s1 = Impl::sampleIndex(model.getS(), [&](const size_t ss) {
+                            return model.getTransitionProbability(s0, a, ss);
+                        }, rnd);
+                        return std::make_tuple(s1, model.getExpectedReward(s0, a, s1));
+                    }
+                });
+            }, 1);
+        } else {
+            for ( size_t i = 0; i < episodes; ++i )
+                runEpisode(i, 0, [&](const size_t s0, const size_t a) {
+                    return model.sampleSR(s0, a);
+                });
+        }
+
+        size_t totalSteps = 0;
+        double totalSeconds = 0.0;
+        for ( unsigned w = 0; w < workers; ++w ) {
+            totalSteps += steps[w];
+            totalSeconds += seconds[w];
+        }
+
+        return makeEvaluationResults(std::move(returns), totalSteps, totalSeconds);
+    }
+}
+
+#endif
@@ -0,0 +1,400 @@
+#ifndef AI_TOOLBOX_MDP_FIXED_MODEL_HEADER_FILE
+#define AI_TOOLBOX_MDP_FIXED_MODEL_HEADER_FILE
+
+#include <array>
+#include <utility>
+#include <random>
+
+#include <AIToolbox/Impl/Seeder.hpp>
+#include <AIToolbox/Types.hpp>
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class represents a Markov Decision Process with sizes known at compile time.
+     *
+     * This class is equivalent to MDP::Model, but the number of states and
+     * actions are template parameters rather than constructor arguments.
+     * All tables are stored in fixed-size Eigen matrices, so that the
+     * class performs no heap allocations, and all products between its
+     * tables and fixed-size vectors can be fully unrolled by the compiler.
+     *
+     * This is only useful for very small problems (a handful of states),
+     * where the overhead of dynamic allocation and of the generic Eigen
+     * kernels dominates the actual computation. For anything bigger you
+     * should use MDP::Model, which will also compile much faster.
+     *
+     * The class implements the full Eigen model interface, so it can be
+     * used with all MDP algorithms, and can be converted to and from any
+     * other model.
+     *
+     * @tparam S The number of states of the world.
+     * @tparam A The number of actions available to the agent.
+     */
+    template <size_t S, size_t A>
+    class FixedModel {
+        static_assert(S > 0 && A > 0, "FixedModel needs at least one state and one action.");
+
+        public:
+            using TransitionMatrix  = Eigen::Matrix<double, static_cast<int>(S), static_cast<int>(S), Eigen::RowMajor>;
+            using TransitionTable   = std::array<TransitionMatrix, A>;
+            using RewardTable       = Eigen::Matrix<double, static_cast<int>(S), static_cast<int>(A),
+                                                    (A == 1 && S != 1) ? Eigen::ColMajor : Eigen::RowMajor>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor initializes the FixedModel so that all
+             * transitions happen with probability 0 but for transitions
+             * that bring back to the same state, no matter the action.
+             *
+             * All rewards are set to 0.
+             *
+             * @param discount The discount factor for the MDP.
+             */
+            FixedModel(double discount = 1.0);
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor takes two arbitrary three dimensional
+             * containers and tries to copy their contents into the
+             * transitions and rewards tables respectively.
+             *
+             * The containers need to support data access through
+             * operator[], and their dimensions must be S,A,S.
+             *
+             * This is important, as this constructor DOES NOT perform any
+             * size checks on the external containers.
+             *
+             * In addition, the transition container must contain a valid
+             * transition function, and the discount must be between 0 and
+             * 1 included, otherwise the constructor will throw an
+             * std::invalid_argument.
+             *
+             * @tparam T The external transition container type.
+             * @tparam R The external rewards container type.
+             * @param t The external transitions container.
+             * @param r The external rewards container.
+             * @param d The discount factor for the MDP.
+             */
+            template <typename T, typename R>
+            FixedModel(const T & t, const R & r, double d = 1.0);
+
+            /**
+             * @brief Copy constructor from any valid MDP model.
+             *
+             * The input model must have exactly S states and A actions,
+             * otherwise the constructor will throw an
+             * std::invalid_argument.
+             *
+             * @tparam M The type of the other model.
+             * @param model The model that needs to be copied.
+             */
+            template <typename M, typename = std::enable_if_t<is_model_v<M>>>
+            FixedModel(const M& model);
+
+            /**
+             * @brief Unchecked constructor.
+             *
+             * This constructor takes ownership of the data that it is
+             * passed to it, and does not perform any sanity checks.
+             *
+             * Note that to use it you have to explicitly use the NO_CHECK
+             * tag parameter first.
+             *
+             * @param t The transition function to be used in the FixedModel.
+             * @param r The reward function to be used in the FixedModel.
+             * @param d The discount factor for the FixedModel.
+             */
+            FixedModel(NoCheck, TransitionTable && t, RewardTable && r, double d);
+
+            /**
+             * @brief This function replaces the transition function with the one provided.
+             *
+             * This function will throw a std::invalid_argument if the
+             * table provided does not contain valid probabilities.
+             *
+             * The container needs to support data access through
+             * operator[], and its dimensions must be S,A,S.
+             *
+             * @tparam T The external transition container type.
+             * @param t The external transitions container.
+             */
+            template <typename T>
+            void setTransitionFunction(const T & t);
+
+            /**
+             * @brief This function sets the transition function using fixed-size Eigen matrices.
+             *
+             * This function will throw a std::invalid_argument if the
+             * table provided does not contain valid probabilities.
+             *
+             * @param t The external transitions container.
+             */
+            void setTransitionFunction(const TransitionTable & t);
+
+            /**
+             * @brief This function replaces the reward function with the one provided.
+             *
+             * The container needs to support data access through
+             * operator[], and its dimensions must be S,A,S.
+             *
+             * @tparam R The external rewards container type.
+             * @param r The external rewards container.
+             */
+            template <typename R>
+            void setRewardFunction(const R & r);
+
+            /**
+             * @brief This function replaces the reward function with the one provided.
+             *
+             * @param r The external rewards container.
+             */
+            void setRewardFunction(const RewardTable & r);
+
+            /**
+             * @brief This function sets a new discount factor for the FixedModel.
+             *
+             * @param d The new discount factor for the FixedModel.
+             */
+            void setDiscount(double d);
+
+            /**
+             * @brief This function samples the MDP for the specified state action pair.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            constexpr size_t getS() const { return S; }
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            constexpr size_t getA() const { return A; }
+
+            /**
+             * @brief This function returns the currently set discount factor.
+             *
+             * @return The currently set discount factor.
+             */
+            double getDiscount() const;
+
+            /**
+             * @brief This function returns the stored transition probability for the specified transition.
+             *
+             * @param s The initial state of the transition.
+             * @param a The action performed in the transition.
+             * @param s1 The final state of the transition.
+             *
+             * @return The probability of the specified transition.
+             */
+            double getTransitionProbability(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the stored expected reward for the specified transition.
+             *
+             * @param s The initial state of the transition.
+             * @param a The action performed in the transition.
+             * @param s1 The final state of the transition.
+             *
+             * @return The expected reward of the specified transition.
+             */
+            double getExpectedReward(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the transition table for inspection.
+             *
+             * @return The transition table.
+             */
+            const TransitionTable & getTransitionFunction() const;
+
+            /**
+             * @brief This function returns the transition function for a given action.
+             *
+             * @param a The action requested.
+             *
+             * @return The transition function for the input action.
+             */
+            const TransitionMatrix & getTransitionFunction(size_t a) const;
+
+            /**
+             * @brief This function returns the rewards table for inspection.
+             *
+             * @return The rewards table.
+             */
+            const RewardTable & getRewardFunction() const;
+
+            /**
+             * @brief This function returns whether a given state is a terminal.
+             *
+             * @param s The state examined.
+             *
+             * @return True if the input state is a terminal, false otherwise.
+             */
+            bool isTerminal(size_t s) const;
+
+        private:
+            double discount_;
+
+            TransitionTable transitions_;
+            RewardTable rewards_;
+
+            mutable RandomEngine rand_;
+    };
+
+    template <size_t S, size_t A>
+    FixedModel<S, A>::FixedModel(const double discount) :
+            rand_(Impl::Seeder::getSeed())
+    {
+        setDiscount(discount);
+        for ( auto & t : transitions_ )
+            t.setIdentity();
+
+        rewards_.setZero();
+    }
+
+    template <size_t S, size_t A>
+    template <typename T, typename R>
+    FixedModel<S, A>::FixedModel(const T & t, const R & r, const double d) :
+            rand_(Impl::Seeder::getSeed())
+    {
+        setDiscount(d);
+        setTransitionFunction(t);
+        setRewardFunction(r);
+    }
+
+    template <size_t S, size_t A>
+    template <typename M, typename>
+    FixedModel<S, A>::FixedModel(const M& model) :
+            rand_(Impl::Seeder::getSeed())
+    {
+        if ( model.getS() != S || model.getA() != A )
+            throw std::invalid_argument("Input model does not have the same size as the FixedModel.");
+
+        setDiscount(model.getDiscount());
+        if constexpr (is_model_eigen_v<M>) {
+            for ( size_t a = 0; a < A; ++a )
+                transitions_[a] = model.getTransitionFunction(a).template cast<double>();
+            rewards_ = model.getRewardFunction().template cast<double>();
+        } else {
+            rewards_.setZero();
+            for ( size_t a = 0; a < A; ++a )
+                for ( size_t s = 0; s < S; ++s ) {
+                    for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                        transitions_[a](s, s1) = model.getTransitionProbability(s, a, s1);
+                        rewards_    (s, a)     += model.getExpectedReward       (s, a, s1) * transitions_[a](s, s1);
+                    }
+                    if ( !checkEqualSmall(1.0, transitions_[a].row(s).sum()) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+                }
+        }
+    }
+
+    template <size_t S, size_t A>
+    FixedModel<S, A>::FixedModel(NoCheck, TransitionTable && t, RewardTable && r, const double d) :
+            discount_(d), transitions_(std::move(t)), rewards_(std::move(r)),
+            rand_(Impl::Seeder::getSeed()) {}
+
+    template <size_t S, size_t A>
+    template <typename T>
+    void FixedModel<S, A>::setTransitionFunction(const T & t) {
+        for ( size_t s = 0; s < S; ++s )
+            for ( size_t a = 0; a < A; ++a )
+                if ( ! isProbability(S, t[s][a]) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+
+        for ( size_t s = 0; s < S; ++s )
+            for ( size_t a = 0; a < A; ++a )
+                for ( size_t s1 = 0; s1 < S; ++s1 )
+                    transitions_[a](s, s1) = t[s][a][s1];
+    }
+
+    template <size_t S, size_t A>
+    void FixedModel<S, A>::setTransitionFunction(const TransitionTable & t) {
+        for ( size_t a = 0; a < A; ++a )
+            for ( size_t s = 0; s < S; ++s )
+                if ( t[a].row(s).minCoeff() < 0.0 || !checkEqualSmall(1.0, t[a].row(s).sum()) )
+                    throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+
+        transitions_ = t;
+    }
+
+    template <size_t S, size_t A>
+    template <typename R>
+    void FixedModel<S, A>::setRewardFunction(const R & r) {
+        rewards_.setZero();
+        for ( size_t s = 0; s < S; ++s )
+            for ( size_t a = 0; a < A; ++a )
+                for ( size_t s1 = 0; s1 < S; ++s1 )
+                    rewards_(s, a) += r[s][a][s1] * transitions_[a](s, s1);
+    }
+
+    template <size_t S, size_t A>
+    void FixedModel<S, A>::setRewardFunction(const RewardTable & r) {
+        rewards_ = r;
+    }
+
+    template <size_t S, size_t A>
+    void FixedModel<S, A>::setDiscount(const double d) {
+        if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
+        discount_ = d;
+    }
+
+    template <size_t S, size_t A>
+    std::tuple<size_t, double> FixedModel<S, A>::sampleSR(const size_t s, const size_t a) const {
+        const size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
+
+        return std::make_tuple(s1, rewards_(s, a));
+    }
+
+    template <size_t S, size_t A>
+    double FixedModel<S, A>::getDiscount() const { return discount_; }
+
+    template <size_t S, size_t A>
+    double FixedModel<S, A>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+        return transitions_[a](s, s1);
+    }
+
+    template <size_t S, size_t A>
+    double FixedModel<S, A>::getExpectedReward(const size_t s, const size_t a, const size_t) const {
+        return rewards_(s, a);
+    }
+
+    template <size_t S, size_t A>
+    const typename FixedModel<S, A>::TransitionTable & FixedModel<S, A>::getTransitionFunction() const {
+        return transitions_;
+    }
+
+    template <size_t S, size_t A>
+    const typename FixedModel<S, A>::TransitionMatrix & FixedModel<S, A>::getTransitionFunction(const size_t a) const {
+        return transitions_[a];
+    }
+
+    template <size_t S, size_t A>
+    const typename FixedModel<S, A>::RewardTable & FixedModel<S, A>::getRewardFunction() const {
+        return rewards_;
+    }
+
+    template <size_t S, size_t A>
+    bool FixedModel<S, A>::isTerminal(const size_t s) const {
+        for ( size_t a = 0; a < A; ++a )
+            if ( !checkEqualSmall(1.0, transitions_[a](s, s)) )
+                return false;
+        return true;
+    }
+}
+
+#endif
@@ -125,7 +125,6 @@ namespace AIToolbox::MDP {
      */
     std::istream& operator>>(std::istream &is, SparseExperience & e);
 
-    class Model;
     /**
      * @brief This function implements input from stream for the MDP::Model class.
      *
@@ -152,6 +151,41 @@ namespace AIToolbox::MDP {
      * @return The input stream.
      */
     std::istream& operator>>(std::istream &is, Policy &);
+
+    class DeterministicPolicy;
+    /**
+     * @brief This function writes a DeterministicPolicy to a binary stream.
+     *
+     * The output contains a short header with the size of the policy,
+     * followed by the raw action indices at the width used by the
+     * policy. The integers are written in the native byte order, so the
+     * output can only be read back on a machine with the same
+     * endianness.
+     *
+     * The stream should be opened in binary mode.
+     *
+     * @param os The stream where the policy is written.
+     * @param p The policy to write.
+     *
+     * @return The original stream.
+     */
+    std::ostream& writeBinary(std::ostream &os, const DeterministicPolicy & p);
+
+    /**
+     * @brief This function reads a DeterministicPolicy from a binary stream.
+     *
+     * This function reads streams produced by writeBinary(). The number of
+     * states and actions in the stream must match the ones of the input
+     * policy, and all actions must be valid. If not, or if not enough data
+     * can be read, the function sets the failbit of the stream and the
+     * input policy is not modified.
+     *
+     * @param is The stream were the policy is being read from.
+     * @param p The policy that is being assigned.
+     *
+     * @return The input stream.
+     */
+    std::istream& readBinary(std::istream &is, DeterministicPolicy & p);
 }
 
 #endif
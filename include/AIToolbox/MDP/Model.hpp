@@ -66,11 +66,22 @@ namespace AIToolbox::MDP {
      *
      * Since so much information can be extracted from the QFunction, lots
      * of methods (mostly in Reinforcement Learning) try to learn it.
+     *
+     * The Scalar template parameter selects the type used to store the
+     * transition and reward tables. Most of the time you will want to use
+     * the MDP::Model alias, which stores them as doubles. Using floats
+     * halves the memory used by the model, which speeds up planning when
+     * the tables are large enough that memory bandwidth dominates. The
+     * interface of the class is unchanged: individual probabilities and
+     * rewards are still returned as doubles.
+     *
+     * @tparam Scalar The type used to store the transition and reward tables.
      */
-    class Model {
+    template <typename Scalar>
+    class ModelT {
         public:
-            using TransitionTable   = Matrix3D;
-            using RewardTable       = Matrix2D;
+            using TransitionTable   = Matrix3DT<Scalar>;
+            using RewardTable       = Matrix2DT<Scalar>;
 
             /**
              * @brief Basic constructor.
@@ -86,7 +97,7 @@ namespace AIToolbox::MDP {
              * @param a The number of actions available to the agent.
              * @param discount The discount factor for the MDP.
              */
-            Model(size_t s, size_t a, double discount = 1.0);
+            ModelT(size_t s, size_t a, double discount = 1.0);
 
             /**
              * @brief Basic constructor.
@@ -124,7 +135,7 @@ namespace AIToolbox::MDP {
              * @param d The discount factor for the MDP.
              */
             template <typename T, typename R>
-            Model(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
+            ModelT(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
 
             /**
              * @brief Copy constructor from any valid MDP model.
@@ -139,7 +150,7 @@ namespace AIToolbox::MDP {
              * @param model The model that needs to be copied.
              */
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
-            Model(const M& model);
+            ModelT(const M& model);
 
             /**
              * @brief Unchecked constructor.
@@ -158,7 +169,7 @@ namespace AIToolbox::MDP {
              * @param r The reward function to be used in the Model.
              * @param d The discount factor for the Model.
              */
-            Model(NoCheck, size_t s, size_t a, TransitionTable && t, RewardTable && r, double d);
+            ModelT(NoCheck, size_t s, size_t a, TransitionTable && t, RewardTable && r, double d);
 
             /**
              * @brief This function replaces the Model transition function with the one provided.
@@ -261,6 +272,37 @@ namespace AIToolbox::MDP {
              */
             std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
 
+            /**
+             * @brief This function samples the MDP for the specified state action pair, with the input RandomEngine.
+             *
+             * This function is equivalent to sampleSR(size_t, size_t),
+             * but it does not use the RandomEngine of the model. Since it
+             * does not modify the model, it can be called concurrently by
+             * multiple threads, as long as each uses its own engine.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The RandomEngine to sample with.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function samples the MDP for many state action pairs at once.
+             *
+             * This function is equivalent to calling sampleSR() for each
+             * pair, but avoids the per-call overhead, and draws all
+             * random numbers for the batch in a single pass.
+             *
+             * @param n The number of pairs to sample.
+             * @param s The states that need to be sampled.
+             * @param a The actions that need to be sampled.
+             * @param s1 The output sampled states.
+             * @param r The output sampled rewards.
+             */
+            void sampleSRBatch(size_t n, const size_t * s, const size_t * a, size_t * s1, double * r) const;
+
             /**
              * @brief This function returns the number of states of the world.
              *
@@ -318,7 +360,7 @@ namespace AIToolbox::MDP {
              *
              * @return The transition function for the input action.
              */
-            const Matrix2D & getTransitionFunction(size_t a) const;
+            const Matrix2DT<Scalar> & getTransitionFunction(size_t a) const;
 
             /**
              * @brief This function returns the rewards table for inspection.
@@ -345,12 +387,15 @@ namespace AIToolbox::MDP {
 
             mutable RandomEngine rand_;
 
-            friend std::istream& operator>>(std::istream &is, Model &);
+            friend std::istream& operator>>(std::istream &is, ModelT<double> &);
     };
 
+    using Model = ModelT<double>;
+
+    template <typename Scalar>
     template <typename T, typename R>
-    Model::Model(const size_t s, const size_t a, const T & t, const R & r, const double d) :
-            S(s), A(a), transitions_(A, Matrix2D(S, S)),
+    ModelT<Scalar>::ModelT(const size_t s, const size_t a, const T & t, const R & r, const double d) :
+            S(s), A(a), transitions_(A, Matrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         setDiscount(d);
@@ -358,25 +403,35 @@ namespace AIToolbox::MDP {
         setRewardFunction(r);
     }
 
+    template <typename Scalar>
     template <typename M, typename>
-    Model::Model(const M& model) :
-            S(model.getS()), A(model.getA()), transitions_(A, Matrix2D(S, S)),
+    ModelT<Scalar>::ModelT(const M& model) :
+            S(model.getS()), A(model.getA()), transitions_(A, Matrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         setDiscount(model.getDiscount());
-        rewards_.fill(0.0);
-        for ( size_t a = 0; a < A; ++a )
-            for ( size_t s = 0; s < S; ++s ) {
-                for ( size_t s1 = 0; s1 < S; ++s1 ) {
-                    transitions_[a](s, s1) = model.getTransitionProbability(s, a, s1);
-                    rewards_    (s, a)     += model.getExpectedReward       (s, a, s1) * transitions_[a](s, s1);
+        if constexpr (is_model_eigen_v<M>) {
+            // Eigen models are already guaranteed to be valid, and we can
+            // just convert their tables directly.
+            for ( size_t a = 0; a < A; ++a )
+                transitions_[a] = model.getTransitionFunction(a).template cast<Scalar>();
+            rewards_ = model.getRewardFunction().template cast<Scalar>();
+        } else {
+            rewards_.fill(0.0);
+            for ( size_t a = 0; a < A; ++a )
+                for ( size_t s = 0; s < S; ++s ) {
+                    for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                        transitions_[a](s, s1) = model.getTransitionProbability(s, a, s1);
+                        rewards_    (s, a)     += model.getExpectedReward       (s, a, s1) * transitions_[a](s, s1);
+                    }
+                    if ( !checkEqualSmall(1.0, transitions_[a].row(s).template cast<double>().sum()) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
                 }
-                if ( !checkEqualSmall(1.0, transitions_[a].row(s).sum()) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
-            }
+        }
     }
 
+    template <typename Scalar>
     template <typename T>
-    void Model::setTransitionFunction(const T & t) {
+    void ModelT<Scalar>::setTransitionFunction(const T & t) {
         for ( size_t s = 0; s < S; ++s )
             for ( size_t a = 0; a < A; ++a )
                 if ( ! isProbability(S, t[s][a]) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
@@ -387,14 +442,18 @@ namespace AIToolbox::MDP {
                     transitions_[a](s, s1) = t[s][a][s1];
     }
 
+    template <typename Scalar>
     template <typename R>
-    void Model::setRewardFunction(const R & r) {
+    void ModelT<Scalar>::setRewardFunction(const R & r) {
         rewards_.fill(0.0);
         for ( size_t s = 0; s < S; ++s )
             for ( size_t a = 0; a < A; ++a )
                 for ( size_t s1 = 0; s1 < S; ++s1 )
                     rewards_(s, a) += r[s][a][s1] * transitions_[a](s, s1);
     }
+
+    extern template class ModelT<double>;
+    extern template class ModelT<float>;
 }
 
 #endif
@@ -0,0 +1,153 @@
+#ifndef AI_TOOLBOX_MDP_DETERMINISTIC_POLICY_HEADER_FILE
+#define AI_TOOLBOX_MDP_DETERMINISTIC_POLICY_HEADER_FILE
+
+#include <iosfwd>
+#include <vector>
+
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/Policies/PolicyInterface.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class represents a deterministic MDP Policy.
+     *
+     * Many policies computed by the planning algorithms in this library
+     * (for example the ones contained in a ValueFunction) select a single
+     * action per state. Storing them in a Policy requires a full S x A
+     * table of doubles, which for large state spaces wastes most of the
+     * memory on zeroes.
+     *
+     * This class instead stores a single action index per state, using the
+     * narrowest unsigned integer able to contain all actions: one byte
+     * when A <= 256, two when A <= 65536, and four otherwise. Both
+     * sampling and probability queries are O(1), and do not touch the
+     * random engine.
+     *
+     * This class can be converted losslessly to and from the dense
+     * representation: getPolicy() returns the equivalent table, and any
+     * table with a single action of probability 1 per state can be used
+     * to construct it. It can also be written to and read from a compact
+     * binary stream (see writeBinary() and readBinary() in MDP/IO.hpp).
+     */
+    class DeterministicPolicy : public PolicyInterface {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor initializes the policy so that action 0 is
+             * chosen in every state.
+             *
+             * @param s The number of states of the world.
+             * @param a The number of actions available to the agent.
+             */
+            DeterministicPolicy(size_t s, size_t a);
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor copies the implied policy contained in a
+             * ValueFunction.
+             *
+             * If any action in the ValueFunction is not less than the
+             * input number of actions, this constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param s The number of states of the world.
+             * @param a The number of actions available to the agent.
+             * @param v The ValueFunction used as a basis for the Policy.
+             */
+            DeterministicPolicy(size_t s, size_t a, const ValueFunction & v);
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor converts a dense policy table.
+             *
+             * Each row of the table must contain a single action with
+             * probability 1 (and all others 0), so that the conversion is
+             * lossless. Otherwise, this constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param p The policy table to convert.
+             */
+            DeterministicPolicy(const Matrix2D & p);
+
+            /**
+             * @brief This function returns the action chosen in state s.
+             *
+             * Since the policy is deterministic, this is always equal to
+             * the output of sampleAction().
+             *
+             * @param s The selected state.
+             *
+             * @return The action chosen in the selected state.
+             */
+            size_t getAction(size_t s) const;
+
+            /**
+             * @brief This function sets the action chosen in state s.
+             *
+             * If the action is not lower than A, this function will throw
+             * an std::invalid_argument.
+             *
+             * @param s The selected state.
+             * @param a The new action for the state.
+             */
+            void setAction(size_t s, size_t a);
+
+            /**
+             * @brief This function returns the action chosen in state s.
+             *
+             * @param s The sampled state of the policy.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const size_t & s) const override;
+
+            /**
+             * @brief This function returns the probability of taking the specified action in the specified state.
+             *
+             * @param s The selected state.
+             * @param a The selected action.
+             *
+             * @return 1.0 if the action is the one chosen in the state, 0.0 otherwise.
+             */
+            virtual double getActionProbability(const size_t & s, const size_t & a) const override;
+
+            /**
+             * @brief This function returns the equivalent dense policy table.
+             *
+             * Note that this allocates a full S x A table, and so
+             * should not be called often for large policies.
+             *
+             * @return The dense policy table.
+             */
+            virtual Matrix2D getPolicy() const override;
+
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function sets the probability of the action of the state to 1, and all others to 0.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
+            /**
+             * @brief This function returns the number of bytes used to store each action.
+             *
+             * @return 1, 2 or 4 depending on the number of actions.
+             */
+            unsigned getActionWidth() const;
+
+        private:
+            friend std::ostream& writeBinary(std::ostream &os, const DeterministicPolicy & p);
+            friend std::istream& readBinary(std::istream &is, DeterministicPolicy & p);
+
+            unsigned width_;
+            std::vector<unsigned char> actions_;
+    };
+}
+
+#endif
@@ -36,6 +36,17 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function mixes the row of the wrapped policy with the uniform
+             * distribution, calling the wrapped policy only once.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
         protected:
             /**
              * @brief This function returns a random action in the Action space.
@@ -51,6 +62,8 @@ namespace AIToolbox::MDP {
              */
             virtual double getRandomActionProbability() const override;
 
+            // The wrapped policy, as an MDP policy.
+            const PolicyInterface & wrapped_;
             // Used to sampled random actions
             mutable std::uniform_int_distribution<size_t> randomDistribution_;
     };
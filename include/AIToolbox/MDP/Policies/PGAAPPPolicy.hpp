@@ -72,6 +72,16 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function returns the row of the underlying policy table.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
             /**
              * @brief This function sets the new learning rate.
              *
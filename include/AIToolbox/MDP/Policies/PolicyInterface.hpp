@@ -24,7 +24,30 @@ namespace AIToolbox::MDP {
              * efficient manner.
              */
             virtual Matrix2D getPolicy() const = 0;
+
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function is equivalent to calling getActionProbability()
+             * for each action, but policies override it to compute the
+             * whole row in a single pass, and with a single virtual call.
+             * This is what algorithms which need expectations over the
+             * actions of a policy (like ExpectedSARSA) should use.
+             *
+             * The output vector is resized to getA() if needed, so that
+             * reusing the same vector across calls does not allocate.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const;
     };
+
+    inline void PolicyInterface::getActionProbabilities(const size_t & s, Vector * out) const {
+        out->resize(A);
+        for ( size_t a = 0; a < A; ++a )
+            (*out)[a] = getActionProbability(s, a);
+    }
 }
 
 #endif
@@ -74,6 +74,16 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function simply copies the row of the wrapped policy table.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
         private:
             const PolicyTable & policy_;
     };
@@ -59,9 +59,23 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function finds the maxima of the QFunction row only
+             * once. Both getActionProbability() and getPolicy() are
+             * implemented through it.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
         private:
             // To avoid reallocating a vector every time for sampling.
             mutable std::vector<unsigned> bestActions_;
+            // To avoid reallocating a vector for every getActionProbability().
+            mutable Vector probabilities_;
     };
 }
 
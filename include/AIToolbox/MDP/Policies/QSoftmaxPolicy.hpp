@@ -74,6 +74,17 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function computes the exponentials of the QFunction row only
+             * once, rather than once per action like getActionProbability().
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
             /**
              * @brief This function sets the temperature parameter.
              *
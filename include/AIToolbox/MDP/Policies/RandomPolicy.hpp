@@ -51,6 +51,16 @@ namespace AIToolbox::MDP {
              */
             virtual Matrix2D getPolicy() const override;
 
+            /**
+             * @brief This function returns the probabilities of all actions in the specified state.
+             *
+             * This function fills the output with the uniform distribution.
+             *
+             * @param s The selected state.
+             * @param out The output vector of action probabilities.
+             */
+            virtual void getActionProbabilities(const size_t & s, Vector * out) const override;
+
         private:
             // Used to sampled random actions
             mutable std::uniform_int_distribution<size_t> randomDistribution_;
@@ -0,0 +1,263 @@
+#ifndef AI_TOOLBOX_MDP_SHARDED_MODEL_HEADER_FILE
+#define AI_TOOLBOX_MDP_SHARDED_MODEL_HEADER_FILE
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <AIToolbox/MDP/Types.hpp>
+#include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
+
+namespace AIToolbox::MDP {
+    /**
+     * @brief This class writes an MDP to disk as a set of shards readable by ShardedModel.
+     *
+     * Each shard covers a contiguous block of states, and stores the
+     * immediate rewards R(s,a) and the transition probabilities of each of
+     * them in compressed sparse row (CSR) format, with one row per
+     * state-action pair. Rows are ordered by state, and then by action.
+     *
+     * The model is given one row at a time, in order: the non-zero
+     * transitions of the row are added with addTransition(), and the row
+     * is closed with finishRow(), together with its immediate reward. Only
+     * the shard being written is kept in memory, so this class can write
+     * models which are much bigger than the available memory.
+     *
+     * Each shard is written in its own file, named "shard-<i>.bin" in the
+     * output directory. Numbers are written in native byte order, so the
+     * shards can only be read back on a machine with the same endianness.
+     * Next-state indices are stored in 32 bits, so the number of states
+     * must be less than 2^32.
+     *
+     * \sa writeShards()
+     */
+    class ShardWriter {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * The output directory is created if it does not exist. If
+             * the parameters are invalid, this constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param directory The directory where to write the shards.
+             * @param S The number of states of the model.
+             * @param A The number of actions of the model.
+             * @param discount The discount factor of the model.
+             * @param statesPerShard The number of states in each shard.
+             */
+            ShardWriter(std::string directory, size_t S, size_t A, double discount, size_t statesPerShard);
+
+            /**
+             * @brief This function adds a non-zero transition to the current row.
+             *
+             * If the next state is out of range, this function will throw
+             * an std::invalid_argument.
+             *
+             * @param s1 The next state of the transition.
+             * @param p The probability of the transition.
+             */
+            void addTransition(size_t s1, double p);
+
+            /**
+             * @brief This function closes the current row.
+             *
+             * The transitions added to the row must form a probability
+             * distribution, otherwise this function will throw an
+             * std::invalid_argument and the row is discarded.
+             *
+             * Once the last row of a shard is closed, the shard is written
+             * to disk. If this fails, this function will throw an
+             * std::runtime_error.
+             *
+             * @param reward The immediate reward of the row.
+             */
+            void finishRow(double reward);
+
+            /**
+             * @brief This function returns whether all rows of the model have been written.
+             *
+             * @return Whether all shards have been written to disk.
+             */
+            bool isComplete() const;
+
+        private:
+            void writeShard();
+
+            std::string directory_;
+            size_t S, A;
+            double discount_;
+            size_t statesPerShard_;
+
+            size_t shard_, shards_, row_;
+            double rowSum_;
+            std::vector<double> rewards_, values_;
+            std::vector<std::uint64_t> rowPtr_;
+            std::vector<std::uint32_t> cols_;
+    };
+
+    /**
+     * @brief This function writes an MDP to disk as a set of shards.
+     *
+     * \sa ShardWriter
+     *
+     * @param model The model to write.
+     * @param directory The directory where to write the shards.
+     * @param statesPerShard The number of states in each shard.
+     */
+    template <typename M, typename = std::enable_if_t<is_model_v<M>>>
+    void writeShards(const M & model, const std::string & directory, size_t statesPerShard) {
+        const size_t S = model.getS(), A = model.getA();
+        const auto ir = computeImmediateRewards(model);
+
+        ShardWriter writer(directory, S, A, model.getDiscount(), statesPerShard);
+        for ( size_t s = 0; s < S; ++s ) {
+            for ( size_t a = 0; a < A; ++a ) {
+                if constexpr (is_model_sparse_v<M>) {
+                    using T = std::decay_t<decltype(model.getTransitionFunction(a))>;
+                    for ( typename T::InnerIterator it(model.getTransitionFunction(a), s); it; ++it )
+                        writer.addTransition(it.col(), it.value());
+                } else {
+                    for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                        const double p = model.getTransitionProbability(s, a, s1);
+                        if ( p != 0.0 ) writer.addTransition(s1, p);
+                    }
+                }
+                writer.finishRow(ir(s, a));
+            }
+        }
+    }
+
+    /**
+     * @brief This class represents an MDP model whose tables live on disk.
+     *
+     * This class reads the shards written by ShardWriter by memory-mapping
+     * them, so that the operating system only keeps in memory the parts
+     * that are currently in use. This allows planning on models whose
+     * transition tables are much bigger than the available memory, as long
+     * as the value functions fit in it.
+     *
+     * This class does not provide the usual model interface, as random
+     * access to its transitions would be very slow. Instead, its shards
+     * are meant to be streamed from the start to the end, as done by
+     * ValueIteration. Each shard can be prefetched before it is needed, so
+     * that reading it from disk overlaps with the work done on other
+     * shards.
+     *
+     * The mapped files are only read, and so this class can be used by
+     * multiple threads at once.
+     *
+     * Shards are mapped with POSIX mmap(). On platforms without it (i.e.
+     * Windows) the constructor always throws an std::runtime_error;
+     * ShardWriter works everywhere.
+     */
+    class ShardedModel {
+        public:
+            /**
+             * @brief This struct represents a view over the data of a shard.
+             *
+             * The rows of the shard are indexed by (s - firstState) * A + a.
+             * The transitions of each row are stored between the
+             * positions rowPtr[row] and rowPtr[row+1] of the cols and
+             * values arrays.
+             */
+            struct Shard {
+                size_t firstState;
+                size_t states;
+                const double * rewards;
+                const std::uint64_t * rowPtr;
+                const double * values;
+                const std::uint32_t * cols;
+            };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor maps all the shards contained in the input
+             * directory. If the shards cannot be read, or if they do not
+             * form a valid model, it will throw an std::runtime_error.
+             *
+             * The row offsets and next states of each shard are checked
+             * while loading, which reads their index arrays once; the
+             * transition values are only read during the sweeps.
+             *
+             * @param directory The directory containing the shards.
+             */
+            ShardedModel(const std::string & directory);
+
+            /**
+             * @brief Basic destructor, which unmaps all shards.
+             */
+            ~ShardedModel();
+
+            ShardedModel(const ShardedModel &) = delete;
+            ShardedModel & operator=(const ShardedModel &) = delete;
+
+            /**
+             * @brief This function sets a new discount factor for the Model.
+             *
+             * @param d The new discount factor for the Model.
+             */
+            void setDiscount(double d);
+
+            /**
+             * @brief This function returns the number of states of the world.
+             *
+             * @return The total number of states.
+             */
+            size_t getS() const;
+
+            /**
+             * @brief This function returns the number of available actions to the agent.
+             *
+             * @return The total number of actions.
+             */
+            size_t getA() const;
+
+            /**
+             * @brief This function returns the currently set discount factor.
+             *
+             * @return The currently set discount factor.
+             */
+            double getDiscount() const;
+
+            /**
+             * @brief This function returns the number of shards of the model.
+             *
+             * @return The number of shards.
+             */
+            size_t getShardsNumber() const;
+
+            /**
+             * @brief This function returns a view over the data of a shard.
+             *
+             * @param i The index of the shard.
+             *
+             * @return A view over the shard.
+             */
+            Shard getShard(size_t i) const;
+
+            /**
+             * @brief This function asks the operating system to start reading a shard in memory.
+             *
+             * This function returns immediately, and only acts as a hint.
+             *
+             * @param i The index of the shard.
+             */
+            void prefetch(size_t i) const;
+
+        private:
+            struct Mapping {
+                void * data;
+                size_t length;
+                Shard shard;
+            };
+
+            size_t S, A;
+            double discount_;
+            std::vector<Mapping> mappings_;
+    };
+}
+
+#endif
@@ -73,11 +73,22 @@ namespace AIToolbox::MDP {
      * SxAxS. It also of course incredibly reduces memory consumption in
      * such cases, which may also improve speed by effect of improved
      * caching.
+     *
+     * The Scalar template parameter selects the type used to store the
+     * transition and reward tables. Most of the time you will want to use
+     * the MDP::SparseModel alias, which stores them as doubles. Using
+     * floats reduces the memory used by the model, which speeds up
+     * planning when the tables are large enough that memory bandwidth
+     * dominates. The interface of the class is unchanged: individual
+     * probabilities and rewards are still returned as doubles.
+     *
+     * @tparam Scalar The type used to store the transition and reward tables.
      */
-    class SparseModel {
+    template <typename Scalar>
+    class SparseModelT {
         public:
-            using TransitionTable   = SparseMatrix3D;
-            using RewardTable       = SparseMatrix2D;
+            using TransitionTable   = SparseMatrix3DT<Scalar>;
+            using RewardTable       = SparseMatrix2DT<Scalar>;
 
             /**
              * @brief Basic constructor.
@@ -93,7 +104,7 @@ namespace AIToolbox::MDP {
              * @param a The number of actions available to the agent.
              * @param discount The discount factor for the MDP.
              */
-            SparseModel(size_t s, size_t a, double discount = 1.0);
+            SparseModelT(size_t s, size_t a, double discount = 1.0);
 
             /**
              * @brief Basic constructor.
@@ -139,7 +150,34 @@ namespace AIToolbox::MDP {
              * @param d The discount factor for the MDP.
              */
             template <typename T, typename R>
-            SparseModel(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
+            SparseModelT(size_t s, size_t a, const T & t, const R & r, double d = 1.0);
+
+            /**
+             * @brief Triplet constructor.
+             *
+             * This constructor builds the model directly from the non-zero
+             * entries of its transition and reward functions, in time
+             * linear in their number. This is the preferred way to create
+             * large models, as the dense constructor needs to inspect S*A*S
+             * entries.
+             *
+             * The transition triplets contain, for each action, the
+             * (s, s1, probability) entries of the transition function.
+             * Duplicate entries are summed. The reward triplets contain
+             * the (s, a, expected reward) entries of the reward function.
+             *
+             * This constructor will throw an std::invalid_argument if the
+             * transition triplets are not A, if any triplet is out of
+             * range, or if they do not describe a valid transition
+             * function.
+             *
+             * @param s The number of states of the world.
+             * @param a The number of actions available to the agent.
+             * @param t The transition triplets for each action.
+             * @param r The expected reward triplets.
+             * @param d The discount factor for the MDP.
+             */
+            SparseModelT(size_t s, size_t a, const std::vector<SparseTriplets> & t, const SparseTriplets & r, double d = 1.0);
 
             /**
              * @brief Copy constructor from any valid MDP model.
@@ -150,11 +188,15 @@ namespace AIToolbox::MDP {
              * course such a solution can be done only when the number of states
              * and actions is not too big.
              *
+             * If the input model exposes its tables as Eigen sparse
+             * matrices (like another SparseModelT), they are copied
+             * directly, in time linear in the number of non-zero entries.
+             *
              * @tparam M The type of the other model.
              * @param model The model that needs to be copied.
              */
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
-            SparseModel(const M& model);
+            SparseModelT(const M& model);
 
             /**
              * @brief Unchecked constructor.
@@ -173,7 +215,7 @@ namespace AIToolbox::MDP {
              * @param r The reward function to be used in the SparseModel.
              * @param d The discount factor for the SparseModel.
              */
-            SparseModel(NoCheck, size_t s, size_t a, TransitionTable && t, RewardTable && r, double d);
+            SparseModelT(NoCheck, size_t s, size_t a, TransitionTable && t, RewardTable && r, double d);
 
             /**
              * @brief This function replaces the transition function with the one provided.
@@ -224,6 +266,40 @@ namespace AIToolbox::MDP {
              */
             void setTransitionFunction(const TransitionTable & t);
 
+            /**
+             * @brief This function sets the transition function from already built Eigen sparse matrices, without copying them.
+             *
+             * This is the fastest way to set the transition function when
+             * the data is already available in compressed sparse row
+             * format, as an Eigen::Map over the CSR arrays can be
+             * assigned to each matrix without any conversion.
+             *
+             * This function will throw a std::invalid_argument if the
+             * table does not contain A matrices of size S x S, if any
+             * column index is out of range, or if it does not contain
+             * valid probabilities. The check runs in time linear in the
+             * non-zero entries, with the rows split across the default
+             * Executor (see Executor::getDefault()).
+             *
+             * @param t The external transitions container.
+             */
+            void setTransitionFunction(TransitionTable && t);
+
+            /**
+             * @brief This function sets the transition function from triplets.
+             *
+             * The input must contain, for each action, the (s, s1,
+             * probability) entries of the transition function. Duplicate
+             * entries are summed.
+             *
+             * This function will throw a std::invalid_argument if the
+             * input does not contain A lists, if any triplet is out of
+             * range, or if it does not describe valid probabilities.
+             *
+             * @param t The transition triplets for each action.
+             */
+            void setTransitionFunction(const std::vector<SparseTriplets> & t);
+
             /**
              * @brief This function replaces the reward function with the one provided.
              *
@@ -265,6 +341,19 @@ namespace AIToolbox::MDP {
              */
             void setRewardFunction(const RewardTable & r);
 
+            /**
+             * @brief This function sets the reward function from triplets.
+             *
+             * The input must contain the (s, a, expected reward) entries of
+             * the reward function. Duplicate entries are summed.
+             *
+             * This function will throw a std::invalid_argument if any
+             * triplet is out of range.
+             *
+             * @param r The reward triplets.
+             */
+            void setRewardFunction(const SparseTriplets & r);
+
             /**
              * @brief This function sets a new discount factor for the SparseModel.
              *
@@ -292,6 +381,37 @@ namespace AIToolbox::MDP {
              */
             std::tuple<size_t, double> sampleSR(size_t s, size_t a) const;
 
+            /**
+             * @brief This function samples the MDP for the specified state action pair, with the input RandomEngine.
+             *
+             * This function is equivalent to sampleSR(size_t, size_t),
+             * but it does not use the RandomEngine of the model. Since it
+             * does not modify the model, it can be called concurrently by
+             * multiple threads, as long as each uses its own engine.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The RandomEngine to sample with.
+             *
+             * @return A tuple containing a new state and a reward.
+             */
+            std::tuple<size_t, double> sampleSR(size_t s, size_t a, RandomEngine & rnd) const;
+
+            /**
+             * @brief This function samples the MDP for many state action pairs at once.
+             *
+             * This function is equivalent to calling sampleSR() for each
+             * pair, but avoids the per-call overhead, and draws all
+             * random numbers for the batch in a single pass.
+             *
+             * @param n The number of pairs to sample.
+             * @param s The states that need to be sampled.
+             * @param a The actions that need to be sampled.
+             * @param s1 The output sampled states.
+             * @param r The output sampled rewards.
+             */
+            void sampleSRBatch(size_t n, const size_t * s, const size_t * a, size_t * s1, double * r) const;
+
             /**
              * @brief This function returns the number of states of the world.
              *
@@ -349,7 +469,7 @@ namespace AIToolbox::MDP {
              *
              * @return The transition function for the input action.
              */
-            const SparseMatrix2D & getTransitionFunction(size_t a) const;
+            const SparseMatrix2DT<Scalar> & getTransitionFunction(size_t a) const;
 
             /**
              * @brief This function returns the rewards table for inspection.
@@ -368,6 +488,13 @@ namespace AIToolbox::MDP {
             bool isTerminal(size_t s) const;
 
         private:
+            /**
+             * @brief This function verifies that the input table contains valid probabilities.
+             *
+             * @param t The transition table to check.
+             */
+            void checkTransitionFunction(const TransitionTable & t) const;
+
             size_t S, A;
             double discount_;
 
@@ -376,12 +503,15 @@ namespace AIToolbox::MDP {
 
             mutable RandomEngine rand_;
 
-            friend std::istream& operator>>(std::istream &is, SparseModel &);
+            friend std::istream& operator>>(std::istream &is, SparseModelT<double> &);
     };
 
+    using SparseModel = SparseModelT<double>;
+
+    template <typename Scalar>
     template <typename T, typename R>
-    SparseModel::SparseModel(const size_t s, const size_t a, const T & t, const R & r, const double d) :
-            S(s), A(a), transitions_(A, SparseMatrix2D(S, S)),
+    SparseModelT<Scalar>::SparseModelT(const size_t s, const size_t a, const T & t, const R & r, const double d) :
+            S(s), A(a), transitions_(A, SparseMatrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         setDiscount(d);
@@ -389,12 +519,35 @@ namespace AIToolbox::MDP {
         setRewardFunction(r);
     }
 
+    template <typename Scalar>
     template <typename M, typename>
-    SparseModel::SparseModel(const M& model) :
-            S(model.getS()), A(model.getA()), transitions_(A, SparseMatrix2D(S, S)),
+    SparseModelT<Scalar>::SparseModelT(const M& model) :
+            S(model.getS()), A(model.getA()), transitions_(A, SparseMatrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         setDiscount(model.getDiscount());
+
+        if constexpr(is_model_eigen_v<M>) {
+            using TM = remove_cv_ref_t<decltype(model.getTransitionFunction(0))>;
+            if constexpr(std::is_base_of_v<Eigen::SparseMatrixBase<TM>, TM>) {
+                // Sparse models can be copied directly, without looking at
+                // all S*A*S entries.
+                for ( size_t a = 0; a < A; ++a ) {
+                    transitions_[a] = model.getTransitionFunction(a).template cast<Scalar>();
+                    transitions_[a].prune(Scalar(0));
+                    transitions_[a].makeCompressed();
+                }
+                checkTransitionFunction(transitions_);
+
+                using RM = remove_cv_ref_t<decltype(model.getRewardFunction())>;
+                if constexpr(std::is_base_of_v<Eigen::SparseMatrixBase<RM>, RM>)
+                    rewards_ = model.getRewardFunction().template cast<Scalar>();
+                else
+                    rewards_ = model.getRewardFunction().template cast<Scalar>().sparseView();
+                rewards_.makeCompressed();
+                return;
+            }
+        }
         for ( size_t s = 0; s < S; ++s )
         for ( size_t a = 0; a < A; ++a ) {
             for ( size_t s1 = 0; s1 < S; ++s1 ) {
@@ -404,7 +557,7 @@ namespace AIToolbox::MDP {
                 const double r = model.getExpectedReward(s, a, s1);
                 if ( checkDifferentSmall(0.0, r) ) rewards_.coeffRef(s, a) += r * p;
             }
-            if ( checkDifferentSmall(1.0, transitions_[a].row(s).sum()) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+            if ( checkDifferentSmall(1.0, transitions_[a].row(s).template cast<double>().sum()) ) throw std::invalid_argument("Input transition table does not contain valid probabilities.");
         }
 
         for ( size_t a = 0; a < A; ++a )
@@ -412,8 +565,9 @@ namespace AIToolbox::MDP {
         rewards_.makeCompressed();
     }
 
+    template <typename Scalar>
     template <typename T>
-    void SparseModel::setTransitionFunction(const T & t) {
+    void SparseModelT<Scalar>::setTransitionFunction(const T & t) {
         // First we verify data, without modifying anything...
         for ( size_t s = 0; s < S; ++s )
         for ( size_t a = 0; a < A; ++a )
@@ -432,8 +586,9 @@ namespace AIToolbox::MDP {
         }
     }
 
+    template <typename Scalar>
     template <typename R>
-    void SparseModel::setRewardFunction( const R & r ) {
+    void SparseModelT<Scalar>::setRewardFunction( const R & r ) {
         rewards_.setZero();
         for ( size_t a = 0; a < A; ++a ) {
             for ( size_t s = 0; s < S; ++s )
@@ -445,6 +600,9 @@ namespace AIToolbox::MDP {
         }
         rewards_.makeCompressed();
     }
+
+    extern template class SparseModelT<double>;
+    extern template class SparseModelT<float>;
 }
 
 #endif
@@ -46,6 +46,50 @@ namespace AIToolbox::MDP {
     template <typename M>
     inline constexpr bool is_generative_model_v = is_generative_model<M>::value;
 
+    /**
+     * @brief This struct represents the interface for a generative MDP which can sample in batches.
+     *
+     * This struct is used to check interfaces of classes in templates.
+     * In particular, this struct tests whether a generative model can
+     * sample many transitions at once. The interface must be implemented
+     * and be public in the parameter class. The interface is the following:
+     *
+     * - void sampleSRBatch(size_t n, const size_t * s, const size_t * a, size_t * s1, double * r) const :
+     *   Samples n state-reward pairs, one for each (s[i], a[i]), and writes them in s1[i] and r[i].
+     *
+     * In addition the MDP needs to respect the interface for the MDP generative model.
+     *
+     * Algorithms which advance many simulations in lockstep (like the
+     * batched rollouts of MCTS and POMCP) use this interface when
+     * available, and fall back to calling sampleSR() for each transition
+     * otherwise.
+     *
+     * \sa MDP::is_generative_model
+     *
+     * is_batch_generative_model<M>::value will be equal to true is M implements the interface,
+     * and false otherwise.
+     *
+     * @tparam M The class to test for the interface.
+     */
+    template <typename M>
+    struct is_batch_generative_model {
+        private:
+            template <typename Z> static constexpr auto test(int) -> decltype(
+
+                    static_cast<void (Z::*)(size_t, const size_t *, const size_t *, size_t *, double *) const>(&Z::sampleSRBatch),
+
+                    bool()
+            ) { return true; }
+
+            template <typename Z> static constexpr auto test(...) -> bool
+            { return false; }
+
+        public:
+            enum { value = test<M>(0) && is_generative_model<M>::value };
+    };
+    template <typename M>
+    inline constexpr bool is_batch_generative_model_v = is_batch_generative_model<M>::value;
+
     /**
      * @brief This struct represents the required interface for a full MDP.
      *
@@ -164,6 +208,32 @@ namespace AIToolbox::MDP {
     template <typename M>
     inline constexpr bool is_model_not_eigen_v = is_model_not_eigen<M>::value;
 
+    /**
+     * @brief This struct verifies that a class satisfies the is_model_eigen interface with sparse transitions.
+     *
+     * In addition to is_model_eigen, this requires the matrices returned
+     * by getTransitionFunction(size_t) to be row-major Eigen sparse
+     * matrices, so that the successors of a state can be enumerated in
+     * time proportional to their number.
+     *
+     * @tparam M The class to test for the interface.
+     */
+    template <typename M, typename = void>
+    struct is_model_sparse {
+        enum { value = false };
+    };
+
+    template <typename M>
+    struct is_model_sparse<M, std::enable_if_t<is_model_eigen_v<M>>> {
+        private:
+            using T = std::decay_t<decltype(std::declval<const M&>().getTransitionFunction(0))>;
+
+        public:
+            enum { value = std::is_base_of_v<Eigen::SparseMatrixBase<T>, T> && T::IsRowMajor };
+    };
+    template <typename M>
+    inline constexpr bool is_model_sparse_v = is_model_sparse<M>::value;
+
     /**
      * @brief This struct represents the required interface for an experience recorder.
      *
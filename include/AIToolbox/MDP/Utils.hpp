@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
 
 namespace AIToolbox::MDP {
     /**
@@ -76,7 +77,7 @@ namespace AIToolbox::MDP {
     template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
     Matrix2D computeImmediateRewards(const M & model) {
         if constexpr(is_model_eigen_v<M>) {
-            return model.getRewardFunction();
+            return model.getRewardFunction().template cast<double>();
         } else {
             const auto S = model.getS();
             const auto A = model.getA();
@@ -91,11 +92,41 @@ namespace AIToolbox::MDP {
         }
     }
 
+    /**
+     * @brief This function returns the immediate rewards of the MDP, copying them only if needed.
+     *
+     * If the model already stores its rewards as a dense double precision
+     * R(s,a) table, this function returns a reference to it. Otherwise, it
+     * returns the result of computeImmediateRewards().
+     *
+     * The result should be bound to a const reference, so that it lives
+     * as long as the reference in both cases.
+     *
+     * @param model The MDP that needs to be solved.
+     *
+     * @return The Models's immediate rewards.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    decltype(auto) getImmediateRewards(const M & model) {
+        if constexpr(is_model_eigen_v<M>) {
+            if constexpr(std::is_same_v<remove_cv_ref_t<decltype(model.getRewardFunction())>, Matrix2D>)
+                return model.getRewardFunction();
+            else
+                return computeImmediateRewards(model);
+        } else {
+            return computeImmediateRewards(model);
+        }
+    }
+
     /**
      * @brief This function computes the Model's QFunction from the values of a ValueFunction.
      *
      * Note that this function is more efficient with eigen models.
      *
+     * If the model stores its tables with a scalar type other than double,
+     * the products are computed in that type and the results are converted
+     * back to double.
+     *
      * @param model The MDP that needs to be solved.
      * @param v The values of the ValueFunction for the future of the QFunction.
      * @param ir The immediate rewards of the model, as created by computeImmediateRewards()
@@ -107,8 +138,18 @@ namespace AIToolbox::MDP {
         const auto A = model.getA();
 
         if constexpr(is_model_eigen_v<M>) {
-            for ( size_t a = 0; a < A; ++a )
-                ir.col(a).noalias() += model.getTransitionFunction(a) * v;
+            using Scalar = typename remove_cv_ref_t<decltype(model.getTransitionFunction(0))>::Scalar;
+            if constexpr(std::is_same_v<Scalar, double>) {
+                for ( size_t a = 0; a < A; ++a )
+                    ir.col(a).noalias() += model.getTransitionFunction(a) * v;
+            } else {
+                // Models storing their tables with a different scalar type
+                // do the products in their own type; only the results are
+                // accumulated back in double.
+                const VectorT<Scalar> vs = v.template cast<Scalar>();
+                for ( size_t a = 0; a < A; ++a )
+                    ir.col(a) += (model.getTransitionFunction(a) * vs).template cast<double>();
+            }
         } else {
             const auto S = model.getS();
             for ( size_t s = 0; s < S; ++s )
@@ -118,6 +159,66 @@ namespace AIToolbox::MDP {
         }
         return ir;
     }
+
+    /**
+     * @brief This function computes the Model's QFunction from the values of a ValueFunction, in parallel.
+     *
+     * The states are split in blocks, which are processed in parallel
+     * by the input Executor. Each block computes its rows of the
+     * QFunction for all actions, so that workers never write to the same
+     * rows.
+     *
+     * With a single-threaded Executor this is equivalent to
+     * computeQFunction(const M &, const Values &, QFunction).
+     *
+     * @param model The MDP that needs to be solved.
+     * @param v The values of the ValueFunction for the future of the QFunction.
+     * @param ir The immediate rewards of the model, as created by computeImmediateRewards()
+     * @param executor The Executor to use.
+     *
+     * @return A new QFunction.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    QFunction computeQFunction(const M & model, const Values & v, QFunction ir, Executor & executor) {
+        if ( executor.getConcurrency() == 1 )
+            return computeQFunction(model, v, std::move(ir));
+
+        const auto S = model.getS();
+        const auto A = model.getA();
+
+        // Blocks of rows big enough to amortize the scheduling.
+        constexpr size_t blockSize = 256;
+        const size_t blocks = (S + blockSize - 1) / blockSize;
+
+        if constexpr(is_model_eigen_v<M>) {
+            using Scalar = typename remove_cv_ref_t<decltype(model.getTransitionFunction(0))>::Scalar;
+            if constexpr(std::is_same_v<Scalar, double>) {
+                executor.parallelFor(0, blocks, [&](const size_t b) {
+                    const size_t begin = b * blockSize;
+                    const size_t n = std::min(blockSize, S - begin);
+                    for ( size_t a = 0; a < A; ++a )
+                        ir.col(a).segment(begin, n).noalias() += model.getTransitionFunction(a).middleRows(begin, n) * v;
+                });
+            } else {
+                const VectorT<Scalar> vs = v.template cast<Scalar>();
+                executor.parallelFor(0, blocks, [&](const size_t b) {
+                    const size_t begin = b * blockSize;
+                    const size_t n = std::min(blockSize, S - begin);
+                    for ( size_t a = 0; a < A; ++a )
+                        ir.col(a).segment(begin, n) += (model.getTransitionFunction(a).middleRows(begin, n) * vs).template cast<double>();
+                });
+            }
+        } else {
+            executor.parallelFor(0, blocks, [&](const size_t b) {
+                const size_t end = std::min(S, (b + 1) * blockSize);
+                for ( size_t s = b * blockSize; s < end; ++s )
+                    for ( size_t a = 0; a < A; ++a )
+                        for ( size_t s1 = 0; s1 < S; ++s1 )
+                            ir(s, a) += model.getTransitionProbability(s,a,s1) * v[s1];
+            });
+        }
+        return ir;
+    }
 }
 
 #endif
@@ -0,0 +1,440 @@
+#ifndef AI_TOOLBOX_POMDP_HSVI_HEADER_FILE
+#define AI_TOOLBOX_POMDP_HSVI_HEADER_FILE
+
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/transform_iterator.hpp>
+
+#include <AIToolbox/Impl/Logging.hpp>
+
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Prune.hpp>
+#include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/TypeTraits.hpp>
+#include <AIToolbox/POMDP/Utils.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/BlindStrategies.hpp>
+#include <AIToolbox/POMDP/Algorithms/FastInformedBound.hpp>
+#include <AIToolbox/POMDP/Algorithms/Utils/Projecter.hpp>
+
+namespace AIToolbox::POMDP {
+    /**
+     * @brief This class implements the Heuristic Search Value Iteration algorithm.
+     *
+     * HSVI keeps both a lower and an upper bound on the optimal value
+     * function, and only refines them on beliefs which are reachable from
+     * the initial belief while following near-optimal policies.
+     *
+     * The lower bound is a set of alpha vectors, initialized with
+     * BlindStrategies. The upper bound is initialized with the
+     * FastInformedBound, whose best value for each state gives the values
+     * of the corners of the belief simplex. Afterwards, the upper bound is
+     * refined with a set of belief-value pairs, and its value at any
+     * belief is computed through the sawtooth interpolation between the
+     * corners and these pairs. For each pair we store only the support of
+     * its belief, and its distance from the corner plane, so that each
+     * interpolation costs time proportional to the total support of the
+     * pairs, and requires no linear programming.
+     *
+     * The algorithm works through trials. Each trial starts at the initial
+     * belief, and descends by picking the action with the highest upper
+     * bound, and the observation whose next belief has the highest
+     * probability-weighted excess gap, i.e. the gap above the precision
+     * that it needs at that depth in order for the initial belief to reach
+     * the target precision. Once the excess gap of the current belief is
+     * no longer positive, both bounds are backed up at each belief of the
+     * trial, in reverse order: a new alpha vector is added to the lower
+     * bound, and a new belief-value pair to the upper bound.
+     *
+     * The projections of the lower bound alpha vectors are kept across
+     * backups, so that each new alpha vector is projected only once, and
+     * each lower bound backup only needs to cross-sum the best
+     * projections at the belief.
+     *
+     * Alpha vectors which are pointwise dominated, and belief-value pairs
+     * which do not lower the upper bound, are removed periodically.
+     *
+     * The solver is anytime: it can be given a time budget, after which it
+     * returns the bounds found so far. Its guarantees require the discount
+     * of the model to be less than 1.
+     *
+     * The returned alpha vectors can be used to act through a POMDP::Policy,
+     * by wrapping them in a ValueFunction with a single horizon. Note that
+     * their observation links are not maintained, so the Policy must only
+     * be sampled from beliefs, and not through its observation ids.
+     */
+    class HSVI {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * The epsilon parameter must be > 0.0, and the tolerance
+             * parameter must be >= 0.0, otherwise the constructor will
+             * throw an std::invalid_argument.
+             *
+             * @param epsilon The gap between the bounds at the initial belief to reach.
+             * @param tolerance The tolerance used to compute the initial bounds.
+             * @param maxDepth The maximum depth of each trial.
+             */
+            HSVI(double epsilon, double tolerance = 0.001, unsigned maxDepth = 1000);
+
+            /**
+             * @brief This function computes lower and upper bounds for the value of the input belief.
+             *
+             * This function runs trials until the gap between the bounds
+             * at the initial belief is at most epsilon, or until the time
+             * budget runs out.
+             *
+             * If the discount of the model is 1, this function will throw
+             * an std::invalid_argument.
+             *
+             * @param model The POMDP model to solve.
+             * @param initialBelief The belief to compute the bounds for.
+             *
+             * @return The lower and upper bounds at the initial belief, and the lower bound VList.
+             */
+            template <typename M, typename = std::enable_if_t<is_model_eigen_v<M>>>
+            std::tuple<double, double, VList> operator()(const M & model, const Belief & initialBelief);
+
+            /**
+             * @brief This function returns the upper bound computed during the last call, at the input belief.
+             *
+             * @param b The belief to compute the upper bound at.
+             *
+             * @return The sawtooth upper bound at the input belief.
+             */
+            double getUpperBound(const Belief & b) const;
+
+            /**
+             * @brief This function returns the number of belief-value pairs of the upper bound.
+             *
+             * @return The number of pairs, excluding the corners.
+             */
+            size_t getUpperBoundPointsNumber() const;
+
+            /**
+             * @brief This function returns the number of trials run during the last call.
+             *
+             * @return The number of trials.
+             */
+            unsigned getTrials() const;
+
+            /**
+             * @brief This function sets the gap between the bounds at the initial belief to reach.
+             *
+             * The epsilon parameter must be > 0.0, otherwise the function
+             * will throw an std::invalid_argument.
+             *
+             * @param epsilon The new epsilon parameter.
+             */
+            void setEpsilon(double epsilon);
+
+            /**
+             * @brief This function returns the currently set epsilon parameter.
+             *
+             * @return The currently set epsilon parameter.
+             */
+            double getEpsilon() const;
+
+            /**
+             * @brief This function sets the tolerance used to compute the initial bounds.
+             *
+             * The tolerance parameter must be >= 0.0, otherwise the
+             * function will throw an std::invalid_argument.
+             *
+             * @param tolerance The new tolerance parameter.
+             */
+            void setTolerance(double tolerance);
+
+            /**
+             * @brief This function returns the currently set tolerance parameter.
+             *
+             * @return The currently set tolerance parameter.
+             */
+            double getTolerance() const;
+
+            /**
+             * @brief This function sets the maximum depth of each trial.
+             *
+             * @param maxDepth The new maximum depth.
+             */
+            void setMaxDepth(unsigned maxDepth);
+
+            /**
+             * @brief This function returns the currently set maximum depth of each trial.
+             *
+             * @return The currently set maximum depth.
+             */
+            unsigned getMaxDepth() const;
+
+            /**
+             * @brief This function sets the time budget of each call.
+             *
+             * Once the budget runs out, the current trial is interrupted
+             * and backed up, and the bounds found so far are returned. A
+             * budget of zero disables the limit.
+             *
+             * @param budget The new time budget.
+             */
+            void setTimeBudget(std::chrono::duration<double> budget);
+
+            /**
+             * @brief This function returns the currently set time budget.
+             *
+             * @return The currently set time budget.
+             */
+            std::chrono::duration<double> getTimeBudget() const;
+
+        private:
+            /**
+             * @brief This struct represents a belief-value pair of the upper bound.
+             */
+            struct UbPoint {
+                // The non-zero entries of the belief.
+                std::vector<std::pair<size_t, double>> support;
+                // The inverse of each entry, to compute ratios without divisions.
+                std::vector<double> inverse;
+                // The upper bound value of the belief.
+                double value;
+                // The value minus the corner interpolation at the belief.
+                double delta;
+            };
+
+            /**
+             * @brief This function computes the sawtooth upper bound at a belief.
+             *
+             * @param b The belief to compute the upper bound at.
+             * @param skip The index of a pair to ignore, if any.
+             *
+             * @return The upper bound at the belief.
+             */
+            double upperBound(const Belief & b, size_t skip) const;
+
+            /**
+             * @brief This function adds a belief-value pair to the upper bound.
+             *
+             * If the belief is a corner of the simplex, the value of the
+             * corner is lowered instead.
+             *
+             * @param b The belief of the pair.
+             * @param v The upper bound value of the belief.
+             */
+            void addUpperPoint(const Belief & b, double v);
+
+            /**
+             * @brief This function removes the belief-value pairs which do not lower the upper bound.
+             */
+            void pruneUpperPoints();
+
+            /**
+             * @brief This function computes the best action according to the upper bound.
+             *
+             * The beliefs following the best action, together with their
+             * probabilities and upper bounds, are returned through the
+             * output parameters, so that the caller does not need to
+             * compute them again.
+             *
+             * @param model The POMDP model to use.
+             * @param R The immediate rewards of the model.
+             * @param b The belief to look the action for.
+             * @param nextBeliefs The output beliefs reached after each observation.
+             * @param nextProbs The output probability of each observation.
+             * @param nextUbs The output upper bound of each next belief.
+             *
+             * @return The best action, and its upper bound value.
+             */
+            template <typename M>
+            std::tuple<size_t, double> bestUpperAction(const M & model, const Matrix2D & R, const Belief & b,
+                                                       std::vector<Belief> * nextBeliefs, std::vector<double> * nextProbs,
+                                                       std::vector<double> * nextUbs) const;
+
+            double epsilon_, tolerance_;
+            unsigned maxDepth_, trials_;
+            std::chrono::duration<double> budget_;
+
+            MDP::Values corners_;
+            std::vector<UbPoint> points_;
+    };
+
+    template <typename M, typename>
+    std::tuple<double, double, VList> HSVI::operator()(const M & model, const Belief & initialBelief) {
+        using Clock = std::chrono::steady_clock;
+        constexpr unsigned infiniteHorizon = 1000000;
+
+        if ( !(model.getDiscount() < 1.0) ) throw std::invalid_argument("HSVI requires a discount factor less than 1");
+
+        const auto start = Clock::now();
+        const auto outOfTime = [&]{
+            return budget_.count() > 0.0 && Clock::now() - start >= budget_;
+        };
+
+        const double discount = model.getDiscount();
+        const Matrix2D R = model.getRewardFunction();
+
+        // Lower bound: the blind strategies, without dominated vectors.
+        BlindStrategies bs(infiniteHorizon, tolerance_);
+        VList lb = std::get<1>(bs(model, true));
+        const auto pruneLower = [&] {
+            const auto rbegin = boost::make_transform_iterator(std::begin(lb), unwrap);
+            const auto rend   = boost::make_transform_iterator(std::end  (lb), unwrap);
+
+            lb.erase(extractDominated(model.getS(), rbegin, rend).base(), std::end(lb));
+        };
+        pruneLower();
+
+        // The projections of the lower bound, with the observation ids
+        // pointing to the alpha vectors in lb. They are recomputed only
+        // when lb is pruned, and extended when an alpha vector is added.
+        Projecter projecter(model);
+        auto projs = projecter(lb);
+        const auto addLower = [&](VEntry entry) {
+            lb.emplace_back(std::move(entry));
+            auto p = projecter(VList(1, lb.back()));
+            for ( size_t a = 0; a < model.getA(); ++a ) {
+                for ( size_t o = 0; o < model.getO(); ++o ) {
+                    projs[a][o].emplace_back(std::move(p[a][o][0]));
+                    projs[a][o].back().observations[0] = lb.size() - 1;
+                }
+            }
+        };
+
+        const auto lowerBound = [&](const Belief & b) {
+            const auto rbegin = boost::make_transform_iterator(std::begin(lb), unwrap);
+            const auto rend   = boost::make_transform_iterator(std::end  (lb), unwrap);
+
+            double v;
+            findBestAtPoint(b, rbegin, rend, &v);
+            return v;
+        };
+
+        // Upper bound: the best values of the fast informed bound are the
+        // values of the corners.
+        FastInformedBound fib(infiniteHorizon, tolerance_);
+        corners_ = std::get<1>(fib(model)).rowwise().maxCoeff();
+        points_.clear();
+        trials_ = 0;
+
+        size_t lbPruneSize = lb.size(), ubPruneSize = 1;
+
+        std::vector<Belief> path, nextBeliefs;
+        std::vector<double> nextProbs, nextUbs;
+
+        double lbValue = lowerBound(initialBelief);
+        double ubValue = upperBound(initialBelief, points_.size());
+
+        AI_LOGGER(AI_SEVERITY_INFO, "Initial bounds: " << lbValue << ", " << ubValue);
+
+        while ( ubValue - lbValue > epsilon_ && !outOfTime() ) {
+            // Descend from the initial belief, following the upper bound,
+            // towards the beliefs which contribute most to the gap.
+            path.clear();
+            path.push_back(initialBelief);
+
+            double threshold = epsilon_;
+            for ( unsigned depth = 0; depth < maxDepth_ && !outOfTime(); ++depth ) {
+                const Belief & b = path.back();
+                if ( depth > 0 && upperBound(b, points_.size()) - lowerBound(b) <= threshold ) break;
+
+                bestUpperAction(model, R, b, &nextBeliefs, &nextProbs, &nextUbs);
+
+                threshold /= discount;
+                size_t bestO = 0;
+                double bestExcess = 0.0;
+                for ( size_t o = 0; o < model.getO(); ++o ) {
+                    if ( checkEqualSmall(nextProbs[o], 0.0) ) continue;
+
+                    const auto & nb = nextBeliefs[o];
+                    const double excess = nextProbs[o] * (nextUbs[o] - lowerBound(nb) - threshold);
+                    if ( excess > bestExcess ) {
+                        bestExcess = excess;
+                        bestO = o;
+                    }
+                }
+                if ( bestExcess <= 0.0 ) break;
+
+                path.push_back(std::move(nextBeliefs[bestO]));
+            }
+
+            // Backup both bounds along the trial, from the bottom up.
+            for ( auto it = path.rbegin(); it != path.rend(); ++it ) {
+                const Belief & b = *it;
+
+                double newLb;
+                auto entry = crossSumBestAtBelief(b, projs, &newLb);
+                if ( newLb > lowerBound(b) + tolerance_ * (1.0 - discount) )
+                    addLower(std::move(entry));
+
+                const double newUb = std::get<1>(bestUpperAction(model, R, b, &nextBeliefs, &nextProbs, &nextUbs));
+                if ( newUb < upperBound(b, points_.size()) )
+                    addUpperPoint(b, newUb);
+            }
+            ++trials_;
+
+            if ( lb.size() > 2 * lbPruneSize ) {
+                pruneLower();
+                projs = projecter(lb);
+                lbPruneSize = lb.size();
+            }
+            if ( points_.size() > 2 * ubPruneSize ) {
+                pruneUpperPoints();
+                ubPruneSize = std::max(size_t(1), points_.size());
+            }
+
+            lbValue = lowerBound(initialBelief);
+            ubValue = upperBound(initialBelief, points_.size());
+
+            AI_LOGGER(AI_SEVERITY_DEBUG, "Trial " << trials_ << ": bounds " << lbValue << ", " << ubValue
+                                          << " -- size LB: " << lb.size() << ", size UB: " << points_.size());
+        }
+        pruneLower();
+
+        return std::make_tuple(lbValue, ubValue, std::move(lb));
+    }
+
+    template <typename M>
+    std::tuple<size_t, double> HSVI::bestUpperAction(const M & model, const Matrix2D & R, const Belief & b,
+                                                     std::vector<Belief> * nextBeliefs, std::vector<double> * nextProbs,
+                                                     std::vector<double> * nextUbs) const
+    {
+        const size_t A = model.getA(), O = model.getO();
+
+        std::vector<Belief> beliefs(O);
+        std::vector<double> probs(O), ubs(O);
+
+        size_t bestA = 0;
+        double bestValue = -std::numeric_limits<double>::infinity();
+        for ( size_t a = 0; a < A; ++a ) {
+            const Belief intermediateBelief = updateBeliefPartial(model, b, a);
+
+            double value = 0.0;
+            for ( size_t o = 0; o < O; ++o ) {
+                updateBeliefPartialUnnormalized(model, intermediateBelief, a, o, &beliefs[o]);
+                probs[o] = beliefs[o].sum();
+                if ( checkEqualSmall(probs[o], 0.0) ) continue;
+
+                beliefs[o] /= probs[o];
+                ubs[o] = upperBound(beliefs[o], points_.size());
+                value += probs[o] * ubs[o];
+            }
+            value = b.dot(R.col(a)) + model.getDiscount() * value;
+
+            if ( value > bestValue ) {
+                bestValue = value;
+                bestA = a;
+                std::swap(beliefs, *nextBeliefs);
+                std::swap(probs, *nextProbs);
+                std::swap(ubs, *nextUbs);
+                beliefs.resize(O);
+                probs.resize(O);
+                ubs.resize(O);
+            }
+        }
+        return std::make_tuple(bestA, bestValue);
+    }
+}
+
+#endif
@@ -42,6 +42,14 @@ namespace AIToolbox::POMDP {
      * of code and managing memory by ourselves, we use its API. It would
      * be nice if one day we could port directly into the code a fast lp
      * implementation; for now we do what we can.
+     *
+     * An epsilon can be specified to prune approximately. In this case the
+     * final prune of each timestep drops all alphavectors which cannot
+     * improve the ValueFunction by more than epsilon, so that each new VList
+     * is at most epsilon lower than the exact one. The intermediate
+     * cross-sum prunes stay exact, so that the error does not compound
+     * within a single timestep. Near-duplicate alphavectors can optionally
+     * be merged before that prune, which saves LP solves.
      */
     class IncrementalPruning {
         public:
@@ -58,10 +66,16 @@ namespace AIToolbox::POMDP {
              * will stop as soon as the difference between two iterations
              * is less than the tolerance specified.
              *
+             * The epsilon parameter must be >= 0.0, otherwise the
+             * constructor will throw an std::invalid_argument. See
+             * setEpsilon() and setMergeDuplicates().
+             *
              * @param h The horizon chosen.
              * @param tolerance The tolerance factor to stop the IncrementalPruning loop.
+             * @param epsilon The maximum value loss allowed when pruning.
+             * @param mergeDuplicates Whether to merge near-duplicates in the final prune.
              */
-            IncrementalPruning(unsigned h, double tolerance);
+            IncrementalPruning(unsigned h, double tolerance, double epsilon = 0.0, bool mergeDuplicates = false);
 
             /**
              * @brief This function sets the tolerance parameter.
@@ -92,6 +106,51 @@ namespace AIToolbox::POMDP {
              */
             double getTolerance() const;
 
+            /**
+             * @brief This function sets the epsilon parameter.
+             *
+             * The epsilon parameter must be >= 0.0, otherwise the function
+             * will throw an std::invalid_argument. With an epsilon of 0.0
+             * pruning is exact. Otherwise, the prune done after combining
+             * the cross-sums of all actions drops alphavectors which cannot
+             * improve the ValueFunction by more than epsilon.
+             *
+             * Since each timestep can then lose up to epsilon value, the
+             * returned variation is increased by epsilon. The tolerance
+             * should thus be set higher than epsilon, otherwise the
+             * algorithm will always run for the whole horizon.
+             *
+             * @param e The new epsilon parameter.
+             */
+            void setEpsilon(double e);
+
+            /**
+             * @brief This function returns the currently set epsilon parameter.
+             *
+             * @return The currently set epsilon parameter.
+             */
+            double getEpsilon() const;
+
+            /**
+             * @brief This function sets whether near-duplicate alphavectors are merged.
+             *
+             * When enabled and epsilon is positive, the final prune first
+             * removes alphavectors which are within epsilon/2 of another in
+             * every state, without solving any LP, and then uses the other
+             * half of epsilon for the LPs. The total loss per timestep is
+             * still at most epsilon. This has no effect when epsilon is 0.0.
+             *
+             * @param m Whether to merge near-duplicates.
+             */
+            void setMergeDuplicates(bool m);
+
+            /**
+             * @brief This function returns whether near-duplicate alphavectors are merged.
+             *
+             * @return Whether near-duplicates are merged in the final prune.
+             */
+            bool getMergeDuplicates() const;
+
             /**
              * @brief This function returns the currently set horizon parameter.
              *
@@ -108,15 +167,44 @@ namespace AIToolbox::POMDP {
              * incrementally, trying to reduce as much as possible the
              * linear programming solves required.
              *
+             * A previous solution can be used to warm-start the process,
+             * in which case the horizon counts the timesteps computed on
+             * top of it. This is useful to re-solve a model after a small
+             * change in its parameters, as the old solution is generally
+             * already close to the new one.
+             *
+             * The witness beliefs of a previous run (see
+             * getWitnessBeliefs()) can also be passed. They are used to
+             * find good alphavectors before solving any LP during the
+             * prunes, which greatly reduces the work needed when the new
+             * solution is similar to the old one.
+             *
+             * This function will throw an std::invalid_argument if the
+             * alphavectors of the last VList in v, or the witnesses, are
+             * not of size S (see checkWarmStart()).
+             *
              * @tparam M The type of POMDP model that needs to be solved.
              *
              * @param model The POMDP model that needs to be solved.
+             * @param v The ValueFunction to startup the process from, if needed.
+             * @param witnesses The beliefs to seed the prunes with, if needed.
              *
              * @return A tuple containing the maximum variation for the
              *         ValueFunction and the computed ValueFunction.
              */
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
-            std::tuple<double, ValueFunction> operator()(const M & model);
+            std::tuple<double, ValueFunction> operator()(const M & model, ValueFunction v = {}, std::vector<Belief> witnesses = {});
+
+            /**
+             * @brief This function returns the witness beliefs of the last solved timestep.
+             *
+             * These are the beliefs which identified the alphavectors of
+             * the last VList computed by operator()(). They can be passed
+             * to a later call to warm-start it.
+             *
+             * @return The witness beliefs of the last run.
+             */
+            const std::vector<Belief> & getWitnessBeliefs() const;
 
         private:
             /**
@@ -143,20 +231,29 @@ namespace AIToolbox::POMDP {
             size_t S, A, O;
             unsigned horizon_;
             double tolerance_;
+            double epsilon_;
+            bool merge_;
+
+            std::vector<Belief> witnesses_;
     };
 
     template <typename M, typename>
-    std::tuple<double, ValueFunction> IncrementalPruning::operator()(const M & model) {
+    std::tuple<double, ValueFunction> IncrementalPruning::operator()(const M & model, ValueFunction v, std::vector<Belief> witnesses) {
         // Initialize "global" variables
         S = model.getS();
         A = model.getA();
         O = model.getO();
 
-        auto v = makeValueFunction(S); // TODO: May take user input
+        checkWarmStart(S, v, witnesses);
+        if ( v.size() == 0 )
+            v = makeValueFunction(S);
 
         unsigned timestep = 0;
 
         Pruner prune(S);
+        // The final prune is the only one allowed to be approximate, so that
+        // each timestep loses at most epsilon.
+        Pruner finalPrune(S, epsilon_, merge_);
         Projecter projecter(model);
 
         const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
@@ -164,11 +261,16 @@ namespace AIToolbox::POMDP {
         while ( timestep < horizon_ && ( !useTolerance || variation > tolerance_ ) ) {
             ++timestep;
 
+            // The witnesses of the last timestep are likely to be good
+            // witnesses for this one too.
+            prune.setSeedPoints(witnesses);
+            finalPrune.setSeedPoints(std::move(witnesses));
+
             // Compute all possible outcomes, from our previous results.
             // This means that for each action-observation pair, we are going
             // to obtain the same number of possible outcomes as the number
             // of entries in our initial vector w.
-            auto projs = projecter(v[timestep-1]);
+            auto projs = projecter(v.back());
 
             size_t finalWSize = 0;
             // In this method we split the work by action, which will then
@@ -241,14 +343,17 @@ namespace AIToolbox::POMDP {
             // computed the parsimonious set of value functions.
             const auto begin = boost::make_transform_iterator(std::begin(w), unwrap);
             const auto end   = boost::make_transform_iterator(std::end  (w), unwrap);
-            w.erase(prune(begin, end).base(), std::end(w));
+            w.erase(finalPrune(begin, end).base(), std::end(w));
+            witnesses = finalPrune.getWitnessPoints();
 
             v.emplace_back(std::move(w));
 
-            // Check convergence
+            // Check convergence, accounting for the error introduced by
+            // approximate pruning.
             if ( useTolerance )
-                variation = weakBoundDistance(v[timestep-1], v[timestep]);
+                variation = weakBoundDistance(v[v.size()-2], v.back()) + epsilon_;
         }
+        witnesses_ = std::move(witnesses);
 
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
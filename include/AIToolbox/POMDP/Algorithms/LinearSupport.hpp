@@ -48,6 +48,11 @@ namespace AIToolbox::POMDP {
      * Even if there is limited time to compute the solution, the algorithm is
      * guaranteed to work in the areas with high error first, allowing one to
      * compute good approximations even without a lot of resources.
+     *
+     * An epsilon can be specified to compute approximate solutions. Vertices
+     * whose error is lower than epsilon are then ignored; since the maximum
+     * error is always found at a vertex, the resulting VList is at most
+     * epsilon lower than the exact one.
      */
     class LinearSupport {
         public:
@@ -64,10 +69,15 @@ namespace AIToolbox::POMDP {
              * as the difference between two iterations is less than the
              * tolerance specified.
              *
+             * The epsilon parameter must be >= 0.0, otherwise the
+             * constructor will throw an std::invalid_argument. See
+             * setEpsilon().
+             *
              * @param h The horizon chosen.
              * @param tolerance The tolerance factor to stop the value iteration loop.
+             * @param epsilon The maximum value loss allowed per timestep.
              */
-            LinearSupport(unsigned horizon, double tolerance);
+            LinearSupport(unsigned horizon, double tolerance, double epsilon = 0.0);
 
             /**
              * @brief This function sets the tolerance parameter.
@@ -98,6 +108,32 @@ namespace AIToolbox::POMDP {
              */
             double getTolerance() const;
 
+            /**
+             * @brief This function sets the epsilon parameter.
+             *
+             * The epsilon parameter must be >= 0.0, otherwise the function
+             * will throw an std::invalid_argument. With an epsilon of 0.0
+             * the solution is exact. Otherwise, vertices whose error is
+             * below epsilon are not explored, so no alphavector is added
+             * for them. Since the error of a VList is highest at one of its
+             * vertices, it is at most epsilon below the exact one.
+             *
+             * Vertices below the tolerance are skipped anyway, so only an
+             * epsilon higher than the tolerance has an effect. Since each
+             * timestep can lose up to epsilon value, the returned
+             * variation is increased by epsilon.
+             *
+             * @param e The new epsilon parameter.
+             */
+            void setEpsilon(double e);
+
+            /**
+             * @brief This function returns the currently set epsilon parameter.
+             *
+             * @return The currently set epsilon parameter.
+             */
+            double getEpsilon() const;
+
             /**
              * @brief This function returns the currently set horizon parameter.
              *
@@ -113,19 +149,49 @@ namespace AIToolbox::POMDP {
              * in order to determine whether it is complete, otherwise it
              * improves it incrementally.
              *
+             * A previous solution can be used to warm-start the process,
+             * in which case the horizon counts the timesteps computed on
+             * top of it. This is useful to re-solve a model after a small
+             * change in its parameters, as the old solution is generally
+             * already close to the new one.
+             *
+             * The witness beliefs of a previous run (see
+             * getWitnessBeliefs()) can also be passed. They are evaluated
+             * together with the vertices found from the simplex corners,
+             * so that the supports they identify are found without having
+             * to rediscover them one vertex at a time.
+             *
+             * If the starting ValueFunction or the witnesses do not match
+             * the number of states of the model, this function will throw
+             * an std::invalid_argument (see checkWarmStart()).
+             *
              * @tparam M The type of POMDP model that needs to be solved.
              *
              * @param model The POMDP model that needs to be solved.
+             * @param v The ValueFunction to startup the process from, if needed.
+             * @param witnesses The beliefs to seed the vertex search with, if needed.
              *
              * @return A tuple containing the maximum variation for the
              *         ValueFunction and the computed ValueFunction.
              */
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
-            std::tuple<double, ValueFunction> operator()(const M & model);
+            std::tuple<double, ValueFunction> operator()(const M & model, ValueFunction v = {}, std::vector<Belief> witnesses = {});
+
+            /**
+             * @brief This function returns the witness beliefs of the last solved timestep.
+             *
+             * These are the vertices whose supports were added to the last
+             * VList computed by operator()(). They can be passed to a
+             * later call to warm-start it.
+             *
+             * @return The witness beliefs of the last run.
+             */
+            const std::vector<Belief> & getWitnessBeliefs() const;
 
         private:
             unsigned horizon_;
             double tolerance_;
+            double epsilon_;
 
             using SupportSet = std::unordered_set<VEntry, boost::hash<VEntry>>;
             struct Vertex;
@@ -145,22 +211,27 @@ namespace AIToolbox::POMDP {
             using Agenda = boost::heap::fibonacci_heap<Vertex, boost::heap::compare<VertexComparator>>;
 
             Agenda agenda_;
+            std::vector<Belief> witnesses_;
     };
 
     template <typename M, typename>
-    std::tuple<double, ValueFunction> LinearSupport::operator()(const M& model) {
+    std::tuple<double, ValueFunction> LinearSupport::operator()(const M& model, ValueFunction v, std::vector<Belief> witnesses) {
         const auto S = model.getS();
 
         Projecter project(model);
-        auto v = makeValueFunction(S); // TODO: May take user input
+        checkWarmStart(S, v, witnesses);
+        if ( v.size() == 0 )
+            v = makeValueFunction(S);
 
         unsigned timestep = 0;
         const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
         double variation = tolerance_ * 2; // Make it bigger
+        // Vertices with an error below this are not worth adding.
+        const double minError = std::max(tolerance_, epsilon_);
         while ( timestep < horizon_ && ( !useTolerance || variation > tolerance_ ) ) {
             ++timestep;
 
-            auto projections = project(v[timestep-1]);
+            auto projections = project(v.back());
 
             // These are the good vectors, the ones that we are going to return for
             // sure.
@@ -209,6 +280,12 @@ namespace AIToolbox::POMDP {
                 );
             }
 
+            // The witnesses of the last timestep are evaluated as any other
+            // vertex; their values are recomputed below anyway.
+            for ( auto & w : witnesses )
+                vertices.emplace_back(std::move(w), 0.0);
+            witnesses.clear();
+
             do {
                 // For each corner, we find its true alphas and its best possible value.
                 // Then we compute the error between a corner's known true value and
@@ -232,7 +309,7 @@ namespace AIToolbox::POMDP {
                     findBestAtPoint(vertex.first, gsBegin, gsEnd, &currentValue);
 
                     auto diff = trueValue - currentValue;
-                    if (diff > tolerance_ && checkDifferentGeneral(diff, tolerance_)) {
+                    if (diff > minError && checkDifferentGeneral(diff, minError)) {
                         auto it = allSupports.insert(std::move(support));
                         Vertex newVertex;
                         newVertex.belief = vertex.first;
@@ -250,6 +327,7 @@ namespace AIToolbox::POMDP {
 
                 Vertex best = agenda_.top();
                 agenda_.pop();
+                witnesses.push_back(best.belief);
 
                 AI_LOGGER(AI_SEVERITY_INFO, "Selected Vertex " << best.belief.transpose() << " as best, with support: " << best.support->values.transpose() << ", action: " << best.support->action);
 
@@ -288,11 +366,13 @@ namespace AIToolbox::POMDP {
 
             v.emplace_back(std::move(goodSupports));
 
-            // Check convergence
+            // Check convergence, accounting for the error introduced by
+            // skipping low-error vertices.
             if ( useTolerance ) {
-                variation = weakBoundDistance(v[timestep-1], v[timestep]);
+                variation = weakBoundDistance(v[v.size()-2], v.back()) + epsilon_;
             }
         }
+        witnesses_ = std::move(witnesses);
 
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
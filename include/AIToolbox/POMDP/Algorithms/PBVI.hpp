@@ -1,9 +1,15 @@
 #ifndef AI_TOOLBOX_POMDP_PBVI_HEADER_FILE
 #define AI_TOOLBOX_POMDP_PBVI_HEADER_FILE
 
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
 #include <boost/iterator/transform_iterator.hpp>
 
+#include <AIToolbox/Utils/Executor.hpp>
 #include <AIToolbox/Utils/Prune.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/POMDP/Utils.hpp>
@@ -41,6 +47,16 @@ namespace AIToolbox::POMDP {
      *
      * There is no convergence guarantee of this method, but the error is
      * bounded.
+     *
+     * The backups of the different actions are independent, and are run
+     * in parallel on the default Executor (see Executor::getDefault()).
+     *
+     * This class also implements an anytime mode (see anytime()), closer
+     * to the original formulation of the algorithm. There, the belief set
+     * starts from the simplex corners and is expanded in rounds; after
+     * each expansion the ValueFunction is backed up on the current set,
+     * and the process repeats until the belief set is full or a time
+     * budget runs out.
      */
     class PBVI {
         public:
@@ -161,6 +177,57 @@ namespace AIToolbox::POMDP {
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
             std::tuple<double, ValueFunction> operator()(const M & model, const std::vector<Belief> & bList, ValueFunction v = {});
 
+            /**
+             * @brief This function solves a POMDP::Model approximately, interleaving belief expansion and backups.
+             *
+             * The belief set starts from the corners of the simplex, and
+             * at each round it is (roughly) doubled through a
+             * BeliefGenerator, until it contains the number of support
+             * beliefs set in this class. After each expansion the
+             * ValueFunction is backed up on the current set until the
+             * variation falls below the tolerance, or for at most
+             * horizon stages.
+             *
+             * Work is reused across stages and rounds. The best value of
+             * each belief in the latest layer is cached, and during a
+             * stage a belief is only backed up if none of the entries
+             * already produced for the new layer improves on it. As the
+             * new beliefs of a round are the only ones without a good
+             * entry, most backups after an expansion go to them.
+             *
+             * If no initial ValueFunction is given, we start from a lower
+             * bound of the true one (the minimum reward repeated forever)
+             * when the discount is less than 1, so that each stage can
+             * only improve the values; otherwise we start from zero.
+             *
+             * When the time budget expires, the layer currently being
+             * built is discarded (as it may not cover all beliefs) and
+             * the ValueFunction computed so far is returned. A budget of
+             * zero means no time limit.
+             *
+             * Note that each backup stage appends a layer to the
+             * ValueFunction, so the number of layers is not related to a
+             * horizon.
+             *
+             * @tparam M The type of POMDP model that needs to be solved.
+             *
+             * @param model The POMDP model that needs to be solved.
+             * @param budget The maximum time to spend solving, or zero for no limit.
+             * @param v The ValueFunction to startup the process from, if needed.
+             *
+             * @return A tuple containing the variation of the last backup
+             *         stage and the computed ValueFunction.
+             */
+            template <typename M, typename = std::enable_if_t<is_model_v<M>>>
+            std::tuple<double, ValueFunction> anytime(const M & model, std::chrono::duration<double> budget, ValueFunction v = {});
+
+            /**
+             * @brief This function returns the beliefs used during the last call to anytime().
+             *
+             * @return The final belief set of the anytime mode.
+             */
+            const std::vector<Belief> & getAnytimeBeliefs() const;
+
         private:
             /**
              * @brief This function computes a VList composed the maximized cross-sums with respect to the provided beliefs.
@@ -188,6 +255,8 @@ namespace AIToolbox::POMDP {
             unsigned horizon_;
             double tolerance_;
 
+            std::vector<Belief> anytimeBeliefs_;
+
             mutable RandomEngine rand_;
     };
 
@@ -216,6 +285,7 @@ namespace AIToolbox::POMDP {
         unsigned timestep = 0;
 
         Projecter projecter(model);
+        const auto executor = Executor::getDefault();
 
         // And off we go
         const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
@@ -229,15 +299,16 @@ namespace AIToolbox::POMDP {
             // of entries in our initial vector w.
             auto projs = projecter(v.back());
 
-            size_t finalWSize = 0;
             // In this method we split the work by action, which will then
-            // be joined again at the end of the loop. This is not required,
-            // but there does not seem to be a speed boost by not doing
-            // so (not that I found one, if there is one I'd like to know!)
-            for ( size_t a = 0; a < A; ++a ) {
+            // be joined again at the end of the loop. The actions are
+            // independent, so each can be processed by a different worker.
+            executor->parallelFor(0, A, [&](const size_t a) {
                 projs[a][0] = crossSum( projs[a], a, beliefs );
+            }, 1);
+
+            size_t finalWSize = 0;
+            for ( size_t a = 0; a < A; ++a )
                 finalWSize += projs[a][0].size();
-            }
             VList w;
             w.reserve(finalWSize);
 
@@ -267,6 +338,99 @@ namespace AIToolbox::POMDP {
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
 
+    template <typename M, typename>
+    std::tuple<double, ValueFunction> PBVI::anytime(const M & model, const std::chrono::duration<double> budget, ValueFunction v) {
+        using Clock = std::chrono::steady_clock;
+        const bool useBudget = budget.count() > 0.0;
+        const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(budget);
+        const auto expired = [&]{ return useBudget && Clock::now() >= deadline; };
+
+        S = model.getS();
+        A = model.getA();
+        O = model.getO();
+
+        if (v.size() == 0) {
+            v = makeValueFunction(S);
+            if ( model.getDiscount() < 1.0 ) {
+                const auto ir = computeImmediateRewards(model);
+                v[0][0].values.fill(ir.minCoeff() / (1.0 - model.getDiscount()));
+            }
+        }
+
+        auto & beliefs = anytimeBeliefs_;
+        beliefs.clear();
+        BeliefGenerator bGen(model);
+
+        // Cache of the best value of each belief in v.back().
+        std::vector<double> cache;
+        const auto bestValue = [](const Belief & b, const VList & vl) {
+            double value;
+            auto begin = boost::make_transform_iterator(std::begin(vl), unwrap);
+            auto end   = boost::make_transform_iterator(std::end(vl),   unwrap);
+            findBestAtPoint(b, begin, end, &value);
+            return value;
+        };
+
+        std::vector<size_t> order;
+        Projecter projecter(model);
+
+        const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
+        double variation = tolerance_ * 2;
+        while ( !expired() ) {
+            // Expansion: the first round adds the corners of the simplex.
+            const auto oldSize = beliefs.size();
+            const auto target = std::min(beliefSize_, std::max(S, 2 * oldSize));
+            if ( oldSize < target ) {
+                if ( oldSize == 0 ) beliefs = bGen(target);
+                else                bGen(target, &beliefs);
+            }
+            // Once the set is full, the last round has already backed it
+            // up as much as we were allowed to.
+            if ( beliefs.size() == oldSize )
+                break;
+
+            for ( size_t i = oldSize; i < beliefs.size(); ++i )
+                cache.push_back(bestValue(beliefs[i], v.back()));
+
+            order.resize(beliefs.size());
+            std::iota(std::begin(order), std::end(order), 0);
+
+            unsigned timestep = 0;
+            variation = tolerance_ * 2;
+            while ( timestep < horizon_ && ( !useTolerance || variation > tolerance_ ) ) {
+                ++timestep;
+
+                auto projs = projecter(v.back());
+                std::shuffle(std::begin(order), std::end(order), rand_);
+
+                VList w;
+                bool completed = true;
+                for ( const auto i : order ) {
+                    const auto & b = beliefs[i];
+                    // Reuse: some other backup already improved this belief.
+                    if ( w.size() && bestValue(b, w) >= cache[i] ) continue;
+
+                    if ( expired() ) {
+                        completed = false;
+                        break;
+                    }
+                    w.emplace_back(crossSumBestAtBelief(b, projs));
+                }
+                if ( !completed ) break;
+
+                variation = 0.0;
+                for ( size_t i = 0; i < beliefs.size(); ++i ) {
+                    const auto value = bestValue(beliefs[i], w);
+                    variation = std::max(variation, std::abs(value - cache[i]));
+                    cache[i] = value;
+                }
+                v.emplace_back(std::move(w));
+            }
+        }
+
+        return std::make_tuple(useTolerance ? variation : 0.0, std::move(v));
+    }
+
     template <typename ProjectionsRow>
     VList PBVI::crossSum(const ProjectionsRow & projs, const size_t a, const std::vector<Belief> & bl) {
         VList result;
@@ -1,6 +1,7 @@
 #ifndef AI_TOOLBOX_POMDP_POMCP_HEADER_FILE
 #define AI_TOOLBOX_POMDP_POMCP_HEADER_FILE
 
+#include <limits>
 #include <unordered_map>
 
 #include <AIToolbox/Impl/Logging.hpp>
@@ -8,6 +9,7 @@
 #include <AIToolbox/Utils/Probability.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
+#include <AIToolbox/MDP/Algorithms/Utils/RolloutBatch.hpp>
 
 namespace AIToolbox::POMDP {
     /**
@@ -56,6 +58,27 @@ namespace AIToolbox::POMDP {
      * reinvigoration method, which would introduce noise in the particle
      * beliefs in order to keep them "fresh" (possibly using domain
      * knowledge).
+     *
+     * Optionally, POMCP can evaluate leaves in batches (see
+     * setBatchSize()). In this mode each round descends the tree multiple
+     * times, updating the particle beliefs and collecting the new leaves,
+     * and then runs all their rollouts together in lockstep with an
+     * MDP::RolloutBatch. The returns are then backed up along all the
+     * recorded paths. Visit counts are updated while descending, so that
+     * the descents of a round spread over different branches, while the
+     * values are only updated once the round is complete.
+     *
+     * Since particle beliefs grow by one particle each time a node is
+     * traversed, and the tree by up to one node per simulation, long
+     * searches can use a lot of memory. POMCP can be bounded in both
+     * regards (see setMaxParticles() and setMaxNodes()). Once a particle
+     * belief is full, new particles replace old ones through reservoir
+     * sampling, so that the belief remains a uniform sample of all the
+     * particles that reached the node. Once the tree is full, new nodes
+     * are not created anymore: the simulations that would have created
+     * them still perform a rollout, but their particles are discarded.
+     * The budget is freed as the root is advanced, since the pruned
+     * branches are removed from the count.
      */
     template <typename M>
     class POMCP {
@@ -75,11 +98,22 @@ namespace AIToolbox::POMDP {
             using ActionNodes = std::vector<ActionNode>;
 
             struct BeliefNode {
-                BeliefNode() : N(0) {}
-                BeliefNode(size_t s) : belief(1, s), N(0) {}
+                BeliefNode() : N(0), particles(0) {}
+                BeliefNode(size_t s) : belief(1, s), N(0), particles(1) {}
                 ActionNodes children;
                 SampleBelief belief;
                 unsigned N;
+                // Number of particles that reached this node, including
+                // the ones discarded by reservoir sampling.
+                size_t particles;
+            };
+
+            struct TreeStatistics {
+                size_t beliefNodes = 0;
+                size_t actionNodes = 0;
+                size_t particles = 0;
+                // Approximate number of bytes used by the tree.
+                size_t bytes = 0;
             };
 
             /**
@@ -106,6 +140,21 @@ namespace AIToolbox::POMDP {
              */
             size_t sampleAction(const Belief& b, unsigned horizon);
 
+            /**
+             * @brief This function resets the internal graph and samples for the provided sparse belief and horizon.
+             *
+             * This overload works as sampleAction(const Belief &, unsigned),
+             * but the initial particles are sampled in time proportional
+             * to the support of the belief rather than to the number of
+             * states.
+             *
+             * @param b The initial belief for the environment.
+             * @param horizon The horizon to plan for.
+             *
+             * @return The best action.
+             */
+            size_t sampleAction(const SparseBelief& b, unsigned horizon);
+
             /**
              * @brief This function uses the internal graph to plan.
              *
@@ -162,6 +211,48 @@ namespace AIToolbox::POMDP {
              */
             void setExploration(double exp);
 
+            /**
+             * @brief This function sets the number of leaves evaluated together.
+             *
+             * Each round samples this many particles from the root belief
+             * and descends once with each. The default of 1 runs each
+             * simulation to completion before starting the next; 0 is
+             * treated as 1.
+             *
+             * The descents of a round still add their particles to the
+             * beliefs they traverse, so batching does not change how
+             * quickly the particle beliefs grow.
+             *
+             * @param batchSize The new batch size.
+             */
+            void setBatchSize(unsigned batchSize);
+
+            /**
+             * @brief This function sets the maximum number of particles stored in each belief node.
+             *
+             * Once a node holds this many particles, new particles
+             * replace existing ones with reservoir sampling. A value of
+             * zero (the default) means unbounded.
+             *
+             * Note that this does not shrink existing particle beliefs;
+             * these are bounded in size only when new particles are
+             * added.
+             *
+             * @param maxParticles The new maximum number of particles per node.
+             */
+            void setMaxParticles(size_t maxParticles);
+
+            /**
+             * @brief This function sets the maximum number of belief nodes in the tree.
+             *
+             * Once the tree contains this many belief nodes (including
+             * the root), no new nodes are created. A value of zero (the
+             * default) means unbounded.
+             *
+             * @param maxNodes The new maximum number of belief nodes.
+             */
+            void setMaxNodes(size_t maxNodes);
+
             /**
              * @brief This function returns the POMDP generative model being used.
              *
@@ -197,6 +288,51 @@ namespace AIToolbox::POMDP {
              */
             double getExploration() const;
 
+            /**
+             * @brief This function returns the number of leaves evaluated together.
+             *
+             * @return The batch size.
+             */
+            unsigned getBatchSize() const;
+
+            /**
+             * @brief This function returns the maximum number of particles stored in each belief node.
+             *
+             * @return The maximum number of particles per node, or zero if unbounded.
+             */
+            size_t getMaxParticles() const;
+
+            /**
+             * @brief This function returns the maximum number of belief nodes in the tree.
+             *
+             * @return The maximum number of belief nodes, or zero if unbounded.
+             */
+            size_t getMaxNodes() const;
+
+            /**
+             * @brief This function returns the number of belief nodes in the tree.
+             *
+             * This number is tracked during the search, and so this
+             * function is O(1).
+             *
+             * @return The number of belief nodes, including the root.
+             */
+            size_t getNodesNumber() const;
+
+            /**
+             * @brief This function computes size statistics of the tree.
+             *
+             * This function traverses the whole tree, so it should not be
+             * called in the middle of time-critical code.
+             *
+             * The memory estimate counts the nodes, the particle vectors
+             * and the hash tables allocated by the tree, but not the
+             * allocator overhead, so it is only a lower bound.
+             *
+             * @return The statistics of the current tree.
+             */
+            TreeStatistics getTreeStatistics() const;
+
         private:
             const M& model_;
             size_t S, A, beliefSize_;
@@ -206,6 +342,24 @@ namespace AIToolbox::POMDP {
             SampleBelief sampleBelief_;
             BeliefNode graph_;
 
+            // Batched simulation data
+            struct PathStep {
+                ActionNode * node;
+                double rew;
+                // Visit count of the node after this visit.
+                unsigned n;
+            };
+            static constexpr size_t NoRollout = std::numeric_limits<size_t>::max();
+
+            unsigned batchSize_;
+            std::vector<PathStep> steps_;
+            // Offset of each path in steps_, and id of its rollout.
+            std::vector<std::pair<size_t, size_t>> paths_;
+            MDP::RolloutBatch rollouts_;
+
+            // Memory bounds
+            size_t maxParticles_, maxNodes_, nodes_;
+
             mutable RandomEngine rand_;
 
             /**
@@ -247,6 +401,49 @@ namespace AIToolbox::POMDP {
              */
             double simulate(BeliefNode & b, size_t s, unsigned horizon);
 
+            /**
+             * @brief This function performs a round of batched simulations.
+             *
+             * This function calls descend() k times, runs all the
+             * collected rollouts together, and then backs up the
+             * resulting returns along each recorded path, in order.
+             *
+             * @param k The number of simulations to perform.
+             */
+            void runBatch(unsigned k);
+
+            /**
+             * @brief This function traverses the tree from the root, without backing up.
+             *
+             * This function behaves like simulate(), but rather than
+             * performing the rollout and updating the values, it records
+             * the path and the new leaf so that runBatch() can process
+             * them later.
+             *
+             * @param s The sampled state to start from.
+             */
+            void descend(size_t s);
+
+            /**
+             * @brief This function adds a particle to a belief node.
+             *
+             * If the node is full, the particle replaces an existing one
+             * via reservoir sampling.
+             *
+             * @param b The node to add the particle to.
+             * @param s The particle.
+             */
+            void addParticle(BeliefNode & b, size_t s);
+
+            /**
+             * @brief This function creates a new belief node from a particle, if the node budget allows it.
+             *
+             * @param aNode The parent of the new node.
+             * @param o The observation identifying the new node.
+             * @param s1 The first particle of the new node.
+             */
+            void addNode(ActionNode & aNode, size_t o, size_t s1);
+
             /**
              * @brief This function implements the rollout policy for POMCP.
              *
@@ -311,12 +508,24 @@ namespace AIToolbox::POMDP {
              * @return A particle belief approximating the input belief.
              */
             SampleBelief makeSampledBelief(const Belief & b);
+
+            /**
+             * @brief This function samples a given sparse belief in order to produce a particle approximation of it.
+             *
+             * Each particle only costs a scan of the support of the belief.
+             *
+             * @param b The belief to be approximated.
+             *
+             * @return A particle belief approximating the input belief.
+             */
+            SampleBelief makeSampledBelief(const SparseBelief & b);
     };
 
     template <typename M>
     POMCP<M>::POMCP(const M& m, const size_t beliefSize, const unsigned iter, const double exp) :
             model_(m), S(model_.getS()), A(model_.getA()), beliefSize_(beliefSize),
-            iterations_(iter), exploration_(exp), graph_(), rand_(Impl::Seeder::getSeed()) {}
+            iterations_(iter), exploration_(exp), graph_(), batchSize_(1),
+            maxParticles_(0), maxNodes_(0), nodes_(1), rand_(Impl::Seeder::getSeed()) {}
 
     template <typename M>
     size_t POMCP<M>::sampleAction(const Belief& b, const unsigned horizon) {
@@ -324,6 +533,20 @@ namespace AIToolbox::POMDP {
         graph_ = BeliefNode(A);
         graph_.children.resize(A);
         graph_.belief = makeSampledBelief(b);
+        graph_.particles = graph_.belief.size();
+        nodes_ = 1;
+
+        return runSimulation(horizon);
+    }
+
+    template <typename M>
+    size_t POMCP<M>::sampleAction(const SparseBelief& b, const unsigned horizon) {
+        // Reset graph
+        graph_ = BeliefNode(A);
+        graph_.children.resize(A);
+        graph_.belief = makeSampledBelief(b);
+        graph_.particles = graph_.belief.size();
+        nodes_ = 1;
 
         return runSimulation(horizon);
     }
@@ -357,6 +580,10 @@ namespace AIToolbox::POMDP {
         // This would break the UCT call.
         graph_.children.resize(A);
 
+        // Recount the nodes of the branch we kept, to free the budget
+        // used by the pruned ones.
+        nodes_ = getTreeStatistics().beliefNodes;
+
         return runSimulation(horizon);
     }
 
@@ -367,8 +594,13 @@ namespace AIToolbox::POMDP {
         maxDepth_ = horizon;
         std::uniform_int_distribution<size_t> generator(0, graph_.belief.size()-1);
 
-        for (unsigned i = 0; i < iterations_; ++i )
-            simulate(graph_, graph_.belief.at(generator(rand_)), 0);
+        if ( batchSize_ == 1 ) {
+            for (unsigned i = 0; i < iterations_; ++i )
+                simulate(graph_, graph_.belief.at(generator(rand_)), 0);
+        } else {
+            for (unsigned i = 0; i < iterations_; i += batchSize_)
+                runBatch(std::min(batchSize_, iterations_ - i));
+        }
 
         auto begin = std::begin(graph_.children);
         return std::distance(begin, findBestA(begin, std::end(graph_.children)));
@@ -391,14 +623,12 @@ namespace AIToolbox::POMDP {
             // update for the next timestep.
             auto ot = aNode.children.find(o);
             if ( ot == std::end(aNode.children) ) {
-                aNode.children.emplace(std::piecewise_construct,
-                                       std::forward_as_tuple(o),
-                                       std::forward_as_tuple(s1));
+                addNode(aNode, o, s1);
                 // This stops automatically if we go out of depth
                 futureRew = rollout(s1, depth + 1);
             }
             else {
-                ot->second.belief.push_back(s1);
+                addParticle(ot->second, s1);
                 // We only go deeper if needed (maxDepth_ is always at least 1).
                 if ( depth + 1 < maxDepth_ && !model_.isTerminal(s1) ) {
                     // Since most memory is allocated on the leaves,
@@ -421,6 +651,123 @@ namespace AIToolbox::POMDP {
         return rew;
     }
 
+    template <typename M>
+    void POMCP<M>::runBatch(const unsigned k) {
+        steps_.clear();
+        paths_.clear();
+        rollouts_.clear();
+
+        std::uniform_int_distribution<size_t> generator(0, graph_.belief.size()-1);
+        for ( unsigned j = 0; j < k; ++j )
+            descend(graph_.belief.at(generator(rand_)));
+
+        rollouts_.run(model_, maxDepth_, rand_);
+
+        // Backups are done in the same order as the descents, so that the
+        // recorded visit counts produce the exact running averages.
+        const auto discount = model_.getDiscount();
+        for ( size_t p = 0; p < paths_.size(); ++p ) {
+            const auto [begin, id] = paths_[p];
+            const auto end = p + 1 < paths_.size() ? paths_[p+1].first : steps_.size();
+
+            double rew = id == NoRollout ? 0.0 : rollouts_.getValue(id);
+            for ( auto i = end; i > begin; --i ) {
+                const auto & step = steps_[i-1];
+                rew = step.rew + discount * rew;
+                step.node->V += ( rew - step.node->V ) / static_cast<double>(step.n);
+            }
+        }
+    }
+
+    template <typename M>
+    void POMCP<M>::descend(size_t s) {
+        paths_.emplace_back(steps_.size(), NoRollout);
+
+        BeliefNode * b = &graph_;
+        for ( unsigned depth = 0; ; ++depth ) {
+            b->N++;
+
+            auto begin = std::begin(b->children);
+            const size_t a = std::distance(begin, findBestBonusA(begin, std::end(b->children), b->N));
+
+            const auto [s1, o, rew] = model_.sampleSOR(s, a);
+
+            // The visit is counted immediately, so the next descents in
+            // the batch see a lower exploration bonus for this action.
+            auto & aNode = b->children[a];
+            steps_.push_back({&aNode, rew, ++aNode.N});
+
+            auto ot = aNode.children.find(o);
+            if ( ot == std::end(aNode.children) ) {
+                addNode(aNode, o, s1);
+                paths_.back().second = rollouts_.add(s1, depth + 1);
+                return;
+            }
+            addParticle(ot->second, s1);
+            if ( depth + 1 >= maxDepth_ || model_.isTerminal(s1) )
+                return;
+
+            // Node references in unordered_maps are stable, and children
+            // are only ever resized from empty, so the pointers stored in
+            // steps_ remain valid for the whole batch.
+            ot->second.children.resize(A);
+            b = &ot->second;
+            s = s1;
+        }
+    }
+
+    template <typename M>
+    void POMCP<M>::addParticle(BeliefNode & b, const size_t s) {
+        ++b.particles;
+        if ( !maxParticles_ || b.belief.size() < maxParticles_ ) {
+            b.belief.push_back(s);
+            return;
+        }
+        // Reservoir sampling: the new particle is kept with probability
+        // size / particles, replacing a uniformly chosen one.
+        std::uniform_int_distribution<size_t> dist(0, b.particles - 1);
+        const auto j = dist(rand_);
+        if ( j < b.belief.size() )
+            b.belief[j] = s;
+    }
+
+    template <typename M>
+    void POMCP<M>::addNode(ActionNode & aNode, const size_t o, const size_t s1) {
+        if ( maxNodes_ && nodes_ >= maxNodes_ ) return;
+
+        aNode.children.emplace(std::piecewise_construct,
+                               std::forward_as_tuple(o),
+                               std::forward_as_tuple(s1));
+        ++nodes_;
+    }
+
+    template <typename M>
+    typename POMCP<M>::TreeStatistics POMCP<M>::getTreeStatistics() const {
+        TreeStatistics stats;
+
+        std::vector<const BeliefNode *> stack{&graph_};
+        stats.bytes += sizeof(BeliefNode);
+        while ( stack.size() ) {
+            const auto & b = *stack.back();
+            stack.pop_back();
+
+            ++stats.beliefNodes;
+            stats.actionNodes += b.children.size();
+            stats.particles += b.belief.size();
+            stats.bytes += b.belief.capacity() * sizeof(size_t) + b.children.capacity() * sizeof(ActionNode);
+
+            for ( const auto & aNode : b.children ) {
+                stats.bytes += aNode.children.bucket_count() * sizeof(void*);
+                for ( const auto & [o, child] : aNode.children ) {
+                    // Each entry is a hash node with a next pointer.
+                    stats.bytes += sizeof(typename BeliefNodes::value_type) + sizeof(void*);
+                    stack.push_back(&child);
+                }
+            }
+        }
+        return stats;
+    }
+
     template <typename M>
     double POMCP<M>::rollout(size_t s, unsigned depth) {
         double rew = 0.0, totalRew = 0.0, gamma = 1.0;
@@ -481,6 +828,18 @@ namespace AIToolbox::POMDP {
         return belief;
     }
 
+    template <typename M>
+    typename POMCP<M>::SampleBelief POMCP<M>::makeSampledBelief(const SparseBelief & b) {
+        SampleBelief belief;
+        belief.reserve(beliefSize_);
+
+        const size_t nnz = b.nonZeros();
+        for ( size_t i = 0; i < beliefSize_; ++i )
+            belief.push_back(b.innerIndexPtr()[sampleProbability(nnz, b.valuePtr(), rand_)]);
+
+        return belief;
+    }
+
     template <typename M>
     void POMCP<M>::setBeliefSize(const size_t beliefSize) {
         beliefSize_ = beliefSize;
@@ -496,6 +855,21 @@ namespace AIToolbox::POMDP {
         exploration_ = exp;
     }
 
+    template <typename M>
+    void POMCP<M>::setBatchSize(const unsigned batchSize) {
+        batchSize_ = std::max(1u, batchSize);
+    }
+
+    template <typename M>
+    void POMCP<M>::setMaxParticles(const size_t maxParticles) {
+        maxParticles_ = maxParticles;
+    }
+
+    template <typename M>
+    void POMCP<M>::setMaxNodes(const size_t maxNodes) {
+        maxNodes_ = maxNodes;
+    }
+
     template <typename M>
     const M& POMCP<M>::getModel() const {
         return model_;
@@ -520,6 +894,26 @@ namespace AIToolbox::POMDP {
     double POMCP<M>::getExploration() const {
         return exploration_;
     }
+
+    template <typename M>
+    unsigned POMCP<M>::getBatchSize() const {
+        return batchSize_;
+    }
+
+    template <typename M>
+    size_t POMCP<M>::getMaxParticles() const {
+        return maxParticles_;
+    }
+
+    template <typename M>
+    size_t POMCP<M>::getMaxNodes() const {
+        return maxNodes_;
+    }
+
+    template <typename M>
+    size_t POMCP<M>::getNodesNumber() const {
+        return nodes_;
+    }
 }
 
 #endif
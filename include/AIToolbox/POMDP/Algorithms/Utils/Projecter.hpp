@@ -1,6 +1,8 @@
 #ifndef AI_TOOLBOX_POMDP_PROJECTER_HEADER_FILE
 #define AI_TOOLBOX_POMDP_PROJECTER_HEADER_FILE
 
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
 #include <AIToolbox/POMDP/TypeTraits.hpp>
 #include <AIToolbox/MDP/Utils.hpp>
@@ -8,6 +10,15 @@
 namespace AIToolbox::POMDP {
     /**
      * @brief This class offers projecting facilities for Models.
+     *
+     * For models that expose their tables as Eigen matrices, all
+     * alphavectors of a VList are stacked into a single matrix, so that
+     * each action-observation projection is computed with a single
+     * matrix-matrix product rather than one product per alphavector.
+     *
+     * When projecting for all actions at once, the actions are split
+     * across the workers of the default Executor (see
+     * Executor::getDefault()).
      */
     template <typename M>
     class Projecter {
@@ -60,6 +71,26 @@ namespace AIToolbox::POMDP {
              */
             void computeImmediateRewards();
 
+            /**
+             * @brief This function computes the projections of the stacked alphavectors for an action.
+             *
+             * @param w The list that needs to be projected.
+             * @param W The alphavectors of the list, one per column.
+             * @param a The action used for projecting the list.
+             *
+             * @return A 1d array of projection lists.
+             */
+            ProjectionsRow project(const VList & w, const Eigen::MatrixXd & W, size_t a) const;
+
+            /**
+             * @brief This function stacks the alphavectors of a VList as columns of a matrix.
+             *
+             * @param w The list to stack.
+             *
+             * @return A matrix with S rows and one column per alphavector.
+             */
+            Eigen::MatrixXd stack(const VList & w) const;
+
             const M & model_;
             size_t S, A, O;
             double discount_;
@@ -81,14 +112,37 @@ namespace AIToolbox::POMDP {
     typename Projecter<M>::ProjectionsTable Projecter<M>::operator()(const VList & w) {
         ProjectionsTable projections( boost::extents[A][O] );
 
-        for ( size_t a = 0; a < A; ++a )
-            projections[a] = operator()(w, a);
+        // We stack the alphas only once for all actions. Each action then
+        // writes to its own row of the table, so they can run in parallel.
+        const auto W = stack(w);
+        const auto executor = Executor::getDefault();
+        executor->parallelFor(0, A, [&](const size_t a) {
+            projections[a] = project(w, W, a);
+        }, 1);
 
         return projections;
     }
 
     template <typename M>
     typename Projecter<M>::ProjectionsRow Projecter<M>::operator()(const VList & w, const size_t a) {
+        return project(w, stack(w), a);
+    }
+
+    template <typename M>
+    Eigen::MatrixXd Projecter<M>::stack(const VList & w) const {
+        // Only the Eigen path uses the stacked alphas.
+        if constexpr(is_model_eigen_v<M>) {
+            Eigen::MatrixXd W(S, w.size());
+            for ( size_t i = 0; i < w.size(); ++i )
+                W.col(i) = w[i].values;
+            return W;
+        } else {
+            return {};
+        }
+    }
+
+    template <typename M>
+    typename Projecter<M>::ProjectionsRow Projecter<M>::project(const VList & w, const Eigen::MatrixXd & W, const size_t a) const {
         ProjectionsRow projections( boost::extents[O] );
 
         for ( size_t o = 0; o < O; ++o ) {
@@ -105,23 +159,31 @@ namespace AIToolbox::POMDP {
             }
 
             // Otherwise we compute a projection for each ValueFunction supplied to us.
-            MDP::Values vproj(S);
-            for ( size_t i = 0; i < w.size(); ++i ) {
-                const auto & v = w[i].values;
-                // For each value function in the previous timestep, we compute the new value
-                // if we performed action a and obtained observation o.
-                // vproj_{a,o}[s] = R(s,a) / |O| + discount * sum_{s'} ( T(s,a,s') * O(s',a,o) * v_{t-1}(s') )
-                if constexpr(is_model_eigen_v<M>) {
-                    vproj = model_.getTransitionFunction(a) * (v.cwiseProduct(model_.getObservationFunction(a).col(o)));
-                } else {
+            // For each value function in the previous timestep, we compute the new value
+            // if we performed action a and obtained observation o.
+            // vproj_{a,o}[s] = R(s,a) / |O| + discount * sum_{s'} ( T(s,a,s') * O(s',a,o) * v_{t-1}(s') )
+            projections[o].reserve(w.size());
+            if constexpr(is_model_eigen_v<M>) {
+                // We project all alphas at once, with a single matrix
+                // product: T(a) * diag(O(a).col(o)) * W.
+                const Vector obs = model_.getObservationFunction(a).col(o);
+                Eigen::MatrixXd vproj = model_.getTransitionFunction(a) * (W.array().colwise() * obs.array()).matrix();
+                vproj *= discount_;
+                vproj.colwise() += immediateRewards_.row(a).transpose();
+
+                for ( size_t i = 0; i < w.size(); ++i )
+                    projections[o].emplace_back(vproj.col(i), a, VObs(1,i));
+            } else {
+                MDP::Values vproj(S);
+                for ( size_t i = 0; i < w.size(); ++i ) {
+                    const auto & v = w[i].values;
                     vproj.fill(0.0);
                     for ( size_t s = 0; s < S; ++s )
                         for ( size_t s1 = 0; s1 < S; ++s1 )
                             vproj[s] += model_.getTransitionProbability(s,a,s1) * model_.getObservationProbability(s1,a,o) * v[s1];
+                    // Set new projection with found value and previous V id.
+                    projections[o].emplace_back(vproj * discount_ + immediateRewards_.row(a).transpose(), a, VObs(1,i));
                 }
-                // Set new projection with found value and previous V id.
-                // projections[o].emplace_back(vproj, a, VObs(1,i));
-                projections[o].emplace_back(vproj * discount_ + immediateRewards_.row(a).transpose(), a, VObs(1,i));
             }
         }
         return projections;
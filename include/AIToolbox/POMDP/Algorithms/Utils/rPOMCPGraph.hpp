@@ -1,6 +1,7 @@
 #ifndef AI_TOOLBOX_POMDP_rPOMCP_GRAPH_HEADER_FILE
 #define AI_TOOLBOX_POMDP_rPOMCP_GRAPH_HEADER_FILE
 
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 
@@ -16,6 +17,7 @@ namespace AIToolbox::Impl::POMDP {
 
     struct BeliefNodeNoEntropyAddon {
         size_t maxS_ = 0;           ///< This keeps track of the belief peak state for max of belief
+        unsigned maxN_ = 0;         ///< This keeps track of the number of particles of the peak state
     };
 }
 
@@ -31,16 +33,65 @@ namespace AIToolbox::POMDP {
         unsigned N = 0;             ///< Number of particles for this particular type (state)
     };
 
-    // This is used to keep track of beliefs down in the tree. We use a map since
-    // we do not need to sample from here, just to access fast and recompute the
-    // entropy values.
+    /**
+     * @brief This class keeps track of the particle counts of beliefs down in the tree.
+     *
+     * We do not need to sample from these beliefs, just to access them
+     * fast and recompute the entropy values. Since most beliefs in the
+     * tree contain only a handful of different states, we store them as a
+     * small vector sorted by state, which we search with a binary search.
+     * This is much more compact than a hash map, and avoids most cache
+     * misses.
+     *
+     * When the support grows past SparseLimit states and is dense enough
+     * (the highest state is less than DenseFactor times the support), the
+     * storage switches to an array indexed directly by state, where
+     * lookups are O(1). If a state added later would make the array
+     * sparser than that, the storage goes back to the sorted vector.
+     */
     template <bool UseEntropy>
-    using TrackBelief = std::unordered_map<
-                            size_t,
-                            BeliefParticle<UseEntropy>,
-                            std::hash<size_t>,
-                            std::equal_to<size_t>
-                        >;
+    class TrackBelief {
+        public:
+            using Particle = BeliefParticle<UseEntropy>;
+
+            static constexpr size_t SparseLimit = 16;
+            static constexpr size_t DenseFactor = 4;
+
+            TrackBelief();
+
+            /**
+             * @brief This function adds a particle for the input state.
+             *
+             * @param s The state of the particle.
+             *
+             * @return A reference to the (already incremented) counter for the state.
+             */
+            Particle & add(size_t s);
+
+            /**
+             * @brief This function calls the input function on each state with at least one particle.
+             *
+             * States are visited in increasing order.
+             *
+             * @param f A function taking a state and its const Particle.
+             */
+            template <typename F>
+            void forEach(F f) const;
+
+            size_t size() const;    ///< The number of different states with particles.
+            bool isDense() const;   ///< Whether the storage is indexed directly by state.
+
+        private:
+            /// This function converts the sparse storage into the dense one.
+            void makeDense();
+            /// This function converts the dense storage back into the sparse one.
+            void makeSparse();
+
+            std::vector<size_t> states_;        ///< Sorted states, only in sparse mode.
+            std::vector<Particle> particles_;   ///< Parallel to states_ in sparse mode, indexed by state in dense mode.
+            size_t support_;
+            bool dense_;
+    };
 
     /**
      * @brief This is a belief node of the rPOMCP tree.
@@ -132,6 +183,91 @@ namespace AIToolbox::POMDP {
             size_t beliefSize_;                   ///< This is the total number of particles for this belief (sum of each count of the sample belief)
     };
 
+    template <bool UseEntropy>
+    TrackBelief<UseEntropy>::TrackBelief() : support_(0), dense_(false) {}
+
+    template <bool UseEntropy>
+    typename TrackBelief<UseEntropy>::Particle & TrackBelief<UseEntropy>::add(const size_t s) {
+        if ( dense_ ) {
+            if ( s >= particles_.size() ) {
+                // A new state would grow the array; we only do it if it
+                // stays dense enough.
+                if ( s < DenseFactor * (support_ + 1) ) {
+                    particles_.resize(s + 1);
+                } else {
+                    makeSparse();
+                    return add(s);
+                }
+            }
+            auto & p = particles_[s];
+            if ( !p.N ) ++support_;
+            ++p.N;
+            return p;
+        }
+        const auto it = std::lower_bound(std::begin(states_), std::end(states_), s);
+        const size_t i = std::distance(std::begin(states_), it);
+        if ( it == std::end(states_) || *it != s ) {
+            states_.insert(it, s);
+            particles_.emplace(std::begin(particles_) + i);
+            ++support_;
+            if ( support_ > SparseLimit && states_.back() < DenseFactor * support_ ) {
+                makeDense();
+                return add(s);  // The new entry is empty, so this only increments it.
+            }
+        }
+        ++particles_[i].N;
+        return particles_[i];
+    }
+
+    template <bool UseEntropy>
+    void TrackBelief<UseEntropy>::makeDense() {
+        std::vector<Particle> dense(states_.back() + 1);
+        for ( size_t i = 0; i < states_.size(); ++i )
+            dense[states_[i]] = particles_[i];
+
+        particles_ = std::move(dense);
+        std::vector<size_t>().swap(states_);
+        // The entry being added still has no particles.
+        --support_;
+        dense_ = true;
+    }
+
+    template <bool UseEntropy>
+    void TrackBelief<UseEntropy>::makeSparse() {
+        std::vector<Particle> sparse;
+        sparse.reserve(support_ + 1);
+        states_.reserve(support_ + 1);
+        for ( size_t s = 0; s < particles_.size(); ++s ) {
+            if ( !particles_[s].N ) continue;
+            states_.push_back(s);
+            sparse.push_back(particles_[s]);
+        }
+        particles_ = std::move(sparse);
+        dense_ = false;
+    }
+
+    template <bool UseEntropy>
+    template <typename F>
+    void TrackBelief<UseEntropy>::forEach(F f) const {
+        if ( dense_ ) {
+            for ( size_t s = 0; s < particles_.size(); ++s )
+                if ( particles_[s].N ) f(s, particles_[s]);
+        } else {
+            for ( size_t i = 0; i < states_.size(); ++i )
+                f(states_[i], particles_[i]);
+        }
+    }
+
+    template <bool UseEntropy>
+    size_t TrackBelief<UseEntropy>::size() const {
+        return support_;
+    }
+
+    template <bool UseEntropy>
+    bool TrackBelief<UseEntropy>::isDense() const {
+        return dense_;
+    }
+
     template <bool UseEntropy>
     BeliefNode<UseEntropy>::BeliefNode() :
             N(0), V(0.0),
@@ -145,28 +281,30 @@ namespace AIToolbox::POMDP {
     // should be seen enough times to still keep a decent approximation of its
     // entropy term. Minor errors are ok since this is still an estimation.
     template <>
-    void BeliefNode<true>::updateBeliefAndKnowledge(const size_t s) {
-        // Remove entropy term for this state from summatory
-        knowledgeMeasure_ -= trackBelief_[s].negativeEntropy;
+    inline void BeliefNode<true>::updateBeliefAndKnowledge(const size_t s) {
         // Updating belief
-        trackBelief_[s].N += 1;
+        auto & particle = trackBelief_.add(s);
+        // Remove entropy term for this state from summatory
+        knowledgeMeasure_ -= particle.negativeEntropy;
         // Computing new entropy term for this state
-        double p = static_cast<double>(trackBelief_[s].N) / static_cast<double>(N+1);
+        double p = static_cast<double>(particle.N) / static_cast<double>(N+1);
         double newEntropy = p * std::log(p);
         // Update values
-        trackBelief_[s].negativeEntropy = newEntropy;
+        particle.negativeEntropy = newEntropy;
         knowledgeMeasure_ += newEntropy;
     }
 
     // This is the Max-Belief implementation
     template <>
-    void BeliefNode<false>::updateBeliefAndKnowledge(const size_t s) {
-        trackBelief_[s].N += 1;
+    inline void BeliefNode<false>::updateBeliefAndKnowledge(const size_t s) {
+        const auto & particle = trackBelief_.add(s);
 
-        if ( trackBelief_[s].N > trackBelief_[maxS_].N )
+        if ( particle.N > maxN_ ) {
             maxS_ = s;
+            maxN_ = particle.N;
+        }
 
-        knowledgeMeasure_ = static_cast<double>(trackBelief_[maxS_].N) / static_cast<double>(N+1);
+        knowledgeMeasure_ = static_cast<double>(maxN_) / static_cast<double>(N+1);
     }
 
     template <bool UseEntropy>
@@ -184,17 +322,18 @@ namespace AIToolbox::POMDP {
             BeliefNode<UseEntropy>(), rand_(&rand), beliefSize_(beliefSize)
     {
         this->children.resize(A);
-        std::unordered_map<size_t, unsigned> generatedSamples;
 
-        size_t S = b.size();
+        const size_t S = b.size();
+        std::vector<unsigned> generatedSamples(S, 0);
         for ( size_t i = 0; i < beliefSize_; ++i )
             generatedSamples[AIToolbox::sampleProbability(S, b, *rand_)] += 1;
 
-        sampleBelief_.reserve(beliefSize_);
-        for ( auto & pair : generatedSamples ) {
-            sampleBelief_.emplace_back(pair);
+        sampleBelief_.reserve(std::min(S, beliefSize_));
+        for ( size_t s = 0; s < S; ++s ) {
+            if ( !generatedSamples[s] ) continue;
+            sampleBelief_.emplace_back(s, generatedSamples[s]);
             // Compute entropy here since we don't have a parent in this case (is it really needed?)
-            // double p = static_cast<double>(pair.second) / static_cast<double>(beliefSize_);
+            // double p = static_cast<double>(generatedSamples[s]) / static_cast<double>(beliefSize_);
             // negativeEntropy += p * std::log(p);
         }
     }
@@ -205,11 +344,11 @@ namespace AIToolbox::POMDP {
     {
         this->children.resize(A);
         sampleBelief_.reserve(this->trackBelief_.size());
-        for ( auto & pair : this->trackBelief_ ) {
-            sampleBelief_.emplace_back(pair.first, pair.second.N);
-            beliefSize_ += pair.second.N;
-        }
-        TrackBelief<UseEntropy>().swap(this->trackBelief_); // Clear belief memory
+        this->trackBelief_.forEach([this](const size_t s, const auto & particle) {
+            sampleBelief_.emplace_back(s, particle.N);
+            beliefSize_ += particle.N;
+        });
+        this->trackBelief_ = TrackBelief<UseEntropy>(); // Clear belief memory
     }
 
     template <bool UseEntropy>
@@ -41,6 +41,12 @@ namespace AIToolbox::POMDP {
      * In addition, Witness will not add to the agenda any VEntry which it has
      * already added; it uses a set to keep track of which combinations of
      * subtrees it has already tried.
+     *
+     * An epsilon can be specified to prune approximately. The search for
+     * witnesses is still exact, but the final prune of each timestep drops
+     * all alphavectors which cannot improve the ValueFunction by more than
+     * epsilon. Near-duplicate alphavectors can optionally be merged before
+     * that prune, which saves LP solves.
      */
     class Witness {
         public:
@@ -57,10 +63,16 @@ namespace AIToolbox::POMDP {
              * as the difference between two iterations is less than the
              * tolerance specified.
              *
+             * The epsilon parameter must be >= 0.0, otherwise the
+             * constructor will throw an std::invalid_argument. See
+             * setEpsilon() and setMergeDuplicates().
+             *
              * @param h The horizon chosen.
              * @param tolerance The tolerance factor to stop the value iteration loop.
+             * @param epsilon The maximum value loss allowed when pruning.
+             * @param mergeDuplicates Whether to merge near-duplicates in the final prune.
              */
-            Witness(unsigned horizon, double tolerance);
+            Witness(unsigned horizon, double tolerance, double epsilon = 0.0, bool mergeDuplicates = false);
 
             /**
              * @brief This function sets the tolerance parameter.
@@ -91,6 +103,52 @@ namespace AIToolbox::POMDP {
              */
             double getTolerance() const;
 
+            /**
+             * @brief This function sets the epsilon parameter.
+             *
+             * The epsilon parameter must be >= 0.0, otherwise the function
+             * will throw an std::invalid_argument. With an epsilon of 0.0
+             * pruning is exact. Otherwise, once all witnesses have been
+             * found the union of the per-action VLists is pruned dropping
+             * alphavectors which cannot improve the ValueFunction by more
+             * than epsilon. The agenda search itself is not affected.
+             *
+             * Since each timestep can then lose up to epsilon value, the
+             * returned variation is increased by epsilon. The tolerance
+             * should thus be set higher than epsilon, otherwise the
+             * algorithm will always run for the whole horizon.
+             *
+             * @param e The new epsilon parameter.
+             */
+            void setEpsilon(double e);
+
+            /**
+             * @brief This function returns the currently set epsilon parameter.
+             *
+             * @return The currently set epsilon parameter.
+             */
+            double getEpsilon() const;
+
+            /**
+             * @brief This function sets whether near-duplicate alphavectors are merged.
+             *
+             * When enabled and epsilon is positive, the final prune first
+             * removes alphavectors which are within epsilon/2 of another in
+             * every state, without solving any LP, and then uses the other
+             * half of epsilon for the LPs. The total loss per timestep is
+             * still at most epsilon. This has no effect when epsilon is 0.0.
+             *
+             * @param m Whether to merge near-duplicates.
+             */
+            void setMergeDuplicates(bool m);
+
+            /**
+             * @brief This function returns whether near-duplicate alphavectors are merged.
+             *
+             * @return Whether near-duplicates are merged in the final prune.
+             */
+            bool getMergeDuplicates() const;
+
             /**
              * @brief This function returns the currently set horizon parameter.
              *
@@ -105,15 +163,45 @@ namespace AIToolbox::POMDP {
              * solvers). It solves a series of LPs trying to find all possible
              * beliefs where an alphavector has not yet been found.
              *
+             * A previous solution can be used to warm-start the process,
+             * in which case the horizon counts the timesteps computed on
+             * top of it. This is useful to re-solve a model after a small
+             * change in its parameters, as the old solution is generally
+             * already close to the new one.
+             *
+             * The witness beliefs of a previous run (see
+             * getWitnessBeliefs()) can also be passed. The best
+             * alphavectors at these beliefs are added before searching
+             * for new witnesses with the LP, so that when the new
+             * solution is similar to the old one most LPs only need to
+             * confirm that no witness is left.
+             *
+             * Both the starting ValueFunction and the witnesses are checked
+             * against the model (see checkWarmStart()); if their sizes do
+             * not match, this function will throw an std::invalid_argument.
+             *
              * @tparam M The type of POMDP model that needs to be solved.
              *
              * @param model The POMDP model that needs to be solved.
+             * @param v The ValueFunction to startup the process from, if needed.
+             * @param witnesses The beliefs to seed the search with, if needed.
              *
              * @return A tuple containing the maximum variation for the
              *         ValueFunction and the computed ValueFunction.
              */
             template <typename M, typename = std::enable_if_t<is_model_v<M>>>
-            std::tuple<double, ValueFunction> operator()(const M & model);
+            std::tuple<double, ValueFunction> operator()(const M & model, ValueFunction v = {}, std::vector<Belief> witnesses = {});
+
+            /**
+             * @brief This function returns the witness beliefs of the last solved timestep.
+             *
+             * These are the beliefs which identified the alphavectors
+             * found in the last timestep computed by operator()(). They
+             * can be passed to a later call to warm-start it.
+             *
+             * @return The witness beliefs of the last run.
+             */
+            const std::vector<Belief> & getWitnessBeliefs() const;
 
         private:
             /**
@@ -136,20 +224,26 @@ namespace AIToolbox::POMDP {
             size_t S, A, O;
             unsigned horizon_;
             double tolerance_;
+            double epsilon_;
+            bool merge_;
 
             std::vector<MDP::Values> agenda_;
             std::unordered_set<VObs, boost::hash<VObs>> triedVectors_;
+
+            std::vector<Belief> witnesses_;
     };
 
     template <typename M, typename>
-    std::tuple<double, ValueFunction> Witness::operator()(const M& model) {
+    std::tuple<double, ValueFunction> Witness::operator()(const M& model, ValueFunction v, std::vector<Belief> witnesses) {
         S = model.getS();
         A = model.getA();
         O = model.getO();
 
         std::vector<VList> U(A);
 
-        auto v = makeValueFunction(S); // TODO: May take user input
+        checkWarmStart(S, v, witnesses);
+        if ( v.size() == 0 )
+            v = makeValueFunction(S);
 
         unsigned timestep = 0;
 
@@ -161,7 +255,7 @@ namespace AIToolbox::POMDP {
         size_t reserveSize = 1;
 
         Projecter project(model);
-        Pruner prune(S);
+        Pruner prune(S, epsilon_, merge_);
         WitnessLP lp(S);
 
         const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
@@ -170,12 +264,18 @@ namespace AIToolbox::POMDP {
             ++timestep;
 
             // As default, we allocate double the numbers of VEntries for last step.
-            reserveSize = std::max(reserveSize, 2 * v[timestep-1].size());
+            reserveSize = std::max(reserveSize, 2 * v.back().size());
             // Compute all possible outcomes, from our previous results.
             // This means that for each action-observation pair, we are going
             // to obtain the same number of possible outcomes as the number
             // of entries in our initial vector w.
-            auto projections = project(v[timestep-1]);
+            auto projections = project(v.back());
+
+            prune.setSeedPoints(witnesses);
+
+            // Here we collect the witnesses for the next timestep.
+            std::vector<Belief> newWitnesses;
+            std::vector<bool> usedSeeds(witnesses.size(), false);
 
             size_t finalWSize = 0;
             for ( size_t a = 0; a < A; ++a ) {
@@ -187,6 +287,31 @@ namespace AIToolbox::POMDP {
 
                 lp.allocate(reserveSize);
 
+                // Adds the best VEntry at a witness point to the solution
+                // and the LP, and its variations to the agenda.
+                const auto addBest = [&](VEntry entry) {
+                    triedVectors_.insert(entry.observations);
+                    U[a].push_back(std::move(entry));
+                    lp.addOptimalRow(U[a].back().values);
+                    // We add to the agenda all possible "variations" of the VEntry found.
+                    addVariations(projections[a], U[a].back());
+                    // We manually check memory for the lp, since this method
+                    // cannot know in advance how many rows it'll need to do.
+                    if ( ++counter == reserveSize ) {
+                        reserveSize *= 2;
+                        lp.allocate(reserveSize);
+                    }
+                };
+
+                // The best vectors at the seed witnesses are guaranteed to
+                // be useful, so we add them without checking with the LP.
+                for ( size_t i = 0; i < witnesses.size(); ++i ) {
+                    auto entry = crossSumBestAtBelief(witnesses[i], projections[a], a);
+                    if ( triedVectors_.find(entry.observations) != std::end(triedVectors_) ) continue;
+                    usedSeeds[i] = true;
+                    addBest(std::move(entry));
+                }
+
                 // We add the VEntry to startoff the whole process. This
                 // VEntry does not even need to be optimal, as we are going
                 // to compute the optimal one for the witness point anyway.
@@ -197,16 +322,8 @@ namespace AIToolbox::POMDP {
                     const auto witness = lp.findWitness(agenda_.back());
                     if ( witness ) {
                         // If so, we generate the best vector for that particular belief point.
-                        U[a].push_back(crossSumBestAtBelief(*witness, projections[a], a));
-                        lp.addOptimalRow(U[a].back().values);
-                        // We add to the agenda all possible "variations" of the VEntry found.
-                        addVariations(projections[a], U[a].back());
-                        // We manually check memory for the lp, since this method
-                        // cannot know in advance how many rows it'll need to do.
-                        if ( ++counter == reserveSize ) {
-                            reserveSize *= 2;
-                            lp.allocate(reserveSize);
-                        }
+                        addBest(crossSumBestAtBelief(*witness, projections[a], a));
+                        newWitnesses.push_back(*witness);
                     }
                     else
                         agenda_.pop_back();
@@ -228,11 +345,18 @@ namespace AIToolbox::POMDP {
 
             v.emplace_back(std::move(w));
 
-            // Check convergence
+            for ( size_t i = 0; i < witnesses.size(); ++i )
+                if ( usedSeeds[i] )
+                    newWitnesses.push_back(std::move(witnesses[i]));
+            witnesses = std::move(newWitnesses);
+
+            // Check convergence, accounting for the error introduced by
+            // approximate pruning.
             if ( useTolerance ) {
-                variation = weakBoundDistance(v[timestep-1], v[timestep]);
+                variation = weakBoundDistance(v[v.size()-2], v.back()) + epsilon_;
             }
         }
+        witnesses_ = std::move(witnesses);
 
         return std::make_tuple(useTolerance ? variation : 0.0, v);
     }
@@ -0,0 +1,181 @@
+#ifndef AI_TOOLBOX_POMDP_EVALUATION_HEADER_FILE
+#define AI_TOOLBOX_POMDP_EVALUATION_HEADER_FILE
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/TypeTraits.hpp>
+#include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/Utils/Evaluation.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
+
+namespace AIToolbox::POMDP {
+    /**
+     * @brief This function estimates the value of an agent by running episodes on a model.
+     *
+     * This function runs the input number of episodes, each starting from
+     * a state sampled from the input belief and lasting until a terminal
+     * state is reached or until the horizon runs out. It reports the mean
+     * discounted return over all episodes, its 95% confidence interval,
+     * and the average time taken by the agent to select each action.
+     *
+     * The agent can be one of three kinds:
+     *
+     * - A policy with a `size_t sampleAction(const Belief & b)` method,
+     *   like POMDP::PolicyGraph. Policies are given the belief of the
+     *   agent, which is kept updated after each step; this requires the
+     *   model to satisfy is_model.
+     * - A finite horizon policy, like POMDP::Policy. These are called with
+     *   sampleAction(b, horizon) on the first step of each episode, and
+     *   then with sampleAction(id, o, horizon), following the ids they
+     *   return. The horizon must then not exceed the one of the policy.
+     * - An online planner like POMCP. These track their own beliefs: they
+     *   are called with sampleAction(b, horizon) on the first step of each
+     *   episode, and with sampleAction(a, o, horizon) afterwards.
+     *
+     * In the last two cases, horizon is the number of steps remaining in
+     * the episode.
+     *
+     * Agents are built by calling makeAgent(worker) once for each worker
+     * of the Executor, before any episode is run; each agent is then only
+     * used by the worker with the same index within this call, in
+     * sequence, even if other threads are using the same Executor. Since agents (and models) own
+     * their random engines, agents which keep a reference to a model to
+     * sample it (like POMCP) must each be given their own copy of it.
+     *
+     * If the model satisfies is_model, episodes are run in parallel, and
+     * the model is only read: transitions and observations are sampled
+     * with the RandomEngine of each worker. Models like Model and
+     * SparseModel are sampled through their sampleSOR(s, a, rnd); for
+     * the others the next state and observation are drawn from the model
+     * probabilities, and rewards are the expected rewards of each
+     * transition. Each worker updates its beliefs in
+     * place in its own preallocated buffers, so that no memory is
+     * allocated during the episodes. In deterministic mode, together with
+     * Impl::Seeder::setRootSeed(), this makes the results reproducible.
+     *
+     * Otherwise, the model can only be sampled through its own
+     * sampleSOR(), which is not thread-safe, so all episodes are run
+     * serially on the calling thread, with a single agent.
+     *
+     * @tparam M The type of the model to evaluate the agent on.
+     * @tparam MakeAgent The type of the function building the agents.
+     * @param model The model to evaluate the agent on.
+     * @param makeAgent A function taking a worker index and returning an agent.
+     * @param b The belief each episode starts from.
+     * @param episodes The number of episodes to run.
+     * @param horizon The maximum number of steps of each episode.
+     * @param e The Executor used to run the episodes.
+     *
+     * @return The results of the evaluation.
+     */
+    template <typename M, typename MakeAgent, typename = std::enable_if_t<is_generative_model_v<M>>>
+    EvaluationResults evaluatePolicy(const M & model, MakeAgent makeAgent, const Belief & b, size_t episodes, unsigned horizon, Executor & e = *Executor::getDefault()) {
+        using Agent = std::decay_t<decltype(makeAgent(0u))>;
+        using Clock = std::chrono::steady_clock;
+
+        constexpr bool online = Impl::is_online_planner_v<Agent>;
+        constexpr bool finite = Impl::is_horizon_policy_v<Agent>;
+        constexpr bool tracking = !online && !finite;
+        static_assert(!tracking || is_model_v<M>, "Evaluating a POMDP policy on beliefs requires a model able to update them.");
+
+        const size_t S = model.getS();
+        if ( static_cast<size_t>(b.size()) != S ) throw std::invalid_argument("The belief given to POMDP::evaluatePolicy has the wrong size.");
+
+        const unsigned workers = is_model_v<M> ? e.getConcurrency() : 1;
+
+        // The agents are built in order on the calling thread, so that
+        // seeds are assigned deterministically.
+        std::vector<std::unique_ptr<Agent>> agents;
+        agents.reserve(workers);
+        for ( unsigned w = 0; w < workers; ++w )
+            agents.emplace_back(new Agent(makeAgent(w)));
+
+        std::vector<double> returns(episodes), seconds(workers, 0.0);
+        std::vector<size_t> steps(workers, 0);
+        std::vector<Belief> beliefs, buffers;
+        if constexpr (tracking) {
+            beliefs.resize(workers, Belief(S));
+            buffers.resize(workers, Belief(S));
+        }
+
+        const auto runEpisode = [&](const size_t i, const unsigned w, const size_t start, auto sampleSOR) {
+            auto & agent = *agents[w];
+            size_t s = start, a = 0, o = 0, id = 0;
+            double ret = 0.0, discount = 1.0;
+            if constexpr (tracking) beliefs[w] = b;
+
+            for ( unsigned t = 0; t < horizon && !model.isTerminal(s); ++t ) {
+                const auto begin = Clock::now();
+                if constexpr (online) {
+                    if ( t == 0 ) a = agent.sampleAction(b, horizon);
+                    else          a = agent.sampleAction(a, o, horizon - t);
+                } else if constexpr (finite) {
+                    if ( t == 0 ) std::tie(a, id) = agent.sampleAction(b, horizon);
+                    else          std::tie(a, id) = agent.sampleAction(id, o, horizon - t);
+                } else {
+                    a = agent.sampleAction(beliefs[w]);
+                }
+                seconds[w] += std::chrono::duration<double>(Clock::now() - begin).count();
+
+                const auto [s1, o1, r] = sampleSOR(s, a);
+                ret += discount * r;
+                discount *= model.getDiscount();
+                s = s1;
+                o = o1;
+                ++steps[w];
+
+                if constexpr (tracking) {
+                    updateBelief(model, beliefs[w], a, o, &buffers[w]);
+                    std::swap(beliefs[w], buffers[w]);
+                }
+            }
+            returns[i] = ret;
+        };
+
+        if constexpr (is_model_v<M>) {
+            // The worker index is given by parallelFor, which guarantees
+            // that no other thread uses it for this call at the same time.
+            e.parallelFor(0, episodes, [&](const size_t i, const unsigned w) {
+                auto & rnd = e.getRandomEngine();
+                const auto start = Impl::sampleIndex(S, [&](const size_t s) { return b[s]; }, rnd);
+                runEpisode(i, w, start, [&](const size_t s, const size_t a) {
+                    if constexpr (Impl::has_engine_sampleSOR_v<M>) {
+                        return model.sampleSOR(s, a, rnd);
+                    } else {
+                        const auto s1 = Impl::sampleIndex(S, [&](const size_t ss) {
+                            return model.getTransitionProbability(s, a, ss);
+                        }, rnd);
+                        const auto o = Impl::sampleIndex(model.getO(), [&](const size_t oo) {
+                            return model.getObservationProbability(s1, a, oo);
+                        }, rnd);
+                        return std::make_tuple(s1, o, model.getExpectedReward(s, a, s1));
+                    }
+                });
+            }, 1);
+        } else {
+            auto & rnd = e.getRandomEngine();
+            for ( size_t i = 0; i < episodes; ++i ) {
+                const auto start = Impl::sampleIndex(S, [&](const size_t s) { return b[s]; }, rnd);
+                runEpisode(i, 0, start, [&](const size_t s, const size_t a) {
+                    return model.sampleSOR(s, a);
+                });
+            }
+        }
+
+        size_t totalSteps = 0;
+        double totalSeconds = 0.0;
+        for ( unsigned w = 0; w < workers; ++w ) {
+            totalSteps += steps[w];
+            totalSeconds += seconds[w];
+        }
+
+        return makeEvaluationResults(std::move(returns), totalSteps, totalSeconds);
+    }
+}
+
+#endif
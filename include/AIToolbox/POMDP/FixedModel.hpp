@@ -0,0 +1,273 @@
+#ifndef AI_TOOLBOX_POMDP_FIXED_MODEL_HEADER_FILE
+#define AI_TOOLBOX_POMDP_FIXED_MODEL_HEADER_FILE
+
+#include <array>
+#include <random>
+
+#include <AIToolbox/Impl/Seeder.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/MDP/FixedModel.hpp>
+#include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/TypeTraits.hpp>
+
+namespace AIToolbox::POMDP {
+    /**
+     * @brief This class represents a POMDP with sizes known at compile time.
+     *
+     * This class is the compile-time sized equivalent of
+     * POMDP::Model<MDP::Model>. It extends MDP::FixedModel with a
+     * fixed-size observation function, so that no part of the model
+     * lives on the heap.
+     *
+     * This class is meant for very small problems (like the tiger
+     * problem), where you need to perform a very large number of belief
+     * updates. When used together with POMDP::FixedBelief, the
+     * updateBelief() family of functions and POMDP::Policy perform no heap
+     * allocations at all, and all products are unrolled by the compiler.
+     *
+     * The class implements the full Eigen POMDP model interface, so it can
+     * be passed to any POMDP algorithm. Note however that the solvers
+     * still store their alphavectors in dynamically sized MDP::Values, as
+     * the number of vectors in a VList is only known at runtime.
+     *
+     * @tparam S The number of states of the world.
+     * @tparam A The number of actions available to the agent.
+     * @tparam O The number of possible observations.
+     */
+    template <size_t S, size_t A, size_t O>
+    class FixedModel : public MDP::FixedModel<S, A> {
+        static_assert(O > 0, "FixedModel needs at least one observation.");
+
+        public:
+            using Base = MDP::FixedModel<S, A>;
+
+            using ObservationMatrix = Eigen::Matrix<double, static_cast<int>(S), static_cast<int>(O),
+                                                    (O == 1 && S != 1) ? Eigen::ColMajor : Eigen::RowMajor>;
+            using ObservationTable  = std::array<ObservationMatrix, A>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor initializes the observation function so
+             * that all actions will return observation 0. The underlying
+             * MDP::FixedModel is initialized with the input discount.
+             *
+             * @param discount The discount factor for the POMDP.
+             */
+            FixedModel(double discount = 1.0);
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor takes three arbitrary three dimensional
+             * containers and copies their contents into the observation,
+             * transition and reward tables respectively.
+             *
+             * The containers need to support data access through
+             * operator[]. The observation container must have dimensions
+             * S,A,O, while the other two must have dimensions S,A,S.
+             *
+             * This constructor will throw an std::invalid_argument if
+             * either the observation or the transition function do not
+             * contain valid probabilities.
+             *
+             * @tparam ObFun The external observations container type.
+             * @tparam T The external transition container type.
+             * @tparam R The external rewards container type.
+             * @param of The observation probability table.
+             * @param t The external transitions container.
+             * @param r The external rewards container.
+             * @param d The discount factor for the POMDP.
+             */
+            template <typename ObFun, typename T, typename R>
+            FixedModel(const ObFun & of, const T & t, const R & r, double d = 1.0);
+
+            /**
+             * @brief Copy constructor from any valid POMDP model.
+             *
+             * The input model must have exactly S states, A actions and O
+             * observations, otherwise the constructor will throw an
+             * std::invalid_argument.
+             *
+             * @tparam PM The type of the other model.
+             * @param model The model that needs to be copied.
+             */
+            template <typename PM, typename = std::enable_if_t<is_model_v<PM>>>
+            FixedModel(const PM& model);
+
+            /**
+             * @brief Unchecked constructor.
+             *
+             * This constructor takes ownership of the data that it is
+             * passed to it, and does not perform any sanity checks.
+             *
+             * Note that to use it you have to explicitly use the NO_CHECK
+             * tag parameter first.
+             *
+             * @param ot The observation function to be used in the FixedModel.
+             * @param t The transition function to be used in the FixedModel.
+             * @param r The reward function to be used in the FixedModel.
+             * @param d The discount factor for the FixedModel.
+             */
+            FixedModel(NoCheck, ObservationTable && ot, typename Base::TransitionTable && t, typename Base::RewardTable && r, double d);
+
+            /**
+             * @brief This function replaces the observation function with the one provided.
+             *
+             * The container needs to support data access through
+             * operator[], and its dimensions must be S,A,O.
+             *
+             * This function will throw a std::invalid_argument if the
+             * table provided does not contain valid probabilities.
+             *
+             * @tparam ObFun The external observations container type.
+             * @param of The external observations container.
+             */
+            template <typename ObFun>
+            void setObservationFunction(const ObFun & of);
+
+            /**
+             * @brief This function samples the POMDP for the specified state action pair.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             *
+             * @return A tuple containing a new state, observation and reward.
+             */
+            std::tuple<size_t, size_t, double> sampleSOR(size_t s, size_t a) const;
+
+            /**
+             * @brief This function samples the POMDP for the specified state action pair.
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param s1 The resulting state of the s,a transition.
+             *
+             * @return A tuple containing a new observation and reward.
+             */
+            std::tuple<size_t, double> sampleOR(size_t s, size_t a, size_t s1) const;
+
+            /**
+             * @brief This function returns the stored observation probability for the specified state-action pair.
+             *
+             * @param s1 The final state of the transition.
+             * @param a The action performed in the transition.
+             * @param o The recorded observation for the transition.
+             *
+             * @return The probability of the specified observation.
+             */
+            double getObservationProbability(size_t s1, size_t a, size_t o) const;
+
+            /**
+             * @brief This function returns the observation function for a given action.
+             *
+             * @param a The action requested.
+             *
+             * @return The observation function for the input action.
+             */
+            const ObservationMatrix & getObservationFunction(size_t a) const;
+
+            /**
+             * @brief This function returns the number of observations possible.
+             *
+             * @return The total number of observations.
+             */
+            constexpr size_t getO() const { return O; }
+
+            /**
+             * @brief This function returns the observation table for inspection.
+             *
+             * @return The observation table.
+             */
+            const ObservationTable & getObservationFunction() const;
+
+        private:
+            ObservationTable observations_;
+            mutable RandomEngine rand_;
+    };
+
+    template <size_t S, size_t A, size_t O>
+    FixedModel<S, A, O>::FixedModel(const double discount) :
+            Base(discount), rand_(Impl::Seeder::getSeed())
+    {
+        for ( auto & o : observations_ ) {
+            o.setZero();
+            o.col(0).fill(1.0);
+        }
+    }
+
+    template <size_t S, size_t A, size_t O>
+    template <typename ObFun, typename T, typename R>
+    FixedModel<S, A, O>::FixedModel(const ObFun & of, const T & t, const R & r, const double d) :
+            Base(t, r, d), rand_(Impl::Seeder::getSeed())
+    {
+        setObservationFunction(of);
+    }
+
+    template <size_t S, size_t A, size_t O>
+    template <typename PM, typename>
+    FixedModel<S, A, O>::FixedModel(const PM& model) :
+            Base(model), rand_(Impl::Seeder::getSeed())
+    {
+        if ( model.getO() != O )
+            throw std::invalid_argument("Input model does not have the same size as the FixedModel.");
+
+        for ( size_t a = 0; a < A; ++a )
+            for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                for ( size_t o = 0; o < O; ++o )
+                    observations_[a](s1, o) = model.getObservationProbability(s1, a, o);
+
+                if ( ! isProbability(O, observations_[a].row(s1)) ) throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+            }
+    }
+
+    template <size_t S, size_t A, size_t O>
+    FixedModel<S, A, O>::FixedModel(NoCheck, ObservationTable && ot, typename Base::TransitionTable && t, typename Base::RewardTable && r, const double d) :
+            Base(NO_CHECK, std::move(t), std::move(r), d), observations_(std::move(ot)),
+            rand_(Impl::Seeder::getSeed()) {}
+
+    template <size_t S, size_t A, size_t O>
+    template <typename ObFun>
+    void FixedModel<S, A, O>::setObservationFunction(const ObFun & of) {
+        for ( size_t s1 = 0; s1 < S; ++s1 )
+            for ( size_t a = 0; a < A; ++a )
+                if ( ! isProbability(O, of[s1][a]) ) throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+
+        for ( size_t s1 = 0; s1 < S; ++s1 )
+            for ( size_t a = 0; a < A; ++a )
+                for ( size_t o = 0; o < O; ++o )
+                    observations_[a](s1, o) = of[s1][a][o];
+    }
+
+    template <size_t S, size_t A, size_t O>
+    std::tuple<size_t, size_t, double> FixedModel<S, A, O>::sampleSOR(const size_t s, const size_t a) const {
+        const auto [s1, r] = this->sampleSR(s, a);
+        const auto o = sampleProbability(O, observations_[a].row(s1), rand_);
+        return std::make_tuple(s1, o, r);
+    }
+
+    template <size_t S, size_t A, size_t O>
+    std::tuple<size_t, double> FixedModel<S, A, O>::sampleOR(const size_t s, const size_t a, const size_t s1) const {
+        const size_t o = sampleProbability(O, observations_[a].row(s1), rand_);
+        const double r = this->getExpectedReward(s, a, s1);
+        return std::make_tuple(o, r);
+    }
+
+    template <size_t S, size_t A, size_t O>
+    double FixedModel<S, A, O>::getObservationProbability(const size_t s1, const size_t a, const size_t o) const {
+        return observations_[a](s1, o);
+    }
+
+    template <size_t S, size_t A, size_t O>
+    const typename FixedModel<S, A, O>::ObservationMatrix & FixedModel<S, A, O>::getObservationFunction(const size_t a) const {
+        return observations_[a];
+    }
+
+    template <size_t S, size_t A, size_t O>
+    const typename FixedModel<S, A, O>::ObservationTable & FixedModel<S, A, O>::getObservationFunction() const {
+        return observations_;
+    }
+}
+
+#endif
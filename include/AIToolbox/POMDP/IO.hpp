@@ -178,6 +178,41 @@ namespace AIToolbox::POMDP {
      * @return The original stream.
      */
     std::ostream& operator<<(std::ostream &os, const Policy & p);
+
+    class PolicyGraph;
+    /**
+     * @brief This function writes a PolicyGraph to a binary stream.
+     *
+     * The output contains a short header with the sizes of the graph,
+     * followed by the node actions and links as 32 bit integers, and by
+     * the alpha vectors used to select the starting node. The data is
+     * written in the native byte order, so the output can only be read
+     * back on a machine with the same endianness.
+     *
+     * The stream should be opened in binary mode.
+     *
+     * @param os The stream where the graph is written.
+     * @param p The graph to write.
+     *
+     * @return The original stream.
+     */
+    std::ostream& writeBinary(std::ostream &os, const PolicyGraph & p);
+
+    /**
+     * @brief This function reads a PolicyGraph from a binary stream.
+     *
+     * This function reads streams produced by writeBinary(). The number of
+     * states, actions and observations in the stream must match the ones
+     * of the input graph, and all links must be valid. If not, or if not
+     * enough data can be read, the function sets the failbit of the
+     * stream and the input graph is not modified.
+     *
+     * @param is The stream were the graph is being read from.
+     * @param p The graph that is being assigned.
+     *
+     * @return The input stream.
+     */
+    std::istream& readBinary(std::istream &is, PolicyGraph & p);
 }
 
 #endif
@@ -195,6 +195,25 @@ namespace AIToolbox::POMDP {
              */
             std::tuple<size_t,size_t, double> sampleSOR(size_t s,size_t a) const;
 
+            /**
+             * @brief This function samples the POMDP for the specified state action pair, with the input RandomEngine.
+             *
+             * This function is equivalent to sampleSOR(size_t, size_t),
+             * but it does not use the RandomEngines of the model. Since it
+             * does not modify the model, it can be called concurrently by
+             * multiple threads, as long as each uses its own engine.
+             *
+             * This function is only available if the underlying MDP model
+             * provides sampleSR(size_t, size_t, RandomEngine &).
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The RandomEngine to sample with.
+             *
+             * @return A tuple containing a new state, observation and reward.
+             */
+            std::tuple<size_t,size_t, double> sampleSOR(size_t s,size_t a, RandomEngine & rnd) const;
+
             /**
              * @brief This function samples the POMDP for the specified state action pair.
              *
@@ -340,6 +359,13 @@ namespace AIToolbox::POMDP {
         return std::make_tuple(s1, o, r);
     }
 
+    template <typename M>
+    std::tuple<size_t,size_t, double> Model<M>::sampleSOR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        const auto [s1, r] = this->sampleSR(s, a, rnd);
+        const auto o = sampleProbability(O, observations_[a].row(s1), rnd);
+        return std::make_tuple(s1, o, r);
+    }
+
     template <typename M>
     std::tuple<size_t, double> Model<M>::sampleOR(const size_t s, const size_t a, const size_t s1) const {
         const size_t o = sampleProbability(O, observations_[a].row(s1), rand_);
@@ -4,6 +4,7 @@
 #include <tuple>
 
 #include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/Utils.hpp>
 #include <AIToolbox/PolicyInterface.hpp>
 
 namespace AIToolbox::POMDP {
@@ -94,6 +95,66 @@ namespace AIToolbox::POMDP {
              */
             std::tuple<size_t, size_t> sampleAction(const Belief & b, unsigned horizon) const;
 
+            /**
+             * @brief This function chooses an action for a fixed-size belief b.
+             *
+             * This overload works as sampleAction(const Belief &), but
+             * accepts beliefs whose size is known at compile time (see
+             * FixedBelief), without converting them to a Belief first.
+             *
+             * @tparam N The number of states of the belief.
+             * @param b The sampled belief of the policy.
+             *
+             * @return The chosen action.
+             */
+            template <int N, typename = std::enable_if_t<N != Eigen::Dynamic>>
+            size_t sampleAction(const Eigen::Matrix<double, N, 1> & b) const;
+
+            /**
+             * @brief This function chooses an action for a fixed-size belief b when horizon steps are missing.
+             *
+             * This overload works as sampleAction(const Belief &, unsigned),
+             * but accepts beliefs whose size is known at compile time (see
+             * FixedBelief), without converting them to a Belief first.
+             *
+             * @tparam N The number of states of the belief.
+             * @param b The sampled belief of the policy.
+             * @param horizon The requested horizon.
+             *
+             * @return A tuple containing the chosen action, plus an id useful to sample an action
+             * more efficiently at the next timestep, if required.
+             */
+            template <int N, typename = std::enable_if_t<N != Eigen::Dynamic>>
+            std::tuple<size_t, size_t> sampleAction(const Eigen::Matrix<double, N, 1> & b, unsigned horizon) const;
+
+            /**
+             * @brief This function chooses an action for a sparse belief b.
+             *
+             * This overload works as sampleAction(const Belief &), but
+             * only looks at the support of the belief to compute the
+             * values of the alpha vectors.
+             *
+             * @param b The sampled belief of the policy.
+             *
+             * @return The chosen action.
+             */
+            size_t sampleAction(const SparseBelief & b) const;
+
+            /**
+             * @brief This function chooses an action for a sparse belief b when horizon steps are missing.
+             *
+             * This overload works as sampleAction(const Belief &, unsigned),
+             * but only looks at the support of the belief to compute the
+             * values of the alpha vectors.
+             *
+             * @param b The sampled belief of the policy.
+             * @param horizon The requested horizon.
+             *
+             * @return A tuple containing the chosen action, plus an id useful to sample an action
+             * more efficiently at the next timestep, if required.
+             */
+            std::tuple<size_t, size_t> sampleAction(const SparseBelief & b, unsigned horizon) const;
+
             /**
              * @brief This function chooses a random action after performing a sampled action and observing observation o, for a particular horizon.
              *
@@ -191,6 +252,17 @@ namespace AIToolbox::POMDP {
             const ValueFunction & getValueFunction() const;
 
         private:
+            /**
+             * @brief This function finds the best VEntry in a VList for the input belief.
+             *
+             * @param b The belief to look for.
+             * @param horizon The horizon of the VList to search in.
+             *
+             * @return A tuple containing the action and the id of the best VEntry.
+             */
+            template <typename B>
+            std::tuple<size_t, size_t> findBestEntry(const B & b, unsigned horizon) const;
+
             // H holds the available max horizon for this Policy.
             size_t O, H;
 
@@ -198,6 +270,30 @@ namespace AIToolbox::POMDP {
 
             friend std::istream& operator>>(std::istream &is, Policy & p);
     };
+
+    template <typename B>
+    std::tuple<size_t, size_t> Policy::findBestEntry(const B & b, const unsigned horizon) const {
+        const auto & vlist = policy_[horizon];
+
+        const auto begin = boost::make_transform_iterator(std::begin(vlist), unwrap);
+        const auto end   = boost::make_transform_iterator(std::end  (vlist), unwrap);
+        const auto bestMatch = findBestAtPoint(b, begin, end);
+
+        const size_t action = bestMatch.base()->action;
+        const size_t id     = std::distance(begin, bestMatch);
+
+        return std::make_tuple(action, id);
+    }
+
+    template <int N, typename>
+    size_t Policy::sampleAction(const Eigen::Matrix<double, N, 1> & b) const {
+        return std::get<0>(findBestEntry(b, H));
+    }
+
+    template <int N, typename>
+    std::tuple<size_t, size_t> Policy::sampleAction(const Eigen::Matrix<double, N, 1> & b, const unsigned horizon) const {
+        return findBestEntry(b, horizon);
+    }
 }
 
 #endif
@@ -0,0 +1,162 @@
+#ifndef AI_TOOLBOX_POMDP_POLICY_GRAPH_HEADER_FILE
+#define AI_TOOLBOX_POMDP_POLICY_GRAPH_HEADER_FILE
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/Policies/Policy.hpp>
+#include <AIToolbox/PolicyInterface.hpp>
+
+namespace AIToolbox::POMDP {
+    /**
+     * @brief This class represents a POMDP Policy as a minimal finite-state controller.
+     *
+     * A POMDP::Policy stores a full ValueFunction, with one list of alpha
+     * vectors per horizon. To act, it only needs the action of each entry
+     * and the entries it links to for each observation; the values are
+     * used just to pick the first entry from a belief. For long horizons
+     * this wastes a lot of memory, as many entries induce exactly the
+     * same behaviour.
+     *
+     * This class converts a Policy into a policy graph: each node has an
+     * action and a successor node for each observation. The graph is then
+     * minimized (in the same way as a deterministic automaton) so that
+     * all nodes with the same action and equivalent successors are
+     * merged. Only the alpha vectors of the highest horizon are kept, to
+     * select the starting node from a belief; afterwards the policy is
+     * executed purely by following links, in O(1) per step.
+     *
+     * If the ValueFunction has converged, so that two consecutive horizons
+     * contain the same entries (up to a tolerance), the graph is made
+     * stationary: the entries of the converged horizon link to each
+     * other, and the resulting controller can be executed forever.
+     * Otherwise the graph follows the horizons of the Policy, and after
+     * getH() steps it reaches a terminal node, which has no action.
+     *
+     * The graph can be written to and read from a compact binary stream
+     * (see writeBinary() and readBinary() in POMDP/IO.hpp).
+     */
+    class PolicyGraph : public PolicyInterface<size_t, Belief, size_t> {
+        public:
+            using Base = PolicyInterface<size_t, Belief, size_t>;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor creates a stationary graph with a single
+             * node, which always selects action 0. This is most useful
+             * if the graph needs to be read from a stream.
+             *
+             * @param s The number of states of the world.
+             * @param a The number of actions available to the agent.
+             * @param o The number of possible observations the agent could make.
+             */
+            PolicyGraph(size_t s, size_t a, size_t o);
+
+            /**
+             * @brief Basic constructor.
+             *
+             * This constructor converts the input Policy into a minimal
+             * policy graph.
+             *
+             * Two consecutive horizons are considered equal when each
+             * entry of the lower one has an entry in the higher one with
+             * the same action and values within the input tolerance. A
+             * negative tolerance disables this check, so that the graph
+             * always follows the horizons of the Policy.
+             *
+             * If the Policy has horizon 0, this constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param p The Policy to convert.
+             * @param tolerance The tolerance used to detect convergence.
+             */
+            PolicyGraph(const Policy & p, double tolerance = 1e-9);
+
+            /**
+             * @brief This function returns the best starting node for the input belief.
+             *
+             * @param b The belief the agent starts from.
+             *
+             * @return The id of the starting node.
+             */
+            size_t getStartNode(const Belief & b) const;
+
+            /**
+             * @brief This function returns the action of a node.
+             *
+             * @param node The id of the node.
+             *
+             * @return The action of the node, or getA() for the terminal node.
+             */
+            size_t getAction(size_t node) const;
+
+            /**
+             * @brief This function returns the node reached from a node after an observation.
+             *
+             * @param node The id of the current node.
+             * @param o The observation obtained after performing the action of the node.
+             *
+             * @return The id of the next node.
+             */
+            size_t getNextNode(size_t node, size_t o) const;
+
+            /**
+             * @brief This function chooses the action for the starting node of the input belief.
+             *
+             * @param b The belief the agent starts from.
+             *
+             * @return The chosen action.
+             */
+            virtual size_t sampleAction(const Belief & b) const override;
+
+            /**
+             * @brief This function returns the probability of taking the specified action in the specified belief.
+             *
+             * @param b The selected belief.
+             * @param a The selected action.
+             *
+             * @return 1.0 if the action is the one of the starting node for the belief, 0.0 otherwise.
+             */
+            virtual double getActionProbability(const Belief & b, const size_t & a) const override;
+
+            /**
+             * @brief This function returns the number of nodes in the graph.
+             *
+             * @return The number of nodes, including the terminal one if present.
+             */
+            size_t getNodesNumber() const;
+
+            /**
+             * @brief This function returns whether the graph can be executed forever.
+             *
+             * @return True if the graph has no terminal node.
+             */
+            bool isStationary() const;
+
+            /**
+             * @brief This function returns the number of observations possible for the agent.
+             *
+             * @return The total number of observations.
+             */
+            size_t getO() const;
+
+        private:
+            friend std::ostream& writeBinary(std::ostream &os, const PolicyGraph & p);
+            friend std::istream& readBinary(std::istream &is, PolicyGraph & p);
+
+            size_t O;
+            bool stationary_;
+
+            // Node data; successors are stored in blocks of O per node.
+            std::vector<std::uint32_t> actions_, successors_;
+
+            // Alpha vectors used to select the starting node.
+            Matrix2D startValues_;
+            std::vector<std::uint32_t> startNodes_;
+    };
+}
+
+#endif
@@ -6,6 +6,7 @@
 #include <AIToolbox/Impl/Seeder.hpp>
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
 #include <AIToolbox/MDP/Types.hpp>
 #include <AIToolbox/MDP/TypeTraits.hpp>
 #include <AIToolbox/POMDP/Types.hpp>
@@ -184,6 +185,36 @@ namespace AIToolbox::POMDP {
             template <typename ObFun>
             void setObservationFunction(const ObFun & of);
 
+            /**
+             * @brief This function sets the observation function from already built Eigen sparse matrices, without copying them.
+             *
+             * The input must contain A matrices of size S x O. This
+             * function will throw a std::invalid_argument if they do not,
+             * if any column index is out of range, or if they do not
+             * contain valid probabilities. The check runs in time linear
+             * in the non-zero entries, with the rows split across the
+             * default Executor (see Executor::getDefault()).
+             *
+             * @param ot The external observations container.
+             */
+            void setObservationFunction(ObservationTable && ot);
+
+            /**
+             * @brief This function sets the observation function from triplets.
+             *
+             * The input must contain, for each action, the (s1, o,
+             * probability) entries of the observation function. Duplicate
+             * entries are summed. Building the function this way takes
+             * time linear in the number of entries, rather than S*A*O.
+             *
+             * This function will throw a std::invalid_argument if the
+             * input does not contain A lists, if any triplet is out of
+             * range, or if it does not describe valid probabilities.
+             *
+             * @param of The observation triplets for each action.
+             */
+            void setObservationFunction(const std::vector<SparseTriplets> & of);
+
             /**
              * @brief This function samples the POMDP for the specified state action pair.
              *
@@ -205,6 +236,25 @@ namespace AIToolbox::POMDP {
              */
             std::tuple<size_t,size_t, double> sampleSOR(size_t s,size_t a) const;
 
+            /**
+             * @brief This function samples the POMDP for the specified state action pair, with the input RandomEngine.
+             *
+             * This function is equivalent to sampleSOR(size_t, size_t),
+             * but it does not use the RandomEngines of the model. Since it
+             * does not modify the model, it can be called concurrently by
+             * multiple threads, as long as each uses its own engine.
+             *
+             * This function is only available if the underlying MDP model
+             * provides sampleSR(size_t, size_t, RandomEngine &).
+             *
+             * @param s The state that needs to be sampled.
+             * @param a The action that needs to be sampled.
+             * @param rnd The RandomEngine to sample with.
+             *
+             * @return A tuple containing a new state, observation and reward.
+             */
+            std::tuple<size_t,size_t, double> sampleSOR(size_t s,size_t a, RandomEngine & rnd) const;
+
             /**
              * @brief This function samples the POMDP for the specified state action pair.
              *
@@ -269,6 +319,13 @@ namespace AIToolbox::POMDP {
             const ObservationTable & getObservationFunction() const;
 
         private:
+            /**
+             * @brief This function verifies that the input table contains valid probabilities.
+             *
+             * @param ot The observation table to check.
+             */
+            void checkObservationFunction(const ObservationTable & ot) const;
+
             size_t O;
             ObservationTable observations_;
             // We need this because we don't know if our parent already has one,
@@ -313,6 +370,20 @@ namespace AIToolbox::POMDP {
             M(model), O(model.getO()), observations_(this->getA(), SparseMatrix2D(this->getS(), O)),
             rand_(Impl::Seeder::getSeed())
     {
+        if constexpr(is_model_eigen_v<PM>) {
+            using OM = remove_cv_ref_t<decltype(model.getObservationFunction(0))>;
+            if constexpr(std::is_base_of_v<Eigen::SparseMatrixBase<OM>, OM>) {
+                // Sparse models can be copied directly, without looking at
+                // all S*A*O entries.
+                for ( size_t a = 0; a < this->getA(); ++a ) {
+                    observations_[a] = model.getObservationFunction(a).template cast<double>();
+                    observations_[a].prune(0.0);
+                    observations_[a].makeCompressed();
+                }
+                checkObservationFunction(observations_);
+                return;
+            }
+        }
         for ( size_t a = 0; a < this->getA(); ++a ) {
             for ( size_t s1 = 0; s1 < this->getS(); ++s1 ) {
                 for ( size_t o = 0; o < O; ++o ) {
@@ -345,6 +416,59 @@ namespace AIToolbox::POMDP {
             observations_[a].makeCompressed();
     }
 
+    template <typename M>
+    void SparseModel<M>::checkObservationFunction(const ObservationTable & ot) const {
+        if ( ot.size() != this->getA() )
+            throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+
+        for ( const auto & m : ot )
+            if ( static_cast<size_t>(m.rows()) != this->getS() || static_cast<size_t>(m.cols()) != O )
+                throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+
+        // As in MDP::SparseModel, rows are checked in parallel and the abs
+        // sum catches negative entries.
+        const size_t S = this->getS();
+        const auto executor = Executor::getDefault();
+        executor->parallelFor(0, this->getA() * S, [&](const size_t i) {
+            const size_t a = i / S, s1 = i % S;
+            double sum = 0.0, absSum = 0.0;
+            for ( SparseMatrix2D::InnerIterator it(ot[a], s1); it; ++it ) {
+                if ( it.col() < 0 || static_cast<size_t>(it.col()) >= O )
+                    throw std::invalid_argument("Input observation table contains out of range indices.");
+                sum += it.value();
+                absSum += std::abs(it.value());
+            }
+            if ( !checkEqualSmall(1.0, sum) || !checkEqualSmall(1.0, absSum) )
+                throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+        });
+    }
+
+    template <typename M>
+    void SparseModel<M>::setObservationFunction(ObservationTable && ot) {
+        checkObservationFunction(ot);
+        observations_ = std::move(ot);
+        for ( auto & m : observations_ )
+            m.makeCompressed();
+    }
+
+    template <typename M>
+    void SparseModel<M>::setObservationFunction(const std::vector<SparseTriplets> & of) {
+        if ( of.size() != this->getA() )
+            throw std::invalid_argument("Input observation table does not contain valid probabilities.");
+
+        ObservationTable table(this->getA(), SparseMatrix2D(this->getS(), O));
+        for ( size_t a = 0; a < this->getA(); ++a ) {
+            // Eigen only asserts on the indices, so we check them here as
+            // out of range triplets would corrupt the matrix.
+            for ( const auto & tr : of[a] )
+                if ( tr.row() < 0 || static_cast<size_t>(tr.row()) >= this->getS() || tr.col() < 0 || static_cast<size_t>(tr.col()) >= O )
+                    throw std::invalid_argument("Input triplets contain out of range indices.");
+            table[a].setFromTriplets(of[a].begin(), of[a].end());
+        }
+
+        setObservationFunction(std::move(table));
+    }
+
     template <typename M>
     double SparseModel<M>::getObservationProbability(const size_t s1, const size_t a, const size_t o) const {
         return observations_[a].coeff(s1, o);
@@ -372,6 +496,13 @@ namespace AIToolbox::POMDP {
         return std::make_tuple(s1, o, r);
     }
 
+    template <typename M>
+    std::tuple<size_t,size_t, double> SparseModel<M>::sampleSOR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        const auto [s1, r] = this->sampleSR(s, a, rnd);
+        const auto o = sampleProbability(O, observations_[a].row(s1), rnd);
+        return std::make_tuple(s1, o, r);
+    }
+
     template <typename M>
     std::tuple<size_t, double> SparseModel<M>::sampleOR(const size_t s, const size_t a, const size_t s1) const {
         const size_t o = sampleProbability(O, observations_[a].row(s1), rand_);
@@ -11,6 +11,29 @@ namespace AIToolbox::POMDP {
      */
     using Belief            = ProbabilityVector;
 
+    /**
+     * @brief This represents a belief over a number of states known at compile time.
+     *
+     * This type does not allocate, and is meant to be used together with
+     * POMDP::FixedModel for problems with very few states.
+     */
+    template <size_t S>
+    using FixedBelief       = Eigen::Matrix<double, static_cast<int>(S), 1>;
+
+    /**
+     * @brief This represents a belief which only stores its non-zero entries.
+     *
+     * The entries are kept as sorted index/value pairs. In problems with
+     * many states, beliefs often have a small support; with this type,
+     * belief updates (especially with a POMDP::SparseModel), alpha vector
+     * dot products and policy lookups cost in the size of the support
+     * rather than in the number of states.
+     *
+     * Conversion from and to Belief can be done with Eigen's sparseView()
+     * and toDense().
+     */
+    using SparseBelief      = Eigen::SparseVector<double>;
+
     /**
      * @name POMDP Value Types
      *
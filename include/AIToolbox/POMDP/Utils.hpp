@@ -1,9 +1,12 @@
 #ifndef AI_TOOLBOX_POMDP_UTILS_HEADER_FILE
 #define AI_TOOLBOX_POMDP_UTILS_HEADER_FILE
 
+#include <algorithm>
 #include <cstddef>
 #include <iterator>
 #include <numeric>
+#include <utility>
+#include <vector>
 
 #include <AIToolbox/Utils/Core.hpp>
 #include <AIToolbox/Utils/Probability.hpp>
@@ -72,6 +75,23 @@ namespace AIToolbox::POMDP {
      */
     ValueFunction makeValueFunction(size_t S);
 
+    /**
+     * @brief This function checks that a warm-start for an exact solver matches the state space.
+     *
+     * Solvers which can continue from a previous ValueFunction and its
+     * witness beliefs use this function to verify them, as vectors of the
+     * wrong size would otherwise be silently read out of bounds.
+     *
+     * This function throws an std::invalid_argument if any alphavector in
+     * the last VList of the ValueFunction, or any belief, is not of size
+     * S.
+     *
+     * @param S The number of possible states.
+     * @param v The ValueFunction to check.
+     * @param witnesses The witness beliefs to check.
+     */
+    void checkWarmStart(size_t S, const ValueFunction & v, const std::vector<Belief> & witnesses);
+
     /**
      * @brief This function returns a weak measure of distance between two VLists.
      *
@@ -83,6 +103,11 @@ namespace AIToolbox::POMDP {
      * We define distance between two ValueFunctions as the maximum between their
      * element-wise difference.
      *
+     * The old VList is copied into a contiguous matrix and compared blockwise,
+     * and the search for the closest match of a new entry stops as soon as it
+     * cannot change the result anymore. Blocks of the new VList are processed
+     * in parallel on the default Executor (see Executor::getDefault()).
+     *
      * @param oldV The fist VList to compare.
      * @param newV The second VList to compare.
      *
@@ -248,6 +273,109 @@ namespace AIToolbox::POMDP {
         return br;
     }
 
+    /**
+     * @brief Creates a new fixed-size belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This overload is selected for beliefs whose size is known at compile
+     * time (see FixedBelief). When the model is also fixed-size (see
+     * FixedModel) the whole update is done on the stack.
+     *
+     * This function will not normalize the output, nor is guaranteed
+     * to return a non-completely-zero vector.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @tparam S The number of states of the belief.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     * @param bRet The output belief.
+     */
+    template <typename M, int S, std::enable_if_t<is_model_v<M> && S != Eigen::Dynamic, int> = 0>
+    void updateBeliefUnnormalized(const M & model, const Eigen::Matrix<double, S, 1> & b, const size_t a, const size_t o, Eigen::Matrix<double, S, 1> * bRet) {
+        if (!bRet) return;
+
+        auto & br = *bRet;
+
+        if constexpr(is_model_eigen_v<M>) {
+            br.noalias() = model.getObservationFunction(a).col(o).cwiseProduct((b.transpose() * model.getTransitionFunction(a)).transpose());
+        } else {
+            for ( size_t s1 = 0; s1 < static_cast<size_t>(S); ++s1 ) {
+                double sum = 0.0;
+                for ( size_t s = 0; s < static_cast<size_t>(S); ++s )
+                    sum += model.getTransitionProbability(s,a,s1) * b[s];
+
+                br[s1] = model.getObservationProbability(s1,a,o) * sum;
+            }
+        }
+    }
+
+    /**
+     * @brief Creates a new fixed-size belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This function will not normalize the output, nor is guaranteed
+     * to return a non-completely-zero vector.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @tparam S The number of states of the belief.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     */
+    template <typename M, int S, std::enable_if_t<is_model_v<M> && S != Eigen::Dynamic, int> = 0>
+    Eigen::Matrix<double, S, 1> updateBeliefUnnormalized(const M & model, const Eigen::Matrix<double, S, 1> & b, const size_t a, const size_t o) {
+        Eigen::Matrix<double, S, 1> br;
+        updateBeliefUnnormalized(model, b, a, o, &br);
+        return br;
+    }
+
+    /**
+     * @brief Creates a new fixed-size belief reflecting changes after an action and observation for a particular Model.
+     *
+     * NOTE: This function assumes that the update and the normalization are
+     * possible, i.e. that from the input belief and action it is possible to
+     * receive the input observation.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @tparam S The number of states of the belief.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     * @param bRet The output belief.
+     */
+    template <typename M, int S, std::enable_if_t<is_model_v<M> && S != Eigen::Dynamic, int> = 0>
+    void updateBelief(const M & model, const Eigen::Matrix<double, S, 1> & b, const size_t a, const size_t o, Eigen::Matrix<double, S, 1> * bRet) {
+        if (!bRet) return;
+
+        updateBeliefUnnormalized(model, b, a, o, bRet);
+
+        auto & br = *bRet;
+        br /= br.sum();
+    }
+
+    /**
+     * @brief Creates a new fixed-size belief reflecting changes after an action and observation for a particular Model.
+     *
+     * NOTE: This function assumes that the update and the normalization are
+     * possible, i.e. that from the input belief and action it is possible to
+     * receive the input observation.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @tparam S The number of states of the belief.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     */
+    template <typename M, int S, std::enable_if_t<is_model_v<M> && S != Eigen::Dynamic, int> = 0>
+    Eigen::Matrix<double, S, 1> updateBelief(const M & model, const Eigen::Matrix<double, S, 1> & b, const size_t a, const size_t o) {
+        Eigen::Matrix<double, S, 1> br;
+        updateBelief(model, b, a, o, &br);
+        return br;
+    }
+
     /**
      * @brief This function partially updates a belief.
      *
@@ -461,6 +589,182 @@ namespace AIToolbox::POMDP {
         }
     }
 
+    /**
+     * @brief Creates a new sparse belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This function works as updateBeliefUnnormalized(const M &, const
+     * Belief &, size_t, size_t, Belief *), but for sparse beliefs. Only
+     * the states in the support of the input belief are looked at.
+     *
+     * If the model stores its transitions in sparse matrices (as
+     * POMDP::SparseModel does), the successors of each state are read
+     * directly, so that the cost of the update is proportional to the
+     * number of transitions out of the support, rather than to the
+     * number of states. Otherwise, each state in the support costs O(S).
+     *
+     * The successors are merged by sorting them; if there are so many
+     * that the output is likely to be dense anyway, they are merged in
+     * a dense vector instead.
+     *
+     * This function writes directly into the provided SparseBelief
+     * pointer, which is resized to the number of states of the model.
+     * It does a basic nullptr check.
+     *
+     * This function will not normalize the output, nor is guaranteed
+     * to return a non-completely-zero vector.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     * @param bRet The output belief.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    void updateBeliefUnnormalized(const M & model, const SparseBelief & b, const size_t a, const size_t o, SparseBelief * bRet) {
+        if (!bRet) return;
+
+        const size_t S = model.getS();
+
+        // We collect all (s1, probability) pairs reachable from the support.
+        std::vector<std::pair<size_t, double>> next;
+        for ( SparseBelief::InnerIterator it(b); it; ++it ) {
+            const size_t s = it.index();
+            if constexpr (MDP::is_model_sparse_v<M>) {
+                using TM = remove_cv_ref_t<decltype(model.getTransitionFunction(a))>;
+                for ( typename TM::InnerIterator jt(model.getTransitionFunction(a), s); jt; ++jt )
+                    next.emplace_back(jt.index(), it.value() * jt.value());
+            } else {
+                for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                    const double p = model.getTransitionProbability(s, a, s1);
+                    if ( p != 0.0 ) next.emplace_back(s1, it.value() * p);
+                }
+            }
+        }
+
+        auto & br = *bRet;
+        br.resize(S);
+
+        const auto insert = [&](const size_t s1, const double p) {
+            const double v = model.getObservationProbability(s1, a, o) * p;
+            if ( v != 0.0 ) br.insertBack(s1) = v;
+        };
+
+        if ( next.size() * 4 > S ) {
+            Vector acc = Vector::Zero(S);
+            for ( const auto & [s1, p] : next )
+                acc[s1] += p;
+            for ( size_t s1 = 0; s1 < S; ++s1 )
+                if ( acc[s1] != 0.0 ) insert(s1, acc[s1]);
+        } else {
+            std::sort(std::begin(next), std::end(next),
+                    [](const auto & lhs, const auto & rhs) { return lhs.first < rhs.first; });
+
+            br.reserve(next.size());
+            for ( size_t i = 0; i < next.size(); ) {
+                const size_t s1 = next[i].first;
+                double p = 0.0;
+                for ( ; i < next.size() && next[i].first == s1; ++i )
+                    p += next[i].second;
+                insert(s1, p);
+            }
+        }
+    }
+
+    /**
+     * @brief Creates a new sparse belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This function works as updateBeliefUnnormalized(const M &, const
+     * SparseBelief &, size_t, size_t, SparseBelief *), but returns the
+     * new belief.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    SparseBelief updateBeliefUnnormalized(const M & model, const SparseBelief & b, const size_t a, const size_t o) {
+        SparseBelief br(model.getS());
+        updateBeliefUnnormalized(model, b, a, o, &br);
+        return br;
+    }
+
+    /**
+     * @brief Creates a new sparse belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This function works as updateBeliefUnnormalized(const M &, const
+     * SparseBelief &, size_t, size_t, SparseBelief *), and then
+     * normalizes the output.
+     *
+     * NOTE: This function assumes that the update and the normalization are
+     * possible, i.e. that from the input belief and action it is possible to
+     * receive the input observation.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     * @param bRet The output belief.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    void updateBelief(const M & model, const SparseBelief & b, const size_t a, const size_t o, SparseBelief * bRet) {
+        if (!bRet) return;
+
+        updateBeliefUnnormalized(model, b, a, o, bRet);
+
+        auto & br = *bRet;
+        br /= br.sum();
+    }
+
+    /**
+     * @brief Creates a new sparse belief reflecting changes after an action and observation for a particular Model.
+     *
+     * This function works as updateBelief(const M &, const SparseBelief
+     * &, size_t, size_t, SparseBelief *), but returns the new belief.
+     *
+     * @tparam M The type of the POMDP Model.
+     * @param model The model used to update the belief.
+     * @param b The old belief.
+     * @param a The action taken during the transition.
+     * @param o The observation registered.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    SparseBelief updateBelief(const M & model, const SparseBelief & b, const size_t a, const size_t o) {
+        SparseBelief br(model.getS());
+        updateBelief(model, b, a, o, &br);
+        return br;
+    }
+
+    /**
+     * @brief This function computes an immediate reward based on a sparse belief rather than a state.
+     *
+     * Only the states in the support of the belief are looked at.
+     *
+     * @param model The POMDP model to use.
+     * @param b The belief to use.
+     * @param a The action performed from the belief.
+     *
+     * @return The immediate reward.
+     */
+    template <typename M, std::enable_if_t<is_model_v<M>, int> = 0>
+    double beliefExpectedReward(const M& model, const SparseBelief & b, const size_t a) {
+        double rew = 0.0;
+        if constexpr (is_model_eigen_v<M>) {
+            const auto & R = model.getRewardFunction();
+            for ( SparseBelief::InnerIterator it(b); it; ++it )
+                rew += R.coeff(it.index(), a) * it.value();
+        } else {
+            const size_t S = model.getS();
+            for ( SparseBelief::InnerIterator it(b); it; ++it )
+                for ( size_t s1 = 0; s1 < S; ++s1 )
+                    rew += model.getTransitionProbability(it.index(), a, s1) * model.getExpectedReward(it.index(), a, s1) * it.value();
+        }
+        return rew;
+    }
+
     /**
      * @brief This function computes the best VEntry for the input belief from the input VLists.
      *
@@ -17,15 +17,50 @@ namespace AIToolbox {
     using Table3D = boost::multi_array<double, 3>;
     using Table2D = boost::multi_array<double, 2>;
 
-    using Vector = Eigen::Matrix<double, Eigen::Dynamic, 1>;
+    /**
+     * @name Scalar-generic Eigen types
+     *
+     * These templates are the building blocks of all the Eigen types used
+     * in the library. The double precision aliases below are what is used
+     * by default everywhere; the others are provided so that the largest
+     * tables (mostly transition functions) can be stored with a smaller
+     * scalar type when memory bandwidth is the bottleneck.
+     *
+     * @{
+     */
+    template <typename T>
+    using VectorT = Eigen::Matrix<T, Eigen::Dynamic, 1>;
+
+    template <typename T>
+    using Matrix2DT       = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor | Eigen::AutoAlign>;
+    template <typename T>
+    using SparseMatrix2DT = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+
+    template <typename T>
+    using Matrix3DT       = std::vector<Matrix2DT<T>>;
+    template <typename T>
+    using SparseMatrix3DT = std::vector<SparseMatrix2DT<T>>;
+    /** @}  */
+
+    using Vector = VectorT<double>;
+
+    using Matrix2D           = Matrix2DT<double>;
+    using SparseMatrix2D     = SparseMatrix2DT<double>;
+    using SparseMatrix2DLong = SparseMatrix2DT<long>;
+
+    using Matrix3D           = Matrix3DT<double>;
+    using SparseMatrix3D     = SparseMatrix3DT<double>;
+    using SparseMatrix3DLong = SparseMatrix3DT<long>;
 
-    using Matrix2D           = Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor | Eigen::AutoAlign>;
-    using SparseMatrix2D     = Eigen::SparseMatrix<double, Eigen::RowMajor>;
-    using SparseMatrix2DLong = Eigen::SparseMatrix<long,   Eigen::RowMajor>;
+    // Single precision variants.
+    using Vectorf         = VectorT<float>;
+    using Matrix2Df       = Matrix2DT<float>;
+    using SparseMatrix2Df = SparseMatrix2DT<float>;
+    using Matrix3Df       = Matrix3DT<float>;
+    using SparseMatrix3Df = SparseMatrix3DT<float>;
 
-    using Matrix3D           = std::vector<Matrix2D>;
-    using SparseMatrix3D     = std::vector<SparseMatrix2D>;
-    using SparseMatrix3DLong = std::vector<SparseMatrix2DLong>;
+    // Row/column/value entries used to build sparse matrices in O(nnz).
+    using SparseTriplets  = std::vector<Eigen::Triplet<double>>;
 
     using Matrix4D       = boost::multi_array<Matrix2D,       2>;
     using SparseMatrix4D = boost::multi_array<SparseMatrix2D, 2>;
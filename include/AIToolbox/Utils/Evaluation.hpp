@@ -0,0 +1,155 @@
+#ifndef AI_TOOLBOX_UTILS_EVALUATION_HEADER_FILE
+#define AI_TOOLBOX_UTILS_EVALUATION_HEADER_FILE
+
+#include <cstddef>
+#include <random>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This struct contains the results of a Monte Carlo policy evaluation.
+     *
+     * \sa MDP::evaluatePolicy(), POMDP::evaluatePolicy()
+     */
+    struct EvaluationResults {
+        /// The number of episodes run.
+        size_t episodes;
+        /// The mean discounted return over all episodes.
+        double mean;
+        /// The sample standard deviation of the discounted returns.
+        double stddev;
+        /// The half-width of the 95% confidence interval around the mean.
+        double confidence;
+        /// The average number of steps per episode.
+        double meanSteps;
+        /// The average time, in seconds, taken by the agent to select an action.
+        double secondsPerStep;
+        /// The discounted return of each episode, in episode order.
+        std::vector<double> returns;
+    };
+
+    /**
+     * @brief This function computes the statistics of a set of evaluation episodes.
+     *
+     * The confidence interval is computed with the normal approximation,
+     * so it is only meaningful with a reasonable number of episodes.
+     *
+     * @param returns The discounted return of each episode.
+     * @param steps The total number of steps taken over all episodes.
+     * @param seconds The total time taken by the agent to select actions.
+     *
+     * @return The statistics of the episodes.
+     */
+    EvaluationResults makeEvaluationResults(std::vector<double> returns, size_t steps, double seconds);
+
+    namespace Impl {
+        /**
+         * @brief This struct reports whether an agent is an online planner.
+         *
+         * Online planners, like MDP::MCTS and POMDP::POMCP, select their
+         * first action with sampleAction(x, horizon), and then every
+         * following one with sampleAction(a, y, horizon), where a is the
+         * previous action and y the state or observation obtained
+         * after it. Both return the selected action.
+         */
+        template <typename Agent, typename = void>
+        struct is_online_planner : std::false_type {};
+
+        template <typename Agent>
+        struct is_online_planner<Agent, std::enable_if_t<std::is_same_v<size_t, decltype(
+            std::declval<Agent&>().sampleAction(size_t(), size_t(), unsigned())
+        )>>> : std::true_type {};
+
+        template <typename Agent>
+        inline constexpr bool is_online_planner_v = is_online_planner<Agent>::value;
+
+        /**
+         * @brief This struct reports whether an agent is a finite horizon policy.
+         *
+         * Finite horizon policies, like POMDP::Policy, select their first
+         * action with sampleAction(x, horizon), and then every following
+         * one with sampleAction(id, y, horizon), where y is the
+         * observation obtained after the previous action. Both return
+         * the selected action together with the id to pass to the next
+         * call.
+         */
+        template <typename Agent, typename = void>
+        struct is_horizon_policy : std::false_type {};
+
+        template <typename Agent>
+        struct is_horizon_policy<Agent, std::enable_if_t<std::is_same_v<std::tuple<size_t, size_t>, decltype(
+            std::declval<Agent&>().sampleAction(size_t(), size_t(), unsigned())
+        )>>> : std::true_type {};
+
+        template <typename Agent>
+        inline constexpr bool is_horizon_policy_v = is_horizon_policy<Agent>::value;
+
+        /**
+         * @brief This struct reports whether an MDP model can be sampled with an external RandomEngine.
+         *
+         * These models, like MDP::Model and MDP::SparseModel, provide
+         * sampleSR(s, a, rnd), which can be called concurrently as long
+         * as each thread uses its own engine.
+         */
+        template <typename M, typename = void>
+        struct has_engine_sampleSR : std::false_type {};
+
+        template <typename M>
+        struct has_engine_sampleSR<M, std::enable_if_t<std::is_same_v<std::tuple<size_t, double>, decltype(
+            std::declval<const M&>().sampleSR(size_t(), size_t(), std::declval<RandomEngine&>())
+        )>>> : std::true_type {};
+
+        template <typename M>
+        inline constexpr bool has_engine_sampleSR_v = has_engine_sampleSR<M>::value;
+
+        /**
+         * @brief This struct reports whether a POMDP model can be sampled with an external RandomEngine.
+         *
+         * These models, like POMDP::Model and POMDP::SparseModel over
+         * the MDP models above, provide sampleSOR(s, a, rnd). Since
+         * that relies on the sampleSR(s, a, rnd) of the underlying MDP
+         * model, we check for both.
+         */
+        template <typename M, typename = void>
+        struct has_engine_sampleSOR : std::false_type {};
+
+        template <typename M>
+        struct has_engine_sampleSOR<M, std::enable_if_t<std::is_same_v<std::tuple<size_t, size_t, double>, decltype(
+            std::declval<const M&>().sampleSOR(size_t(), size_t(), std::declval<RandomEngine&>())
+        )>>> : std::true_type {};
+
+        template <typename M>
+        inline constexpr bool has_engine_sampleSOR_v = has_engine_sampleSOR<M>::value && has_engine_sampleSR_v<M>;
+
+        /**
+         * @brief This function samples an index from a distribution given as a function.
+         *
+         * This avoids sharing any distribution object between threads.
+         *
+         * @param d The number of possible indices.
+         * @param prob A function returning the probability of each index.
+         * @param rnd The generator used to sample.
+         *
+         * @return An index in range [0,d-1].
+         */
+        template <typename F, typename G>
+        size_t sampleIndex(const size_t d, F prob, G & rnd) {
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+            double p = dist(rnd);
+
+            for ( size_t i = 0; i < d - 1; ++i ) {
+                const double v = prob(i);
+                if ( v > p ) return i;
+                p -= v;
+            }
+            return d - 1;
+        }
+    }
+}
+
+#endif
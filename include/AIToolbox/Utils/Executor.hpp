@@ -0,0 +1,427 @@
+#ifndef AI_TOOLBOX_UTILS_EXECUTOR_HEADER_FILE
+#define AI_TOOLBOX_UTILS_EXECUTOR_HEADER_FILE
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <AIToolbox/Types.hpp>
+
+namespace AIToolbox {
+    /**
+     * @brief This class is a work-stealing thread pool shared by the algorithms of the library.
+     *
+     * Algorithms that can split their work into independent pieces do so
+     * through an Executor, rather than spawning their own threads. This
+     * allows a single process to bound the total number of threads used
+     * by the library, no matter how many solvers it runs.
+     *
+     * An Executor with concurrency N owns N-1 background threads, with
+     * indices 1 to N-1; the thread waiting on the work is the N-th
+     * worker, and has index 0 if it does not belong to the Executor.
+     * An Executor with concurrency 1 owns no threads at all, and simply
+     * runs everything in the calling thread, in order.
+     *
+     * Work is submitted through TaskGroups. The tasks of a group are
+     * only ever run by the thread waiting on the group and by the
+     * background threads, which steal them when idle; a waiting thread
+     * never runs the tasks of other callers. This makes it safe for
+     * multiple external threads to use the same Executor at the same
+     * time: each sees only its own work as worker 0.
+     *
+     * Each background thread has its own RandomEngine, seeded through
+     * Impl::Seeder at construction, and each external thread gets its own
+     * when it first calls getRandomEngine(). Tasks should use
+     * getRandomEngine() to sample, so that no engine is ever shared
+     * between threads.
+     *
+     * In deterministic mode, work is never stolen: parallelFor() always
+     * assigns the same indices to the same workers, and TaskGroup assigns
+     * tasks to workers in round-robin submission order. Together with
+     * Impl::Seeder::setRootSeed(), this makes results reproducible
+     * regardless of thread timing, as long as each external thread
+     * first uses the Executor in the same order.
+     *
+     * By default, the library uses the Executor returned by getDefault(),
+     * which is single-threaded unless changed with setDefault().
+     */
+    class Executor {
+        public:
+            class TaskGroup;
+
+            /**
+             * @brief Basic constructor.
+             *
+             * A concurrency of 0 is treated as 1.
+             *
+             * @param concurrency The total number of workers, including the calling thread.
+             * @param deterministic Whether work stealing is disabled.
+             */
+            explicit Executor(unsigned concurrency = 1, bool deterministic = false);
+
+            /**
+             * @brief Basic destructor.
+             *
+             * This waits for all background threads to terminate. All
+             * work should have been waited upon before destroying the
+             * Executor.
+             */
+            ~Executor();
+
+            Executor(const Executor &) = delete;
+            Executor & operator=(const Executor &) = delete;
+
+            /**
+             * @brief This function calls a function on every index in a range, in parallel.
+             *
+             * The range is split into chunks of at least grain indices,
+             * which are distributed among the workers. A grain of 0
+             * selects a default which creates a few chunks per worker.
+             *
+             * In deterministic mode the range is instead split into one
+             * contiguous block per worker, and the grain is ignored.
+             *
+             * The function can take the worker index as a second
+             * argument. No two threads ever run calls of the same
+             * parallelFor() with the same worker index, so it can be used
+             * to select per-worker state owned by the caller.
+             *
+             * This function returns once all indices have been processed.
+             * If any call throws, the first exception is rethrown here.
+             *
+             * @param begin The first index.
+             * @param end The index after the last.
+             * @param f The function to call on each index, and optionally on the worker index.
+             * @param grain The minimum number of indices per task.
+             */
+            template <typename F>
+            void parallelFor(size_t begin, size_t end, F f, size_t grain = 0);
+
+            /**
+             * @brief This function returns the index of the calling worker.
+             *
+             * Threads which do not belong to this Executor always get
+             * index 0. Since a thread only runs the tasks it waits on, or
+             * those of this Executor if it is a background thread, index
+             * 0 identifies the calling thread among the workers running
+             * the tasks of any one TaskGroup.
+             *
+             * @return The index of the calling worker, in [0, getConcurrency()).
+             */
+            unsigned getWorkerIndex() const;
+
+            /**
+             * @brief This function returns the RandomEngine of the calling worker.
+             *
+             * External threads each get their own RandomEngine, seeded
+             * through Impl::Seeder on their first call.
+             *
+             * @return The RandomEngine of the calling worker.
+             */
+            RandomEngine & getRandomEngine();
+
+            /**
+             * @brief This function returns the number of workers of this Executor.
+             *
+             * @return The number of workers, including the calling thread.
+             */
+            unsigned getConcurrency() const;
+
+            /**
+             * @brief This function returns whether this Executor schedules work deterministically.
+             *
+             * @return Whether work stealing is disabled.
+             */
+            bool isDeterministic() const;
+
+            /**
+             * @brief This function returns the default Executor of the library.
+             *
+             * Unless setDefault() has been called, this Executor is
+             * single-threaded. It is safe to call this function from
+             * multiple threads.
+             *
+             * The returned pointer keeps the Executor alive, so
+             * algorithms should hold it for as long as they use the
+             * Executor.
+             *
+             * @return The default Executor.
+             */
+            static std::shared_ptr<Executor> getDefault();
+
+            /**
+             * @brief This function replaces the default Executor of the library.
+             *
+             * Algorithms which are already running keep using the
+             * previous default Executor, which is only destroyed once
+             * all of them are done with it; only later calls to
+             * getDefault() see the new one.
+             *
+             * This function must not be called from within a task of the
+             * current default Executor.
+             *
+             * @param concurrency The total number of workers of the new default.
+             * @param deterministic Whether work stealing is disabled.
+             */
+            static void setDefault(unsigned concurrency, bool deterministic = false);
+
+        private:
+            using Task = std::function<void()>;
+
+            struct Queue {
+                std::mutex mutex;
+                // Pinned tasks can only be run by the owner of the queue.
+                std::deque<Task> pinned, shared;
+                std::atomic<size_t> size{0};
+            };
+
+            /**
+             * @brief This function enqueues a task.
+             *
+             * @param t The task to enqueue.
+             * @param q The queue which receives the task.
+             * @param pinned Whether the task cannot be stolen.
+             */
+            void push(Task t, Queue & q, bool pinned);
+
+            /**
+             * @brief This function pops a task from a queue.
+             *
+             * Pinned tasks are taken first; shared tasks are taken LIFO,
+             * for locality.
+             *
+             * @param q The queue to pop from.
+             *
+             * @return The task, or an empty Task if the queue was empty.
+             */
+            Task pop(Queue & q);
+
+            /**
+             * @brief This function steals a shared task from the registered TaskGroups, if one is available.
+             *
+             * @param worker The background worker looking for work.
+             *
+             * @return The task, or an empty Task if none was found.
+             */
+            Task steal(unsigned worker);
+
+            /**
+             * @brief This function returns whether a background worker could find work.
+             */
+            bool hasWork(unsigned worker) const;
+
+            /**
+             * @brief This function wakes up all sleeping workers and waiting threads.
+             */
+            void notifyAll();
+
+            /**
+             * @brief This function is the main loop of the background threads.
+             *
+             * @param worker The index of the worker.
+             */
+            void workerLoop(unsigned worker);
+
+            unsigned concurrency_;
+            bool deterministic_;
+            // Identifies this Executor in the thread-local engine cache,
+            // since addresses can be reused.
+            size_t id_;
+
+            // Queues and engines of the background workers; worker w uses
+            // the element at index w-1.
+            std::vector<std::unique_ptr<Queue>> queues_;
+            std::vector<RandomEngine> engines_;
+            std::vector<std::thread> threads_;
+
+            // Engines of the external threads.
+            std::mutex externalMutex_;
+            std::unordered_map<std::thread::id, RandomEngine> externalEngines_;
+
+            // Queues of the TaskGroups that have shared tasks to steal.
+            std::mutex groupsMutex_;
+            std::vector<Queue *> groups_;
+            std::atomic<size_t> sharedSize_;
+
+            std::mutex sleepMutex_;
+            std::condition_variable sleepCondition_;
+            bool stop_;
+    };
+
+    /**
+     * @brief This class groups tasks submitted to an Executor, so they can be waited upon together.
+     *
+     * Each TaskGroup has its own queue, which background workers steal
+     * from. While waiting, the calling thread runs the tasks of its own
+     * group (and, if it is a background worker, the tasks pinned to it)
+     * rather than those of other callers; if there are none, it sleeps
+     * until some are submitted or all its tasks complete. It is thus safe
+     * to create and wait on TaskGroups from within other tasks.
+     *
+     * A TaskGroup must be waited upon by the thread which created it.
+     *
+     * With a single-threaded Executor, tasks are run immediately when
+     * submitted.
+     */
+    class Executor::TaskGroup {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * @param e The Executor which will run the tasks.
+             */
+            TaskGroup(Executor & e);
+
+            /**
+             * @brief Basic destructor.
+             *
+             * This waits for all tasks in the group, ignoring any error.
+             */
+            ~TaskGroup();
+
+            TaskGroup(const TaskGroup &) = delete;
+            TaskGroup & operator=(const TaskGroup &) = delete;
+
+            /**
+             * @brief This function submits a task to the group.
+             *
+             * @param f The task to run.
+             */
+            template <typename F>
+            void run(F f);
+
+            /**
+             * @brief This function submits a task to the group, pinned to a specific worker.
+             *
+             * The task will not be stolen by other workers. Worker 0 is
+             * the thread waiting on the group.
+             *
+             * @param f The task to run.
+             * @param worker The worker which will run the task.
+             */
+            template <typename F>
+            void runOn(F f, unsigned worker);
+
+            /**
+             * @brief This function waits until all tasks in the group have completed.
+             *
+             * If any task threw, the first exception is rethrown here.
+             */
+            void wait();
+
+        private:
+            template <typename F>
+            Task wrap(F f);
+
+            /**
+             * @brief This function runs a single task on behalf of the waiting thread, if one is available.
+             *
+             * @return Whether a task was run.
+             */
+            bool runOne();
+
+            /**
+             * @brief This function returns whether the waiting thread can stop sleeping.
+             */
+            bool canWake() const;
+
+            Executor & executor_;
+            unsigned owner_;
+            Queue queue_;
+            std::atomic<size_t> pending_;
+            unsigned submitted_;
+
+            std::mutex errorMutex_;
+            std::exception_ptr error_;
+    };
+
+    template <typename F>
+    Executor::Task Executor::TaskGroup::wrap(F f) {
+        return [this, &e = executor_, f = std::move(f)]() mutable {
+            try {
+                f();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex_);
+                if ( !error_ ) error_ = std::current_exception();
+            }
+            // Once pending_ reaches zero the group may be destroyed, so
+            // only the Executor is touched afterwards.
+            if ( pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+                e.notifyAll();
+        };
+    }
+
+    template <typename F>
+    void Executor::TaskGroup::run(F f) {
+        if ( executor_.concurrency_ == 1 ) {
+            ++pending_;
+            wrap(std::move(f))();
+        } else if ( executor_.deterministic_ ) {
+            runOn(std::move(f), submitted_ % executor_.concurrency_);
+        } else {
+            ++pending_;
+            ++submitted_;
+            executor_.push(wrap(std::move(f)), queue_, false);
+        }
+    }
+
+    template <typename F>
+    void Executor::TaskGroup::runOn(F f, const unsigned worker) {
+        ++pending_;
+        ++submitted_;
+        if ( executor_.concurrency_ == 1 ) {
+            wrap(std::move(f))();
+        } else {
+            const auto w = worker % executor_.concurrency_;
+            executor_.push(wrap(std::move(f)), w ? *executor_.queues_[w-1] : queue_, true);
+        }
+    }
+
+    template <typename F>
+    void Executor::parallelFor(const size_t begin, const size_t end, F f, size_t grain) {
+        if ( begin >= end ) return;
+        const size_t n = end - begin;
+
+        const auto block = [this, &f](const size_t b, const size_t e) {
+            if constexpr (std::is_invocable_v<F&, size_t, unsigned>) {
+                const auto w = getWorkerIndex();
+                for ( size_t i = b; i < e; ++i ) f(i, w);
+            } else {
+                for ( size_t i = b; i < e; ++i ) f(i);
+            }
+        };
+
+        if ( concurrency_ == 1 || n == 1 ) {
+            block(begin, end);
+            return;
+        }
+
+        TaskGroup group(*this);
+        if ( deterministic_ ) {
+            for ( unsigned w = 0; w < concurrency_; ++w ) {
+                const size_t b = begin + n * w / concurrency_;
+                const size_t e = begin + n * (w + 1) / concurrency_;
+                if ( b == e ) continue;
+                group.runOn([&block, b, e]{ block(b, e); }, w);
+            }
+        } else {
+            if ( !grain ) grain = std::max<size_t>(1, n / (4 * concurrency_));
+            for ( size_t b = begin; b < end; b += grain ) {
+                const size_t e = std::min(end, b + grain);
+                group.run([&block, b, e]{ block(b, e); });
+            }
+        }
+        group.wait();
+    }
+}
+
+#endif
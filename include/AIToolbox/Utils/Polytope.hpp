@@ -18,6 +18,9 @@ namespace AIToolbox {
      * Given a list of hyperplanes as a surface, this function returns the
      * hyperplane which provides the highest value at the specified point.
      *
+     * The point can be any Eigen vector, so that fixed-size points can be
+     * used without converting them to a Point first.
+     *
      * @param p The point where we need to check the value
      * @param begin The start of the range to look in.
      * @param end The end of the range to look in (excluded).
@@ -25,8 +28,8 @@ namespace AIToolbox {
      *
      * @return An iterator pointing to the best choice in range.
      */
-    template <typename Iterator>
-    Iterator findBestAtPoint(const Point & p, Iterator begin, Iterator end, double * value = nullptr) {
+    template <typename Iterator, typename P = Point>
+    Iterator findBestAtPoint(const P & p, Iterator begin, Iterator end, double * value = nullptr) {
         auto bestMatch = begin;
         double bestValue = p.dot(*bestMatch);
 
@@ -437,11 +440,17 @@ namespace AIToolbox {
              * successful returns the witness point which satisfies
              * the solution.
              *
+             * A witness is only returned if the input Hyperplane improves
+             * on all optimal ones by more than epsilon. With a positive
+             * epsilon, Hyperplanes which are only marginally useful are
+             * thus reported as having no witness.
+             *
              * @param v The Hyperplane to test against the optimal ones already added.
+             * @param epsilon The minimum improvement a witness must provide.
              *
              * @return If found, the Point witness to the set problem.
              */
-            std::optional<Point> findWitness(const Hyperplane & v);
+            std::optional<Point> findWitness(const Hyperplane & v, double epsilon = 0.0);
 
             /**
              * @brief This function resets the internal LP to only the simplex constraint.
@@ -97,6 +97,7 @@ namespace AIToolbox {
      * std::uniform_real_distribution<double>, since that is what is used
      * to obtain the random sample.
      *
+     * @tparam Scalar The scalar type of the sparse matrix.
      * @tparam G The type of the generator used.
      * @param in The external probability container.
      * @param d The size of the supplied container.
@@ -104,11 +105,11 @@ namespace AIToolbox {
      *
      * @return An index in range [0,d-1].
      */
-    template <typename G>
-    size_t sampleProbability(const size_t d, const SparseMatrix2D::ConstRowXpr& in, G& generator) {
+    template <typename Scalar, typename G>
+    size_t sampleProbability(const size_t d, const Eigen::Block<const SparseMatrix2DT<Scalar>, 1, Eigen::Dynamic, true> & in, G& generator) {
         double p = probabilityDistribution(generator);
 
-        for ( SparseMatrix2D::ConstRowXpr::InnerIterator i(in, 0); ; ++i ) {
+        for ( typename SparseMatrix2DT<Scalar>::ConstRowXpr::InnerIterator i(in, 0); ; ++i ) {
             if ( i.value() > p ) return i.col();
             p -= i.value();
         }
@@ -2,6 +2,7 @@
 #define AI_TOOLBOX_UTILS_PRUNE_HEADER_FILE
 
 #include <algorithm>
+#include <stdexcept>
 
 #include <AIToolbox/Types.hpp>
 #include <AIToolbox/Utils/Core.hpp>
@@ -68,6 +69,54 @@ next:;
         return end;
     }
 
+    /**
+     * @brief This function finds and moves all Vectors in the range that are nearly dominated by others.
+     *
+     * A Vector is considered nearly dominated if there is another Vector in
+     * the range which is, in every element, at most epsilon lower. Vectors
+     * are only tested against Vectors which are kept, so that for every
+     * removed Vector there is a kept one which is at most epsilon worse at
+     * every point.
+     *
+     * This is a cheap way to merge near-duplicate Vectors before a
+     * full-fledged prune.
+     *
+     * Nearly dominated elements will be moved at the end of the range for
+     * safe removal.
+     *
+     * @param N The number of elements in each Vector.
+     * @param epsilon The maximum allowed difference for each element.
+     * @param begin The begin of the list that needs to be pruned.
+     * @param end The end of the list that needs to be pruned.
+     *
+     * @return The iterator that separates nearly dominated elements with non-pruned.
+     */
+    template <typename Iterator>
+    Iterator extractNearlyDominated(const size_t N, const double epsilon, Iterator begin, Iterator end) {
+        auto nearlyDominates = [N, epsilon](const auto & lhs, const auto & rhs) {
+            for ( size_t i = 0; i < N; ++i )
+                if ( rhs[i] > lhs[i] + epsilon ) return false;
+            return true;
+        };
+
+        // Everything before 'target' has been kept.
+        auto target = begin;
+        while ( target < end ) {
+            bool dominated = false;
+            for ( auto iter = begin; iter < target; ++iter ) {
+                if ( nearlyDominates(*iter, *target) ) {
+                    dominated = true;
+                    break;
+                }
+            }
+            if ( dominated )
+                iter_swap(target, --end);
+            else
+                ++target;
+        }
+        return end;
+    }
+
     /**
      * @brief This class offers pruning facilities for non-parsimonious ValueFunction sets.
      *
@@ -75,15 +124,42 @@ next:;
      * remove all hyperplanes which are completely dominated. It is much more
      * precise than extractDominated, but it is also a lot more expensive to
      * call.
+     *
+     * This class can also prune approximately. When a positive epsilon is
+     * specified, hyperplanes which cannot improve the value of the kept
+     * ones by more than epsilon at any point are removed. The pruned set is
+     * then guaranteed to be at most epsilon lower than the exact one at
+     * every point of the simplex, and is generally much smaller.
+     *
+     * In addition, near-duplicates can be merged with a cheap
+     * element-wise check before solving any LP (see
+     * extractNearlyDominated()). In this case half of epsilon is used for
+     * the merge and half for the LPs, so that the overall bound stays
+     * epsilon.
+     *
+     * Finally, a set of seed points can be provided (for example the
+     * witness points of a previous prune of a similar set). The best
+     * hyperplanes at these points are extracted right after the simplex
+     * corners, without solving any LP, so that when the seeds are good
+     * most of the LPs only need to confirm that no witness is left.
      */
     class Pruner {
         public:
             /**
              * @brief Basic constructor.
              *
+             * The epsilon parameter must be >= 0.0, otherwise the
+             * constructor will throw an std::invalid_argument.
+             *
              * @param S The number of dimensions of the simplex to operate on.
+             * @param epsilon The maximum value loss allowed when pruning.
+             * @param mergeDuplicates Whether to merge near-duplicates before pruning.
              */
-            Pruner(const size_t s) : S(s), lp_(S) {}
+            Pruner(const size_t s, const double epsilon = 0.0, const bool mergeDuplicates = false) :
+                    S(s), epsilon_(epsilon), merge_(mergeDuplicates), lp_(S)
+            {
+                if ( epsilon_ < 0.0 ) throw std::invalid_argument("Epsilon must be >= 0");
+            }
 
             /**
              * @brief This function prunes all non useful hyperplanes from the provided list.
@@ -93,19 +169,71 @@ next:;
             template <typename It>
             It operator()(It begin, It end);
 
+            /**
+             * @brief This function returns the maximum value loss allowed when pruning.
+             *
+             * @return The epsilon of this Pruner.
+             */
+            double getEpsilon() const { return epsilon_; }
+
+            /**
+             * @brief This function sets the seed points to check before solving any LP.
+             *
+             * This function throws an std::invalid_argument if any of the
+             * points is not of size S.
+             *
+             * @param points The points to check, each of size S.
+             */
+            void setSeedPoints(std::vector<Point> points) {
+                for ( const auto & p : points )
+                    if ( static_cast<size_t>(p.size()) != S )
+                        throw std::invalid_argument("Seed points must have size S");
+                seeds_ = std::move(points);
+            }
+
+            /**
+             * @brief This function returns the currently set seed points.
+             *
+             * @return The seed points.
+             */
+            const std::vector<Point> & getSeedPoints() const { return seeds_; }
+
+            /**
+             * @brief This function returns the witness points found in the last prune.
+             *
+             * These are all the points, other than the simplex corners,
+             * which identified a hyperplane that was kept: both seed
+             * points and points found by the LPs. They can be used as
+             * seeds for later prunes of similar sets.
+             *
+             * @return The witness points of the last prune.
+             */
+            const std::vector<Point> & getWitnessPoints() const { return witnesses_; }
+
         private:
             size_t S;
+            double epsilon_;
+            bool merge_;
 
             WitnessLP lp_;
+            std::vector<Point> seeds_, witnesses_;
     };
 
     // The idea is that the input thing already has all the best vectors,
     // thus we only need to find them and discard the others.
     template <typename It>
     It Pruner::operator()(It begin, It end) {
+        witnesses_.clear();
+
         // Remove easy ValueFunctions to avoid doing more work later.
         end = extractDominated(S, begin, end);
 
+        double lpEpsilon = epsilon_;
+        if ( merge_ && epsilon_ > 0.0 ) {
+            lpEpsilon /= 2.0;
+            end = extractNearlyDominated(S, lpEpsilon, begin, end);
+        }
+
         const size_t size = std::distance(begin, end);
         if ( size < 2 ) return end;
 
@@ -115,7 +243,12 @@ next:;
 
         bound = extractBestAtSimplexCorners(S, begin, bound, end);
 
-        // Here we could do some random belief lookups..
+        for ( const auto & seed : seeds_ ) {
+            if ( bound == end ) break;
+            const auto newBound = extractBestAtPoint(seed, begin, bound, end);
+            if ( newBound != bound ) witnesses_.push_back(seed);
+            bound = newBound;
+        }
 
         // If we actually have still work to do..
         if ( bound < end ) {
@@ -139,12 +272,13 @@ next:;
         //
         // That we do in the findWitnessPoint function.
         while ( bound < end ) {
-            const auto witness = lp_.findWitness(*(end-1));
+            const auto witness = lp_.findWitness(*(end-1), lpEpsilon);
             // If we get a belief point, we search for the actual vector that provides
             // the best value on the belief point, we move it into the best vector.
             if ( witness ) {
                 // Advance bound with the next best
                 bound = extractBestAtPoint(*witness, bound, bound, end);
+                witnesses_.push_back(*witness);
                 // Add the newly found vector to our lp.
                 lp_.addOptimalRow(*(bound-1));
             }
@@ -0,0 +1,333 @@
+#ifndef AI_TOOLBOX_UTILS_TRAJECTORY_LOG_HEADER_FILE
+#define AI_TOOLBOX_UTILS_TRAJECTORY_LOG_HEADER_FILE
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace AIToolbox {
+    /**
+     * @brief This struct contains the records of a block of a trajectory log.
+     *
+     * The records are stored as separate arrays, one per field, so that
+     * they can be consumed in bulk. The observations array is empty for
+     * logs which do not contain observations.
+     */
+    struct TrajectoryBlock {
+        std::vector<size_t> states;
+        std::vector<size_t> actions;
+        std::vector<size_t> nextStates;
+        std::vector<size_t> observations;
+        std::vector<double> rewards;
+
+        /**
+         * @brief This function returns the number of records in the block.
+         *
+         * @return The number of records.
+         */
+        size_t size() const { return states.size(); }
+    };
+
+    /**
+     * @brief This class appends experience to a binary trajectory log.
+     *
+     * A trajectory log is a file containing a stream of (s, a, s1, r)
+     * records, or (s, a, s1, o, r) records if it was created with
+     * observations. Records are grouped in blocks, each with its own
+     * header containing its size and a CRC-32 checksum of its data, so
+     * that corruption can be detected when reading.
+     *
+     * Each block is compressed independently: integers are written as
+     * variable length numbers, the state of a record is omitted when it
+     * equals the next state of the previous record, and its reward is
+     * omitted when it equals the previous one. Logs of trajectories
+     * generally take a few bytes per record.
+     *
+     * Numbers are written in native byte order, so logs can only be read
+     * back on a machine with the same endianness.
+     *
+     * The log is only ever appended to. If the file already exists, new
+     * blocks are written after the existing ones; an incomplete block at
+     * the end of the file, left for example by a crash during a write, is
+     * removed first.
+     *
+     * Records are not written directly through this class, but through
+     * Appenders. Each Appender compresses its records in its own block,
+     * and only takes a lock on the file to write it once it is full. Thus,
+     * many threads can log at the same time, each with its own Appender.
+     * The records of each Appender keep their order in the log, but blocks
+     * from different Appenders can be interleaved.
+     *
+     * \sa TrajectoryReader
+     */
+    class TrajectoryWriter {
+        public:
+            /**
+             * @brief This class compresses records into blocks for a TrajectoryWriter.
+             *
+             * An Appender is not thread-safe, so each thread should use
+             * its own. All Appenders must be destroyed before the
+             * TrajectoryWriter that created them.
+             */
+            class Appender {
+                public:
+                    /**
+                     * @brief Basic destructor, which writes the last incomplete block.
+                     */
+                    ~Appender();
+
+                    Appender(Appender &&) noexcept;
+                    Appender & operator=(Appender &&) = delete;
+                    Appender(const Appender &) = delete;
+                    Appender & operator=(const Appender &) = delete;
+
+                    /**
+                     * @brief This function records a transition.
+                     *
+                     * If the log contains observations, this function will
+                     * throw an std::invalid_argument. If this Appender has
+                     * been moved from, it will throw an std::runtime_error.
+                     *
+                     * @param s The initial state.
+                     * @param a The action performed.
+                     * @param s1 The final state.
+                     * @param rew The reward obtained.
+                     */
+                    void record(size_t s, size_t a, size_t s1, double rew);
+
+                    /**
+                     * @brief This function records a transition together with its observation.
+                     *
+                     * If the log does not contain observations, this
+                     * function will throw an std::invalid_argument. If this
+                     * Appender has been moved from, it will throw an
+                     * std::runtime_error.
+                     *
+                     * @param s The initial state.
+                     * @param a The action performed.
+                     * @param s1 The final state.
+                     * @param o The observation obtained.
+                     * @param rew The reward obtained.
+                     */
+                    void record(size_t s, size_t a, size_t s1, size_t o, double rew);
+
+                    /**
+                     * @brief This function writes the current block to the log, even if not full.
+                     */
+                    void flush();
+
+                private:
+                    friend class TrajectoryWriter;
+                    Appender(TrajectoryWriter & writer);
+
+                    void encode(size_t s, size_t a, size_t s1, size_t o, double rew);
+
+                    TrajectoryWriter * writer_;
+                    std::vector<unsigned char> buffer_;
+                    std::uint32_t records_;
+                    size_t lastS1_;
+                    double lastRew_;
+            };
+
+            /**
+             * @brief Basic constructor.
+             *
+             * If the file exists and it is a trajectory log, the new
+             * records are appended to it. If the existing log was created
+             * with a different observations setting, this constructor
+             * will throw an std::invalid_argument. If the file cannot be
+             * opened, or it is not a trajectory log, this constructor will
+             * throw an std::runtime_error.
+             *
+             * The blockRecords parameter must be at least 1, and small
+             * enough that a full block fits in 4GB (about 89 million
+             * records); otherwise this constructor will throw an
+             * std::invalid_argument.
+             *
+             * @param filename The file of the log.
+             * @param observations Whether the records contain observations.
+             * @param blockRecords The number of records in each block.
+             */
+            TrajectoryWriter(const std::string & filename, bool observations = false, unsigned blockRecords = 4096);
+
+            /**
+             * @brief This function creates a new Appender for this log.
+             *
+             * This function is thread-safe.
+             *
+             * @return A new Appender.
+             */
+            Appender makeAppender();
+
+            /**
+             * @brief This function flushes to disk all blocks written so far.
+             *
+             * This function is thread-safe.
+             */
+            void flush();
+
+            /**
+             * @brief This function returns whether the records of the log contain observations.
+             *
+             * @return Whether the records contain observations.
+             */
+            bool hasObservations() const;
+
+        private:
+            void writeBlock(const std::vector<unsigned char> & payload, std::uint32_t records);
+
+            bool observations_;
+            unsigned blockRecords_;
+            std::ofstream file_;
+            std::mutex mutex_;
+    };
+
+    namespace Impl {
+        /**
+         * @brief This struct reports whether a class can record transitions like an Experience.
+         */
+        template <typename L, typename = void>
+        struct has_record : std::false_type {};
+
+        template <typename L>
+        struct has_record<L, std::void_t<decltype(
+            std::declval<L&>().record(size_t(), size_t(), size_t(), double())
+        )>> : std::true_type {};
+
+        /**
+         * @brief This struct reports whether a class can learn from transitions like QLearning.
+         */
+        template <typename L, typename = void>
+        struct has_step_update_q : std::false_type {};
+
+        template <typename L>
+        struct has_step_update_q<L, std::void_t<decltype(
+            std::declval<L&>().stepUpdateQ(size_t(), size_t(), size_t(), double())
+        )>> : std::true_type {};
+    }
+
+    /**
+     * @brief This class reads a binary trajectory log.
+     *
+     * The log is read one block at a time, and each block is verified
+     * against its checksum before being decoded. The records can be read
+     * in bulk with readBlock(), or passed to a function or a learner one
+     * at a time with replay().
+     *
+     * If the last block of the log is incomplete, it is ignored, as it is
+     * what remains of an interrupted write, and isTruncated() will return
+     * true.
+     *
+     * \sa TrajectoryWriter
+     */
+    class TrajectoryReader {
+        public:
+            /**
+             * @brief Basic constructor.
+             *
+             * If the file cannot be opened, or it is not a trajectory log,
+             * this constructor will throw an std::runtime_error.
+             *
+             * @param filename The file of the log.
+             */
+            TrajectoryReader(const std::string & filename);
+
+            /**
+             * @brief This function reads the next block of the log.
+             *
+             * The input block is overwritten, reusing its memory. If the
+             * block does not match its checksum, this function will throw
+             * an std::runtime_error.
+             *
+             * @param block The block to fill.
+             *
+             * @return Whether a block was read, or the end of the log was reached.
+             */
+            bool readBlock(TrajectoryBlock * block);
+
+            /**
+             * @brief This function passes all remaining records of the log to a function or learner.
+             *
+             * The input can be:
+             *
+             * - A function taking (s, a, s1, rew), or (s, a, s1, o, rew) if
+             *   the log contains observations.
+             * - Something with a record(s, a, s1, rew) method, like
+             *   MDP::Experience and MDP::SparseExperience.
+             * - Something with a stepUpdateQ(s, a, s1, rew) method, like
+             *   MDP::QLearning and the other off-policy learners.
+             *
+             * In the last two cases observations are ignored.
+             *
+             * @param f The function or learner to pass the records to.
+             *
+             * @return The number of records passed.
+             */
+            template <typename F>
+            size_t replay(F && f);
+
+            /**
+             * @brief This function returns whether the records of the log contain observations.
+             *
+             * @return Whether the records contain observations.
+             */
+            bool hasObservations() const;
+
+            /**
+             * @brief This function returns whether an incomplete block was found at the end of the log.
+             *
+             * @return Whether the log is truncated.
+             */
+            bool isTruncated() const;
+
+        private:
+            bool observations_, truncated_;
+            std::ifstream file_;
+            std::vector<unsigned char> buffer_;
+            TrajectoryBlock block_;
+    };
+
+    template <typename F>
+    size_t TrajectoryReader::replay(F && f) {
+        using G = std::remove_reference_t<F>;
+
+        size_t n = 0;
+        while ( readBlock(&block_) ) {
+            const size_t N = block_.size();
+            const auto & s = block_.states, & a = block_.actions, & s1 = block_.nextStates, & o = block_.observations;
+            const auto & r = block_.rewards;
+
+            if constexpr (std::is_invocable_v<G&, size_t, size_t, size_t, size_t, double>) {
+                if ( observations_ ) {
+                    for ( size_t i = 0; i < N; ++i )
+                        f(s[i], a[i], s1[i], o[i], r[i]);
+                    n += N;
+                    continue;
+                }
+            }
+            if constexpr (std::is_invocable_v<G&, size_t, size_t, size_t, double>) {
+                for ( size_t i = 0; i < N; ++i )
+                    f(s[i], a[i], s1[i], r[i]);
+            } else if constexpr (Impl::has_record<G>::value) {
+                for ( size_t i = 0; i < N; ++i )
+                    f.record(s[i], a[i], s1[i], r[i]);
+            } else if constexpr (Impl::has_step_update_q<G>::value) {
+                for ( size_t i = 0; i < N; ++i )
+                    f.stepUpdateQ(s[i], a[i], s1[i], r[i]);
+            } else {
+                static_assert(std::is_invocable_v<G&, size_t, size_t, size_t, size_t, double>,
+                              "TrajectoryReader::replay() requires a function or learner taking the records of the log.");
+                throw std::invalid_argument("The input function requires observations, but the log does not contain them");
+            }
+            n += N;
+        }
+        return n;
+    }
+}
+
+#endif
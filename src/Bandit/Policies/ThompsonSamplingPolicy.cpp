@@ -1,15 +1,49 @@
 #include <AIToolbox/Bandit/Policies/ThompsonSamplingPolicy.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <random>
 
+#include <Eigen/Eigenvalues>
+
 namespace AIToolbox::Bandit {
-    ThompsonSamplingPolicy::ThompsonSamplingPolicy(const size_t A) : Base(A), experience_(A) {}
+    namespace {
+        /**
+         * @brief This function returns nodes and weights for Gauss-Legendre quadrature.
+         *
+         * They are computed once with the Golub-Welsch algorithm, as the
+         * eigenvalues and first eigenvector components of the Jacobi matrix
+         * of the Legendre polynomials. Nodes are mapped to [0,1] and the
+         * weights normalized to sum up to one, so that sum_i w_i f(x_i)
+         * approximates the mean of f over [0,1].
+         */
+        const std::pair<Vector, Vector> & gaussLegendre() {
+            static const auto retval = []{
+                constexpr int N = 8;
+                Matrix2D jacobi = Matrix2D::Zero(N, N);
+                for ( int i = 1; i < N; ++i )
+                    jacobi(i, i-1) = jacobi(i-1, i) = i / std::sqrt(4.0 * i * i - 1.0);
+
+                const Eigen::SelfAdjointEigenSolver<Matrix2D> solver(jacobi);
+                Vector nodes = (solver.eigenvalues().array() + 1.0) / 2.0;
+                Vector weights = solver.eigenvectors().row(0).transpose().array().square();
+                weights /= weights.sum();
+                return std::make_pair(std::move(nodes), std::move(weights));
+            }();
+            return retval;
+        }
+    }
+
+    ThompsonSamplingPolicy::ThompsonSamplingPolicy(const size_t A) :
+            Base(A), experience_(A), policy_(A), cacheValid_(false) {}
 
     void ThompsonSamplingPolicy::stepUpdateP(const size_t a, const double reward) {
         auto & [avg, tries] = experience_[a];
         // Rolling average for this bandit arm
         avg = (tries * avg + reward) / (tries + 1);
         ++tries;
+
+        cacheValid_ = false;
     }
 
     size_t ThompsonSamplingPolicy::sampleAction() const {
@@ -33,77 +67,73 @@ namespace AIToolbox::Bandit {
     }
 
     double ThompsonSamplingPolicy::getActionProbability(const size_t & a) const {
-        // The true formula here would be:
-        //
-        // \int_{-infty, +infty} PDF(N(a)) * CDF(N(0)) * ... * CDF(N(A-1))
-        //
-        // Where N(x) means the normal distribution obtained from the
-        // parameters of that action.
-        //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 100000;
-        unsigned selected = 0;
-
-        // We avoid recreating the distributions thousands of times here.
-        std::vector<std::normal_distribution<double>> dists;
-        dists.reserve(A);
-
-        for (size_t aa = 0; aa < A; ++aa)
-            dists.emplace_back(experience_[aa].first, 1.0 / (experience_[aa].second + 1));
-
-        for (size_t i = 0; i < trials; ++i) {
-            size_t bestAction = 0;
-            double bestValue = dists[0](rand_);
-            for ( size_t aa = 1; aa < A; ++aa ) {
-                const auto val = dists[aa](rand_);
-
-                if ( val > bestValue ) {
-                    bestAction = aa;
-                    bestValue = val;
-                }
-            }
-            if (bestAction == a) ++selected;
-        }
-        return static_cast<double>(selected) / trials;
+        if ( !cacheValid_ ) computePolicy();
+        return policy_[a];
     }
 
     Vector ThompsonSamplingPolicy::getPolicy() const {
-        // The true formula here would be:
+        if ( !cacheValid_ ) computePolicy();
+        return policy_;
+    }
+
+    void ThompsonSamplingPolicy::computePolicy() const {
+        // The true formula here is:
         //
         // \int_{-infty, +infty} PDF(N(a)) * CDF(N(0)) * ... * CDF(N(A-1))
         //
         // Where N(x) means the normal distribution obtained from the
-        // parameters of that action.
+        // parameters of that action (skipping the CDF of a itself).
         //
-        // Instead we sample, which is easier and possibly faster if we just
-        // want a rough approximation.
-        constexpr unsigned trials = 100000;
-
-        Vector retval{A};
-        retval.fill(0.0);
-
-        // We avoid recreating the distributions thousands of times here.
-        std::vector<std::normal_distribution<double>> dists;
-        dists.reserve(A);
-
-        for (size_t aa = 0; aa < A; ++aa)
-            dists.emplace_back(experience_[aa].first, 1.0 / (experience_[aa].second + 1));
-
-        for (size_t i = 0; i < trials; ++i) {
-            size_t bestAction = 0;
-            double bestValue = dists[0](rand_);
-            for ( size_t aa = 1; aa < A; ++aa ) {
-                const auto val = dists[aa](rand_);
-
-                if ( val > bestValue ) {
-                    bestAction = aa;
-                    bestValue = val;
+        // The posteriors can have very different widths, and the CDF of a
+        // narrow one looks like a step to a wide one, so a single
+        // quadrature rule centered on each action does not work. Instead
+        // we split the real line at every action's mean +- k standard
+        // deviations, so that no piece is wider than the scale of the
+        // functions that change in it, and integrate all actions together
+        // with a Gauss-Legendre rule on each piece.
+        constexpr int K = 8;
+        constexpr double sqrt2   = 1.41421356237309504880;
+        constexpr double sqrt2pi = 2.50662827463100050242;
+        const auto & [nodes, weights] = gaussLegendre();
+
+        Vector mu(A), sigma(A);
+        std::vector<double> breaks;
+        breaks.reserve(A * (2 * K + 1));
+        for ( size_t a = 0; a < A; ++a ) {
+            mu[a] = experience_[a].first;
+            sigma[a] = 1.0 / (experience_[a].second + 1);
+            for ( int k = -K; k <= K; ++k )
+                breaks.push_back(mu[a] + k * sigma[a]);
+        }
+        std::sort(std::begin(breaks), std::end(breaks));
+        breaks.erase(std::unique(std::begin(breaks), std::end(breaks)), std::end(breaks));
+
+        policy_.setZero();
+        Vector pdf(A), cdf(A), suffix(A + 1);
+        for ( size_t i = 1; i < breaks.size(); ++i ) {
+            const double width = breaks[i] - breaks[i-1];
+            for ( Eigen::Index n = 0; n < nodes.size(); ++n ) {
+                const double x = breaks[i-1] + width * nodes[n];
+                for ( size_t a = 0; a < A; ++a ) {
+                    const double z = (x - mu[a]) / sigma[a];
+                    pdf[a] = std::exp(-0.5 * z * z) / (sigma[a] * sqrt2pi);
+                    cdf[a] = 0.5 * std::erfc(-z / sqrt2);
+                }
+                // Products of all CDFs but one, through prefix and suffix
+                // products.
+                suffix[A] = 1.0;
+                for ( size_t a = A; a > 0; --a )
+                    suffix[a-1] = suffix[a] * cdf[a-1];
+
+                double prefix = width * weights[n];
+                for ( size_t a = 0; a < A; ++a ) {
+                    policy_[a] += prefix * pdf[a] * suffix[a+1];
+                    prefix *= cdf[a];
                 }
             }
-            retval[bestAction] += 1.0;
         }
-        retval /= retval.sum();
-        return retval;
+        // Remove the residual quadrature error.
+        policy_ /= policy_.sum();
+        cacheValid_ = true;
     }
 }
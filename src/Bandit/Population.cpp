@@ -0,0 +1,95 @@
+#include <AIToolbox/Bandit/Population.hpp>
+
+#include <random>
+
+#include <AIToolbox/Impl/Seeder.hpp>
+#include <AIToolbox/Utils/Core.hpp>
+
+namespace AIToolbox::Bandit {
+    Population::Population(const size_t n, const size_t a) :
+            N(n), A(a), averages_(N, A), tries_(N, A), buffer_(A),
+            rand_(Impl::Seeder::getSeed())
+    {
+        reset();
+    }
+
+    void Population::stepUpdateP(const size_t i, const size_t a, const double r) {
+        auto & avg = averages_(i, a);
+        auto & tries = tries_(i, a);
+
+        // Incremental rolling average, which loses less precision in
+        // single precision than recomputing the total.
+        ++tries;
+        avg += (static_cast<float>(r) - avg) / tries;
+    }
+
+    size_t Population::sampleGreedyAction(const size_t i) const {
+        return sampleGreedy(i, rand_);
+    }
+
+    size_t Population::sampleThompsonAction(const size_t i) const {
+        return sampleThompson(i, buffer_, rand_);
+    }
+
+    size_t Population::sampleGreedy(const size_t i, RandomEngine & rnd) const {
+        const auto row = averages_.row(i);
+
+        // This work is due to multiple max-valued actions
+        size_t bestAction = 0;
+        double bestValue = row[0]; unsigned bestActionCount = 1;
+        for ( size_t a = 1; a < A; ++a ) {
+            const double val = row[a];
+            if ( checkEqualGeneral(val, bestValue) ) {
+                ++bestActionCount;
+                // Reservoir sampling among the tied actions, so we
+                // don't need to store them.
+                if ( std::uniform_int_distribution<unsigned>(0, bestActionCount-1)(rnd) == 0 )
+                    bestAction = a;
+            }
+            else if ( val > bestValue ) {
+                bestAction = a;
+                bestActionCount = 1;
+                bestValue = val;
+            }
+        }
+        return bestAction;
+    }
+
+    size_t Population::sampleThompson(const size_t i, Vectorf & buffer, RandomEngine & rnd) const {
+        std::normal_distribution<float> dist;
+        for ( size_t a = 0; a < A; ++a )
+            buffer[a] = dist(rnd);
+
+        // Scale standard normal samples to N(avg, 1/(tries+1)) for all arms
+        // at once, and pick the best.
+        Eigen::Index bestAction;
+        (averages_.row(i).array() + buffer.transpose().array() / (tries_.row(i).cast<float>().array() + 1.0f))
+            .maxCoeff(&bestAction);
+
+        return bestAction;
+    }
+
+    void Population::reset() {
+        averages_.setZero();
+        tries_.setZero();
+    }
+
+    double Population::getAverage(const size_t i, const size_t a) const {
+        return averages_(i, a);
+    }
+
+    unsigned long Population::getTries(const size_t i, const size_t a) const {
+        return tries_(i, a);
+    }
+
+    const Population::AverageTable & Population::getAverages() const {
+        return averages_;
+    }
+
+    const Population::CountTable & Population::getTries() const {
+        return tries_;
+    }
+
+    size_t Population::getN() const { return N; }
+    size_t Population::getA() const { return A; }
+}
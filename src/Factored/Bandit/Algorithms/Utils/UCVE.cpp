@@ -20,7 +20,18 @@ namespace AIToolbox::Factored::Bandit {
      *
      * @return A new list containing all cross-sums.
      */
-    UCVE::Entries crossSum(const UCVE::Entries & lhs, const UCVE::Entries & rhs);
+    UCVE::SmallEntries crossSum(const UCVE::SmallEntries & lhs, const UCVE::SmallEntries & rhs);
+
+    /**
+     * @brief This function appends the cross-sums of the input lists to the output.
+     *
+     * \sa crossSum(const UCVE::SmallEntries &, const UCVE::SmallEntries &);
+     *
+     * @param lhs The left hand side.
+     * @param rhs The right hand side.
+     * @param out The list to append the cross-sums to.
+     */
+    void crossSum(const UCVE::SmallEntries & lhs, const UCVE::SmallEntries & rhs, UCVE::SmallEntries * out);
 
     /**
      * @brief This function cross-sums the input lists.
@@ -29,14 +40,14 @@ namespace AIToolbox::Factored::Bandit {
      * single joined list. This is useful considering how the getPayoffs()
      * function works.
      *
-     * \sa crossSum(const UCVE::Entries &, const UCVE::Entries &);
+     * \sa crossSum(const UCVE::SmallEntries &, const UCVE::SmallEntries &);
      *
      * @param lhs The left hand side.
      * @param rhs A list of pointers to valid Entries lists.
      *
      * @return A new list containing all cross-sums.
      */
-    UCVE::Entries crossSum(const UCVE::Entries & lhs, const std::vector<const UCVE::Entries*> rhs);
+    UCVE::SmallEntries crossSum(const UCVE::SmallEntries & lhs, const std::vector<const UCVE::SmallEntries*> & rhs);
 
     /**
      * @brief This function returns a list of pointers to all Entries from the Rules matching the input joint action.
@@ -46,7 +57,7 @@ namespace AIToolbox::Factored::Bandit {
      *
      * @return A list of pointers to the Entries contained in the Rules matched against the input action.
      */
-    std::vector<const UCVE::Entries*> getPayoffs(const UCVE::Rules & rules, const PartialAction & jointAction);
+    std::vector<const UCVE::SmallEntries*> getPayoffs(const UCVE::Rules & rules, const PartialAction & jointAction);
 
     /**
      * @brief This function returns cross-sums common elements between the input plus all unique Rules.
@@ -65,7 +76,7 @@ namespace AIToolbox::Factored::Bandit {
     UCVE::UCVE(Action a, double logtA) : A(std::move(a)), graph_(A.size()), logtA_(logtA * 0.5) {}
 
     // We use this to compute the UCB value given a bound
-    double computeValue(const UCVE::Entry & e, const double x, const double logtA);
+    double computeValue(const UCVE::SmallEntry & e, const double x, const double logtA);
 
     UCVE::Result UCVE::start() {
         // This can possibly be improved with some heuristic ordering
@@ -76,6 +87,7 @@ namespace AIToolbox::Factored::Bandit {
         if (finalFactors_.size() == 0) return {};
 
         AI_LOGGER(AI_SEVERITY_DEBUG, "Picking best final factors...");
+        SmallPartialAction tags;
         Result retval; std::get<1>(retval).fill(0.0);
         for (const auto & fValue : finalFactors_) {
             const auto begin = fValue.begin(), end = fValue.end();
@@ -89,9 +101,10 @@ namespace AIToolbox::Factored::Bandit {
                     maxIt = it;
                 }
             }
-            std::get<0>(retval) = merge(std::get<0>(retval), std::get<0>(*maxIt));
+            inplace_merge(&tags, std::get<0>(*maxIt));
             std::get<1>(retval) += std::get<1>(*maxIt);
         }
+        std::get<0>(retval) = toPartialFactors(tags);
         return retval;
     }
 
@@ -147,14 +160,17 @@ namespace AIToolbox::Factored::Bandit {
         Rules newRules;
         PartialFactorsEnumerator jointActions(A, agents, agent);
         const auto id = jointActions.getFactorToSkipId();
+        // We reuse this buffer for the entries of every action, so that it
+        // is only reallocated when the cross-sums grow it.
+        SmallEntries newEntries;
         while (jointActions.isValid()) {
             auto & jointAction = *jointActions;
 
-            Entries values;
+            SmallEntries values;
             for (size_t agentAction = 0; agentAction < A[agent]; ++agentAction) {
                 jointAction.second[id] = agentAction;
 
-                Entries newEntries;
+                newEntries.clear();
                 for (const auto p : getPayoffs(factors[0]->getData().rules, jointAction))
                     newEntries.insert(std::end(newEntries), std::begin(*p), std::end(*p));
 
@@ -191,7 +207,7 @@ namespace AIToolbox::Factored::Bandit {
                 // really need anymore.
                 if (!isFinalFactor) {
                     AI_LOGGER(AI_SEVERITY_DEBUG, "Found new rule...");
-                    newRules.emplace_back(removeFactor(jointAction, agent), std::move(values));
+                    newRules.emplace_back(removeFactor(toSmallPartialFactors(jointAction), agent), std::move(values));
                 } else {
                     AI_LOGGER(AI_SEVERITY_DEBUG, "Adding final factor...");
                     finalFactors_.emplace_back(std::move(values));
@@ -226,17 +242,17 @@ namespace AIToolbox::Factored::Bandit {
         }
     }
 
-    double computeValue(const UCVE::Entry & e, const double x, const double logtA) {
+    double computeValue(const UCVE::SmallEntry & e, const double x, const double logtA) {
         // Note: the 1/2 is implied in logtA
         return std::get<1>(e)[0] + std::sqrt((std::get<1>(e)[1] + x) * logtA);
     };
 
-    UCVE::Entries::iterator UCVE::boundPrune(const Entries::iterator begin, Entries::iterator end, const double x_l, const double x_u) {
+    UCVE::SmallEntries::iterator UCVE::boundPrune(const SmallEntries::iterator begin, SmallEntries::iterator end, const double x_l, const double x_u) {
         if ( std::distance(begin, end) < 2 ) return end;
 
         // We first eliminate all dominated vectors, then we remove all that
         // can't possibly be useful using the bounds we have computed.
-        const auto unwrap = +[](UCVE::Entry & entry) -> UCVE::V & {return std::get<1>(entry);};
+        const auto unwrap = +[](UCVE::SmallEntry & entry) -> UCVE::V & {return std::get<1>(entry);};
         const auto rbegin = boost::make_transform_iterator(begin, unwrap);
         const auto rend   = boost::make_transform_iterator(end, unwrap);
 
@@ -254,11 +270,11 @@ namespace AIToolbox::Factored::Bandit {
         // Put the best first so we can use <= for the pruning (otherwise if we
         // didn't know we would be forced to use < to avoid removing the best)
         iter_swap(begin, maxIt);
-        return std::remove_if(begin + 1, end, [max, x_u, logtA = logtA_](const UCVE::Entry & e) { return computeValue(e, x_u, logtA) <= max; });
+        return std::remove_if(begin + 1, end, [max, x_u, logtA = logtA_](const UCVE::SmallEntry & e) { return computeValue(e, x_u, logtA) <= max; });
     }
 
-    std::vector<const UCVE::Entries*> getPayoffs(const UCVE::Rules & rules, const PartialAction & jointAction) {
-        std::vector<const UCVE::Entries*> retval;
+    std::vector<const UCVE::SmallEntries*> getPayoffs(const UCVE::Rules & rules, const PartialAction & jointAction) {
+        std::vector<const UCVE::SmallEntries*> retval;
         // Note here that we must use match since the factors adjacent to
         // one agent aren't all next to all its neighbors. Since they are
         // different, we must coarsely check that equal agents do equal
@@ -269,33 +285,47 @@ namespace AIToolbox::Factored::Bandit {
         return retval;
     }
 
-    UCVE::Entries crossSum(const UCVE::Entries & lhs, const std::vector<const UCVE::Entries*> rhs) {
+    UCVE::SmallEntries crossSum(const UCVE::SmallEntries & lhs, const std::vector<const UCVE::SmallEntries*> & rhs) {
         if (!rhs.size()) return lhs;
 
-        UCVE::Entries retval;
-        for (auto p : rhs) {
-            auto tmp = crossSum(lhs, *p);
-            retval.insert(std::end(retval), std::make_move_iterator(std::begin(tmp)),
-                                            std::make_move_iterator(std::end(tmp)));
-        }
+        // We size the result once and append to it directly, rather than
+        // building a temporary list for each rhs.
+        size_t size = 0;
+        for (const auto p : rhs)
+            size += (lhs.size() && p->size()) ? lhs.size() * p->size() : lhs.size() + p->size();
+
+        UCVE::SmallEntries retval;
+        retval.reserve(size);
+        for (const auto p : rhs)
+            crossSum(lhs, *p, &retval);
+
         return retval;
     }
 
-    UCVE::Entries crossSum(const UCVE::Entries & lhs, const UCVE::Entries & rhs) {
+    UCVE::SmallEntries crossSum(const UCVE::SmallEntries & lhs, const UCVE::SmallEntries & rhs) {
         if (!lhs.size()) return rhs;
         if (!rhs.size()) return lhs;
-        UCVE::Entries retval;
-        retval.reserve(lhs.size() + rhs.size());
+        UCVE::SmallEntries retval;
+        retval.reserve(lhs.size() * rhs.size());
+        crossSum(lhs, rhs, &retval);
+        return retval;
+    }
+
+    void crossSum(const UCVE::SmallEntries & lhs, const UCVE::SmallEntries & rhs, UCVE::SmallEntries * out) {
+        if (!lhs.size() || !rhs.size()) {
+            const auto & nonEmpty = lhs.size() ? lhs : rhs;
+            out->insert(std::end(*out), std::begin(nonEmpty), std::end(nonEmpty));
+            return;
+        }
         // We do the rhs last since they'll usually be shorter (due to
         // this class usage), so hopefully we can use the cache better.
         for (const auto & lhsVal : lhs) {
             for (const auto & rhsVal : rhs) {
                 auto tags = merge(std::get<0>(lhsVal), std::get<0>(rhsVal));
                 auto values = std::get<1>(lhsVal) + std::get<1>(rhsVal);
-                retval.emplace_back(std::move(tags), std::move(values));
+                out->emplace_back(std::move(tags), std::move(values));
             }
         }
-        return retval;
     }
 
     bool ruleComp(const UCVE::Rule & lhs, const UCVE::Rule & rhs) {
@@ -15,7 +15,7 @@ namespace AIToolbox::Factored::Bandit {
      *
      * @return The sum of all matching Rules' values.
      */
-    double getPayoff(const VE::Rules & rules, const PartialAction & jointAction, PartialAction * tags = nullptr);
+    double getPayoff(const VE::Rules & rules, const PartialAction & jointAction, SmallPartialAction * tags = nullptr);
 
     VE::VariableElimination(Action a) : A(std::move(a)), graph_(A.size()) {}
 
@@ -46,10 +46,12 @@ namespace AIToolbox::Factored::Bandit {
 
         const bool isFinalFactor = agents.size() == 1;
 
+        // We reuse the tag buffers across iterations to avoid allocating
+        // for every action of every joint action.
+        SmallPartialAction newTag, bestTag;
         while (jointActions.isValid()) {
             auto & jointAction = *jointActions;
             double bestPayoff = std::numeric_limits<double>::lowest();
-            PartialAction bestTag;
 
             // So here we're trying to create a single rule with a value
             // optimal for this particular joint action for this subset of
@@ -63,7 +65,8 @@ namespace AIToolbox::Factored::Bandit {
                 jointAction.second[id] = agentAction;
 
                 double newPayoff = 0.0;
-                PartialAction newTag{{agent}, {agentAction}};
+                newTag.first.assign(1, agent);
+                newTag.second.assign(1, agentAction);
                 // The idea here is that we sum all values for all factors
                 // touching these agents. In doing so, we also track all
                 // actions of all other agents that contributed in the
@@ -77,12 +80,12 @@ namespace AIToolbox::Factored::Bandit {
                 // We only select the agent's best action.
                 if (newPayoff > bestPayoff) {
                     bestPayoff = newPayoff;
-                    bestTag = std::move(newTag);
+                    std::swap(bestTag, newTag);
                 }
             }
             if (checkDifferentGeneral(bestPayoff, std::numeric_limits<double>::lowest())) {
                 if (!isFinalFactor) {
-                    newRules.emplace_back(removeFactor(jointAction, agent), Entry{bestPayoff, std::move(bestTag)});
+                    newRules.emplace_back(removeFactor(toSmallPartialFactors(jointAction), agent), Entry{bestPayoff, std::move(bestTag)});
                 } else {
                     finalFactors_.emplace_back(bestPayoff, std::move(bestTag));
                 }
@@ -107,7 +110,7 @@ namespace AIToolbox::Factored::Bandit {
         }
     }
 
-    double getPayoff(const VE::Rules & rules, const PartialAction & jointAction, PartialAction * tags) {
+    double getPayoff(const VE::Rules & rules, const PartialAction & jointAction, SmallPartialAction * tags) {
         double result = 0.0;
         // Note here that we must use match since the factors adjacent to
         // one agent aren't all next to all its neighbors. Since they are
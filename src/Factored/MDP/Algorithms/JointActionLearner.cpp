@@ -7,6 +7,7 @@ namespace AIToolbox::Factored::MDP {
             stateActionCounts_(boost::extents[ss][A.size() - 1]),
             singleQFun_(ss, A[id_]),
             jointActions_(A, id_),
+            jointIndex_(A),
             qLearning_(ss, factorSpace(A), d, al)
     {
         singleQFun_.fill(0.0);
@@ -27,7 +28,7 @@ namespace AIToolbox::Factored::MDP {
         }
 
         // QLearning update
-        const auto jointA = toIndex(A, aa);
+        const auto jointA = jointIndex_.encode(aa);
         qLearning_.stepUpdateQ(s, jointA, s1, rew);
 
         // Single QFunction update
@@ -46,13 +47,13 @@ namespace AIToolbox::Factored::MDP {
                 p /= stateCounters_[s];
             }
 
-            // Finally, update the row for the single QFunction.
-            for (size_t ai = 0; ai < A[id_]; ++ai) {
-                jointAction.second[id_] = ai;
-                const auto aa = toIndex(A, jointAction.second);
-
-                singleQFun_(s, ai) += qLearning_.getQFunction()(s, aa) * p;
-            }
+            // Finally, update the row for the single QFunction. Our own
+            // action only shifts the joint index by a fixed amount.
+            jointAction.second[id_] = 0;
+            const auto baseA = jointIndex_.encode(jointAction);
+            const auto step = jointIndex_.getMultiplier(id_);
+            for (size_t ai = 0; ai < A[id_]; ++ai)
+                singleQFun_(s, ai) += qLearning_.getQFunction()(s, baseA + ai * step) * p;
             jointActions_.advance();
         }
     }
@@ -27,32 +27,47 @@ namespace AIToolbox::Factored::MDP {
         const auto rules = rules_.filter(s1, 0); // Partial filter using only s1
         const auto a1 = std::get<0>(ve(rules));
 
-        auto beforeRules = rules_.filter(join(s, a));
-        const auto afterRules = rules_.filter(join(s1, a1));
+        // We join states and actions in a reused buffer; the filter does
+        // not keep it, so the same one serves both lookups.
+        const auto joinSA = [this](const State & ss, const Action & aa) -> const Factors & {
+            stateAction_.assign(std::begin(ss), std::end(ss));
+            stateAction_.insert(std::end(stateAction_), std::begin(aa), std::end(aa));
+            return stateAction_;
+        };
+        auto beforeRules = rules_.filter(joinSA(s, a));
+        const auto afterRules = rules_.filter(joinSA(s1, a1));
 
-        const auto computeQ = [](const size_t agent, const decltype(rules_)::Iterable & rules) {
-            double sum = 0.0;
-            for (const auto & rule : rules)
-                sum += sequential_sorted_contains(rule.action.first, agent) ? rule.value / rule.action.first.size() : 0.0;
-            return sum;
+        // The Q of each agent is the sum of the values of the rules it
+        // takes part in, each split evenly among its agents. We compute it
+        // for all agents in a single pass over the rules, rather than once
+        // per agent of every rule we update.
+        const auto computeQ = [this](const decltype(rules_)::Iterable & rules, std::vector<double> & q) {
+            q.assign(A.size(), 0.0);
+            for (const auto & rule : rules) {
+                const double share = rule.value / rule.action.first.size();
+                for (const auto agent : rule.action.first)
+                    q[agent] += share;
+            }
         };
+        computeQ(beforeRules, beforeQ_);
+        computeQ(afterRules, afterQ_);
+
         // First we compute all updates since we don't want to risk
         // overwriting the rules before we are done.
-        std::vector<double> updates;
-        updates.reserve(beforeRules.size());
+        updates_.clear();
         for (const auto & br : beforeRules) {
             double sum = 0;
             for (const auto agent : br.action.first) {
                 sum += rew[agent];
-                sum += discount_ * computeQ(agent, afterRules);
-                sum -= computeQ(agent, beforeRules);
+                sum += discount_ * afterQ_[agent];
+                sum -= beforeQ_[agent];
             }
-            updates.push_back(alpha_ * sum);
+            updates_.push_back(alpha_ * sum);
         }
         // Finally update the rules.
         size_t i = 0;
         for (auto & br : beforeRules)
-            br.value += updates[i++];
+            br.value += updates_[i++];
 
         return a1;
     }
@@ -39,7 +39,7 @@ namespace AIToolbox::Factored::MDP {
                 lp.pushRow(LP::Constraint::Equal, 0.0);
                 lp.row[currentRule+1] = 0.0;
 
-                newFactor->getData().emplace_back(entry.state, currentRule);
+                newFactor->getData().emplace_back(toSmallPartialFactors(entry.state), currentRule);
                 currentRule += 2;
             }
             lp.row[wi++] = 0.0;
@@ -58,7 +58,7 @@ namespace AIToolbox::Factored::MDP {
                 lp.pushRow(LP::Constraint::Equal, entry.value);
                 lp.row[currentRule+1] = 0.0;
 
-                newFactor->getData().emplace_back(entry.state, currentRule);
+                newFactor->getData().emplace_back(toSmallPartialFactors(entry.state), currentRule);
                 currentRule += 2;
             }
         }
@@ -73,8 +73,8 @@ namespace AIToolbox::Factored::MDP {
         lp.row.fill(0.0);
         lp.row[phiId] = -1.0;
 
-        for (const auto ruleIds : finalFactors_)
-            for (const auto ruleId : ruleIds)
+        for (const auto & ruleIds : finalFactors_)
+            for (const auto & ruleId : ruleIds)
                 lp.row[std::get<1>(ruleId)] = 1.0;
 
         lp.pushRow(LP::Constraint::LessEqual, 0.0);
@@ -112,36 +112,46 @@ namespace AIToolbox::Factored::MDP {
         // variables, we create two rules: one for (Cw - b) and one for (b -
         // Cw).
 
+        // The ids of the rules matching the current assignment. We only
+        // write those in the row, rather than clearing and scanning all of
+        // it for every constraint.
+        std::vector<size_t> matched;
         while (jointActions.isValid()) {
             auto & jointAction = *jointActions;
             lp.addColumn();
             lp.addColumn();
+            // Adding columns reallocates the row, so we clear it once here.
+            lp.row.fill(0.0);
 
             const size_t newRuleId = lp.row.size() - 2;
 
             for (size_t sAction = 0; sAction < S[s]; ++sAction) {
-                lp.row.fill(0.0);
-                lp.row[newRuleId] = -1.0;
-
                 jointAction.second[id] = sAction;
+
+                matched.clear();
                 for (const auto ruleIds : factors)
-                    for (const auto ruleId : ruleIds->getData())
+                    for (const auto & ruleId : ruleIds->getData())
                         if (match(jointAction, std::get<0>(ruleId)))
-                            lp.row[std::get<1>(ruleId)] = 1.0;
+                            matched.push_back(std::get<1>(ruleId));
+
+                lp.row[newRuleId] = -1.0;
+                for (const auto r : matched) lp.row[r] = 1.0;
 
                 lp.pushRow(LP::Constraint::LessEqual, 0.0);
 
                 // Now do the reverse for all opposite rules (same rules +1)
-                for (int i = lp.row.size() - 2; i >= 0; --i) {
-                    if (lp.row[i] != 0.0) {
-                        lp.row[i+1] = lp.row[i];
-                        lp.row[i] = 0.0;
-                    }
-                }
+                lp.row[newRuleId] = 0.0;
+                for (const auto r : matched) lp.row[r] = 0.0;
+                lp.row[newRuleId+1] = -1.0;
+                for (const auto r : matched) lp.row[r+1] = 1.0;
+
                 lp.pushRow(LP::Constraint::LessEqual, 0.0);
+
+                lp.row[newRuleId+1] = 0.0;
+                for (const auto r : matched) lp.row[r+1] = 0.0;
             }
 
-            newRules.emplace_back(*jointActions, newRuleId);
+            newRules.emplace_back(toSmallPartialFactors(*jointActions), newRuleId);
             jointActions.advance();
         }
 
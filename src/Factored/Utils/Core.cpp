@@ -2,39 +2,89 @@
 
 #include <AIToolbox/Utils/Core.hpp>
 
-namespace AIToolbox::Factored {
-    PartialFactors removeFactor(const PartialFactors & pf, const size_t f) {
-        size_t i = 0;
-        while (i < pf.first.size() && pf.first[i] < f) ++i;
-        if (i == pf.first.size() || pf.first[i] != f) return pf;
+#include <numeric>
 
-        PartialFactors retval;
-        retval.first.reserve(pf.first.size() - 1);
-        retval.second.reserve(pf.first.size() - 1);
+namespace AIToolbox::Factored {
+    namespace {
+        // These work on both PartialFactors and SmallPartialFactors.
+
+        template <typename PF>
+        PF removeFactorImpl(const PF & pf, const size_t f) {
+            size_t i = 0;
+            while (i < pf.first.size() && pf.first[i] < f) ++i;
+            if (i == pf.first.size() || pf.first[i] != f) return pf;
+
+            PF retval;
+            retval.first.reserve(pf.first.size() - 1);
+            retval.second.reserve(pf.first.size() - 1);
+
+            for (size_t j = 0; j < pf.first.size(); ++j) {
+                if (i == j) continue;
+                retval.first.push_back(pf.first[j]);
+                retval.second.push_back(pf.second[j]);
+            }
+            return retval;
+        }
 
-        for (size_t j = 0; j < pf.first.size(); ++j) {
-            if (i == j) continue;
-            retval.first.push_back(pf.first[j]);
-            retval.second.push_back(pf.second[j]);
+        template <typename B, typename PF>
+        bool matchImpl(const B & bigger, const PF & smaller) {
+            size_t i = 0, j = 0;
+            while (j < smaller.second.size()) {
+                if (i == bigger.first.size()) return false;
+                if (bigger.first[i] < smaller.first[j]) ++i;
+                else if (bigger.first[i] > smaller.first[j]) return false;
+                else {
+                    if (bigger.second[i] != smaller.second[j]) return false;
+                    ++i;
+                    ++j;
+                }
+            }
+            return true;
         }
-        return retval;
-    }
 
-    bool match(const PartialFactors & lhs, const PartialFactors & rhs) {
-        const PartialFactors * smaller = &rhs, * bigger = &lhs;
-        if (lhs.first.size() < rhs.first.size()) std::swap(smaller, bigger);
-
-        size_t i = 0, j = 0;
-        while (j < smaller->second.size()) {
-            if (bigger->first[i] < smaller->first[j]) ++i;
-            else if (bigger->first[i] > smaller->first[j]) return false;
-            else {
-                if (bigger->second[i] != smaller->second[j]) return false;
+        template <typename PF>
+        void inplaceMergeImpl(PF & lhs, const PF & rhs) {
+            lhs.first.reserve(lhs.first.size() + rhs.first.size());
+            lhs.second.reserve(lhs.first.size() + rhs.first.size());
+
+            size_t i = 0, j = 0;
+            while (i < lhs.first.size() && j < rhs.first.size()) {
+                if (lhs.first[i] < rhs.first[j]) { ++i; continue; }
+                lhs.first.insert(std::begin(lhs.first) + i, rhs.first[j]);
+                lhs.second.insert(std::begin(lhs.second) + i, rhs.second[j]);
                 ++i;
                 ++j;
             }
+            lhs.first.insert(std::end(lhs.first), std::begin(rhs.first) + j, std::end(rhs.first));
+            lhs.second.insert(std::end(lhs.second), std::begin(rhs.second) + j, std::end(rhs.second));
+        }
+
+        template <typename PF>
+        Factors toFactorsImpl(const size_t F, const PF & pf) {
+            Factors f(F);
+            for (size_t i = 0; i < pf.first.size(); ++i)
+                f[pf.first[i]] = pf.second[i];
+
+            return f;
         }
-        return true;
+    }
+
+    PartialFactors removeFactor(const PartialFactors & pf, const size_t f) {
+        return removeFactorImpl(pf, f);
+    }
+
+    SmallPartialFactors removeFactor(const SmallPartialFactors & pf, const size_t f) {
+        return removeFactorImpl(pf, f);
+    }
+
+    bool match(const PartialFactors & lhs, const PartialFactors & rhs) {
+        if (lhs.first.size() < rhs.first.size()) return matchImpl(rhs, lhs);
+        return matchImpl(lhs, rhs);
+    }
+
+    bool match(const PartialFactors & lhs, const SmallPartialFactors & rhs) {
+        if (lhs.first.size() < rhs.first.size()) return matchImpl(rhs, lhs);
+        return matchImpl(lhs, rhs);
     }
 
     PartialFactors join(const size_t S, const PartialFactors & lhs, const PartialFactors & rhs) {
@@ -69,23 +119,32 @@ namespace AIToolbox::Factored {
         return retval;
     }
 
+    SmallPartialFactors merge(const SmallPartialFactors & lhs, const SmallPartialFactors & rhs) {
+        SmallPartialFactors retval = lhs;
+        inplaceMergeImpl(retval, rhs);
+        return retval;
+    }
+
     void inplace_merge(PartialFactors * plhs, const PartialFactors & rhs) {
-        if (!plhs) return;
-        auto & lhs = *plhs;
-
-        lhs.first.reserve(lhs.first.size() + rhs.first.size());
-        lhs.second.reserve(lhs.first.size() + rhs.first.size());
-
-        size_t i = 0, j = 0;
-        while (i < lhs.first.size() && j < rhs.first.size()) {
-            if (lhs.first[i] < rhs.first[j]) { ++i; continue; }
-            lhs.first.insert(std::begin(lhs.first) + i, rhs.first[j]);
-            lhs.second.insert(std::begin(lhs.second) + i, rhs.second[j]);
-            ++i;
-            ++j;
-        }
-        lhs.first.insert(std::end(lhs.first), std::begin(rhs.first) + j, std::end(rhs.first));
-        lhs.second.insert(std::end(lhs.second), std::begin(rhs.second) + j, std::end(rhs.second));
+        if (plhs) inplaceMergeImpl(*plhs, rhs);
+    }
+
+    void inplace_merge(SmallPartialFactors * plhs, const SmallPartialFactors & rhs) {
+        if (plhs) inplaceMergeImpl(*plhs, rhs);
+    }
+
+    SmallPartialFactors toSmallPartialFactors(const PartialFactors & pf) {
+        return SmallPartialFactors(
+            SmallFactors(std::begin(pf.first), std::end(pf.first)),
+            SmallFactors(std::begin(pf.second), std::end(pf.second))
+        );
+    }
+
+    PartialFactors toPartialFactors(const SmallPartialFactors & pf) {
+        return PartialFactors(
+            std::vector<size_t>(std::begin(pf.first), std::end(pf.first)),
+            std::vector<size_t>(std::begin(pf.second), std::end(pf.second))
+        );
     }
 
     size_t factorSpace(const Factors & space) {
@@ -122,11 +181,11 @@ namespace AIToolbox::Factored {
     }
 
     Factors toFactors(const size_t F, const PartialFactors & pf) {
-        Factors f(F);
-        for (size_t i = 0; i < pf.first.size(); ++i)
-            f[pf.first[i]] = pf.second[i];
+        return toFactorsImpl(F, pf);
+    }
 
-        return f;
+    Factors toFactors(const size_t F, const SmallPartialFactors & pf) {
+        return toFactorsImpl(F, pf);
     }
 
     Factors toFactors(const Factors & space, size_t id) {
@@ -177,6 +236,50 @@ namespace AIToolbox::Factored {
         return result;
     }
 
+    // PartialIndexEncoder below.
+
+    PartialIndexEncoder::PartialIndexEncoder(const Factors & space) :
+        PartialIndexEncoder(space, [&]{
+            std::vector<size_t> ids(space.size());
+            std::iota(std::begin(ids), std::end(ids), 0);
+            return ids;
+        }()) {}
+
+    PartialIndexEncoder::PartialIndexEncoder(const Factors & space, std::vector<size_t> ids) :
+        ids_(std::move(ids)), sizes_(ids_.size()), multipliers_(ids_.size()), size_(1)
+    {
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            sizes_[i] = space[ids_[i]];
+            multipliers_[i] = size_;
+            size_ *= sizes_[i];
+        }
+    }
+
+    size_t PartialIndexEncoder::encode(const Factors & f) const {
+        size_t result = 0;
+        for (size_t i = 0; i < ids_.size(); ++i)
+            result += multipliers_[i] * f[ids_[i]];
+        return result;
+    }
+
+    size_t PartialIndexEncoder::encode(const PartialFactors & pf) const {
+        size_t result = 0;
+        for (size_t i = 0; i < ids_.size(); ++i)
+            result += multipliers_[i] * pf.second[i];
+        return result;
+    }
+
+    void PartialIndexEncoder::decode(size_t id, Factors * f) const {
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            (*f)[ids_[i]] = id % sizes_[i];
+            id /= sizes_[i];
+        }
+    }
+
+    size_t PartialIndexEncoder::getMultiplier(const size_t i) const { return multipliers_[i]; }
+    size_t PartialIndexEncoder::size() const { return size_; }
+    const std::vector<size_t> & PartialIndexEncoder::getIds() const { return ids_; }
+
     // PartialFactorsEnumerator below.
 
     PartialFactorsEnumerator::PartialFactorsEnumerator(Factors f, std::vector<size_t> factors) :
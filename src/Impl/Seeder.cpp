@@ -2,8 +2,15 @@
 
 #include <chrono>
 #include <limits>
+#include <mutex>
 
 namespace AIToolbox::Impl {
+    namespace {
+        // Executors seed the engines of external threads lazily, so seeds
+        // may be requested from several threads at once.
+        std::mutex seederMutex;
+    }
+
     Seeder Seeder::instance_;
 
     Seeder::Seeder() : generator_(std::chrono::system_clock::now().time_since_epoch().count()) {}
@@ -11,10 +18,12 @@ namespace AIToolbox::Impl {
     unsigned Seeder::getSeed() {
         static std::uniform_int_distribution<unsigned> dist(0, std::numeric_limits<unsigned>::max());
 
+        std::lock_guard<std::mutex> lock(seederMutex);
         return dist(instance_.generator_);
     }
 
     void Seeder::setRootSeed(const unsigned seed) {
+        std::lock_guard<std::mutex> lock(seederMutex);
         instance_.generator_.seed(seed);
     }
 }
@@ -2,16 +2,15 @@
 
 namespace AIToolbox::MDP {
     ExpectedSARSA::ExpectedSARSA(QFunction & qfun, const PolicyInterface & policy, const double discount, const double alpha) :
-            policy_(policy), S(policy_.getS()), A(policy_.getA()), q_(qfun)
+            policy_(policy), S(policy_.getS()), A(policy_.getA()), q_(qfun), probs_(A)
     {
         setDiscount(discount);
         setLearningRate(alpha);
     }
 
     void ExpectedSARSA::stepUpdateQ(const size_t s, const size_t a, const size_t s1, const double rew) {
-        double expectedQ = 0.0;
-        for (size_t ai = 0; ai < A; ++ai)
-            expectedQ += policy_.getActionProbability(s1, ai) * q_(s1, ai);
+        policy_.getActionProbabilities(s1, &probs_);
+        const double expectedQ = q_.row(s1) * probs_;
 
         q_(s, a) += alpha_ * ( rew + discount_ * expectedQ - q_(s, a) );
     }
@@ -0,0 +1,126 @@
+#include <AIToolbox/MDP/Algorithms/TopologicalValueIteration.hpp>
+
+namespace AIToolbox::MDP {
+    TopologicalValueIteration::TopologicalValueIteration(const unsigned horizon, const double tolerance) :
+            horizon_(horizon)
+    {
+        setTolerance(tolerance);
+    }
+
+    void TopologicalValueIteration::computeComponents(const size_t S) {
+        // Iterative version of Tarjan's algorithm, since recursion could
+        // overflow the stack on large models. Tarjan emits each component
+        // only after all the components reachable from it, which is
+        // exactly the order in which we need to solve them.
+        constexpr size_t unvisited = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> index(S, unvisited), lowlink(S);
+        std::vector<bool> onStack(S, false);
+        std::vector<size_t> stack;
+        // DFS stack: node and position of the next successor to visit.
+        std::vector<std::pair<size_t, size_t>> dfs;
+
+        components_.clear();
+        componentOffsets_.clear();
+        componentOffsets_.push_back(0);
+
+        size_t counter = 0;
+        for ( size_t root = 0; root < S; ++root ) {
+            if ( index[root] != unvisited ) continue;
+
+            dfs.emplace_back(root, graphOffsets_[root]);
+            index[root] = lowlink[root] = counter++;
+            stack.push_back(root);
+            onStack[root] = true;
+
+            while ( dfs.size() ) {
+                auto & [s, next] = dfs.back();
+                if ( next < graphOffsets_[s+1] ) {
+                    const auto s1 = graph_[next++];
+                    if ( index[s1] == unvisited ) {
+                        index[s1] = lowlink[s1] = counter++;
+                        stack.push_back(s1);
+                        onStack[s1] = true;
+                        // Note that this invalidates s and next.
+                        dfs.emplace_back(s1, graphOffsets_[s1]);
+                    } else if ( onStack[s1] ) {
+                        lowlink[s] = std::min(lowlink[s], index[s1]);
+                    }
+                    continue;
+                }
+                const auto done = s;
+                dfs.pop_back();
+                if ( dfs.size() )
+                    lowlink[dfs.back().first] = std::min(lowlink[dfs.back().first], lowlink[done]);
+
+                if ( lowlink[done] == index[done] ) {
+                    size_t s1;
+                    do {
+                        s1 = stack.back();
+                        stack.pop_back();
+                        onStack[s1] = false;
+                        components_.push_back(s1);
+                    } while ( s1 != done );
+                    componentOffsets_.push_back(components_.size());
+                }
+            }
+        }
+    }
+
+    void TopologicalValueIteration::computeLevels(const size_t S) {
+        const size_t C = getComponentsNumber();
+
+        std::vector<size_t> componentOf(S);
+        for ( size_t c = 0; c < C; ++c )
+            for ( size_t i = componentOffsets_[c]; i < componentOffsets_[c+1]; ++i )
+                componentOf[components_[i]] = c;
+
+        // Components are in reverse topological order, so the levels of
+        // all the successors of a component are known when we reach it.
+        std::vector<size_t> level(C, 0);
+        size_t maxLevel = 0;
+        for ( size_t c = 0; c < C; ++c ) {
+            for ( size_t i = componentOffsets_[c]; i < componentOffsets_[c+1]; ++i ) {
+                const auto s = components_[i];
+                for ( size_t j = graphOffsets_[s]; j < graphOffsets_[s+1]; ++j ) {
+                    const auto c1 = componentOf[graph_[j]];
+                    if ( c1 != c ) level[c] = std::max(level[c], level[c1] + 1);
+                }
+            }
+            maxLevel = std::max(maxLevel, level[c]);
+        }
+
+        // Counting sort of the components by level.
+        levelOffsets_.assign(C ? maxLevel + 2 : 1, 0);
+        for ( size_t c = 0; c < C; ++c )
+            ++levelOffsets_[level[c] + 1];
+        for ( size_t l = 1; l < levelOffsets_.size(); ++l )
+            levelOffsets_[l] += levelOffsets_[l-1];
+
+        levels_.resize(C);
+        auto next = levelOffsets_;
+        for ( size_t c = 0; c < C; ++c )
+            levels_[next[level[c]]++] = c;
+    }
+
+    void TopologicalValueIteration::setTolerance(const double t) {
+        if ( t < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
+        tolerance_ = t;
+    }
+
+    void TopologicalValueIteration::setHorizon(const unsigned h) {
+        horizon_ = h;
+    }
+
+    double TopologicalValueIteration::getTolerance() const { return tolerance_; }
+
+    unsigned TopologicalValueIteration::getHorizon() const { return horizon_; }
+
+    size_t TopologicalValueIteration::getComponentsNumber() const {
+        return componentOffsets_.size() ? componentOffsets_.size() - 1 : 0;
+    }
+
+    size_t TopologicalValueIteration::getLevelsNumber() const {
+        return levelOffsets_.size() ? levelOffsets_.size() - 1 : 0;
+    }
+}
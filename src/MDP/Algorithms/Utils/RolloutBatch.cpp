@@ -0,0 +1,22 @@
+#include <AIToolbox/MDP/Algorithms/Utils/RolloutBatch.hpp>
+
+namespace AIToolbox::MDP {
+    size_t RolloutBatch::add(const size_t s, const unsigned depth) {
+        states_.push_back(s);
+        depths_.push_back(depth);
+        return states_.size() - 1;
+    }
+
+    void RolloutBatch::clear() {
+        states_.clear();
+        depths_.clear();
+    }
+
+    size_t RolloutBatch::size() const {
+        return states_.size();
+    }
+
+    double RolloutBatch::getValue(const size_t id) const {
+        return values_[id];
+    }
+}
@@ -1,5 +1,7 @@
 #include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
 
+#include <AIToolbox/MDP/ShardedModel.hpp>
+
 namespace AIToolbox::MDP {
     ValueIteration::ValueIteration(unsigned horizon, double tolerance, ValueFunction v) :
             horizon_(horizon), vParameter_(v)
@@ -25,4 +27,64 @@ namespace AIToolbox::MDP {
     unsigned ValueIteration::getHorizon() const { return horizon_; }
 
     const ValueFunction & ValueIteration::getValueFunction() const { return vParameter_; }
+
+    std::tuple<double, ValueFunction, QFunction> ValueIteration::operator()(const ShardedModel & model) {
+        const size_t S = model.getS();
+        const size_t A = model.getA();
+        const size_t shards = model.getShardsNumber();
+
+        if ( static_cast<size_t>(vParameter_.values.size()) != S ) {
+            if ( vParameter_.values.size() != 0 ) {
+                AI_LOGGER(AI_SEVERITY_WARNING, "Size of starting value function is incorrect, ignoring...");
+            }
+            v1_ = makeValueFunction(S);
+        }
+        else
+            v1_ = vParameter_;
+
+        const auto executor = Executor::getDefault();
+        // Each worker prefetches the shard it will likely process after
+        // the current one, wrapping around to the next iteration.
+        const size_t ahead = executor->getConcurrency();
+        for ( size_t i = 0; i < std::min(ahead, shards); ++i )
+            model.prefetch(i);
+
+        unsigned timestep = 0;
+        double variation = tolerance_ * 2; // Make it bigger
+
+        Values val0;
+        auto & val1 = v1_.values;
+        auto & actions = v1_.actions;
+        QFunction q = makeQFunction(S, A);
+
+        const double discount = model.getDiscount();
+        const bool useTolerance = checkDifferentSmall(tolerance_, 0.0);
+        while ( timestep < horizon_ && (!useTolerance || variation > tolerance_) ) {
+            ++timestep;
+            AI_LOGGER(AI_SEVERITY_DEBUG, "Processing timestep " << timestep);
+
+            val0 = val1;
+
+            executor->parallelFor(0, shards, [&](const size_t i) {
+                if ( shards > ahead ) model.prefetch((i + ahead) % shards);
+
+                const auto shard = model.getShard(i);
+                for ( size_t k = 0, row = 0; k < shard.states; ++k ) {
+                    const size_t s = shard.firstState + k;
+                    for ( size_t a = 0; a < A; ++a, ++row ) {
+                        double v = 0.0;
+                        for ( auto j = shard.rowPtr[row]; j < shard.rowPtr[row + 1]; ++j )
+                            v += shard.values[j] * val0[shard.cols[j]];
+                        q(s, a) = shard.rewards[row] + discount * v;
+                    }
+                    val1[s] = q.row(s).maxCoeff(&actions[s]);
+                }
+            }, 1);
+
+            if ( useTolerance )
+                variation = (val1 - val0).cwiseAbs().maxCoeff();
+        }
+
+        return std::make_tuple(useTolerance ? variation : 0.0, std::move(v1_), std::move(q));
+    }
 }
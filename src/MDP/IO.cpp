@@ -5,11 +5,14 @@
 #include <AIToolbox/MDP/Model.hpp>
 #include <AIToolbox/MDP/SparseModel.hpp>
 #include <AIToolbox/MDP/Policies/Policy.hpp>
+#include <AIToolbox/MDP/Policies/DeterministicPolicy.hpp>
 
 #include <AIToolbox/Impl/CassandraParser.hpp>
 #include <AIToolbox/Impl/Logging.hpp>
 
 #include <iostream>
+#include <algorithm>
+#include <cstdint>
 
 namespace AIToolbox::MDP {
     Model parseCassandra(std::istream & input) {
@@ -218,4 +221,66 @@ namespace AIToolbox::MDP {
 
         return is;
     }
+
+    namespace {
+        constexpr char deterministicPolicyMagic[4] = {'A', 'I', 'D', 'P'};
+    }
+
+    // MDP::DeterministicPolicy binary writer
+    std::ostream& writeBinary(std::ostream &os, const DeterministicPolicy & p) {
+        const std::uint64_t S = p.getS(), A = p.getA();
+
+        os.write(deterministicPolicyMagic, sizeof(deterministicPolicyMagic));
+        os.write(reinterpret_cast<const char *>(&S), sizeof(S));
+        os.write(reinterpret_cast<const char *>(&A), sizeof(A));
+        os.write(reinterpret_cast<const char *>(p.actions_.data()), p.actions_.size());
+
+        return os;
+    }
+
+    // MDP::DeterministicPolicy binary reader
+    std::istream& readBinary(std::istream &is, DeterministicPolicy & p) {
+        char magic[sizeof(deterministicPolicyMagic)];
+        std::uint64_t S, A;
+
+        if ( !is.read(magic, sizeof(magic)) ||
+             !is.read(reinterpret_cast<char *>(&S), sizeof(S)) ||
+             !is.read(reinterpret_cast<char *>(&A), sizeof(A)) )
+        {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Could not read policy header.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        if ( !std::equal(std::begin(magic), std::end(magic), std::begin(deterministicPolicyMagic)) ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input data is not a deterministic policy.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        if ( S != p.getS() || A != p.getA() ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input policy has size " << S << "x" << A << ", expected " << p.getS() << "x" << p.getA());
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        std::vector<unsigned char> actions(p.actions_.size());
+        if ( !is.read(reinterpret_cast<char *>(actions.data()), actions.size()) ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Could not read policy data.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        // Swap the data in to check the actions, and restore the old
+        // ones if any is invalid.
+        std::swap(actions, p.actions_);
+        for ( size_t s = 0; s < S; ++s ) {
+            if ( p.getAction(s) >= A ) {
+                AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input policy data contains invalid actions.");
+                std::swap(actions, p.actions_);
+                is.setstate(std::ios::failbit);
+                return is;
+            }
+        }
+
+        return is;
+    }
 }
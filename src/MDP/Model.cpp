@@ -1,14 +1,16 @@
 #include <AIToolbox/MDP/Model.hpp>
 
 namespace AIToolbox::MDP {
-    Model::Model(NoCheck, const size_t s, const size_t a, TransitionTable && t, RewardTable && r, const double d) :
+    template <typename Scalar>
+    ModelT<Scalar>::ModelT(NoCheck, const size_t s, const size_t a, TransitionTable && t, RewardTable && r, const double d) :
             S(s), A(a), discount_(d),
             transitions_(std::move(t)),
             rewards_(std::move(r)),
             rand_(Impl::Seeder::getSeed()) {}
 
-    Model::Model(const size_t s, const size_t a, const double discount) :
-            S(s), A(a), discount_(discount), transitions_(A, Matrix2D(S, S)),
+    template <typename Scalar>
+    ModelT<Scalar>::ModelT(const size_t s, const size_t a, const double discount) :
+            S(s), A(a), discount_(discount), transitions_(A, Matrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         // Make transition table true probability
@@ -18,12 +20,15 @@ namespace AIToolbox::MDP {
         rewards_.fill(0.0);
     }
 
-    void Model::setTransitionFunction(const Matrix3D & t) {
+    template <typename Scalar>
+    void ModelT<Scalar>::setTransitionFunction(const TransitionTable & t) {
         // First we verify data, without modifying anything...
         for ( size_t a = 0; a < A; ++a ) {
             for ( size_t s = 0; s < S; ++s ) {
+                // We sum in double precision so that the check does not
+                // depend on the accumulated error of the stored type.
                 if ( t[a].row(s).minCoeff() < 0.0 ||
-                     !checkEqualSmall(1.0, t[a].row(s).sum()) )
+                     !checkEqualSmall(1.0, t[a].row(s).template cast<double>().sum()) )
                 {
                     throw std::invalid_argument("Input transition table does not contain valid probabilities.");
                 }
@@ -33,42 +38,81 @@ namespace AIToolbox::MDP {
         transitions_ = t;
     }
 
-    void Model::setRewardFunction(const RewardTable & r) {
+    template <typename Scalar>
+    void ModelT<Scalar>::setRewardFunction(const RewardTable & r) {
         rewards_ = r;
     }
 
-    std::tuple<size_t, double> Model::sampleSR(const size_t s, const size_t a) const {
-        size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
+    template <typename Scalar>
+    std::tuple<size_t, double> ModelT<Scalar>::sampleSR(const size_t s, const size_t a) const {
+        return sampleSR(s, a, rand_);
+    }
+
+    template <typename Scalar>
+    std::tuple<size_t, double> ModelT<Scalar>::sampleSR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        size_t s1 = sampleProbability(S, transitions_[a].row(s), rnd);
 
         return std::make_tuple(s1, rewards_(s, a));
     }
 
-    double Model::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+    template <typename Scalar>
+    void ModelT<Scalar>::sampleSRBatch(const size_t n, const size_t * s, const size_t * a, size_t * s1, double * r) const {
+        // We use the reward buffer to hold the random numbers, so that
+        // all draws happen together and we don't need to allocate.
+        for ( size_t i = 0; i < n; ++i )
+            r[i] = probabilityDistribution(rand_);
+
+        for ( size_t i = 0; i < n; ++i ) {
+            double p = r[i];
+            s1[i] = S - 1;
+            const auto row = transitions_[a[i]].row(s[i]);
+            for ( size_t j = 0; j < S; ++j ) {
+                if ( row[j] > p ) { s1[i] = j; break; }
+                p -= row[j];
+            }
+            r[i] = rewards_(s[i], a[i]);
+        }
+    }
+
+    template <typename Scalar>
+    double ModelT<Scalar>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
         return transitions_[a](s, s1);
     }
 
-    double Model::getExpectedReward(const size_t s, const size_t a, const size_t) const {
+    template <typename Scalar>
+    double ModelT<Scalar>::getExpectedReward(const size_t s, const size_t a, const size_t) const {
         return rewards_(s, a);
     }
 
-    void Model::setDiscount(const double d) {
+    template <typename Scalar>
+    void ModelT<Scalar>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
     }
 
-    bool Model::isTerminal(const size_t s) const {
+    template <typename Scalar>
+    bool ModelT<Scalar>::isTerminal(const size_t s) const {
         for ( size_t a = 0; a < A; ++a )
             if ( !checkEqualSmall(1.0, transitions_[a](s, s)) )
                 return false;
         return true;
     }
 
-    size_t Model::getS() const { return S; }
-    size_t Model::getA() const { return A; }
-    double Model::getDiscount() const { return discount_; }
+    template <typename Scalar>
+    size_t ModelT<Scalar>::getS() const { return S; }
+    template <typename Scalar>
+    size_t ModelT<Scalar>::getA() const { return A; }
+    template <typename Scalar>
+    double ModelT<Scalar>::getDiscount() const { return discount_; }
+
+    template <typename Scalar>
+    const typename ModelT<Scalar>::TransitionTable & ModelT<Scalar>::getTransitionFunction() const { return transitions_; }
+    template <typename Scalar>
+    const typename ModelT<Scalar>::RewardTable &     ModelT<Scalar>::getRewardFunction()     const { return rewards_; }
 
-    const Model::TransitionTable & Model::getTransitionFunction() const { return transitions_; }
-    const Model::RewardTable &     Model::getRewardFunction()     const { return rewards_; }
+    template <typename Scalar>
+    const Matrix2DT<Scalar> & ModelT<Scalar>::getTransitionFunction(const size_t a) const { return transitions_[a]; }
 
-    const Matrix2D & Model::getTransitionFunction(const size_t a) const { return transitions_[a]; }
+    template class ModelT<double>;
+    template class ModelT<float>;
 }
@@ -0,0 +1,88 @@
+#include <AIToolbox/MDP/Policies/DeterministicPolicy.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace AIToolbox::MDP {
+    namespace {
+        unsigned actionWidth(const size_t A) {
+            if ( A <= std::numeric_limits<std::uint8_t>::max() + 1ul ) return 1;
+            if ( A <= std::numeric_limits<std::uint16_t>::max() + 1ul ) return 2;
+            if ( A <= std::numeric_limits<std::uint32_t>::max() + 1ul ) return 4;
+            throw std::invalid_argument("DeterministicPolicy cannot store more than 2^32 actions");
+        }
+    }
+
+    DeterministicPolicy::DeterministicPolicy(const size_t s, const size_t a) :
+            PolicyInterface::Base(s, a), width_(actionWidth(A)), actions_(S * width_, 0) {}
+
+    DeterministicPolicy::DeterministicPolicy(const size_t s, const size_t a, const ValueFunction & v) :
+            DeterministicPolicy(s, a)
+    {
+        if ( static_cast<size_t>(v.actions.size()) != S )
+            throw std::invalid_argument("Initializing DeterministicPolicy with a ValueFunction of the wrong size");
+
+        for ( size_t s = 0; s < S; ++s )
+            setAction(s, v.actions[s]);
+    }
+
+    DeterministicPolicy::DeterministicPolicy(const Matrix2D & p) :
+            DeterministicPolicy(p.rows(), p.cols())
+    {
+        for ( size_t s = 0; s < S; ++s ) {
+            Eigen::Index a;
+            // A row is deterministic only if it contains exactly one 1.0
+            // and zeroes everywhere else.
+            if ( p.row(s).maxCoeff(&a) != 1.0 || (p.row(s).array() != 0.0).count() != 1 )
+                throw std::invalid_argument("Initializing DeterministicPolicy with a non-deterministic PolicyTable");
+            setAction(s, a);
+        }
+    }
+
+    size_t DeterministicPolicy::getAction(const size_t s) const {
+        const unsigned char * data = actions_.data() + s * width_;
+        switch ( width_ ) {
+            case 1: return *data;
+            case 2: { std::uint16_t a; std::memcpy(&a, data, 2); return a; }
+            default: { std::uint32_t a; std::memcpy(&a, data, 4); return a; }
+        }
+    }
+
+    void DeterministicPolicy::setAction(const size_t s, const size_t a) {
+        // Since the width is chosen from A, any valid action fits in it.
+        if ( a >= A ) throw std::invalid_argument("DeterministicPolicy action " + std::to_string(a) + " is not valid");
+
+        unsigned char * data = actions_.data() + s * width_;
+        switch ( width_ ) {
+            case 1: *data = static_cast<std::uint8_t>(a); break;
+            case 2: { const auto aa = static_cast<std::uint16_t>(a); std::memcpy(data, &aa, 2); break; }
+            default: { const auto aa = static_cast<std::uint32_t>(a); std::memcpy(data, &aa, 4); break; }
+        }
+    }
+
+    size_t DeterministicPolicy::sampleAction(const size_t & s) const {
+        return getAction(s);
+    }
+
+    double DeterministicPolicy::getActionProbability(const size_t & s, const size_t & a) const {
+        return getAction(s) == a ? 1.0 : 0.0;
+    }
+
+    Matrix2D DeterministicPolicy::getPolicy() const {
+        Matrix2D p(S, A);
+        p.setZero();
+        for ( size_t s = 0; s < S; ++s )
+            p(s, getAction(s)) = 1.0;
+        return p;
+    }
+
+    void DeterministicPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        out->resize(A);
+        out->setZero();
+        (*out)[getAction(s)] = 1.0;
+    }
+
+    unsigned DeterministicPolicy::getActionWidth() const { return width_; }
+}
@@ -3,7 +3,7 @@
 namespace AIToolbox::MDP {
     EpsilonPolicy::EpsilonPolicy(const PolicyInterface & p, double epsilon) :
             PolicyInterface::Base(p.getS(), p.getA()), EpsilonBase(p, epsilon),
-            randomDistribution_(0, this->A-1) {}
+            wrapped_(p), randomDistribution_(0, this->A-1) {}
 
     size_t EpsilonPolicy::sampleRandomAction() const {
         return randomDistribution_(rand_);
@@ -14,12 +14,18 @@ namespace AIToolbox::MDP {
     }
 
     Matrix2D EpsilonPolicy::getPolicy() const {
-        const auto & wrapped = dynamic_cast<const PolicyInterface &>(policy_);
-        auto p = wrapped.getPolicy();
+        auto p = wrapped_.getPolicy();
 
         p *= (1.0 - epsilon_);
         p.array() += epsilon_ / A;
 
         return p;
     }
+
+    void EpsilonPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        wrapped_.getActionProbabilities(s, out);
+
+        *out *= (1.0 - epsilon_);
+        out->array() += epsilon_ / A;
+    }
 }
@@ -44,6 +44,10 @@ namespace AIToolbox::MDP {
         return policy_.getPolicy();
     }
 
+    void PGAAPPPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        policy_.getActionProbabilities(s, out);
+    }
+
     void PGAAPPPolicy::setLearningRate(const double lRate) {
         if ( lRate < 0.0 ) throw std::invalid_argument("Learning rate must be >= 0");
         lRate_ = lRate;
@@ -24,4 +24,8 @@ namespace AIToolbox::MDP {
     Matrix2D PolicyWrapper::getPolicy() const {
         return policy_;
     }
+
+    void PolicyWrapper::getActionProbabilities(const size_t & s, Vector * out) const {
+        *out = policy_.row(s).transpose();
+    }
 }
@@ -36,8 +36,26 @@ namespace AIToolbox::MDP {
     }
 
     double QGreedyPolicy::getActionProbability(const size_t & s, const size_t & a) const {
-        const double max = q_(s, a); unsigned count = 0;
-        for ( size_t aa = 0; aa < A; ++aa ) {
+        getActionProbabilities(s, &probabilities_);
+        return probabilities_[a];
+    }
+
+    Matrix2D QGreedyPolicy::getPolicy() const {
+        Matrix2D retval(S, A);
+
+        for (size_t s = 0; s < S; ++s) {
+            getActionProbabilities(s, &probabilities_);
+            retval.row(s) = probabilities_.transpose();
+        }
+
+        return retval;
+    }
+
+    void QGreedyPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        out->resize(A);
+
+        double max = q_(s, 0); unsigned count = 1;
+        for ( size_t aa = 1; aa < A; ++aa ) {
             // The checkEqualGeneral is before the greater since we want to
             // trap here things that may be equal (even if one is a tiny bit
             // higher than the other).
@@ -45,32 +63,15 @@ namespace AIToolbox::MDP {
             // In case the new element is really higher than the other, then we
             // reset the counts.
             else if ( q_(s, aa) > max ) {
-                return 0.0;
+                max = q_(s, aa);
+                count = 1;
             }
         }
-        return 1.0 / count;
-    }
-
-    Matrix2D QGreedyPolicy::getPolicy() const {
-        Matrix2D retval(S, A);
-
-        for (size_t s = 0; s < S; ++s) {
-            double max = q_(s, 0); unsigned count = 1;
-            for ( size_t aa = 1; aa < A; ++aa ) {
-                if ( checkEqualGeneral(q_(s, aa), max) ) ++count;
-                else if ( q_(s, aa) > max ) {
-                    max = q_(s, aa);
-                    count = 1;
-                }
-            }
-            for ( size_t aa = 0; aa < A; ++aa ) {
-                if ( checkEqualGeneral(q_(s, aa), max) )
-                    retval(s, aa) = 1.0 / count;
-                else
-                    retval(s, aa) = 0.0;
-            }
+        for ( size_t aa = 0; aa < A; ++aa ) {
+            if ( checkEqualGeneral(q_(s, aa), max) )
+                (*out)[aa] = 1.0 / count;
+            else
+                (*out)[aa] = 0.0;
         }
-
-        return retval;
     }
 }
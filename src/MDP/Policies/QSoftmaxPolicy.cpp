@@ -109,6 +109,36 @@ namespace AIToolbox::MDP {
         return retval;
     }
 
+    void QSoftmaxPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        if ( checkEqualSmall(temperature_, 0.0) )
+            return greedy_.getActionProbabilities(s, out);
+
+        auto & p = *out;
+        p.resize(A);
+
+        unsigned infinities = 0;
+        double sum = 0.0;
+        for ( size_t a = 0; a < A; ++a ) {
+            p[a] = std::exp(q_(s, a) / temperature_);
+            sum += p[a];
+            if ( std::isinf(p[a]) )
+                infinities++;
+        }
+
+        if ( infinities ) {
+            for ( size_t a = 0; a < A; ++a ) {
+                if ( std::isinf(p[a]) )
+                    p[a] = 1.0 / infinities;
+                else
+                    p[a] = 0.0;
+            }
+        } else if ( checkEqualSmall(sum, 0.0) ) {
+            p.fill(1.0 / A);
+        } else {
+            p /= sum;
+        }
+    }
+
     void QSoftmaxPolicy::setTemperature(const double t) {
         if ( t < 0.0 ) throw std::invalid_argument("Temperature must be >= 0");
         temperature_ = t;
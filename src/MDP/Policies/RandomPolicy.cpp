@@ -14,8 +14,13 @@ namespace AIToolbox::MDP {
     }
 
     Matrix2D RandomPolicy::getPolicy() const {
-        Matrix2D p;
+        Matrix2D p(S, A);
         p.fill(1.0/getA());
         return p;
     }
+
+    void RandomPolicy::getActionProbabilities(const size_t &, Vector * out) const {
+        out->resize(A);
+        out->fill(1.0/getA());
+    }
 }
@@ -68,6 +68,10 @@ namespace AIToolbox::MDP {
         return actualPolicy_.getPolicy();
     }
 
+    void WoLFPolicy::getActionProbabilities(const size_t & s, Vector * out) const {
+        actualPolicy_.getActionProbabilities(s, out);
+    }
+
     void WoLFPolicy::setDeltaW(const double deltaW) {
         deltaW_ = deltaW;
     }
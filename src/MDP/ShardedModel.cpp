@@ -0,0 +1,265 @@
+#include <AIToolbox/MDP/ShardedModel.hpp>
+
+#include <AIToolbox/Utils/Core.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AIToolbox::MDP {
+    namespace {
+        constexpr char shardMagic[8] = {'A', 'I', 'M', 'D', 'P', 'S', 'H', 'D'};
+        constexpr std::uint64_t shardVersion = 1;
+
+        struct ShardHeader {
+            char magic[8];
+            std::uint64_t version;
+            std::uint64_t S, A;
+            std::uint64_t shard, shards;
+            std::uint64_t firstState, states;
+            std::uint64_t nonZeros;
+            double discount;
+        };
+        static_assert(sizeof(ShardHeader) == 80, "Shard header must have no padding.");
+
+        std::string shardPath(const std::string & directory, const size_t i) {
+            return directory + "/shard-" + std::to_string(i) + ".bin";
+        }
+
+        // Creates the directory and its missing parents, like mkdir -p.
+        // Only the last failure matters: parents may exist, or be outside
+        // our permissions.
+        void createDirectories(const std::string & directory) {
+            size_t pos = 0;
+            do {
+                pos = directory.find_first_of("/\\", pos + 1);
+                const auto path = directory.substr(0, pos);
+#ifdef _WIN32
+                const bool created = ::_mkdir(path.c_str()) == 0 || errno == EEXIST;
+#else
+                const bool created = ::mkdir(path.c_str(), 0777) == 0 || errno == EEXIST;
+#endif
+                if ( !created && pos == std::string::npos )
+                    throw std::runtime_error("Could not create directory " + directory);
+            } while ( pos != std::string::npos );
+        }
+
+        size_t shardLength(const ShardHeader & h) {
+            const size_t rows = h.states * h.A;
+            return sizeof(ShardHeader) + rows * sizeof(double) + (rows + 1) * sizeof(std::uint64_t)
+                                       + h.nonZeros * (sizeof(double) + sizeof(std::uint32_t));
+        }
+    }
+
+    // ShardWriter
+
+    ShardWriter::ShardWriter(std::string directory, const size_t s, const size_t a, const double discount, const size_t statesPerShard) :
+            directory_(std::move(directory)), S(s), A(a), discount_(discount), statesPerShard_(statesPerShard),
+            shard_(0), row_(0), rowSum_(0.0)
+    {
+        if ( S == 0 || A == 0 ) throw std::invalid_argument("The model must have at least one state and action");
+        if ( S > std::numeric_limits<std::uint32_t>::max() ) throw std::invalid_argument("Sharded models must have less than 2^32 states");
+        if ( statesPerShard_ == 0 ) throw std::invalid_argument("Each shard must contain at least one state");
+        if ( discount_ <= 0.0 || discount_ > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
+
+        shards_ = (S + statesPerShard_ - 1) / statesPerShard_;
+        rowPtr_.push_back(0);
+
+        createDirectories(directory_);
+    }
+
+    void ShardWriter::addTransition(const size_t s1, const double p) {
+        if ( isComplete() ) throw std::invalid_argument("All rows of the model have already been written");
+        if ( s1 >= S ) throw std::invalid_argument("Next state is out of range");
+        if ( p < 0.0 ) throw std::invalid_argument("Transition probabilities must be non-negative");
+
+        cols_.push_back(static_cast<std::uint32_t>(s1));
+        values_.push_back(p);
+        rowSum_ += p;
+    }
+
+    void ShardWriter::finishRow(const double reward) {
+        if ( isComplete() ) throw std::invalid_argument("All rows of the model have already been written");
+        if ( !checkEqualGeneral(rowSum_, 1.0) ) {
+            cols_.resize(rowPtr_.back());
+            values_.resize(rowPtr_.back());
+            rowSum_ = 0.0;
+            throw std::invalid_argument("Input transition row does not contain valid probabilities");
+        }
+        rewards_.push_back(reward);
+        rowPtr_.push_back(cols_.size());
+        rowSum_ = 0.0;
+        ++row_;
+
+        const size_t firstState = shard_ * statesPerShard_;
+        const size_t states = std::min(statesPerShard_, S - firstState);
+        if ( row_ == states * A ) writeShard();
+    }
+
+    bool ShardWriter::isComplete() const {
+        return shard_ == shards_;
+    }
+
+    void ShardWriter::writeShard() {
+        ShardHeader h;
+        std::memcpy(h.magic, shardMagic, sizeof(shardMagic));
+        h.version = shardVersion;
+        h.S = S;
+        h.A = A;
+        h.shard = shard_;
+        h.shards = shards_;
+        h.firstState = shard_ * statesPerShard_;
+        h.states = std::min(statesPerShard_, S - h.firstState);
+        h.nonZeros = cols_.size();
+        h.discount = discount_;
+
+        const auto path = shardPath(directory_, shard_);
+        std::ofstream os(path, std::ios::binary | std::ios::trunc);
+
+        os.write(reinterpret_cast<const char *>(&h), sizeof(h));
+        os.write(reinterpret_cast<const char *>(rewards_.data()), rewards_.size() * sizeof(double));
+        os.write(reinterpret_cast<const char *>(rowPtr_.data()), rowPtr_.size() * sizeof(std::uint64_t));
+        os.write(reinterpret_cast<const char *>(values_.data()), values_.size() * sizeof(double));
+        os.write(reinterpret_cast<const char *>(cols_.data()), cols_.size() * sizeof(std::uint32_t));
+        os.close();
+
+        if ( !os ) throw std::runtime_error("Could not write shard " + path);
+
+        rewards_.clear();
+        values_.clear();
+        cols_.clear();
+        rowPtr_.assign(1, 0);
+        row_ = 0;
+        ++shard_;
+    }
+
+    // ShardedModel
+
+#ifdef _WIN32
+    ShardedModel::ShardedModel(const std::string &) : S(0), A(0), discount_(1.0) {
+        throw std::runtime_error("ShardedModel needs POSIX memory mapping, which is not available on this platform");
+    }
+
+    ShardedModel::~ShardedModel() {}
+
+    void ShardedModel::prefetch(size_t) const {}
+#else
+    ShardedModel::ShardedModel(const std::string & directory) : S(0), A(0), discount_(1.0) {
+        size_t shards = 1;
+        // We keep the mappings made so far in the member, so that on
+        // failure we can clean them up like the destructor does.
+        try {
+            for ( size_t i = 0; i < shards; ++i ) {
+                const auto path = shardPath(directory, i);
+
+                const int fd = ::open(path.c_str(), O_RDONLY);
+                if ( fd < 0 ) throw std::runtime_error("Could not open shard " + path);
+
+                struct stat st;
+                ShardHeader h;
+                if ( ::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(h) ||
+                     ::pread(fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h)) )
+                {
+                    ::close(fd);
+                    throw std::runtime_error("Could not read the header of shard " + path);
+                }
+                if ( std::memcmp(h.magic, shardMagic, sizeof(shardMagic)) != 0 || h.version != shardVersion ) {
+                    ::close(fd);
+                    throw std::runtime_error("File " + path + " is not a model shard");
+                }
+
+                if ( i == 0 ) {
+                    S = h.S;
+                    A = h.A;
+                    discount_ = h.discount;
+                    shards = h.shards;
+                    mappings_.reserve(shards);
+                }
+                const size_t firstState = i == 0 ? 0 : mappings_.back().shard.firstState + mappings_.back().shard.states;
+                if ( h.S != S || h.A != A || h.shard != i || h.shards != shards || h.firstState != firstState ||
+                     h.states == 0 || firstState + h.states > S || (i + 1 == shards && firstState + h.states != S) ||
+                     static_cast<size_t>(st.st_size) != shardLength(h) )
+                {
+                    ::close(fd);
+                    throw std::runtime_error("Shard " + path + " is not consistent with the rest of the model");
+                }
+
+                void * data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+                ::close(fd);
+                if ( data == MAP_FAILED ) throw std::runtime_error("Could not map shard " + path);
+
+                // Shards are read from start to end.
+                ::madvise(data, st.st_size, MADV_SEQUENTIAL);
+
+                const size_t rows = h.states * A;
+                const char * ptr = static_cast<const char *>(data) + sizeof(ShardHeader);
+
+                Mapping m;
+                m.data = data;
+                m.length = st.st_size;
+                m.shard.firstState = h.firstState;
+                m.shard.states = h.states;
+                m.shard.rewards = reinterpret_cast<const double *>(ptr);
+                ptr += rows * sizeof(double);
+                m.shard.rowPtr = reinterpret_cast<const std::uint64_t *>(ptr);
+                ptr += (rows + 1) * sizeof(std::uint64_t);
+                m.shard.values = reinterpret_cast<const double *>(ptr);
+                ptr += h.nonZeros * sizeof(double);
+                m.shard.cols = reinterpret_cast<const std::uint32_t *>(ptr);
+
+                mappings_.push_back(m);
+
+                // The sweeps index the shard directly with these, so we
+                // check them once here. This touches the index arrays
+                // of the shard, but not its values.
+                if ( m.shard.rowPtr[0] != 0 || m.shard.rowPtr[rows] != h.nonZeros )
+                    throw std::runtime_error("Shard " + path + " contains invalid row data");
+                for ( size_t r = 0; r < rows; ++r )
+                    if ( m.shard.rowPtr[r] > m.shard.rowPtr[r+1] )
+                        throw std::runtime_error("Shard " + path + " contains invalid row data");
+                for ( size_t j = 0; j < h.nonZeros; ++j )
+                    if ( m.shard.cols[j] >= S )
+                        throw std::runtime_error("Shard " + path + " contains out of range states");
+            }
+        } catch (...) {
+            for ( auto & m : mappings_ )
+                ::munmap(m.data, m.length);
+            throw;
+        }
+    }
+
+    ShardedModel::~ShardedModel() {
+        for ( auto & m : mappings_ )
+            ::munmap(m.data, m.length);
+    }
+
+    void ShardedModel::prefetch(const size_t i) const {
+        ::madvise(mappings_[i].data, mappings_[i].length, MADV_WILLNEED);
+    }
+#endif
+
+    void ShardedModel::setDiscount(const double d) {
+        if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
+        discount_ = d;
+    }
+
+    size_t ShardedModel::getS() const { return S; }
+    size_t ShardedModel::getA() const { return A; }
+    double ShardedModel::getDiscount() const { return discount_; }
+    size_t ShardedModel::getShardsNumber() const { return mappings_.size(); }
+
+    ShardedModel::Shard ShardedModel::getShard(const size_t i) const {
+        return mappings_[i].shard;
+    }
+}
@@ -1,11 +1,38 @@
 #include <AIToolbox/MDP/SparseModel.hpp>
 
+#include <AIToolbox/Utils/Executor.hpp>
+
 namespace AIToolbox::MDP {
-    SparseModel::SparseModel(NoCheck, const size_t s, const size_t a, TransitionTable && t, RewardTable && r, const double d) :
-            S(s), A(a), discount_(d), transitions_(t), rewards_(r), rand_(Impl::Seeder::getSeed()) {}
+    namespace {
+        template <typename Scalar>
+        void fillFromTriplets(const SparseTriplets & t, SparseMatrix2DT<Scalar> * m) {
+            // Eigen only asserts on the indices, so we check them here as
+            // out of range triplets would corrupt the matrix.
+            for ( const auto & tr : t )
+                if ( tr.row() < 0 || tr.row() >= m->rows() || tr.col() < 0 || tr.col() >= m->cols() )
+                    throw std::invalid_argument("Input triplets contain out of range indices.");
+
+            // Eigen's triplets are templated on the scalar, so we convert
+            // them only if needed.
+            if constexpr(std::is_same_v<Scalar, double>) {
+                m->setFromTriplets(t.begin(), t.end());
+            } else {
+                std::vector<Eigen::Triplet<Scalar>> converted;
+                converted.reserve(t.size());
+                for ( const auto & tr : t )
+                    converted.emplace_back(tr.row(), tr.col(), static_cast<Scalar>(tr.value()));
+                m->setFromTriplets(converted.begin(), converted.end());
+            }
+        }
+    }
 
-    SparseModel::SparseModel(const size_t s, const size_t a, const double discount) :
-            S(s), A(a), discount_(discount), transitions_(A, SparseMatrix2D(S, S)),
+    template <typename Scalar>
+    SparseModelT<Scalar>::SparseModelT(NoCheck, const size_t s, const size_t a, TransitionTable && t, RewardTable && r, const double d) :
+            S(s), A(a), discount_(d), transitions_(std::move(t)), rewards_(std::move(r)), rand_(Impl::Seeder::getSeed()) {}
+
+    template <typename Scalar>
+    SparseModelT<Scalar>::SparseModelT(const size_t s, const size_t a, const double discount) :
+            S(s), A(a), discount_(discount), transitions_(A, SparseMatrix2DT<Scalar>(S, S)),
             rewards_(S, A), rand_(Impl::Seeder::getSeed())
     {
         // Make transition table true probability
@@ -13,59 +40,155 @@ namespace AIToolbox::MDP {
             transitions_[a].setIdentity();
     }
 
-    void SparseModel::setTransitionFunction(const SparseMatrix3D & t) {
-        // First we verify data, without modifying anything...
-        for ( size_t a = 0; a < A; ++a ) {
-            // Eigen sparse does not implement minCoeff so we can't check for negatives.
-            // So we force the matrix to its abs, and if then the sum goes haywire then
-            // we found an error.
-            for ( size_t s = 0; s < S; ++s ) {
-                if ( !checkEqualSmall(1.0, t[a].row(s).sum()) )
-                    throw std::invalid_argument("Input transition table does not contain valid probabilities.");
-                if ( !checkEqualSmall(1.0, t[a].row(s).cwiseAbs().sum()) )
-                    throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+    template <typename Scalar>
+    SparseModelT<Scalar>::SparseModelT(const size_t s, const size_t a, const std::vector<SparseTriplets> & t, const SparseTriplets & r, const double d) :
+            S(s), A(a), transitions_(A, SparseMatrix2DT<Scalar>(S, S)),
+            rewards_(S, A), rand_(Impl::Seeder::getSeed())
+    {
+        setDiscount(d);
+        setTransitionFunction(t);
+        setRewardFunction(r);
+    }
+
+    template <typename Scalar>
+    void SparseModelT<Scalar>::checkTransitionFunction(const TransitionTable & t) const {
+        if ( t.size() != A )
+            throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+
+        for ( const auto & m : t )
+            if ( static_cast<size_t>(m.rows()) != S || static_cast<size_t>(m.cols()) != S )
+                throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+
+        // Rows are independent, so we check them in parallel. Eigen sparse
+        // does not implement minCoeff so we can't check for negatives
+        // directly; instead we also sum the abs of the row, and if that
+        // goes haywire we found an error. Sums are done in double
+        // precision so that the check does not depend on the accumulated
+        // error of the stored type.
+        const auto executor = Executor::getDefault();
+        executor->parallelFor(0, A * S, [&](const size_t i) {
+            const size_t a = i / S, s = i % S;
+            double sum = 0.0, absSum = 0.0;
+            for ( typename SparseMatrix2DT<Scalar>::InnerIterator it(t[a], s); it; ++it ) {
+                if ( it.col() < 0 || static_cast<size_t>(it.col()) >= S )
+                    throw std::invalid_argument("Input transition table contains out of range indices.");
+                sum += static_cast<double>(it.value());
+                absSum += std::abs(static_cast<double>(it.value()));
             }
-        }
+            if ( !checkEqualSmall(1.0, sum) || !checkEqualSmall(1.0, absSum) )
+                throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+        });
+    }
+
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setTransitionFunction(const TransitionTable & t) {
+        // First we verify data, without modifying anything...
+        checkTransitionFunction(t);
         // Then we copy.
         transitions_ = t;
     }
 
-    void SparseModel::setRewardFunction(const RewardTable & r) {
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setTransitionFunction(TransitionTable && t) {
+        checkTransitionFunction(t);
+        transitions_ = std::move(t);
+        for ( auto & m : transitions_ )
+            m.makeCompressed();
+    }
+
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setTransitionFunction(const std::vector<SparseTriplets> & t) {
+        if ( t.size() != A )
+            throw std::invalid_argument("Input transition table does not contain valid probabilities.");
+
+        TransitionTable table(A, SparseMatrix2DT<Scalar>(S, S));
+        for ( size_t a = 0; a < A; ++a )
+            fillFromTriplets(t[a], &table[a]);
+        setTransitionFunction(std::move(table));
+    }
+
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setRewardFunction(const RewardTable & r) {
         rewards_ = r;
     }
 
-    std::tuple<size_t, double> SparseModel::sampleSR(const size_t s, const size_t a) const {
-        const size_t s1 = sampleProbability(S, transitions_[a].row(s), rand_);
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setRewardFunction(const SparseTriplets & r) {
+        fillFromTriplets(r, &rewards_);
+    }
+
+    template <typename Scalar>
+    std::tuple<size_t, double> SparseModelT<Scalar>::sampleSR(const size_t s, const size_t a) const {
+        return sampleSR(s, a, rand_);
+    }
+
+    template <typename Scalar>
+    std::tuple<size_t, double> SparseModelT<Scalar>::sampleSR(const size_t s, const size_t a, RandomEngine & rnd) const {
+        const size_t s1 = sampleProbability(S, transitions_[a].row(s), rnd);
 
         return std::make_tuple(s1, getExpectedReward(s, a, s1));
     }
 
-    double SparseModel::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
+    template <typename Scalar>
+    void SparseModelT<Scalar>::sampleSRBatch(const size_t n, const size_t * s, const size_t * a, size_t * s1, double * r) const {
+        // We use the reward buffer to hold the random numbers, so that
+        // all draws happen together and we don't need to allocate.
+        for ( size_t i = 0; i < n; ++i )
+            r[i] = probabilityDistribution(rand_);
+
+        for ( size_t i = 0; i < n; ++i ) {
+            double p = r[i];
+            s1[i] = S - 1;
+            for ( typename SparseMatrix2DT<Scalar>::InnerIterator it(transitions_[a[i]], s[i]); it; ++it ) {
+                // Precision errors can leave p over the last value, in
+                // which case we pick the last non-zero state.
+                s1[i] = it.col();
+                if ( it.value() > p ) break;
+                p -= it.value();
+            }
+            r[i] = rewards_.coeff(s[i], a[i]);
+        }
+    }
+
+    template <typename Scalar>
+    double SparseModelT<Scalar>::getTransitionProbability(const size_t s, const size_t a, const size_t s1) const {
         return transitions_[a].coeff(s, s1);
     }
 
-    double SparseModel::getExpectedReward(const size_t s, const size_t a, const size_t) const {
+    template <typename Scalar>
+    double SparseModelT<Scalar>::getExpectedReward(const size_t s, const size_t a, const size_t) const {
         return rewards_.coeff(s, a);
     }
 
-    void SparseModel::setDiscount(const double d) {
+    template <typename Scalar>
+    void SparseModelT<Scalar>::setDiscount(const double d) {
         if ( d <= 0.0 || d > 1.0 ) throw std::invalid_argument("Discount parameter must be in (0,1]");
         discount_ = d;
     }
 
-    bool SparseModel::isTerminal(const size_t s) const {
+    template <typename Scalar>
+    bool SparseModelT<Scalar>::isTerminal(const size_t s) const {
         for ( size_t a = 0; a < A; ++a )
             if ( !checkEqualSmall(1.0, getTransitionProbability(s, a, s)) )
                 return false;
         return true;
     }
 
-    size_t SparseModel::getS() const { return S; }
-    size_t SparseModel::getA() const { return A; }
-    double SparseModel::getDiscount() const { return discount_; }
+    template <typename Scalar>
+    size_t SparseModelT<Scalar>::getS() const { return S; }
+    template <typename Scalar>
+    size_t SparseModelT<Scalar>::getA() const { return A; }
+    template <typename Scalar>
+    double SparseModelT<Scalar>::getDiscount() const { return discount_; }
+
+    template <typename Scalar>
+    const typename SparseModelT<Scalar>::TransitionTable & SparseModelT<Scalar>::getTransitionFunction() const { return transitions_; }
+    template <typename Scalar>
+    const typename SparseModelT<Scalar>::RewardTable &     SparseModelT<Scalar>::getRewardFunction()     const { return rewards_; }
 
-    const SparseModel::TransitionTable & SparseModel::getTransitionFunction() const { return transitions_; }
-    const SparseModel::RewardTable &     SparseModel::getRewardFunction()     const { return rewards_; }
+    template <typename Scalar>
+    const SparseMatrix2DT<Scalar> & SparseModelT<Scalar>::getTransitionFunction(const size_t a) const { return transitions_[a]; }
 
-    const SparseMatrix2D & SparseModel::getTransitionFunction(const size_t a) const { return transitions_[a]; }
+    template class SparseModelT<double>;
+    template class SparseModelT<float>;
 }
@@ -0,0 +1,125 @@
+#include <AIToolbox/POMDP/Algorithms/HSVI.hpp>
+
+namespace AIToolbox::POMDP {
+    HSVI::HSVI(const double epsilon, const double tolerance, const unsigned maxDepth) :
+        maxDepth_(maxDepth), trials_(0), budget_(0.0)
+    {
+        setEpsilon(epsilon);
+        setTolerance(tolerance);
+    }
+
+    double HSVI::upperBound(const Belief & b, const size_t skip) const {
+        const double v0 = b.dot(corners_);
+
+        // Sawtooth interpolation: each pair lowers the bound by its delta,
+        // scaled by how much of its belief fits within the input one.
+        double retval = v0;
+        for ( size_t i = 0; i < points_.size(); ++i ) {
+            if ( i == skip ) continue;
+
+            const auto & point = points_[i];
+            double ratio = std::numeric_limits<double>::infinity();
+            for ( size_t j = 0; j < point.support.size(); ++j ) {
+                ratio = std::min(ratio, b[point.support[j].first] * point.inverse[j]);
+                if ( ratio == 0.0 ) break;
+            }
+            if ( ratio == 0.0 ) continue;
+
+            retval = std::min(retval, v0 + ratio * point.delta);
+        }
+        return retval;
+    }
+
+    void HSVI::addUpperPoint(const Belief & b, const double v) {
+        UbPoint point;
+        for ( size_t s = 0; s < static_cast<size_t>(b.size()); ++s )
+            if ( checkDifferentSmall(b[s], 0.0) )
+                point.support.emplace_back(s, b[s]);
+
+        // Corners are kept separately, and they change the delta of all
+        // other pairs.
+        if ( point.support.size() == 1 ) {
+            const auto s = point.support[0].first;
+            if ( v < corners_[s] ) {
+                corners_[s] = v;
+                for ( auto & p : points_ ) {
+                    double plane = 0.0;
+                    for ( const auto & [ss, pp] : p.support )
+                        plane += pp * corners_[ss];
+                    p.delta = p.value - plane;
+                }
+            }
+            return;
+        }
+        point.inverse.reserve(point.support.size());
+        for ( const auto & [s, p] : point.support )
+            point.inverse.push_back(1.0 / p);
+        point.value = v;
+        point.delta = v - b.dot(corners_);
+        points_.emplace_back(std::move(point));
+    }
+
+    void HSVI::pruneUpperPoints() {
+        Belief b(corners_.size());
+
+        size_t i = points_.size();
+        while ( i-- ) {
+            b.fill(0.0);
+            for ( const auto & [s, p] : points_[i].support )
+                b[s] = p;
+
+            // If the other pairs already give this belief a bound at least
+            // as low, this pair is useless.
+            if ( points_[i].delta >= 0.0 || upperBound(b, i) <= points_[i].value + tolerance_ ) {
+                std::swap(points_[i], points_.back());
+                points_.pop_back();
+            }
+        }
+    }
+
+    double HSVI::getUpperBound(const Belief & b) const {
+        return upperBound(b, points_.size());
+    }
+
+    size_t HSVI::getUpperBoundPointsNumber() const {
+        return points_.size();
+    }
+
+    unsigned HSVI::getTrials() const {
+        return trials_;
+    }
+
+    void HSVI::setEpsilon(const double epsilon) {
+        if ( epsilon <= 0.0 ) throw std::invalid_argument("Epsilon must be > 0");
+        epsilon_ = epsilon;
+    }
+
+    double HSVI::getEpsilon() const {
+        return epsilon_;
+    }
+
+    void HSVI::setTolerance(const double tolerance) {
+        if ( tolerance < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
+        tolerance_ = tolerance;
+    }
+
+    double HSVI::getTolerance() const {
+        return tolerance_;
+    }
+
+    void HSVI::setMaxDepth(const unsigned maxDepth) {
+        maxDepth_ = maxDepth;
+    }
+
+    unsigned HSVI::getMaxDepth() const {
+        return maxDepth_;
+    }
+
+    void HSVI::setTimeBudget(const std::chrono::duration<double> budget) {
+        budget_ = budget;
+    }
+
+    std::chrono::duration<double> HSVI::getTimeBudget() const {
+        return budget_;
+    }
+}
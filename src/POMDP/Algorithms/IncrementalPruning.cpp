@@ -1,10 +1,11 @@
 #include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
 
 namespace AIToolbox::POMDP {
-    IncrementalPruning::IncrementalPruning(const unsigned h, const double t) :
-            horizon_(h)
+    IncrementalPruning::IncrementalPruning(const unsigned h, const double t, const double e, const bool m) :
+            horizon_(h), merge_(m)
     {
         setTolerance(t);
+        setEpsilon(e);
     }
 
     void IncrementalPruning::setHorizon(const unsigned h) {
@@ -14,6 +15,13 @@ namespace AIToolbox::POMDP {
         if ( t < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
         tolerance_ = t;
     }
+    void IncrementalPruning::setEpsilon(const double e) {
+        if ( e < 0.0 ) throw std::invalid_argument("Epsilon must be >= 0");
+        epsilon_ = e;
+    }
+    void IncrementalPruning::setMergeDuplicates(const bool m) {
+        merge_ = m;
+    }
 
     unsigned IncrementalPruning::getHorizon() const {
         return horizon_;
@@ -23,6 +31,18 @@ namespace AIToolbox::POMDP {
         return tolerance_;
     }
 
+    double IncrementalPruning::getEpsilon() const {
+        return epsilon_;
+    }
+
+    bool IncrementalPruning::getMergeDuplicates() const {
+        return merge_;
+    }
+
+    const std::vector<Belief> & IncrementalPruning::getWitnessBeliefs() const {
+        return witnesses_;
+    }
+
     VList IncrementalPruning::crossSum(const VList & l1, const VList & l2, const size_t a, const bool order) {
         VList c;
 
@@ -9,8 +9,9 @@ namespace AIToolbox::POMDP {
 
     // -----
 
-    LinearSupport::LinearSupport(const unsigned h, const double t) : horizon_(h) {
+    LinearSupport::LinearSupport(const unsigned h, const double t, const double e) : horizon_(h) {
         setTolerance(t);
+        setEpsilon(e);
     }
 
     void LinearSupport::setHorizon(const unsigned h) {
@@ -20,6 +21,10 @@ namespace AIToolbox::POMDP {
         if ( t < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
         tolerance_ = t;
     }
+    void LinearSupport::setEpsilon(const double e) {
+        if ( e < 0.0 ) throw std::invalid_argument("Epsilon must be >= 0");
+        epsilon_ = e;
+    }
 
     unsigned LinearSupport::getHorizon() const {
         return horizon_;
@@ -28,4 +33,12 @@ namespace AIToolbox::POMDP {
     double LinearSupport::getTolerance() const {
         return tolerance_;
     }
+
+    double LinearSupport::getEpsilon() const {
+        return epsilon_;
+    }
+
+    const std::vector<Belief> & LinearSupport::getWitnessBeliefs() const {
+        return witnesses_;
+    }
 }
@@ -1,8 +1,9 @@
 #include <AIToolbox/POMDP/Algorithms/Witness.hpp>
 
 namespace AIToolbox::POMDP {
-    Witness::Witness(const unsigned h, const double t) : horizon_(h) {
+    Witness::Witness(const unsigned h, const double t, const double e, const bool m) : horizon_(h), merge_(m) {
         setTolerance(t);
+        setEpsilon(e);
     }
 
     void Witness::setHorizon(const unsigned h) {
@@ -12,6 +13,13 @@ namespace AIToolbox::POMDP {
         if ( t < 0.0 ) throw std::invalid_argument("Tolerance must be >= 0");
         tolerance_ = t;
     }
+    void Witness::setEpsilon(const double e) {
+        if ( e < 0.0 ) throw std::invalid_argument("Epsilon must be >= 0");
+        epsilon_ = e;
+    }
+    void Witness::setMergeDuplicates(const bool m) {
+        merge_ = m;
+    }
 
     unsigned Witness::getHorizon() const {
         return horizon_;
@@ -20,4 +28,16 @@ namespace AIToolbox::POMDP {
     double Witness::getTolerance() const {
         return tolerance_;
     }
+
+    double Witness::getEpsilon() const {
+        return epsilon_;
+    }
+
+    bool Witness::getMergeDuplicates() const {
+        return merge_;
+    }
+
+    const std::vector<Belief> & Witness::getWitnessBeliefs() const {
+        return witnesses_;
+    }
 }
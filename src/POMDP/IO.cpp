@@ -1,8 +1,13 @@
 #include <AIToolbox/POMDP/IO.hpp>
 
 #include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/POMDP/Policies/PolicyGraph.hpp>
 
 #include <AIToolbox/Impl/CassandraParser.hpp>
+#include <AIToolbox/Impl/Logging.hpp>
+
+#include <algorithm>
+#include <limits>
 
 namespace AIToolbox::POMDP {
     Model<MDP::Model> parseCassandra(std::istream & input) {
@@ -108,4 +113,96 @@ failure:
         is.setstate(std::ios::failbit);
         return is;
     }
+
+    namespace {
+        constexpr char policyGraphMagic[4] = {'A', 'I', 'P', 'G'};
+
+        template <typename T>
+        void writeRaw(std::ostream & os, const T * data, const size_t n) {
+            os.write(reinterpret_cast<const char *>(data), n * sizeof(T));
+        }
+
+        template <typename T>
+        bool readRaw(std::istream & is, T * data, const size_t n) {
+            return static_cast<bool>(is.read(reinterpret_cast<char *>(data), n * sizeof(T)));
+        }
+    }
+
+    // POMDP::PolicyGraph binary writer
+    std::ostream& writeBinary(std::ostream &os, const PolicyGraph & p) {
+        const std::uint64_t header[] = {
+            p.getS(), p.getA(), p.getO(),
+            p.actions_.size(), p.startNodes_.size(),
+            p.stationary_
+        };
+
+        os.write(policyGraphMagic, sizeof(policyGraphMagic));
+        writeRaw(os, header, std::size(header));
+        writeRaw(os, p.actions_.data(), p.actions_.size());
+        writeRaw(os, p.successors_.data(), p.successors_.size());
+        writeRaw(os, p.startNodes_.data(), p.startNodes_.size());
+        // Matrix2D is row major, so each alpha vector is contiguous.
+        writeRaw(os, p.startValues_.data(), p.startValues_.size());
+
+        return os;
+    }
+
+    // POMDP::PolicyGraph binary reader
+    std::istream& readBinary(std::istream &is, PolicyGraph & p) {
+        char magic[sizeof(policyGraphMagic)];
+        std::uint64_t header[6];
+
+        if ( !is.read(magic, sizeof(magic)) || !readRaw(is, header, std::size(header)) ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Could not read policy graph header.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        if ( !std::equal(std::begin(magic), std::end(magic), std::begin(policyGraphMagic)) ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input data is not a policy graph.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        const auto [S, A, O, N, M, stationary] = header;
+        if ( S != p.getS() || A != p.getA() || O != p.getO() ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input policy graph has size " << S << "x" << A << "x" << O <<
+                                         ", expected " << p.getS() << "x" << p.getA() << "x" << p.getO());
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+        if ( !N || !M || N > std::numeric_limits<std::uint32_t>::max() ) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input policy graph has invalid size.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        std::vector<std::uint32_t> actions(N), successors(N * O), startNodes(M);
+        Matrix2D startValues(M, S);
+        if ( !readRaw(is, actions.data(), actions.size()) ||
+             !readRaw(is, successors.data(), successors.size()) ||
+             !readRaw(is, startNodes.data(), startNodes.size()) ||
+             !readRaw(is, startValues.data(), startValues.size()) )
+        {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Could not read policy graph data.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        const auto invalidNode = [N](const std::uint32_t n) { return n >= N; };
+        if ( std::any_of(std::begin(actions), std::end(actions), [A](const std::uint32_t a) { return a > A; }) ||
+             std::any_of(std::begin(successors), std::end(successors), invalidNode) ||
+             std::any_of(std::begin(startNodes), std::end(startNodes), invalidNode) )
+        {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Input policy graph data contains invalid actions or links.");
+            is.setstate(std::ios::failbit);
+            return is;
+        }
+
+        p.stationary_ = stationary;
+        p.actions_ = std::move(actions);
+        p.successors_ = std::move(successors);
+        p.startNodes_ = std::move(startNodes);
+        p.startValues_ = std::move(startValues);
+
+        return is;
+    }
 }
@@ -14,26 +14,19 @@ namespace AIToolbox::POMDP {
 
     size_t Policy::sampleAction(const Belief & b) const {
         // We use the latest horizon here.
-        const auto & vlist = policy_.back();
-
-        const auto begin = boost::make_transform_iterator(std::begin(vlist), unwrap);
-        const auto end   = boost::make_transform_iterator(std::end  (vlist), unwrap);
-        const auto bestMatch = findBestAtPoint(b, begin, end).base();
-
-        return bestMatch->action;
+        return std::get<0>(findBestEntry(b, H));
     }
 
     std::tuple<size_t, size_t> Policy::sampleAction(const Belief & b, const unsigned horizon) const {
-        const auto & vlist = policy_[horizon];
-
-        const auto begin = boost::make_transform_iterator(std::begin(vlist), unwrap);
-        const auto end   = boost::make_transform_iterator(std::end  (vlist), unwrap);
-        const auto bestMatch = findBestAtPoint(b, begin, end);
+        return findBestEntry(b, horizon);
+    }
 
-        const size_t action = bestMatch.base()->action;
-        const size_t id     = std::distance(begin, bestMatch);
+    size_t Policy::sampleAction(const SparseBelief & b) const {
+        return std::get<0>(findBestEntry(b, H));
+    }
 
-        return std::make_tuple(action, id);
+    std::tuple<size_t, size_t> Policy::sampleAction(const SparseBelief & b, const unsigned horizon) const {
+        return findBestEntry(b, horizon);
     }
 
     std::tuple<size_t, size_t> Policy::sampleAction(const size_t id, const size_t o, const unsigned horizon) const {
@@ -0,0 +1,187 @@
+#include <AIToolbox/POMDP/Policies/PolicyGraph.hpp>
+
+#include <limits>
+#include <unordered_map>
+
+#include <boost/functional/hash.hpp>
+
+namespace AIToolbox::POMDP {
+    namespace {
+        /**
+         * @brief This function matches each entry of a VList to an equal entry of another.
+         *
+         * @param lower The VList whose entries must be matched.
+         * @param upper The VList to search the matches in.
+         * @param tolerance The maximum difference allowed between matched values.
+         * @param match The output list of matched ids in upper.
+         *
+         * @return Whether all entries of lower could be matched.
+         */
+        bool matchEntries(const VList & lower, const VList & upper, const double tolerance, std::vector<size_t> * match) {
+            if ( lower.size() != upper.size() ) return false;
+
+            match->resize(lower.size());
+            for ( size_t i = 0; i < lower.size(); ++i ) {
+                bool found = false;
+                for ( size_t j = 0; j < upper.size(); ++j ) {
+                    if ( lower[i].action != upper[j].action ) continue;
+                    if ( (lower[i].values - upper[j].values).cwiseAbs().maxCoeff() > tolerance ) continue;
+                    (*match)[i] = j;
+                    found = true;
+                    break;
+                }
+                if ( !found ) return false;
+            }
+            return true;
+        }
+    }
+
+    PolicyGraph::PolicyGraph(const size_t s, const size_t a, const size_t o) :
+            Base(s, a), O(o), stationary_(true),
+            actions_(1, 0), successors_(O, 0),
+            startValues_(Matrix2D::Zero(1, S)), startNodes_(1, 0) {}
+
+    PolicyGraph::PolicyGraph(const Policy & p, const double tolerance) :
+            Base(p.getS(), p.getA()), O(p.getO()), stationary_(false)
+    {
+        const size_t H = p.getH();
+        if ( !H ) throw std::invalid_argument("The Policy supplied to POMDP::PolicyGraph has horizon 0.");
+
+        const auto & vf = p.getValueFunction();
+
+        // Look for the first horizon which repeats the one below it. If
+        // found, we only keep that horizon, and we redirect its links to
+        // the horizon below onto itself.
+        size_t bottom = 1, top = H;
+        std::vector<size_t> loop;
+        if ( tolerance >= 0.0 ) {
+            for ( size_t h = 1; h < H; ++h ) {
+                if ( matchEntries(vf[h], vf[h+1], tolerance, &loop) ) {
+                    bottom = top = h + 1;
+                    stationary_ = true;
+                    break;
+                }
+            }
+        }
+
+        // Build the unminimized graph. Node 0 is the terminal node, then
+        // each horizon from bottom to top follows in order.
+        std::vector<size_t> offsets(H + 2, 0);
+        size_t N = 1;
+        for ( size_t h = bottom; h <= top; ++h ) {
+            offsets[h] = N;
+            N += vf[h].size();
+        }
+
+        const size_t terminal = 0;
+        std::vector<size_t> rawActions(N), rawSuccessors(N * O);
+        rawActions[terminal] = A;
+        for ( size_t o = 0; o < O; ++o )
+            rawSuccessors[terminal * O + o] = terminal;
+
+        for ( size_t h = bottom; h <= top; ++h ) {
+            for ( size_t i = 0; i < vf[h].size(); ++i ) {
+                const auto & entry = vf[h][i];
+                const size_t n = offsets[h] + i;
+                rawActions[n] = entry.action;
+                for ( size_t o = 0; o < O; ++o ) {
+                    size_t next;
+                    if ( stationary_ )  next = offsets[h] + loop[entry.observations[o]];
+                    else if ( h == 1 )  next = terminal;
+                    else                next = offsets[h-1] + entry.observations[o];
+                    rawSuccessors[n * O + o] = next;
+                }
+            }
+        }
+
+        // Minimize by partition refinement: we start by grouping nodes by
+        // action, and split groups whose nodes have successors in
+        // different groups, until nothing changes.
+        std::vector<size_t> classes(rawActions), newClasses(N);
+        size_t classesNumber = 0;
+        std::unordered_map<std::vector<size_t>, size_t, boost::hash<std::vector<size_t>>> signatures;
+        std::vector<size_t> signature(O + 1);
+        while ( true ) {
+            signatures.clear();
+            for ( size_t n = 0; n < N; ++n ) {
+                signature[0] = classes[n];
+                for ( size_t o = 0; o < O; ++o )
+                    signature[o + 1] = classes[rawSuccessors[n * O + o]];
+                newClasses[n] = signatures.emplace(signature, signatures.size()).first->second;
+            }
+            std::swap(classes, newClasses);
+            // Refinement only ever splits classes, so if the number did
+            // not change we are done.
+            if ( signatures.size() == classesNumber ) break;
+            classesNumber = signatures.size();
+        }
+
+        // Keep only the classes reachable from the top horizon, numbering
+        // them in visit order.
+        const auto & topList = vf[top];
+        constexpr auto unvisited = std::numeric_limits<size_t>::max();
+        std::vector<size_t> ids(classesNumber, unvisited), representative, queue;
+        const auto visit = [&](const size_t n) {
+            if ( ids[classes[n]] != unvisited ) return;
+            ids[classes[n]] = representative.size();
+            representative.push_back(n);
+        };
+
+        startNodes_.resize(topList.size());
+        startValues_.resize(topList.size(), S);
+        for ( size_t i = 0; i < topList.size(); ++i ) {
+            visit(offsets[top] + i);
+            startNodes_[i] = ids[classes[offsets[top] + i]];
+            startValues_.row(i) = topList[i].values.transpose();
+        }
+        for ( size_t r = 0; r < representative.size(); ++r )
+            for ( size_t o = 0; o < O; ++o )
+                visit(rawSuccessors[representative[r] * O + o]);
+
+        if ( representative.size() > std::numeric_limits<std::uint32_t>::max() )
+            throw std::invalid_argument("The Policy supplied to POMDP::PolicyGraph produces too many nodes.");
+
+        actions_.resize(representative.size());
+        successors_.resize(representative.size() * O);
+        for ( size_t r = 0; r < representative.size(); ++r ) {
+            const auto n = representative[r];
+            actions_[r] = rawActions[n];
+            for ( size_t o = 0; o < O; ++o )
+                successors_[r * O + o] = ids[classes[rawSuccessors[n * O + o]]];
+        }
+    }
+
+    size_t PolicyGraph::getStartNode(const Belief & b) const {
+        Eigen::Index best;
+        (startValues_ * b).maxCoeff(&best);
+        return startNodes_[best];
+    }
+
+    size_t PolicyGraph::getAction(const size_t node) const {
+        return actions_[node];
+    }
+
+    size_t PolicyGraph::getNextNode(const size_t node, const size_t o) const {
+        return successors_[node * O + o];
+    }
+
+    size_t PolicyGraph::sampleAction(const Belief & b) const {
+        return actions_[getStartNode(b)];
+    }
+
+    double PolicyGraph::getActionProbability(const Belief & b, const size_t & a) const {
+        return sampleAction(b) == a ? 1.0 : 0.0;
+    }
+
+    size_t PolicyGraph::getNodesNumber() const {
+        return actions_.size();
+    }
+
+    bool PolicyGraph::isStationary() const {
+        return stationary_;
+    }
+
+    size_t PolicyGraph::getO() const {
+        return O;
+    }
+}
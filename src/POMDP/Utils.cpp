@@ -1,5 +1,7 @@
 #include <AIToolbox/POMDP/Utils.hpp>
 
+#include <AIToolbox/Utils/Executor.hpp>
+
 namespace AIToolbox::POMDP {
     ValueFunction makeValueFunction(const size_t S) {
         auto values = MDP::Values(S);
@@ -8,6 +10,17 @@ namespace AIToolbox::POMDP {
         return ValueFunction(1, VList(1, {values, 0, VObs()}));
     }
 
+    void checkWarmStart(const size_t S, const ValueFunction & v, const std::vector<Belief> & witnesses) {
+        if ( v.size() )
+            for ( const auto & entry : v.back() )
+                if ( static_cast<size_t>(entry.values.size()) != S )
+                    throw std::invalid_argument("Input ValueFunction does not match the number of states of the model.");
+
+        for ( const auto & b : witnesses )
+            if ( static_cast<size_t>(b.size()) != S )
+                throw std::invalid_argument("Input witness beliefs do not match the number of states of the model.");
+    }
+
     bool operator<(const VEntry & lhs, const VEntry & rhs) {
         auto cmp = veccmp(lhs.values, rhs.values);
         if (cmp != 0) return cmp < 0;
@@ -35,22 +48,52 @@ namespace AIToolbox::POMDP {
         //
         // We define distance between two ValueFunctions as the maximum between their
         // element-wise difference.
+        //
+        // We copy the old alphas in a single contiguous matrix, so that each
+        // new alpha can be compared against a whole block of them with a
+        // single vectorized expression. Since we only care about the max of
+        // the mins, we can stop looking at a new alpha as soon as we find an
+        // old one closer than the current max, as that alpha cannot raise it.
         if ( !oldV.size() ) return 0.0;
 
-        double distance = 0.0;
-        for ( const auto & newVE : newV ) {
-            // Initialize closest distance for newVE as infinity
-            double closestDistance = std::numeric_limits<double>::infinity();
-            for ( const auto & oldVE : oldV ) {
-                // Compute the distance, we pick the max
-                double distance = (newVE.values - oldVE.values).cwiseAbs().maxCoeff();
-
-                // Keep the closest, we pick the min
-                closestDistance = std::min(closestDistance, distance);
+        constexpr size_t blockSize = 64;
+
+        const size_t S = oldV[0].values.size();
+        Matrix2D oldM(oldV.size(), S);
+        for ( size_t i = 0; i < oldV.size(); ++i )
+            oldM.row(i) = oldV[i].values.transpose();
+
+        // The new alphas are split in chunks, each of which is processed
+        // in parallel with its own running max. The early exit is a bit
+        // weaker as chunks do not share it, but the max is the same.
+        const size_t chunks = (newV.size() + blockSize - 1) / blockSize;
+        std::vector<double> distances(chunks, 0.0);
+
+        const auto executor = Executor::getDefault();
+        executor->parallelFor(0, chunks, [&](const size_t c) {
+            double & distance = distances[c];
+            const auto end = std::min(newV.size(), (c + 1) * blockSize);
+            for ( size_t n = c * blockSize; n < end; ++n ) {
+                const auto & newVE = newV[n];
+                // Initialize closest distance for newVE as infinity
+                double closestDistance = std::numeric_limits<double>::infinity();
+                for ( size_t b = 0; b < oldV.size(); b += blockSize ) {
+                    const auto rows = std::min(blockSize, oldV.size() - b);
+                    // Compute the distances of the block, we pick the min
+                    const double blockDistance = (oldM.middleRows(b, rows).rowwise() - newVE.values.transpose())
+                                                    .cwiseAbs().rowwise().maxCoeff().minCoeff();
+
+                    closestDistance = std::min(closestDistance, blockDistance);
+                    if ( closestDistance <= distance ) break;
+                }
+                // Keep the maximum distance between a new VList and its closest old VList
+                distance = std::max(distance, closestDistance);
             }
-            // Keep the maximum distance between a new VList and its closest old VList
-            distance = std::max(distance, closestDistance);
-        }
+        }, 1);
+
+        double distance = 0.0;
+        for ( const auto d : distances )
+            distance = std::max(distance, d);
         return distance;
     }
 }
@@ -117,6 +117,17 @@ void exportMCTSByModel(std::string className) {
                  "@param exp The new exploration constant."
         , (arg("self"), "exp"))
 
+        .def("setBatchSize",            &V::setBatchSize,
+                 "This function sets the number of leaves evaluated together.\n"
+                 "\n"
+                 "With values above 1, MCTS descends the tree this many times\n"
+                 "before running the rollouts of all new leaves together, and\n"
+                 "only then backs up their returns. The default is 1, and 0 is\n"
+                 "treated as 1.\n"
+                 "\n"
+                 "@param batchSize The new batch size."
+        , (arg("self"), "batchSize"))
+
         .def("getModel",                &V::getModel,   return_value_policy<reference_existing_object>(),
                  "This function returns the MDP generative model being used."
         , (arg("self")))
@@ -127,6 +138,10 @@ void exportMCTSByModel(std::string className) {
 
         .def("getExploration",          &V::getExploration,
                  "This function returns the currently set exploration constant."
+        , (arg("self")))
+
+        .def("getBatchSize",            &V::getBatchSize,
+                 "This function returns the number of leaves evaluated together."
         , (arg("self")));
 }
 
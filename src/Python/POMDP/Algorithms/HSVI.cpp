@@ -0,0 +1,127 @@
+#include <AIToolbox/POMDP/Algorithms/HSVI.hpp>
+
+#include <AIToolbox/POMDP/Types.hpp>
+#include "../../Utils.hpp"
+
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/POMDP/Model.hpp>
+#include <AIToolbox/POMDP/SparseModel.hpp>
+
+#include <boost/python.hpp>
+
+using POMDPModelBinded = AIToolbox::POMDP::Model<AIToolbox::MDP::Model>;
+using POMDPSparseModelBinded = AIToolbox::POMDP::SparseModel<AIToolbox::MDP::SparseModel>;
+
+namespace {
+    void setTimeBudget(AIToolbox::POMDP::HSVI & self, const double seconds) {
+        self.setTimeBudget(std::chrono::duration<double>(seconds));
+    }
+
+    double getTimeBudget(const AIToolbox::POMDP::HSVI & self) {
+        return self.getTimeBudget().count();
+    }
+}
+
+void exportPOMDPHSVI() {
+    using namespace boost::python;
+    using namespace AIToolbox::POMDP;
+
+    using Retval = std::tuple<double, double, VList>;
+
+    class_<HSVI>{"HSVI",
+
+         "This class implements the Heuristic Search Value Iteration algorithm.\n"
+         "\n"
+         "HSVI keeps both a lower and an upper bound on the optimal value\n"
+         "function, and only refines them on beliefs which are reachable from\n"
+         "the initial belief while following near-optimal policies.\n"
+         "\n"
+         "The lower bound is a set of alpha vectors, initialized with\n"
+         "BlindStrategies. The upper bound is initialized with the\n"
+         "FastInformedBound, and refined with a set of belief-value pairs which\n"
+         "are interpolated with the sawtooth approximation.\n"
+         "\n"
+         "The algorithm works through trials, each descending from the initial\n"
+         "belief towards the beliefs which contribute most to the gap between\n"
+         "the bounds, and then backing up both bounds along the way.\n"
+         "\n"
+         "The solver is anytime: it can be given a time budget, after which it\n"
+         "returns the bounds found so far.", no_init}
+
+        .def(init<double, optional<double, unsigned>>(
+                 "Basic constructor.\n"
+                 "\n"
+                 "The epsilon parameter must be > 0.0, and the tolerance\n"
+                 "parameter must be >= 0.0, otherwise the constructor will\n"
+                 "throw an std::invalid_argument.\n"
+                 "\n"
+                 "@param epsilon The gap between the bounds at the initial belief to reach.\n"
+                 "@param tolerance The tolerance used to compute the initial bounds.\n"
+                 "@param maxDepth The maximum depth of each trial."
+        , (arg("self"), "epsilon", "tolerance", "maxDepth")))
+
+        .def("getUpperBound",               &HSVI::getUpperBound,
+                 "This function returns the upper bound computed during the last call, at the input belief."
+        , (arg("self"), "belief"))
+
+        .def("getUpperBoundPointsNumber",   &HSVI::getUpperBoundPointsNumber,
+                 "This function returns the number of belief-value pairs of the upper bound."
+        , (arg("self")))
+
+        .def("getTrials",                   &HSVI::getTrials,
+                 "This function returns the number of trials run during the last call."
+        , (arg("self")))
+
+        .def("setEpsilon",                  &HSVI::setEpsilon,
+                 "This function sets the gap between the bounds at the initial belief to reach."
+        , (arg("self"), "epsilon"))
+
+        .def("getEpsilon",                  &HSVI::getEpsilon,
+                 "This function returns the currently set epsilon parameter."
+        , (arg("self")))
+
+        .def("setTolerance",                &HSVI::setTolerance,
+                 "This function sets the tolerance used to compute the initial bounds."
+        , (arg("self"), "tolerance"))
+
+        .def("getTolerance",                &HSVI::getTolerance,
+                 "This function returns the currently set tolerance parameter."
+        , (arg("self")))
+
+        .def("setMaxDepth",                 &HSVI::setMaxDepth,
+                 "This function sets the maximum depth of each trial."
+        , (arg("self"), "maxDepth"))
+
+        .def("getMaxDepth",                 &HSVI::getMaxDepth,
+                 "This function returns the currently set maximum depth of each trial."
+        , (arg("self")))
+
+        .def("setTimeBudget",               &setTimeBudget,
+                 "This function sets the time budget of each call, in seconds.\n"
+                 "\n"
+                 "A budget of zero disables the limit."
+        , (arg("self"), "seconds"))
+
+        .def("getTimeBudget",               &getTimeBudget,
+                 "This function returns the currently set time budget, in seconds."
+        , (arg("self")))
+
+        .def("__call__",                    static_cast<Retval(HSVI::*)(const POMDPModelBinded&, const Belief&)>(&HSVI::operator()<POMDPModelBinded>),
+                 "This function computes lower and upper bounds for the value of the input belief.\n"
+                 "\n"
+                 "@param model The POMDP model to solve.\n"
+                 "@param initialBelief The belief to compute the bounds for.\n"
+                 "\n"
+                 "@return The lower and upper bounds at the initial belief, and the lower bound VList."
+        , (arg("self"), "model", "initialBelief"))
+
+        .def("__call__",                    static_cast<Retval(HSVI::*)(const POMDPSparseModelBinded&, const Belief&)>(&HSVI::operator()<POMDPSparseModelBinded>),
+                 "This function computes lower and upper bounds for the value of the input belief.\n"
+                 "\n"
+                 "@param model The POMDP model to solve.\n"
+                 "@param initialBelief The belief to compute the bounds for.\n"
+                 "\n"
+                 "@return The lower and upper bounds at the initial belief, and the lower bound VList."
+        , (arg("self"), "model", "initialBelief"));
+}
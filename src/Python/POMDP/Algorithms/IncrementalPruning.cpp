@@ -48,7 +48,7 @@ void exportPOMDPIncrementalPruning() {
          "be nice if one day we could port directly into the code a fast lp\n"
          "implementation; for now we do what we can.", no_init}
 
-        .def(init<unsigned, double>(
+        .def(init<unsigned, double, optional<double, bool>>(
                  "Basic constructor.\n"
                  "\n"
                  "This constructor sets the default horizon used to solve a POMDP::Model.\n"
@@ -61,9 +61,15 @@ void exportPOMDPIncrementalPruning() {
                  "will stop as soon as the difference between two iterations\n"
                  "is less than the tolerance specified.\n"
                  "\n"
+                 "The epsilon parameter must be >= 0.0, otherwise the\n"
+                 "constructor will throw an std::invalid_argument. See\n"
+                 "setEpsilon() and setMergeDuplicates().\n"
+                 "\n"
                  "@param h The horizon chosen.\n"
-                 "@param tolerance The tolerance factor to stop the value iteration loop."
-        , (arg("self"), "horizon", "tolerance")))
+                 "@param tolerance The tolerance factor to stop the value iteration loop.\n"
+                 "@param epsilon The maximum value loss allowed when pruning.\n"
+                 "@param mergeDuplicates Whether to merge near-duplicates in the final prune."
+        , (arg("self"), "horizon", "tolerance", "epsilon", "mergeDuplicates")))
 
         .def("setTolerance",                &IncrementalPruning::setTolerance,
                  "This function sets the tolerance parameter.\n"
@@ -87,10 +93,51 @@ void exportPOMDPIncrementalPruning() {
                  "This function returns the currently set tolerance parameter."
         , (arg("self")))
 
+        .def("setEpsilon",                  &IncrementalPruning::setEpsilon,
+                 "This function sets the epsilon parameter.\n"
+                 "\n"
+                 "The epsilon parameter must be >= 0.0. With an epsilon of 0.0\n"
+                 "pruning is exact. Otherwise, the prune done after combining\n"
+                 "the cross-sums of all actions drops alphavectors which cannot\n"
+                 "improve the ValueFunction by more than epsilon.\n"
+                 "\n"
+                 "Since each timestep can then lose up to epsilon value, the\n"
+                 "returned variation is increased by epsilon. The tolerance\n"
+                 "should thus be set higher than epsilon.\n"
+                 "\n"
+                 "@param e The new epsilon parameter."
+        , (arg("self"), "e"))
+
+        .def("getEpsilon",                  &IncrementalPruning::getEpsilon,
+                 "This function returns the currently set epsilon parameter."
+        , (arg("self")))
+
+        .def("setMergeDuplicates",          &IncrementalPruning::setMergeDuplicates,
+                 "This function sets whether near-duplicate alphavectors are merged.\n"
+                 "\n"
+                 "When enabled and epsilon is positive, the final prune first\n"
+                 "removes alphavectors which are within epsilon/2 of another in\n"
+                 "every state, without solving any LP, and then uses the other\n"
+                 "half of epsilon for the LPs. The total loss per timestep is\n"
+                 "still at most epsilon. This has no effect when epsilon is 0.0.\n"
+                 "\n"
+                 "@param m Whether to merge near-duplicates."
+        , (arg("self"), "m"))
+
+        .def("getMergeDuplicates",          &IncrementalPruning::getMergeDuplicates,
+                 "This function returns whether near-duplicate alphavectors are merged."
+        , (arg("self")))
+
         .def("getHorizon",                  &IncrementalPruning::getHorizon,
                  "This function returns the currently set horizon parameter."
         , (arg("self")))
 
+        .def("getWitnessBeliefs",           &IncrementalPruning::getWitnessBeliefs, return_internal_reference<>(),
+                 "This function returns the witness beliefs of the last solved timestep.\n"
+                 "\n"
+                 "These can be passed to a later call to warm-start it."
+        , (arg("self")))
+
         .def("__call__",                    &IncrementalPruning::operator()<POMDPModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
                  "\n"
@@ -100,11 +147,16 @@ void exportPOMDPIncrementalPruning() {
                  "incrementally, trying to reduce as much as possible the\n"
                  "linear programming solves required.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"))
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()))
 
         .def("__call__",                    &IncrementalPruning::operator()<POMDPSparseModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
@@ -115,9 +167,14 @@ void exportPOMDPIncrementalPruning() {
                  "incrementally, trying to reduce as much as possible the\n"
                  "linear programming solves required.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"));
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()));
 }
@@ -50,7 +50,7 @@ void exportPOMDPLinearSupport() {
          "guaranteed to work in the areas with high error first, allowing one to\n"
          "compute good approximations even without a lot of resources.", no_init}
 
-        .def(init<unsigned, double>(
+        .def(init<unsigned, double, optional<double>>(
                  "Basic constructor.\n"
                  "\n"
                  "This constructor sets the default horizon used to solve a POMDP::Model.\n"
@@ -63,9 +63,14 @@ void exportPOMDPLinearSupport() {
                  "as the difference between two iterations is less than the\n"
                  "tolerance specified.\n"
                  "\n"
+                 "The epsilon parameter must be >= 0.0, otherwise the\n"
+                 "constructor will throw an std::invalid_argument. See\n"
+                 "setEpsilon().\n"
+                 "\n"
                  "@param h The horizon chosen.\n"
-                 "@param tolerance The tolerance factor to stop the value iteration loop."
-        , (arg("self"), "horizon", "tolerance")))
+                 "@param tolerance The tolerance factor to stop the value iteration loop.\n"
+                 "@param epsilon The maximum value loss allowed per timestep."
+        , (arg("self"), "horizon", "tolerance", "epsilon")))
 
         .def("setTolerance",                &LinearSupport::setTolerance,
                  "This function sets the tolerance parameter.\n"
@@ -89,10 +94,35 @@ void exportPOMDPLinearSupport() {
                  "This function returns the currently set tolerance parameter."
         , (arg("self")))
 
+        .def("setEpsilon",                  &LinearSupport::setEpsilon,
+                 "This function sets the epsilon parameter.\n"
+                 "\n"
+                 "The epsilon parameter must be >= 0.0. With an epsilon of 0.0\n"
+                 "the solution is exact. Otherwise, vertices whose error is\n"
+                 "below epsilon are not explored, so the VList is at most\n"
+                 "epsilon below the exact one.\n"
+                 "\n"
+                 "Vertices below the tolerance are skipped anyway, so only an\n"
+                 "epsilon higher than the tolerance has an effect. The returned\n"
+                 "variation is increased by epsilon.\n"
+                 "\n"
+                 "@param e The new epsilon parameter."
+        , (arg("self"), "e"))
+
+        .def("getEpsilon",                  &LinearSupport::getEpsilon,
+                 "This function returns the currently set epsilon parameter."
+        , (arg("self")))
+
         .def("getHorizon",                  &LinearSupport::getHorizon,
                  "This function returns the currently set horizon parameter."
         , (arg("self")))
 
+        .def("getWitnessBeliefs",           &LinearSupport::getWitnessBeliefs, return_internal_reference<>(),
+                 "This function returns the witness beliefs of the last solved timestep.\n"
+                 "\n"
+                 "These can be passed to a later call to warm-start it."
+        , (arg("self")))
+
         .def("__call__",                    &LinearSupport::operator()<POMDPModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
                  "\n"
@@ -101,11 +131,16 @@ void exportPOMDPLinearSupport() {
                  "in order to determine whether it is complete, otherwise it\n"
                  "improves it incrementally.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"))
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()))
 
         .def("__call__",                    &LinearSupport::operator()<POMDPSparseModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
@@ -115,9 +150,14 @@ void exportPOMDPLinearSupport() {
                  "in order to determine whether it is complete, otherwise it\n"
                  "improves it incrementally.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"));
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()));
 }
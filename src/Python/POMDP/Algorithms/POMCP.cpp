@@ -150,6 +150,38 @@ void exportPOMCPByModel(std::string className) {
                  "@param exp The new exploration constant."
         , (arg("self"), "exp"))
 
+        .def("setBatchSize",            &V::setBatchSize,
+                 "This function sets the number of leaves evaluated together.\n"
+                 "\n"
+                 "With values above 1, POMCP samples this many particles from\n"
+                 "the root and descends the tree with each before running all\n"
+                 "the rollouts together; values are updated at the end of the\n"
+                 "round, while particles are still added to the beliefs as they\n"
+                 "are traversed. The default is 1, and 0 is treated as 1.\n"
+                 "\n"
+                 "@param batchSize The new batch size."
+        , (arg("self"), "batchSize"))
+
+        .def("setMaxParticles",         &V::setMaxParticles,
+                 "This function sets the maximum number of particles stored in each belief node.\n"
+                 "\n"
+                 "Once a node holds this many particles, new particles\n"
+                 "replace existing ones with reservoir sampling. A value of\n"
+                 "zero (the default) means unbounded.\n"
+                 "\n"
+                 "@param maxParticles The new maximum number of particles per node."
+        , (arg("self"), "maxParticles"))
+
+        .def("setMaxNodes",             &V::setMaxNodes,
+                 "This function sets the maximum number of belief nodes in the tree.\n"
+                 "\n"
+                 "Once the tree contains this many belief nodes (including\n"
+                 "the root), no new nodes are created. A value of zero (the\n"
+                 "default) means unbounded.\n"
+                 "\n"
+                 "@param maxNodes The new maximum number of belief nodes."
+        , (arg("self"), "maxNodes"))
+
         .def("getModel",                &V::getModel,   return_value_policy<reference_existing_object>(),
                  "This function returns the POMDP generative model being used."
         , (arg("self")))
@@ -164,6 +196,22 @@ void exportPOMCPByModel(std::string className) {
 
         .def("getExploration",          &V::getExploration,
                  "This function returns the currently set exploration constant."
+        , (arg("self")))
+
+        .def("getBatchSize",            &V::getBatchSize,
+                 "This function returns the number of leaves evaluated together."
+        , (arg("self")))
+
+        .def("getMaxParticles",         &V::getMaxParticles,
+                 "This function returns the maximum number of particles stored in each belief node."
+        , (arg("self")))
+
+        .def("getMaxNodes",             &V::getMaxNodes,
+                 "This function returns the maximum number of belief nodes in the tree."
+        , (arg("self")))
+
+        .def("getNodesNumber",          &V::getNodesNumber,
+                 "This function returns the number of belief nodes in the tree."
         , (arg("self")));
 }
 
@@ -46,7 +46,7 @@ void exportPOMDPWitness() {
          "already added; it uses a set to keep track of which combinations of\n"
          "subtrees it has already tried.", no_init}
 
-        .def(init<unsigned, double>(
+        .def(init<unsigned, double, optional<double, bool>>(
                  "Basic constructor.\n"
                  "\n"
                  "This constructor sets the default horizon used to solve a POMDP::Model.\n"
@@ -59,9 +59,15 @@ void exportPOMDPWitness() {
                  "as the difference between two iterations is less than the\n"
                  "tolerance specified.\n"
                  "\n"
+                 "The epsilon parameter must be >= 0.0, otherwise the\n"
+                 "constructor will throw an std::invalid_argument. See\n"
+                 "setEpsilon() and setMergeDuplicates().\n"
+                 "\n"
                  "@param h The horizon chosen.\n"
-                 "@param tolerance The tolerance factor to stop the value iteration loop."
-        , (arg("self"), "horizon", "tolerance")))
+                 "@param tolerance The tolerance factor to stop the value iteration loop.\n"
+                 "@param epsilon The maximum value loss allowed when pruning.\n"
+                 "@param mergeDuplicates Whether to merge near-duplicates in the final prune."
+        , (arg("self"), "horizon", "tolerance", "epsilon", "mergeDuplicates")))
 
         .def("setTolerance",                &Witness::setTolerance,
                  "This function sets the tolerance parameter.\n"
@@ -85,10 +91,52 @@ void exportPOMDPWitness() {
                  "This function returns the currently set tolerance parameter."
         , (arg("self")))
 
+        .def("setEpsilon",                  &Witness::setEpsilon,
+                 "This function sets the epsilon parameter.\n"
+                 "\n"
+                 "The epsilon parameter must be >= 0.0. With an epsilon of 0.0\n"
+                 "pruning is exact. Otherwise, once all witnesses have been\n"
+                 "found the union of the per-action VLists is pruned dropping\n"
+                 "alphavectors which cannot improve the ValueFunction by more\n"
+                 "than epsilon. The agenda search itself is not affected.\n"
+                 "\n"
+                 "Since each timestep can then lose up to epsilon value, the\n"
+                 "returned variation is increased by epsilon. The tolerance\n"
+                 "should thus be set higher than epsilon.\n"
+                 "\n"
+                 "@param e The new epsilon parameter."
+        , (arg("self"), "e"))
+
+        .def("getEpsilon",                  &Witness::getEpsilon,
+                 "This function returns the currently set epsilon parameter."
+        , (arg("self")))
+
+        .def("setMergeDuplicates",          &Witness::setMergeDuplicates,
+                 "This function sets whether near-duplicate alphavectors are merged.\n"
+                 "\n"
+                 "When enabled and epsilon is positive, the final prune first\n"
+                 "removes alphavectors which are within epsilon/2 of another in\n"
+                 "every state, without solving any LP, and then uses the other\n"
+                 "half of epsilon for the LPs. The total loss per timestep is\n"
+                 "still at most epsilon. This has no effect when epsilon is 0.0.\n"
+                 "\n"
+                 "@param m Whether to merge near-duplicates."
+        , (arg("self"), "m"))
+
+        .def("getMergeDuplicates",          &Witness::getMergeDuplicates,
+                 "This function returns whether near-duplicate alphavectors are merged."
+        , (arg("self")))
+
         .def("getHorizon",                  &Witness::getHorizon,
                  "This function returns the currently set horizon parameter."
         , (arg("self")))
 
+        .def("getWitnessBeliefs",           &Witness::getWitnessBeliefs, return_internal_reference<>(),
+                 "This function returns the witness beliefs of the last solved timestep.\n"
+                 "\n"
+                 "These can be passed to a later call to warm-start it."
+        , (arg("self")))
+
         .def("__call__",                    &Witness::operator()<POMDPModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
                  "\n"
@@ -96,11 +144,16 @@ void exportPOMDPWitness() {
                  "solvers). It solves a series of LPs trying to find all possible\n"
                  "beliefs where an alphavector has not yet been found.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"))
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()))
 
         .def("__call__",                    &Witness::operator()<POMDPSparseModelBinded>,
                  "This function solves a POMDP::Model completely.\n"
@@ -109,9 +162,14 @@ void exportPOMDPWitness() {
                  "solvers). It solves a series of LPs trying to find all possible\n"
                  "beliefs where an alphavector has not yet been found.\n"
                  "\n"
+                 "A previous solution and its witness beliefs can be passed to\n"
+                 "warm-start the process (see getWitnessBeliefs()).\n"
+                 "\n"
                  "@param model The POMDP model that needs to be solved.\n"
+                 "@param v The ValueFunction to startup the process from, if needed.\n"
+                 "@param witnesses The witness beliefs of a previous run, if needed.\n"
                  "\n"
                  "@return A tuple containing the maximum variation for the\n"
                  "        ValueFunction and the computed ValueFunction."
-        , (arg("self"), "model"));
+        , (arg("self"), "model", arg("v") = ValueFunction(), arg("witnesses") = std::vector<Belief>()));
 }
@@ -101,7 +101,7 @@ void exportPOMDPModel() {
                 "them otherwise."
         , (arg("self"), "observationFunction3D"))
 
-        .def("sampleSOR",                   &POMDPModelBinded::sampleSOR,
+        .def("sampleSOR",                   static_cast<std::tuple<size_t, size_t, double>(POMDPModelBinded::*)(size_t, size_t) const>(&POMDPModelBinded::sampleSOR),
                 "This function samples the POMDP for the specified state action pair.\n"
                 "\n"
                 "This function samples the model for simulated experience. The\n"
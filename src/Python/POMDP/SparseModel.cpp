@@ -110,7 +110,7 @@ void exportPOMDPSparseModel() {
                 "them otherwise."
         , (arg("self"), "observationFunction3D"))
 
-        .def("sampleSOR",                   &POMDPSparseModelBinded::sampleSOR,
+        .def("sampleSOR",                   static_cast<std::tuple<size_t, size_t, double>(POMDPSparseModelBinded::*)(size_t, size_t) const>(&POMDPSparseModelBinded::sampleSOR),
                 "This function samples the POMDP for the specified state action pair.\n"
                 "\n"
                 "This function samples the model for simulated experience. The\n"
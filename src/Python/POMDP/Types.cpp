@@ -39,4 +39,6 @@ void exportPOMDPTypes() {
     TupleToPython<std::tuple<double, POMDP::ValueFunction>>();
     // GapMin return value
     TupleToPython<std::tuple<double, double, POMDP::VList, MDP::QFunction>>();
+    // HSVI return value
+    TupleToPython<std::tuple<double, double, POMDP::VList>>();
 }
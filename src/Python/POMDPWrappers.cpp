@@ -19,6 +19,7 @@ void exportPOMDPAMDP();
 void exportPOMDPPERSEUS();
 void exportPOMDPPBVI();
 void exportPOMDPGapMin();
+void exportPOMDPHSVI();
 
 void exportPOMDPPolicyInterface();
 void exportPOMDPPolicy();
@@ -51,6 +52,7 @@ void exportPOMDP() {
     exportPOMDPPERSEUS();
     exportPOMDPPBVI();
     exportPOMDPGapMin();
+    exportPOMDPHSVI();
 
     exportPOMDPPolicyInterface();
     exportPOMDPPolicy();
@@ -0,0 +1,32 @@
+#include <AIToolbox/Utils/Evaluation.hpp>
+
+#include <cmath>
+#include <utility>
+
+namespace AIToolbox {
+    EvaluationResults makeEvaluationResults(std::vector<double> returns, const size_t steps, const double seconds) {
+        EvaluationResults retval;
+        const size_t n = returns.size();
+
+        retval.episodes = n;
+        retval.mean = 0.0;
+        retval.stddev = 0.0;
+        retval.confidence = 0.0;
+        retval.meanSteps = n ? static_cast<double>(steps) / n : 0.0;
+        retval.secondsPerStep = steps ? seconds / steps : 0.0;
+
+        if ( n ) {
+            for ( const auto r : returns ) retval.mean += r;
+            retval.mean /= n;
+        }
+        if ( n > 1 ) {
+            double ss = 0.0;
+            for ( const auto r : returns ) ss += (r - retval.mean) * (r - retval.mean);
+            retval.stddev = std::sqrt(ss / (n - 1));
+            retval.confidence = 1.96 * retval.stddev / std::sqrt(static_cast<double>(n));
+        }
+        retval.returns = std::move(returns);
+
+        return retval;
+    }
+}
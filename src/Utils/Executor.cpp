@@ -0,0 +1,231 @@
+#include <AIToolbox/Utils/Executor.hpp>
+
+#include <AIToolbox/Impl/Seeder.hpp>
+
+namespace AIToolbox {
+    namespace {
+        // The worker index of background threads; external threads keep
+        // the default and thus act as worker 0 of any Executor.
+        thread_local const Executor * currentExecutor = nullptr;
+        thread_local unsigned currentWorker = 0;
+
+        // The engine last used by this thread as an external worker, so
+        // that getRandomEngine() does not need to lock in the common case.
+        thread_local size_t cachedEngineOwner = 0;
+        thread_local RandomEngine * cachedEngine = nullptr;
+
+        std::atomic<size_t> nextExecutorId(1);
+
+        // The default Executor is created on first use; function-local
+        // statics make this safe even when called from several threads.
+        // Replacing it only swaps the pointer, so running algorithms keep
+        // the previous one alive until they are done.
+        struct DefaultExecutor {
+            std::mutex mutex;
+            std::shared_ptr<Executor> executor = std::make_shared<Executor>(1);
+        };
+
+        DefaultExecutor & defaultExecutor() {
+            static DefaultExecutor d;
+            return d;
+        }
+    }
+
+    Executor::Executor(const unsigned concurrency, const bool deterministic) :
+            concurrency_(std::max(1u, concurrency)), deterministic_(deterministic),
+            id_(nextExecutorId++), sharedSize_(0), stop_(false)
+    {
+        queues_.reserve(concurrency_ - 1);
+        engines_.reserve(concurrency_ - 1);
+        for ( unsigned w = 1; w < concurrency_; ++w ) {
+            queues_.emplace_back(std::make_unique<Queue>());
+            engines_.emplace_back(Impl::Seeder::getSeed());
+        }
+        threads_.reserve(concurrency_ - 1);
+        for ( unsigned w = 1; w < concurrency_; ++w )
+            threads_.emplace_back(&Executor::workerLoop, this, w);
+    }
+
+    Executor::~Executor() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        sleepCondition_.notify_all();
+        for ( auto & t : threads_ )
+            t.join();
+    }
+
+    void Executor::push(Task t, Queue & q, const bool pinned) {
+        {
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if ( pinned ) {
+                q.pinned.push_back(std::move(t));
+            } else {
+                q.shared.push_back(std::move(t));
+                ++sharedSize_;
+            }
+            ++q.size;
+        }
+        notifyAll();
+    }
+
+    Executor::Task Executor::pop(Queue & q) {
+        Task t;
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if ( q.pinned.size() ) {
+            t = std::move(q.pinned.front());
+            q.pinned.pop_front();
+            --q.size;
+        } else if ( q.shared.size() ) {
+            t = std::move(q.shared.back());
+            q.shared.pop_back();
+            --q.size;
+            --sharedSize_;
+        }
+        return t;
+    }
+
+    Executor::Task Executor::steal(const unsigned worker) {
+        Task t;
+        if ( deterministic_ || !sharedSize_.load() ) return t;
+
+        // Steal FIFO, starting from a different group for each worker so
+        // that thieves spread out.
+        std::lock_guard<std::mutex> groupsLock(groupsMutex_);
+        const auto n = groups_.size();
+        for ( size_t i = 0; i < n && !t; ++i ) {
+            auto & q = *groups_[(worker + i) % n];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if ( q.shared.size() ) {
+                t = std::move(q.shared.front());
+                q.shared.pop_front();
+                --q.size;
+                --sharedSize_;
+            }
+        }
+        return t;
+    }
+
+    bool Executor::hasWork(const unsigned worker) const {
+        // In deterministic mode all tasks are pinned, so shared work can't
+        // be taken.
+        return queues_[worker-1]->size.load() || (!deterministic_ && sharedSize_.load());
+    }
+
+    void Executor::notifyAll() {
+        // Locking here makes sure sleeping threads can't miss the update.
+        { std::lock_guard<std::mutex> lock(sleepMutex_); }
+        sleepCondition_.notify_all();
+    }
+
+    void Executor::workerLoop(const unsigned worker) {
+        currentExecutor = this;
+        currentWorker = worker;
+
+        while ( true ) {
+            // Only pinned tasks can be in a background worker's queue.
+            auto t = pop(*queues_[worker-1]);
+            if ( !t ) t = steal(worker);
+            if ( t ) {
+                t();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            sleepCondition_.wait(lock, [this, worker]{ return stop_ || hasWork(worker); });
+            if ( stop_ ) return;
+        }
+    }
+
+    unsigned Executor::getWorkerIndex() const {
+        return currentExecutor == this ? currentWorker : 0;
+    }
+
+    RandomEngine & Executor::getRandomEngine() {
+        if ( currentExecutor == this )
+            return engines_[currentWorker-1];
+
+        if ( cachedEngineOwner != id_ ) {
+            std::lock_guard<std::mutex> lock(externalMutex_);
+            auto it = externalEngines_.find(std::this_thread::get_id());
+            if ( it == std::end(externalEngines_) )
+                it = externalEngines_.emplace(std::this_thread::get_id(), Impl::Seeder::getSeed()).first;
+
+            cachedEngineOwner = id_;
+            cachedEngine = &it->second;
+        }
+        return *cachedEngine;
+    }
+
+    unsigned Executor::getConcurrency() const { return concurrency_; }
+    bool Executor::isDeterministic() const { return deterministic_; }
+
+    std::shared_ptr<Executor> Executor::getDefault() {
+        auto & d = defaultExecutor();
+        std::lock_guard<std::mutex> lock(d.mutex);
+        return d.executor;
+    }
+
+    void Executor::setDefault(const unsigned concurrency, const bool deterministic) {
+        auto e = std::make_shared<Executor>(concurrency, deterministic);
+        auto & d = defaultExecutor();
+        {
+            std::lock_guard<std::mutex> lock(d.mutex);
+            std::swap(d.executor, e);
+        }
+        // If nobody else holds the previous default, it is destroyed here,
+        // outside the lock.
+    }
+
+    Executor::TaskGroup::TaskGroup(Executor & e) :
+            executor_(e), owner_(e.getWorkerIndex()), pending_(0), submitted_(0)
+    {
+        if ( executor_.concurrency_ > 1 ) {
+            std::lock_guard<std::mutex> lock(executor_.groupsMutex_);
+            executor_.groups_.push_back(&queue_);
+        }
+    }
+
+    Executor::TaskGroup::~TaskGroup() {
+        try {
+            wait();
+        } catch (...) {}
+
+        if ( executor_.concurrency_ > 1 ) {
+            std::lock_guard<std::mutex> lock(executor_.groupsMutex_);
+            auto & groups = executor_.groups_;
+            groups.erase(std::find(std::begin(groups), std::end(groups), &queue_));
+        }
+    }
+
+    bool Executor::TaskGroup::runOne() {
+        auto t = executor_.pop(queue_);
+        // Background workers must also run the tasks pinned to them, as
+        // other groups may be waiting on those.
+        if ( !t && owner_ ) t = executor_.pop(*executor_.queues_[owner_-1]);
+        if ( !t ) return false;
+        t();
+        return true;
+    }
+
+    bool Executor::TaskGroup::canWake() const {
+        return !pending_.load(std::memory_order_acquire) || queue_.size.load() ||
+               (owner_ && executor_.queues_[owner_-1]->size.load());
+    }
+
+    void Executor::TaskGroup::wait() {
+        while ( pending_.load(std::memory_order_acquire) ) {
+            if ( runOne() ) continue;
+
+            std::unique_lock<std::mutex> lock(executor_.sleepMutex_);
+            executor_.sleepCondition_.wait(lock, [this]{ return canWake(); });
+        }
+        std::exception_ptr e;
+        {
+            std::lock_guard<std::mutex> lock(errorMutex_);
+            std::swap(e, error_);
+        }
+        if ( e ) std::rethrow_exception(e);
+    }
+}
@@ -71,7 +71,7 @@ namespace AIToolbox {
         lp_.row[S+1] = 0.0;
     }
 
-    std::optional<Point> WitnessLP::findWitness(const Hyperplane & v) {
+    std::optional<Point> WitnessLP::findWitness(const Hyperplane & v, const double epsilon) {
         // Add witness constraint
         for ( size_t i = 0; i < S; ++i )
             lp_.row[i] = v[i];
@@ -86,8 +86,8 @@ namespace AIToolbox {
         // We have found a witness point if we have found a point where the
         // value of the supplied hyperplane is greater than ALL others. Thus we
         // just need to verify that the variable we have maximixed is actually
-        // greater than 0.
-        if (deltaValue <= 0)
+        // greater than 0 (or than the requested epsilon).
+        if (deltaValue <= epsilon)
             solution.reset();
 
         return solution;
@@ -0,0 +1,316 @@
+#include <AIToolbox/Utils/TrajectoryLog.hpp>
+
+#include <AIToolbox/Impl/Logging.hpp>
+
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <boost/crc.hpp>
+
+namespace AIToolbox {
+    namespace {
+        constexpr char logMagic[8] = {'A', 'I', 'T', 'R', 'J', 'L', 'O', 'G'};
+        constexpr std::uint32_t logVersion = 1;
+        constexpr std::uint32_t observationsFlag = 1;
+
+        struct LogHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t flags;
+        };
+
+        struct BlockHeader {
+            std::uint32_t bytes;
+            std::uint32_t records;
+            std::uint32_t checksum;
+        };
+
+        // Bits of the key of each record, in addition to the action.
+        constexpr size_t sameStateBit  = 1;
+        constexpr size_t sameRewardBit = 2;
+        constexpr size_t keyBits       = 2;
+
+        constexpr size_t noState = std::numeric_limits<size_t>::max();
+
+        // A record takes at most a varint for each of key, state, next
+        // state and observation, plus the reward. Bounding the records of a
+        // block keeps its size within the 32 bits of its header.
+        constexpr size_t maxVarintBytes = (std::numeric_limits<size_t>::digits + 6) / 7;
+        constexpr size_t maxRecordBytes = 4 * maxVarintBytes + sizeof(double);
+        constexpr size_t maxBlockRecords = std::numeric_limits<std::uint32_t>::max() / maxRecordBytes;
+
+        std::uint32_t checksum(const unsigned char * data, const size_t size) {
+            boost::crc_32_type crc;
+            crc.process_bytes(data, size);
+            return crc.checksum();
+        }
+
+        bool sameBits(const double a, const double b) {
+            return std::memcmp(&a, &b, sizeof(double)) == 0;
+        }
+
+        void truncateFile(const std::string & filename, const size_t size) {
+#ifdef _WIN32
+            const int fd = ::_open(filename.c_str(), _O_RDWR | _O_BINARY);
+            const bool done = fd >= 0 && ::_chsize_s(fd, size) == 0;
+            if ( fd >= 0 ) ::_close(fd);
+#else
+            const bool done = ::truncate(filename.c_str(), size) == 0;
+#endif
+            if ( !done ) throw std::runtime_error("Could not truncate trajectory log " + filename);
+        }
+
+        void writeVarint(std::vector<unsigned char> & buffer, size_t v) {
+            while ( v >= 0x80 ) {
+                buffer.push_back(static_cast<unsigned char>(v) | 0x80);
+                v >>= 7;
+            }
+            buffer.push_back(static_cast<unsigned char>(v));
+        }
+
+        size_t readVarint(const unsigned char *& ptr, const unsigned char * end) {
+            size_t v = 0;
+            for ( unsigned shift = 0; shift < 64; shift += 7 ) {
+                if ( ptr == end ) throw std::runtime_error("Trajectory log block ends in the middle of a record");
+                const unsigned char c = *ptr++;
+                v |= static_cast<size_t>(c & 0x7F) << shift;
+                if ( !(c & 0x80) ) return v;
+            }
+            throw std::runtime_error("Trajectory log block contains an invalid number");
+        }
+    }
+
+    // TrajectoryWriter::Appender
+
+    TrajectoryWriter::Appender::Appender(TrajectoryWriter & writer) :
+            writer_(&writer), records_(0), lastS1_(noState), lastRew_(0.0) {}
+
+    TrajectoryWriter::Appender::Appender(Appender && other) noexcept :
+            writer_(other.writer_), buffer_(std::move(other.buffer_)), records_(other.records_),
+            lastS1_(other.lastS1_), lastRew_(other.lastRew_)
+    {
+        other.writer_ = nullptr;
+        other.records_ = 0;
+    }
+
+    TrajectoryWriter::Appender::~Appender() {
+        try {
+            flush();
+        } catch (const std::exception & e) {
+            AI_LOGGER(AI_SEVERITY_ERROR, "AIToolbox: Could not write the last block of a trajectory log: " << e.what());
+        }
+    }
+
+    void TrajectoryWriter::Appender::record(const size_t s, const size_t a, const size_t s1, const double rew) {
+        if ( !writer_ ) throw std::runtime_error("Cannot record through a moved-from Appender");
+        if ( writer_->observations_ ) throw std::invalid_argument("Records of this trajectory log require an observation");
+        encode(s, a, s1, 0, rew);
+    }
+
+    void TrajectoryWriter::Appender::record(const size_t s, const size_t a, const size_t s1, const size_t o, const double rew) {
+        if ( !writer_ ) throw std::runtime_error("Cannot record through a moved-from Appender");
+        if ( !writer_->observations_ ) throw std::invalid_argument("Records of this trajectory log do not contain observations");
+        encode(s, a, s1, o, rew);
+    }
+
+    void TrajectoryWriter::Appender::encode(const size_t s, const size_t a, const size_t s1, const size_t o, const double rew) {
+        const bool sameState = s == lastS1_;
+        const bool sameReward = sameBits(rew, lastRew_);
+
+        writeVarint(buffer_, (a << keyBits) | (sameState ? sameStateBit : 0) | (sameReward ? sameRewardBit : 0));
+        if ( !sameState ) writeVarint(buffer_, s);
+        writeVarint(buffer_, s1);
+        if ( writer_->observations_ ) writeVarint(buffer_, o);
+        if ( !sameReward ) {
+            const auto ptr = reinterpret_cast<const unsigned char *>(&rew);
+            buffer_.insert(std::end(buffer_), ptr, ptr + sizeof(double));
+        }
+
+        lastS1_ = s1;
+        lastRew_ = rew;
+
+        if ( ++records_ == writer_->blockRecords_ ) flush();
+    }
+
+    void TrajectoryWriter::Appender::flush() {
+        if ( !records_ ) return;
+
+        writer_->writeBlock(buffer_, records_);
+
+        // Each block can be decoded on its own.
+        buffer_.clear();
+        records_ = 0;
+        lastS1_ = noState;
+        lastRew_ = 0.0;
+    }
+
+    // TrajectoryWriter
+
+    TrajectoryWriter::TrajectoryWriter(const std::string & filename, const bool observations, const unsigned blockRecords) :
+            observations_(observations), blockRecords_(blockRecords)
+    {
+        if ( blockRecords_ == 0 ) throw std::invalid_argument("Blocks must contain at least one record");
+        if ( blockRecords_ > maxBlockRecords )
+            throw std::invalid_argument("Blocks must contain at most " + std::to_string(maxBlockRecords) + " records");
+
+        std::ifstream is(filename, std::ios::binary | std::ios::ate);
+        const size_t size = is ? static_cast<size_t>(is.tellg()) : 0;
+        const bool exists = size > 0;
+
+        if ( exists ) {
+            is.seekg(0);
+            LogHeader h;
+            if ( !is.read(reinterpret_cast<char *>(&h), sizeof(h)) ||
+                 std::memcmp(h.magic, logMagic, sizeof(logMagic)) != 0 || h.version != logVersion )
+            {
+                throw std::runtime_error("File " + filename + " is not a trajectory log");
+            }
+            if ( static_cast<bool>(h.flags & observationsFlag) != observations_ )
+                throw std::invalid_argument("Existing trajectory log " + filename + " has a different observations setting");
+
+            // Find the end of the last complete block.
+            size_t end = sizeof(LogHeader);
+            BlockHeader b;
+            while ( end + sizeof(b) <= size && is.seekg(end) && is.read(reinterpret_cast<char *>(&b), sizeof(b)) ) {
+                if ( end + sizeof(b) + b.bytes > size ) break;
+                end += sizeof(b) + b.bytes;
+            }
+
+            if ( end != size ) {
+                AI_LOGGER(AI_SEVERITY_WARNING, "AIToolbox: Removing incomplete block at the end of trajectory log " << filename);
+                truncateFile(filename, end);
+            }
+        }
+
+        is.close();
+        file_.open(filename, std::ios::binary | std::ios::app);
+        if ( !file_ ) throw std::runtime_error("Could not open trajectory log " + filename);
+
+        if ( !exists ) {
+            LogHeader h;
+            std::memcpy(h.magic, logMagic, sizeof(logMagic));
+            h.version = logVersion;
+            h.flags = observations_ ? observationsFlag : 0;
+
+            file_.write(reinterpret_cast<const char *>(&h), sizeof(h));
+            file_.flush();
+            if ( !file_ ) throw std::runtime_error("Could not write trajectory log " + filename);
+        }
+    }
+
+    TrajectoryWriter::Appender TrajectoryWriter::makeAppender() {
+        return Appender(*this);
+    }
+
+    void TrajectoryWriter::flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        file_.flush();
+        if ( !file_ ) throw std::runtime_error("Could not write trajectory log");
+    }
+
+    bool TrajectoryWriter::hasObservations() const {
+        return observations_;
+    }
+
+    void TrajectoryWriter::writeBlock(const std::vector<unsigned char> & payload, const std::uint32_t records) {
+        // This can't happen with the bound on blockRecords_, but we never
+        // want to write a truncated size.
+        if ( payload.size() > std::numeric_limits<std::uint32_t>::max() )
+            throw std::runtime_error("Trajectory log block is too large");
+
+        BlockHeader b;
+        b.bytes = static_cast<std::uint32_t>(payload.size());
+        b.records = records;
+        b.checksum = checksum(payload.data(), payload.size());
+
+        // Each block is written whole, so blocks are never mixed.
+        std::lock_guard<std::mutex> lock(mutex_);
+        file_.write(reinterpret_cast<const char *>(&b), sizeof(b));
+        file_.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+        if ( !file_ ) throw std::runtime_error("Could not write trajectory log");
+    }
+
+    // TrajectoryReader
+
+    TrajectoryReader::TrajectoryReader(const std::string & filename) :
+            truncated_(false), file_(filename, std::ios::binary)
+    {
+        if ( !file_ ) throw std::runtime_error("Could not open trajectory log " + filename);
+
+        LogHeader h;
+        if ( !file_.read(reinterpret_cast<char *>(&h), sizeof(h)) ||
+             std::memcmp(h.magic, logMagic, sizeof(logMagic)) != 0 || h.version != logVersion )
+        {
+            throw std::runtime_error("File " + filename + " is not a trajectory log");
+        }
+        observations_ = h.flags & observationsFlag;
+    }
+
+    bool TrajectoryReader::readBlock(TrajectoryBlock * blockp) {
+        BlockHeader b;
+        file_.read(reinterpret_cast<char *>(&b), sizeof(b));
+        if ( file_.gcount() == 0 ) return false;
+        if ( file_.gcount() != sizeof(b) ) {
+            truncated_ = true;
+            return false;
+        }
+
+        buffer_.resize(b.bytes);
+        if ( !file_.read(reinterpret_cast<char *>(buffer_.data()), b.bytes) ) {
+            truncated_ = true;
+            return false;
+        }
+        if ( checksum(buffer_.data(), buffer_.size()) != b.checksum )
+            throw std::runtime_error("Trajectory log block does not match its checksum");
+
+        auto & block = *blockp;
+        block.states.resize(b.records);
+        block.actions.resize(b.records);
+        block.nextStates.resize(b.records);
+        block.observations.resize(observations_ ? b.records : 0);
+        block.rewards.resize(b.records);
+
+        const unsigned char * ptr = buffer_.data(), * end = ptr + buffer_.size();
+        size_t lastS1 = noState;
+        double lastRew = 0.0;
+        for ( size_t i = 0; i < b.records; ++i ) {
+            const size_t key = readVarint(ptr, end);
+            block.actions[i] = key >> keyBits;
+
+            if ( key & sameStateBit ) {
+                if ( lastS1 == noState ) throw std::runtime_error("Trajectory log block contains an invalid record");
+                block.states[i] = lastS1;
+            } else {
+                block.states[i] = readVarint(ptr, end);
+            }
+            lastS1 = block.nextStates[i] = readVarint(ptr, end);
+            if ( observations_ ) block.observations[i] = readVarint(ptr, end);
+
+            if ( !(key & sameRewardBit) ) {
+                if ( end - ptr < static_cast<std::ptrdiff_t>(sizeof(double)) )
+                    throw std::runtime_error("Trajectory log block ends in the middle of a record");
+                std::memcpy(&lastRew, ptr, sizeof(double));
+                ptr += sizeof(double);
+            }
+            block.rewards[i] = lastRew;
+        }
+        if ( ptr != end ) throw std::runtime_error("Trajectory log block contains more data than records");
+
+        return true;
+    }
+
+    bool TrajectoryReader::hasObservations() const {
+        return observations_;
+    }
+
+    bool TrajectoryReader::isTruncated() const {
+        return truncated_;
+    }
+}
@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE Bandit_Population
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <array>
+#include <vector>
+#include <AIToolbox/Impl/Seeder.hpp>
+#include <AIToolbox/Bandit/Population.hpp>
+
+BOOST_AUTO_TEST_CASE( updates ) {
+    using namespace AIToolbox;
+    constexpr size_t N = 4, A = 3;
+
+    Bandit::Population p(N, A);
+
+    BOOST_CHECK_EQUAL(p.getN(), N);
+    BOOST_CHECK_EQUAL(p.getA(), A);
+
+    p.stepUpdateP(1, 2, 1.0);
+    p.stepUpdateP(1, 2, 0.0);
+    p.stepUpdateP(1, 2, 0.5);
+    p.stepUpdateP(3, 0, 0.25);
+
+    BOOST_CHECK_CLOSE(p.getAverage(1, 2), 0.5, 0.0001);
+    BOOST_CHECK_EQUAL(p.getTries(1, 2), 3);
+    BOOST_CHECK_CLOSE(p.getAverage(3, 0), 0.25, 0.0001);
+    BOOST_CHECK_EQUAL(p.getTries(3, 0), 1);
+
+    // Untouched arms stay empty.
+    BOOST_CHECK_EQUAL(p.getAverage(0, 0), 0.0);
+    BOOST_CHECK_EQUAL(p.getTries(0, 0), 0);
+
+    // Batched updates are equivalent to single ones.
+    Bandit::Population b(N, A);
+    const std::vector<size_t> is{1, 1, 1, 3};
+    const std::vector<size_t> as{2, 2, 2, 0};
+    const std::vector<double> rs{1.0, 0.0, 0.5, 0.25};
+    b.stepUpdateP(std::begin(is), std::end(is), std::begin(as), std::begin(rs));
+
+    BOOST_CHECK(p.getAverages() == b.getAverages());
+    BOOST_CHECK(p.getTries() == b.getTries());
+
+    p.reset();
+    BOOST_CHECK_EQUAL(p.getTries().sum(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( greedySampling ) {
+    using namespace AIToolbox;
+    constexpr size_t N = 100, A = 3;
+
+    Bandit::Population p(N, A);
+
+    // Without experience, all arms are tied.
+    std::array<unsigned, A> counts{{0,0,0}};
+    for (unsigned i = 0; i < 1000; ++i)
+        ++counts[p.sampleGreedyAction(0)];
+
+    BOOST_CHECK(counts[0] > 200);
+    BOOST_CHECK(counts[1] > 200);
+    BOOST_CHECK(counts[2] > 200);
+
+    for (size_t i = 0; i < N; ++i)
+        p.stepUpdateP(i, i % A, 1.0);
+
+    RandomEngine rnd(Impl::Seeder::getSeed());
+    std::vector<size_t> actions(N);
+    p.sampleGreedyActions(0, N, std::begin(actions), rnd);
+
+    for (size_t i = 0; i < N; ++i)
+        BOOST_CHECK_EQUAL(actions[i], i % A);
+}
+
+BOOST_AUTO_TEST_CASE( thompsonSampling ) {
+    using namespace AIToolbox;
+    constexpr size_t N = 100, A = 3;
+
+    Bandit::Population p(N, A);
+
+    std::array<unsigned, A> counts{{0,0,0}};
+    for (unsigned i = 0; i < 1000; ++i)
+        ++counts[p.sampleThompsonAction(0)];
+
+    BOOST_CHECK(counts[0] > 200);
+    BOOST_CHECK(counts[1] > 200);
+    BOOST_CHECK(counts[2] > 200);
+
+    // After enough experience, each instance must prefer its best arm.
+    for (size_t i = 0; i < N; ++i) {
+        for (size_t a = 0; a < A; ++a) {
+            for (unsigned t = 0; t < 20; ++t)
+                p.stepUpdateP(i, a, a == i % A ? 1.0 : 0.0);
+        }
+    }
+
+    // We sample in two shards with separate engines, as different threads would.
+    RandomEngine rnd1(Impl::Seeder::getSeed()), rnd2(Impl::Seeder::getSeed());
+    std::vector<size_t> actions(N);
+    p.sampleThompsonActions(0, N / 2, std::begin(actions), rnd1);
+    p.sampleThompsonActions(N / 2, N, std::begin(actions) + N / 2, rnd2);
+
+    for (size_t i = 0; i < N; ++i)
+        BOOST_CHECK_EQUAL(actions[i], i % A);
+}
@@ -79,3 +79,71 @@ BOOST_AUTO_TEST_CASE( probability ) {
     BOOST_CHECK(0.375 < pol[1] && pol[1] < 0.485);
     BOOST_CHECK(0.375 < pol[2] && pol[2] < 0.485);
 }
+
+BOOST_AUTO_TEST_CASE( probability_matches_sampling ) {
+    using namespace AIToolbox;
+    constexpr size_t A = 4;
+
+    Bandit::ThompsonSamplingPolicy p(A);
+
+    // Very different posterior widths, which are the hardest case for the
+    // quadrature.
+    for (unsigned i = 0; i < 5; ++i) {
+        p.stepUpdateP(1, 1.0);
+        p.stepUpdateP(2, 1.0);
+    }
+    for (unsigned i = 0; i < 49; ++i)
+        p.stepUpdateP(3, 0.3);
+
+    const auto pol = p.getPolicy();
+    BOOST_CHECK(checkEqualSmall(pol.sum(), 1.0));
+
+    constexpr unsigned trials = 200000;
+    std::array<unsigned, A> counts{{0,0,0,0}};
+    for (unsigned i = 0; i < trials; ++i)
+        ++counts[p.sampleAction()];
+
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_TEST_INFO("Action " << a);
+        BOOST_CHECK_SMALL(pol[a] - static_cast<double>(counts[a]) / trials, 0.005);
+        BOOST_CHECK_EQUAL(pol[a], p.getActionProbability(a));
+    }
+
+    // The cache must be invalidated on update.
+    for (unsigned i = 0; i < 20; ++i)
+        p.stepUpdateP(0, 1.0);
+
+    BOOST_CHECK(p.getActionProbability(0) > pol[0]);
+    BOOST_CHECK(checkEqualSmall(p.getPolicy().sum(), 1.0));
+}
+
+BOOST_AUTO_TEST_CASE( probability_unbalanced_posteriors ) {
+    using namespace AIToolbox;
+    constexpr size_t A = 5;
+
+    Bandit::ThompsonSamplingPolicy p(A);
+
+    // Means and posterior widths spread over three orders of magnitude,
+    // with the narrow posteriors right where the wide ones have most of
+    // their mass.
+    const std::array<std::pair<double, unsigned>, A> arms{{
+        {0.0, 0}, {0.9, 1}, {0.7, 200}, {0.2, 3}, {0.72, 1000}
+    }};
+    for (size_t a = 0; a < A; ++a)
+        for (unsigned i = 0; i < arms[a].second; ++i)
+            p.stepUpdateP(a, arms[a].first);
+
+    const auto pol = p.getPolicy();
+    BOOST_CHECK(checkEqualSmall(pol.sum(), 1.0));
+
+    constexpr unsigned trials = 2000000;
+    std::array<unsigned, A> counts{{0,0,0,0,0}};
+    for (unsigned i = 0; i < trials; ++i)
+        ++counts[p.sampleAction()];
+
+    // The standard error of each frequency is at most 3.5e-4.
+    for (size_t a = 0; a < A; ++a) {
+        BOOST_TEST_INFO("Action " << a);
+        BOOST_CHECK_SMALL(pol[a] - static_cast<double>(counts[a]) / trials, 0.002);
+    }
+}
@@ -152,6 +152,52 @@ BOOST_AUTO_TEST_CASE( partial_factor_merge ) {
                                   std::begin(result2.second), std::end(result2.second));
 }
 
+BOOST_AUTO_TEST_CASE( small_partial_factors ) {
+    const aif::PartialFactors pf = {{0, 3, 5, 6}, {1, 2, 0, 4}};
+
+    const auto spf = aif::toSmallPartialFactors(pf);
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(pf.first), std::end(pf.first),
+                                  std::begin(spf.first), std::end(spf.first));
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(pf.second), std::end(pf.second),
+                                  std::begin(spf.second), std::end(spf.second));
+    BOOST_CHECK(aif::toPartialFactors(spf) == pf);
+
+    // The small overloads must agree with the PartialFactors ones.
+    const aif::PartialFactors rhs = {{1, 2, 4, 7}, {1, 2, 4, 7}};
+    const auto merged = aif::merge(spf, aif::toSmallPartialFactors(rhs));
+    BOOST_CHECK(aif::toPartialFactors(merged) == aif::merge(pf, rhs));
+
+    auto inplace = spf;
+    aif::inplace_merge(&inplace, aif::toSmallPartialFactors(rhs));
+    BOOST_CHECK(inplace == merged);
+
+    BOOST_CHECK(aif::toPartialFactors(aif::removeFactor(spf, 5)) == aif::removeFactor(pf, 5));
+    BOOST_CHECK(aif::removeFactor(spf, 4) == spf);
+
+    BOOST_CHECK(aif::toFactors(7, spf) == aif::toFactors(7, pf));
+
+    const aif::PartialFactors big = {{0, 1, 3, 5, 6}, {1, 7, 2, 0, 4}};
+    BOOST_CHECK(aif::match(big, spf));
+    BOOST_CHECK(aif::match(big, spf) == aif::match(big, pf));
+
+    const aif::PartialFactors other = {{0, 1, 3, 5, 6}, {1, 7, 3, 0, 4}};
+    BOOST_CHECK(!aif::match(other, spf));
+    BOOST_CHECK(aif::match(other, spf) == aif::match(other, pf));
+
+    // Factors missing from the bigger input do not match, even past its end.
+    const aif::PartialFactors lhsEnd = {{0, 1}, {1, 2}};
+    const auto rhsEnd = aif::toSmallPartialFactors(aif::PartialFactors{{0, 9}, {1, 0}});
+    BOOST_CHECK(!aif::match(lhsEnd, rhsEnd));
+
+    // More factors than fit inline must still work.
+    aif::PartialFactors large;
+    for (size_t i = 0; i < 20; ++i) {
+        large.first.push_back(i);
+        large.second.push_back(i * 2);
+    }
+    BOOST_CHECK(aif::toPartialFactors(aif::toSmallPartialFactors(large)) == large);
+}
+
 BOOST_AUTO_TEST_CASE( partial_factor_enumerator_no_skip ) {
     aif::Factors f{1,2,3,4,5};
     aif::PartialFactorsEnumerator enumerator(f, {0, 2, 3});
@@ -245,3 +291,46 @@ BOOST_AUTO_TEST_CASE( partial_factor_enumerator_skip_only_factor ) {
         ++counter;
     }
 }
+
+BOOST_AUTO_TEST_CASE( partial_index_encoder ) {
+    aif::Factors space{2, 3, 4, 5};
+
+    // Full encoder matches toIndex/toFactors.
+    aif::PartialIndexEncoder full(space);
+    BOOST_CHECK_EQUAL(full.size(), aif::factorSpace(space));
+
+    aif::Factors f(space.size());
+    for (size_t id = 0; id < full.size(); ++id) {
+        full.decode(id, &f);
+        BOOST_CHECK(f == aif::toFactors(space, id));
+        BOOST_CHECK_EQUAL(full.encode(f), aif::toIndex(space, f));
+        BOOST_CHECK_EQUAL(full.encode(aif::toPartialFactors(f)), id);
+    }
+
+    // Partial encoder matches toIndexPartial.
+    const std::vector<size_t> ids{1, 3};
+    aif::PartialIndexEncoder partial(space, ids);
+    BOOST_CHECK_EQUAL(partial.size(), aif::factorSpacePartial(ids, space));
+    BOOST_CHECK(partial.getIds() == ids);
+
+    const aif::Factors values{1, 2, 3, 4};
+    const aif::PartialFactors pf{ids, {2, 4}};
+    BOOST_CHECK_EQUAL(partial.encode(values), aif::toIndexPartial(ids, space, values));
+    BOOST_CHECK_EQUAL(partial.encode(pf), aif::toIndexPartial(space, pf));
+
+    // Multipliers shift the index by a single factor.
+    BOOST_CHECK_EQUAL(partial.getMultiplier(0), 1);
+    BOOST_CHECK_EQUAL(partial.getMultiplier(1), 3);
+    aif::Factors out(space.size(), 0);
+    partial.decode(partial.encode(values) - partial.getMultiplier(0), &out);
+    BOOST_CHECK_EQUAL(out[0], 0);
+    BOOST_CHECK_EQUAL(out[1], 1);
+    BOOST_CHECK_EQUAL(out[2], 0);
+    BOOST_CHECK_EQUAL(out[3], 4);
+
+    partial.decode(partial.encode(values) - partial.getMultiplier(1), &out);
+    BOOST_CHECK_EQUAL(out[0], 0);
+    BOOST_CHECK_EQUAL(out[1], 2);
+    BOOST_CHECK_EQUAL(out[2], 0);
+    BOOST_CHECK_EQUAL(out[3], 3);
+}
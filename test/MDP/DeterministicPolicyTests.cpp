@@ -0,0 +1,87 @@
+#define BOOST_TEST_MODULE MDP_DeterministicPolicy
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+#include <AIToolbox/MDP/Utils.hpp>
+#include <AIToolbox/MDP/IO.hpp>
+#include <AIToolbox/MDP/Policies/Policy.hpp>
+#include <AIToolbox/MDP/Policies/DeterministicPolicy.hpp>
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 5, A = 300;
+
+    auto v = makeValueFunction(S);
+    v.actions = {3, 299, 0, 256, 42};
+
+    DeterministicPolicy p(S, A, v);
+
+    BOOST_CHECK_EQUAL(p.getActionWidth(), 2);
+    for ( size_t s = 0; s < S; ++s ) {
+        BOOST_CHECK_EQUAL(p.getAction(s), v.actions[s]);
+        BOOST_CHECK_EQUAL(p.sampleAction(s), v.actions[s]);
+        for ( size_t a = 0; a < A; ++a )
+            BOOST_CHECK_EQUAL(p.getActionProbability(s, a), a == v.actions[s] ? 1.0 : 0.0);
+    }
+
+    BOOST_CHECK_EQUAL(DeterministicPolicy(S, 256).getActionWidth(), 1);
+    BOOST_CHECK_EQUAL(DeterministicPolicy(S, 65537).getActionWidth(), 4);
+
+    v.actions[2] = A;
+    BOOST_CHECK_THROW(DeterministicPolicy(S, A, v), std::invalid_argument);
+
+    // Invalid actions are rejected, including ones that would be truncated
+    // to a valid one by the storage width.
+    BOOST_CHECK_THROW(p.setAction(0, A), std::invalid_argument);
+    BOOST_CHECK_THROW(p.setAction(0, 65536 + 3), std::invalid_argument);
+    BOOST_CHECK_EQUAL(p.getAction(0), v.actions[0]);
+
+    p.setAction(0, A - 1);
+    BOOST_CHECK_EQUAL(p.getAction(0), A - 1);
+}
+
+BOOST_AUTO_TEST_CASE( dense_conversion ) {
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 4, A = 3;
+
+    auto v = makeValueFunction(S);
+    v.actions = {2, 0, 1, 2};
+
+    const Policy dense(S, A, v);
+    const DeterministicPolicy p(dense.getPolicyTable());
+
+    BOOST_CHECK_EQUAL(p.getPolicy(), dense.getPolicyTable());
+    BOOST_CHECK_EQUAL(Policy(p).getPolicyTable(), dense.getPolicyTable());
+
+    // Stochastic tables can't be converted.
+    BOOST_CHECK_THROW(DeterministicPolicy(Policy(S, A).getPolicyTable()), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( binary_io ) {
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 50, A = 70000;
+
+    DeterministicPolicy p(S, A);
+    for ( size_t s = 0; s < S; ++s )
+        p.setAction(s, (s * 1399) % A);
+
+    std::stringstream ss;
+    writeBinary(ss, p);
+    // Header plus four bytes per state.
+    BOOST_CHECK_EQUAL(ss.str().size(), 20 + S * 4);
+
+    DeterministicPolicy q(S, A);
+    BOOST_CHECK(readBinary(ss, q));
+    for ( size_t s = 0; s < S; ++s )
+        BOOST_CHECK_EQUAL(q.getAction(s), p.getAction(s));
+
+    // Mismatched sizes are rejected, and the policy is not modified.
+    std::stringstream ss2;
+    writeBinary(ss2, DeterministicPolicy(S, 3));
+    BOOST_CHECK(!readBinary(ss2, q));
+    for ( size_t s = 0; s < S; ++s )
+        BOOST_CHECK_EQUAL(q.getAction(s), p.getAction(s));
+}
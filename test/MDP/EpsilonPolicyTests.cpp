@@ -0,0 +1,47 @@
+#define BOOST_TEST_MODULE MDP_EpsilonPolicy
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
+#include <AIToolbox/MDP/Policies/QGreedyPolicy.hpp>
+#include <AIToolbox/MDP/Policies/EpsilonPolicy.hpp>
+
+BOOST_AUTO_TEST_CASE( getActionProbabilities ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 3, A = 3;
+    constexpr double epsilon = 0.3;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 45;
+    q(0,1) = 14;
+    q(0,2) = -15;
+
+    q(1,0) = 1001;
+    q(1,1) = 1000.99;
+    q(1,2) = 1001;
+
+    q(2,0) = 42;
+    q(2,1) = 42;
+    q(2,2) = 42;
+
+    QGreedyPolicy greedy(q);
+    EpsilonPolicy p(greedy, epsilon);
+    const auto table = p.getPolicy();
+
+    Vector row, greedyRow;
+    for (size_t s = 0; s < S; ++s) {
+        p.getActionProbabilities(s, &row);
+        greedy.getActionProbabilities(s, &greedyRow);
+        BOOST_CHECK_EQUAL(row.size(), A);
+
+        for (size_t a = 0; a < A; ++a) {
+            const double expected = (1.0 - epsilon) * greedyRow[a] + epsilon / A;
+            BOOST_CHECK(checkEqualSmall(row[a], expected));
+            BOOST_CHECK(checkEqualSmall(row[a], p.getActionProbability(s, a)));
+            BOOST_CHECK(checkEqualSmall(row[a], table(s, a)));
+        }
+    }
+}
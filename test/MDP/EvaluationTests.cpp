@@ -0,0 +1,135 @@
+#define BOOST_TEST_MODULE MDP_Evaluation
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/MDP/Evaluation.hpp>
+#include <AIToolbox/MDP/Algorithms/MCTS.hpp>
+#include <AIToolbox/MDP/Algorithms/Utils/PolicyEvaluation.hpp>
+#include <AIToolbox/MDP/Policies/Policy.hpp>
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/Impl/Seeder.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+#include "Utils/CornerProblem.hpp"
+
+BOOST_AUTO_TEST_CASE( randomPolicy ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    Model model = makeCornerProblem(grid, 1.0);
+    model.setDiscount(1.0);
+
+    constexpr unsigned horizon = 10;
+    constexpr size_t start = 5;
+    constexpr size_t episodes = 4000;
+
+    Policy policy(model.getS(), model.getA());
+
+    PolicyEvaluation ev(model, horizon, 0.0);
+    const double truth = std::get<1>(ev(policy))[start];
+
+    Executor e(4);
+    const auto results = evaluatePolicy(model, [&](unsigned) { return policy; }, start, episodes, horizon, e);
+
+    BOOST_CHECK_EQUAL(results.episodes, episodes);
+    BOOST_CHECK_EQUAL(results.returns.size(), episodes);
+    BOOST_CHECK(results.confidence > 0.0);
+    // The mean is off by more than 5 standard errors with probability
+    // below 1e-6, whatever the seed.
+    const double stderror = results.stddev / std::sqrt(static_cast<double>(episodes));
+    BOOST_CHECK(std::fabs(results.mean - truth) < 5.0 * stderror);
+    BOOST_CHECK(results.meanSteps > 0.0 && results.meanSteps <= horizon);
+
+    // Sparse models are sampled directly through their sparse rows.
+    const SparseModel sparseModel(model);
+    const auto sresults = evaluatePolicy(sparseModel, [&](unsigned) { return policy; }, start, episodes, horizon, e);
+    const double sstderror = sresults.stddev / std::sqrt(static_cast<double>(episodes));
+    BOOST_CHECK(std::fabs(sresults.mean - truth) < 5.0 * sstderror);
+}
+
+BOOST_AUTO_TEST_CASE( deterministic ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    Model model = makeCornerProblem(grid, 0.8);
+
+    const auto run = [&]() {
+        Impl::Seeder::setRootSeed(42);
+        Executor e(3, true);
+        Policy p(model.getS(), model.getA());
+        return evaluatePolicy(model, [&](unsigned) { return p; }, 3, 200, 20, e).returns;
+    };
+
+    const auto r1 = run();
+    const auto r2 = run();
+    BOOST_CHECK(r1 == r2);
+}
+
+BOOST_AUTO_TEST_CASE( onlinePlanner ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    Model model = makeCornerProblem(grid);
+
+    constexpr unsigned workers = 2;
+    constexpr unsigned horizon = 10;
+
+    // Each MCTS samples its own copy of the model.
+    std::vector<Model> copies(workers, model);
+
+    Executor e(workers);
+    const auto results = evaluatePolicy(model, [&](unsigned w) {
+        return MCTS<Model>(copies[w], 500, 5.0);
+    }, 5, 20, horizon, e);
+
+    BOOST_CHECK_EQUAL(results.episodes, 20);
+    // From this state, the optimal policy reaches a corner in 2 steps
+    // when moves do not fail.
+    BOOST_CHECK(results.meanSteps < 5.0);
+    BOOST_CHECK(results.mean > -5.0);
+    BOOST_CHECK(results.secondsPerStep > 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( concurrentCallers ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    Model model = makeCornerProblem(grid);
+
+    // An agent which counts the times it is used by two threads at once.
+    struct CheckedAgent {
+        size_t sampleAction(size_t) {
+            if ( (*busy)++ ) ++*overlaps;
+            std::this_thread::yield();
+            --*busy;
+            return 0;
+        }
+        std::shared_ptr<std::atomic<unsigned>> busy;
+        std::atomic<size_t> * overlaps;
+    };
+
+    std::atomic<size_t> overlaps(0);
+    Executor e(3);
+
+    const auto caller = [&] {
+        for ( unsigned k = 0; k < 20; ++k )
+            evaluatePolicy(model, [&](unsigned) {
+                return CheckedAgent{std::make_shared<std::atomic<unsigned>>(0), &overlaps};
+            }, 5, 50, 10, e);
+    };
+    std::thread t0(caller), t1(caller);
+    t0.join();
+    t1.join();
+
+    BOOST_CHECK_EQUAL(overlaps.load(), 0);
+}
@@ -0,0 +1,76 @@
+#define BOOST_TEST_MODULE MDP_FixedModel
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/FixedModel.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+
+#include "Utils/CornerProblem.hpp"
+
+BOOST_AUTO_TEST_CASE( eigen_model ) {
+    BOOST_CHECK((AIToolbox::MDP::is_model_eigen_v<AIToolbox::MDP::FixedModel<4, 4>>));
+    BOOST_CHECK((AIToolbox::MDP::is_model_eigen_v<AIToolbox::MDP::FixedModel<3, 1>>));
+}
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 5, A = 6;
+
+    FixedModel<S, A> m;
+
+    BOOST_CHECK_EQUAL(m.getS(), S);
+    BOOST_CHECK_EQUAL(m.getA(), A);
+    BOOST_CHECK_EQUAL(m.getDiscount(), 1.0);
+
+    BOOST_CHECK_EQUAL(m.getTransitionProbability(0,0,0), 1.0);
+    BOOST_CHECK_EQUAL(m.getTransitionProbability(0,1,0), 1.0);
+    BOOST_CHECK_EQUAL(m.getTransitionProbability(0,0,1), 0.0);
+    BOOST_CHECK_EQUAL(m.getExpectedReward(0,0,0), 0.0);
+
+    BOOST_CHECK_THROW((FixedModel<S, A>(0.0)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( copy_construction ) {
+    using namespace AIToolbox::MDP;
+    GridWorld grid(2, 2);
+
+    const auto model = makeCornerProblem(grid);
+    const size_t S = model.getS(), A = model.getA();
+
+    FixedModel<4, 4> copy(model);
+
+    BOOST_CHECK_EQUAL(model.getDiscount(), copy.getDiscount());
+
+    for ( size_t s = 0; s < S; ++s )
+        for ( size_t a = 0; a < A; ++a )
+            for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                BOOST_CHECK_EQUAL(model.getTransitionProbability(s, a, s1), copy.getTransitionProbability(s, a, s1));
+                BOOST_CHECK_EQUAL(model.getExpectedReward(s, a, s1), copy.getExpectedReward(s, a, s1));
+            }
+
+    // Converting back recovers the same model.
+    Model back(copy);
+    for ( size_t a = 0; a < A; ++a )
+        BOOST_CHECK(model.getTransitionFunction(a).isApprox(back.getTransitionFunction(a)));
+
+    // Sizes must match.
+    BOOST_CHECK_THROW((FixedModel<3, 4>(model)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( solving ) {
+    using namespace AIToolbox::MDP;
+    GridWorld grid(2, 2);
+
+    auto model = makeCornerProblem(grid);
+    FixedModel<4, 4> fixed(model);
+
+    ValueIteration solver(1000000, 0.001);
+
+    const auto [b1, vf1, q1] = solver(model);
+    const auto [b2, vf2, q2] = solver(fixed);
+
+    BOOST_CHECK_EQUAL(b1, b2);
+    BOOST_CHECK(q1.isApprox(q2));
+}
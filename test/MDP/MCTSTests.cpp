@@ -102,3 +102,99 @@ BOOST_AUTO_TEST_CASE( sampleOneTime ) {
     // We make a,o the new head
     solver.sampleAction( 0, s1, horizon - 1);
 }
+
+BOOST_AUTO_TEST_CASE( transpositionTable ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4,4);
+
+    auto model = makeCornerProblem(grid);
+
+    constexpr size_t maxNodes = 100;
+    MCTS solver(model, 10000, 5.0, maxNodes);
+    BOOST_CHECK_EQUAL(solver.getMaxTableNodes(), maxNodes);
+
+    // Same checks as the tree version.
+    BOOST_CHECK_EQUAL( solver.sampleAction(1,10), LEFT);
+    BOOST_CHECK_EQUAL( solver.sampleAction(4,10), UP);
+    BOOST_CHECK_EQUAL( solver.sampleAction(7,10), DOWN);
+    BOOST_CHECK_EQUAL( solver.sampleAction(13,10), RIGHT);
+
+    // The table never grows above its bound, and nodes are shared: with
+    // 16 states and 10 levels there can't be more than 160 distinct ones.
+    const auto & table = solver.getTable();
+    BOOST_CHECK(table.size() <= maxNodes);
+    for ( const auto & [key, node] : table ) {
+        BOOST_CHECK(key / model.getS() >= 1);
+        BOOST_CHECK(key / model.getS() < 10);
+    }
+
+    // The tree does not store children in transposition mode.
+    for ( const auto & an : solver.getGraph().children )
+        BOOST_CHECK(an.children.empty());
+
+    // Advancing the root keeps only deeper nodes.
+    const auto a = solver.sampleAction(13, 10);
+    const auto [s1, r] = model.sampleSR(13, a);
+    (void)r;
+    solver.sampleAction(a, s1, 9);
+    for ( const auto & [key, node] : solver.getTable() )
+        BOOST_CHECK(key / model.getS() >= 2);
+
+    // Even a table too small for a single path keeps its bound.
+    solver.setMaxTableNodes(5);
+    solver.sampleAction(1, 10);
+    BOOST_CHECK(solver.getTable().size() <= 5);
+    BOOST_CHECK_EQUAL(solver.getGraph().N, 10000u);
+
+    // Disabling the table goes back to the tree.
+    solver.setMaxTableNodes(0);
+    BOOST_CHECK_EQUAL( solver.sampleAction(1,10), LEFT);
+    BOOST_CHECK(solver.getTable().empty());
+}
+
+BOOST_AUTO_TEST_CASE( batchedRollouts ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4,4);
+
+    auto model = makeCornerProblem(grid);
+
+    MCTS solver(model, 10000, 5.0);
+    BOOST_CHECK_EQUAL(solver.getBatchSize(), 1u);
+    solver.setBatchSize(16);
+    BOOST_CHECK_EQUAL(solver.getBatchSize(), 16u);
+
+    // Same checks as the unbatched version.
+    BOOST_CHECK_EQUAL( solver.sampleAction(1,10), LEFT);
+    BOOST_CHECK_EQUAL( solver.sampleAction(2,10), LEFT);
+    BOOST_CHECK_EQUAL( solver.sampleAction(4,10), UP);
+    BOOST_CHECK_EQUAL( solver.sampleAction(7,10), DOWN);
+    BOOST_CHECK_EQUAL( solver.sampleAction(13,10), RIGHT);
+    BOOST_CHECK_EQUAL( solver.sampleAction(14,10), RIGHT);
+
+    // All simulations are accounted for, even if the batch size does
+    // not divide the number of iterations.
+    solver.setIterations(1000);
+    solver.setBatchSize(64);
+    solver.sampleAction(5, 10);
+    unsigned visits = 0;
+    for ( const auto & an : solver.getGraph().children )
+        visits += an.N;
+    BOOST_CHECK_EQUAL(visits, 1000u);
+    BOOST_CHECK_EQUAL(solver.getGraph().N, 1000u);
+
+    // The batched mode works with the transposition table too.
+    solver.setIterations(10000);
+    solver.setMaxTableNodes(100);
+    BOOST_CHECK_EQUAL( solver.sampleAction(1,10), LEFT);
+    BOOST_CHECK_EQUAL( solver.sampleAction(13,10), RIGHT);
+    BOOST_CHECK(solver.getTable().size() <= 100);
+
+    // A batch can need more nodes than the table holds; the ones that do
+    // not fit are simply not stored.
+    solver.setMaxTableNodes(8);
+    solver.sampleAction(5, 10);
+    BOOST_CHECK(solver.getTable().size() <= 8);
+    BOOST_CHECK_EQUAL(solver.getGraph().N, 10000u);
+}
@@ -12,6 +12,7 @@
 
 BOOST_AUTO_TEST_CASE( eigen_model ) {
     BOOST_CHECK(AIToolbox::MDP::is_model_eigen_v<AIToolbox::MDP::Model>);
+    BOOST_CHECK(AIToolbox::MDP::is_model_eigen_v<AIToolbox::MDP::ModelT<float>>);
 }
 
 BOOST_AUTO_TEST_CASE( construction ) {
@@ -57,6 +58,35 @@ BOOST_AUTO_TEST_CASE( copy_construction ) {
     }
 }
 
+BOOST_AUTO_TEST_CASE( single_precision_conversion ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+
+    auto model = makeCornerProblem(grid);
+    size_t S = model.getS(), A = model.getA();
+
+    ModelT<float> copy(model);
+
+    BOOST_CHECK_EQUAL(model.getDiscount(), copy.getDiscount());
+    BOOST_CHECK_EQUAL(S, copy.getS());
+    BOOST_CHECK_EQUAL(A, copy.getA());
+
+    for ( size_t s = 0; s < S; ++s ) {
+        for ( size_t a = 0; a < A; ++a ) {
+            for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                BOOST_CHECK_CLOSE(model.getTransitionProbability(s, a, s1), copy.getTransitionProbability(s, a, s1), 0.0001);
+                BOOST_CHECK_CLOSE(model.getExpectedReward(s, a, s1), copy.getExpectedReward(s, a, s1), 0.0001);
+            }
+        }
+    }
+
+    // Converting back recovers the same model.
+    Model back(copy);
+    for ( size_t a = 0; a < A; ++a )
+        BOOST_CHECK(model.getTransitionFunction(a).isApprox(back.getTransitionFunction(a), 1e-6));
+}
+
 int generator() {
     static int counter = 0;
     return ++counter;
@@ -124,3 +154,36 @@ BOOST_AUTO_TEST_CASE( cassandraCorner ) {
         BOOST_CHECK(AIToolbox::checkEqualGeneral(m.getExpectedReward(s, a, s1), m2.getExpectedReward(s, a, s1)));
     }
 }
+
+BOOST_AUTO_TEST_CASE( sampleBatch ) {
+    using namespace AIToolbox::MDP;
+
+    BOOST_CHECK(is_batch_generative_model_v<Model>);
+
+    GridWorld grid(4, 4);
+    auto model = makeCornerProblem(grid);
+
+    constexpr size_t N = 100000;
+    std::vector<size_t> s(N), a(N), s1(N);
+    std::vector<double> r(N);
+    for ( size_t i = 0; i < N; ++i ) {
+        s[i] = i % 2 ? 5 : 10;
+        a[i] = (i / 2) % model.getA();
+    }
+    model.sampleSRBatch(N, s.data(), a.data(), s1.data(), r.data());
+
+    // Check the empirical frequencies against the transition function.
+    std::vector<double> counts(model.getS() * model.getA() * 2, 0.0);
+    for ( size_t i = 0; i < N; ++i ) {
+        BOOST_CHECK_EQUAL(r[i], model.getExpectedReward(s[i], a[i], s1[i]));
+        counts[(i % 2) * model.getS() * model.getA() + a[i] * model.getS() + s1[i]] += 1.0;
+    }
+    const double perPair = N / 2.0 / model.getA();
+    for ( size_t i = 0; i < 2; ++i ) {
+        const size_t ss = i ? 5 : 10;
+        for ( size_t aa = 0; aa < model.getA(); ++aa )
+            for ( size_t ss1 = 0; ss1 < model.getS(); ++ss1 )
+                BOOST_CHECK_SMALL(counts[i * model.getS() * model.getA() + aa * model.getS() + ss1] / perPair
+                                  - model.getTransitionProbability(ss, aa, ss1), 0.02);
+    }
+}
@@ -118,3 +118,32 @@ BOOST_AUTO_TEST_CASE( getPolicy ) {
     BOOST_CHECK(checkEqualSmall(table(2,1), 1.0/3.0));
     BOOST_CHECK(checkEqualSmall(table(2,2), 1.0/3.0));
 }
+
+BOOST_AUTO_TEST_CASE( getActionProbabilities ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 3, A = 3;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 45;
+    q(0,1) = 14;
+    q(0,2) = -15;
+
+    q(1,0) = 1001;
+    q(1,1) = 1000.99;
+    q(1,2) = 1001;
+
+    q(2,0) = 42;
+    q(2,1) = 42;
+    q(2,2) = 42;
+
+    QGreedyPolicy p(q);
+
+    Vector row;
+    for (size_t s = 0; s < S; ++s) {
+        p.getActionProbabilities(s, &row);
+        BOOST_CHECK_EQUAL(row.size(), A);
+        for (size_t a = 0; a < A; ++a)
+            BOOST_CHECK(checkEqualSmall(row[a], p.getActionProbability(s, a)));
+    }
+}
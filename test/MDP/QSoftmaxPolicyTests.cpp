@@ -0,0 +1,49 @@
+#define BOOST_TEST_MODULE MDP_QSoftmaxPolicy
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <AIToolbox/Utils/Core.hpp>
+#include <AIToolbox/MDP/Utils.hpp>
+#include <AIToolbox/MDP/Policies/QSoftmaxPolicy.hpp>
+
+BOOST_AUTO_TEST_CASE( getActionProbabilities ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::MDP;
+    constexpr size_t S = 3, A = 3;
+    constexpr double temperature = 10.0;
+
+    auto q = makeQFunction(S, A);
+    q(0,0) = 45;
+    q(0,1) = 14;
+    q(0,2) = -15;
+
+    q(1,0) = 1001;
+    q(1,1) = 1000.99;
+    q(1,2) = 1001;
+
+    q(2,0) = 42;
+    q(2,1) = 42;
+    q(2,2) = 42;
+
+    QSoftmaxPolicy p(q, temperature);
+    const auto table = p.getPolicy();
+
+    Vector row;
+    for (size_t s = 0; s < S; ++s) {
+        p.getActionProbabilities(s, &row);
+        BOOST_CHECK_EQUAL(row.size(), A);
+
+        double norm = 0.0;
+        for (size_t a = 0; a < A; ++a)
+            norm += std::exp((q(s, a) - q.row(s).maxCoeff()) / temperature);
+
+        for (size_t a = 0; a < A; ++a) {
+            const double expected = std::exp((q(s, a) - q.row(s).maxCoeff()) / temperature) / norm;
+            BOOST_CHECK(checkEqualSmall(row[a], expected));
+            BOOST_CHECK(checkEqualSmall(row[a], p.getActionProbability(s, a)));
+            BOOST_CHECK(checkEqualSmall(row[a], table(s, a)));
+        }
+    }
+}
@@ -0,0 +1,200 @@
+#define BOOST_TEST_MODULE MDP_ShardedModel
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/MDP/ShardedModel.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+
+#include "Utils/CornerProblem.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+
+namespace {
+    struct TempDirectory {
+        // Each directory gets a random suffix, so that concurrent runs of
+        // the tests do not step on each other.
+        TempDirectory(const std::string & name) {
+            std::random_device rd;
+            do path = (std::filesystem::temp_directory_path() / (name + "-" + std::to_string(rd()))).string();
+            while ( !std::filesystem::create_directory(path) );
+        }
+        ~TempDirectory() { std::filesystem::remove_all(path); }
+
+        std::string path;
+    };
+}
+
+BOOST_AUTO_TEST_CASE( roundtrip ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    const SparseModel model(makeCornerProblem(grid));
+
+    TempDirectory dir("aitoolbox-shards-roundtrip");
+    writeShards(model, dir.path, 5);
+
+    const ShardedModel sharded(dir.path);
+    BOOST_CHECK_EQUAL(sharded.getS(), model.getS());
+    BOOST_CHECK_EQUAL(sharded.getA(), model.getA());
+    BOOST_CHECK_EQUAL(sharded.getDiscount(), model.getDiscount());
+    BOOST_CHECK_EQUAL(sharded.getShardsNumber(), 4);
+
+    const auto & R = model.getRewardFunction();
+    for ( size_t i = 0; i < sharded.getShardsNumber(); ++i ) {
+        const auto shard = sharded.getShard(i);
+        BOOST_CHECK_EQUAL(shard.firstState, i * 5);
+
+        for ( size_t k = 0, row = 0; k < shard.states; ++k ) {
+            const size_t s = shard.firstState + k;
+            for ( size_t a = 0; a < model.getA(); ++a, ++row ) {
+                BOOST_CHECK_EQUAL(shard.rewards[row], R.coeff(s, a));
+
+                double sum = 0.0;
+                for ( auto j = shard.rowPtr[row]; j < shard.rowPtr[row + 1]; ++j ) {
+                    BOOST_CHECK_EQUAL(shard.values[j], model.getTransitionProbability(s, a, shard.cols[j]));
+                    sum += shard.values[j];
+                }
+                BOOST_CHECK_CLOSE(sum, 1.0, 0.0001);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( nestedDirectory ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(3, 3);
+    const SparseModel model(makeCornerProblem(grid));
+
+    // Missing parent directories are created by the writer.
+    TempDirectory dir("aitoolbox-shards-nested");
+    const auto path = dir.path + "/a/b/";
+    writeShards(model, path, 4);
+
+    const ShardedModel sharded(path);
+    BOOST_CHECK_EQUAL(sharded.getS(), model.getS());
+    BOOST_CHECK_EQUAL(sharded.getShardsNumber(), 3);
+
+    // A file in the way of the directory is an error.
+    std::ofstream(dir.path + "/file") << "x";
+    BOOST_CHECK_THROW(writeShards(model, dir.path + "/file/c", 4), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( valueIteration ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+    auto model = makeCornerProblem(grid);
+    model.setDiscount(0.9);
+
+    TempDirectory dir("aitoolbox-shards-vi");
+    // A dense model goes through the generic path.
+    writeShards(model, dir.path, 3);
+    const ShardedModel sharded(dir.path);
+
+    ValueIteration solver(1000, 0.00001);
+    const auto [variation, vf, q] = solver(model);
+    const auto [svariation, svf, sq] = solver(sharded);
+
+    BOOST_CHECK_CLOSE(variation, svariation, 0.0001);
+    for ( size_t s = 0; s < model.getS(); ++s ) {
+        BOOST_CHECK_CLOSE(vf.values[s], svf.values[s], 0.000001);
+        BOOST_CHECK_EQUAL(vf.actions[s], svf.actions[s]);
+        for ( size_t a = 0; a < model.getA(); ++a )
+            BOOST_CHECK_CLOSE(q(s, a), sq(s, a), 0.000001);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( writerErrors ) {
+    using namespace AIToolbox::MDP;
+
+    TempDirectory dir("aitoolbox-shards-errors");
+
+    BOOST_CHECK_THROW(ShardWriter(dir.path, 3, 2, 0.9, 0), std::invalid_argument);
+    BOOST_CHECK_THROW(ShardWriter(dir.path, 3, 2, 0.0, 1), std::invalid_argument);
+
+    ShardWriter writer(dir.path, 2, 1, 0.9, 1);
+    BOOST_CHECK_THROW(writer.addTransition(2, 1.0), std::invalid_argument);
+
+    // Invalid rows are discarded, so they can be rewritten.
+    writer.addTransition(0, 0.5);
+    BOOST_CHECK_THROW(writer.finishRow(0.0), std::invalid_argument);
+    writer.addTransition(0, 0.5);
+    writer.addTransition(1, 0.5);
+    writer.finishRow(1.0);
+    BOOST_CHECK(!writer.isComplete());
+
+    writer.addTransition(1, 1.0);
+    writer.finishRow(2.0);
+    BOOST_CHECK(writer.isComplete());
+    BOOST_CHECK_THROW(writer.addTransition(1, 1.0), std::invalid_argument);
+
+    const ShardedModel sharded(dir.path);
+    BOOST_CHECK_EQUAL(sharded.getShardsNumber(), 2);
+    BOOST_CHECK_EQUAL(sharded.getShard(0).rowPtr[1], 2);
+    BOOST_CHECK_EQUAL(sharded.getShard(1).rewards[0], 2.0);
+}
+
+BOOST_AUTO_TEST_CASE( readerErrors ) {
+    using namespace AIToolbox::MDP;
+
+    TempDirectory dir("aitoolbox-shards-corrupt");
+    BOOST_CHECK_THROW(ShardedModel{dir.path}, std::runtime_error);
+
+    GridWorld grid(4, 4);
+    writeShards(makeCornerProblem(grid), dir.path, 6);
+
+    // A missing shard is detected.
+    std::filesystem::rename(dir.path + "/shard-2.bin", dir.path + "/moved.bin");
+    BOOST_CHECK_THROW(ShardedModel{dir.path}, std::runtime_error);
+    std::filesystem::rename(dir.path + "/moved.bin", dir.path + "/shard-2.bin");
+    BOOST_CHECK_NO_THROW(ShardedModel{dir.path});
+
+    // So is a truncated one.
+    const auto size = std::filesystem::file_size(dir.path + "/shard-1.bin");
+    std::filesystem::resize_file(dir.path + "/shard-1.bin", size - 4);
+    BOOST_CHECK_THROW(ShardedModel{dir.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( corruptIndices ) {
+    using namespace AIToolbox::MDP;
+
+    TempDirectory dir("aitoolbox-shards-indices");
+    GridWorld grid(4, 4);
+    const auto model = makeCornerProblem(grid);
+    const auto S = model.getS(), A = model.getA();
+
+    const auto shardFile = dir.path + "/shard-0.bin";
+    const auto patch = [&](const std::uintmax_t offset, const auto value) {
+        std::fstream f(shardFile, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(offset);
+        f.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    // The next states are the last array of each shard, and the row
+    // offsets come right after the rewards.
+    writeShards(model, dir.path, 2);
+    const auto size = std::filesystem::file_size(shardFile);
+    std::uintmax_t rowPtrOffset;
+    {
+        const ShardedModel sharded(dir.path);
+        const auto & shard = sharded.getShard(0);
+        const size_t rows = shard.states * A, nonZeros = shard.rowPtr[rows];
+        rowPtrOffset = size - nonZeros * (sizeof(double) + sizeof(std::uint32_t)) - (rows + 1) * sizeof(std::uint64_t);
+    }
+
+    patch(size - sizeof(std::uint32_t), static_cast<std::uint32_t>(S));
+    BOOST_CHECK_THROW(ShardedModel{dir.path}, std::runtime_error);
+
+    writeShards(model, dir.path, 2);
+    // Row 1 now ends before it starts.
+    patch(rowPtrOffset + 2 * sizeof(std::uint64_t), std::uint64_t(0));
+    BOOST_CHECK_THROW(ShardedModel{dir.path}, std::runtime_error);
+
+    writeShards(model, dir.path, 2);
+    BOOST_CHECK_NO_THROW(ShardedModel{dir.path});
+}
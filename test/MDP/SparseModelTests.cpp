@@ -121,3 +121,99 @@ BOOST_AUTO_TEST_CASE( setTransitionFunction ) {
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE( triplets ) {
+    using namespace AIToolbox;
+    const size_t S = 5, A = 2;
+
+    std::vector<SparseTriplets> t(A);
+    SparseTriplets r;
+    for ( size_t s = 0; s < S; ++s ) {
+        t[0].emplace_back(s, (s + 1) % S, 0.7);
+        t[0].emplace_back(s, s, 0.3);
+        // Duplicates are summed.
+        t[1].emplace_back(s, 0, 0.5);
+        t[1].emplace_back(s, 0, 0.5);
+        r.emplace_back(s, 1, 2.0);
+    }
+
+    MDP::SparseModel m(S, A, t, r, 0.9);
+
+    BOOST_CHECK_EQUAL(m.getDiscount(), 0.9);
+    for ( size_t s = 0; s < S; ++s ) {
+        BOOST_CHECK_EQUAL(m.getTransitionProbability(s, 0, (s + 1) % S), 0.7);
+        BOOST_CHECK_EQUAL(m.getTransitionProbability(s, 0, s), 0.3);
+        BOOST_CHECK_EQUAL(m.getTransitionProbability(s, 1, 0), 1.0);
+        BOOST_CHECK_EQUAL(m.getExpectedReward(s, 0, 0), 0.0);
+        BOOST_CHECK_EQUAL(m.getExpectedReward(s, 1, 0), 2.0);
+    }
+
+    // Sparse to sparse copies go through the fast path.
+    MDP::SparseModelT<float> copy(m);
+    for ( size_t s = 0; s < S; ++s ) {
+        for ( size_t a = 0; a < A; ++a ) {
+            for ( size_t s1 = 0; s1 < S; ++s1 ) {
+                BOOST_CHECK_CLOSE(m.getTransitionProbability(s, a, s1), copy.getTransitionProbability(s, a, s1), 0.0001);
+                BOOST_CHECK_EQUAL(m.getExpectedReward(s, a, s1), copy.getExpectedReward(s, a, s1));
+            }
+        }
+    }
+
+    // Out of range triplets are rejected.
+    auto bad = t;
+    bad[0].emplace_back(0, S, 0.0);
+    BOOST_CHECK_THROW(m.setTransitionFunction(bad), std::invalid_argument);
+    SparseTriplets badR = r;
+    badR.emplace_back(S, 0, 1.0);
+    BOOST_CHECK_THROW(m.setRewardFunction(badR), std::invalid_argument);
+
+    // Matrices of the wrong size are rejected.
+    MDP::SparseModel::TransitionTable wrongSize(A, SparseMatrix2D(S, S + 1));
+    for ( auto & w : wrongSize )
+        for ( size_t s = 0; s < S; ++s )
+            w.insert(s, s) = 1.0;
+    BOOST_CHECK_THROW(m.setTransitionFunction(std::move(wrongSize)), std::invalid_argument);
+
+    // Invalid rows are rejected.
+    t[1].pop_back();
+    BOOST_CHECK_THROW(m.setTransitionFunction(t), std::invalid_argument);
+    t.pop_back();
+    BOOST_CHECK_THROW(m.setTransitionFunction(t), std::invalid_argument);
+
+    // The model is left untouched.
+    for ( size_t s = 0; s < S; ++s )
+        BOOST_CHECK_EQUAL(m.getTransitionProbability(s, 1, 0), 1.0);
+}
+
+BOOST_AUTO_TEST_CASE( sampleBatch ) {
+    using namespace AIToolbox::MDP;
+
+    BOOST_CHECK(is_batch_generative_model_v<SparseModel>);
+
+    GridWorld grid(4, 4);
+    SparseModel model = makeCornerProblem(grid);
+
+    constexpr size_t N = 100000;
+    std::vector<size_t> s(N), a(N), s1(N);
+    std::vector<double> r(N);
+    for ( size_t i = 0; i < N; ++i ) {
+        s[i] = i % 2 ? 5 : 10;
+        a[i] = (i / 2) % model.getA();
+    }
+    model.sampleSRBatch(N, s.data(), a.data(), s1.data(), r.data());
+
+    // Check the empirical frequencies against the transition function.
+    std::vector<double> counts(model.getS() * model.getA() * 2, 0.0);
+    for ( size_t i = 0; i < N; ++i ) {
+        BOOST_CHECK_EQUAL(r[i], model.getExpectedReward(s[i], a[i], s1[i]));
+        counts[(i % 2) * model.getS() * model.getA() + a[i] * model.getS() + s1[i]] += 1.0;
+    }
+    const double perPair = N / 2.0 / model.getA();
+    for ( size_t i = 0; i < 2; ++i ) {
+        const size_t ss = i ? 5 : 10;
+        for ( size_t aa = 0; aa < model.getA(); ++aa )
+            for ( size_t ss1 = 0; ss1 < model.getS(); ++ss1 )
+                BOOST_CHECK_SMALL(counts[i * model.getS() * model.getA() + aa * model.getS() + ss1] / perPair
+                                  - model.getTransitionProbability(ss, aa, ss1), 0.02);
+    }
+}
@@ -0,0 +1,168 @@
+#define BOOST_TEST_MODULE MDP_TopologicalValueIteration
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/MDP/Algorithms/TopologicalValueIteration.hpp>
+#include <AIToolbox/MDP/Algorithms/ValueIteration.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+
+#include "Utils/CornerProblem.hpp"
+#include "Utils/OldMDPModel.hpp"
+
+BOOST_AUTO_TEST_CASE( escapeToCorners ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+
+    Model model = makeCornerProblem(grid);
+    SparseModel sparseModel(model);
+    OldMDPModel oldModel(model);
+
+    ValueIteration vi(1000000, 0.00001);
+    TopologicalValueIteration solver(1000000, 0.00001);
+
+    const auto [viBound, viVFun, viQFun] = vi(model);
+    (void)viBound; (void)viQFun;
+
+    const auto check = [&](const auto & m) {
+        const auto [bound, vfun, qfun] = solver(m);
+        BOOST_CHECK( bound <= solver.getTolerance() );
+
+        for ( size_t s = 0; s < model.getS(); ++s ) {
+            BOOST_CHECK_SMALL( vfun.values[s] - viVFun.values[s], 0.001 );
+            BOOST_CHECK_SMALL( vfun.values[s] - qfun.row(s).maxCoeff(), 0.000001 );
+        }
+    };
+    check(model);
+    check(sparseModel);
+    check(oldModel);
+}
+
+BOOST_AUTO_TEST_CASE( chainComponents ) {
+    using namespace AIToolbox::MDP;
+
+    // A chain where each state can only move forward, possibly staying
+    // in place; each state is its own component.
+    constexpr size_t S = 50, A = 2;
+    AIToolbox::Table3D transitions(boost::extents[S][A][S]);
+    AIToolbox::Table3D rewards(boost::extents[S][A][S]);
+
+    for ( size_t s = 0; s < S - 1; ++s ) {
+        transitions[s][0][s] = 0.1;
+        transitions[s][0][s+1] = 0.9;
+        rewards[s][0][s+1] = 1.0;
+
+        transitions[s][1][std::min(S - 1, s + 2)] = 1.0;
+        rewards[s][1][std::min(S - 1, s + 2)] = 1.5;
+    }
+    transitions[S-1][0][S-1] = 1.0;
+    transitions[S-1][1][S-1] = 1.0;
+
+    SparseModel model(S, A, transitions, rewards, 0.95);
+
+    TopologicalValueIteration solver(1000000, 0.0000001);
+    const auto [bound, vfun, qfun] = solver(model);
+    BOOST_CHECK_EQUAL( solver.getComponentsNumber(), S );
+    BOOST_CHECK( bound <= solver.getTolerance() );
+
+    ValueIteration vi(1000000, 0.0000001);
+    const auto [viBound, viVFun, viQFun] = vi(model);
+    (void)viBound;
+
+    for ( size_t s = 0; s < S; ++s ) {
+        BOOST_CHECK_SMALL( vfun.values[s] - viVFun.values[s], 0.00001 );
+        BOOST_CHECK_EQUAL( vfun.actions[s], viVFun.actions[s] );
+        for ( size_t a = 0; a < A; ++a )
+            BOOST_CHECK_SMALL( qfun(s, a) - viQFun(s, a), 0.00001 );
+    }
+}
+
+BOOST_AUTO_TEST_CASE( parallelLevels ) {
+    using namespace AIToolbox::MDP;
+
+    // Independent chains, whose states at the same depth are in the same
+    // level and can be solved at the same time.
+    constexpr size_t chains = 8, length = 5, S = chains * length, A = 2;
+    AIToolbox::Table3D transitions(boost::extents[S][A][S]);
+    AIToolbox::Table3D rewards(boost::extents[S][A][S]);
+
+    for ( size_t c = 0; c < chains; ++c ) {
+        for ( size_t i = 0; i < length; ++i ) {
+            const size_t s = c * length + i;
+            if ( i + 1 == length ) {
+                transitions[s][0][s] = transitions[s][1][s] = 1.0;
+                rewards[s][0][s] = static_cast<double>(c);
+                continue;
+            }
+            transitions[s][0][s] = 0.3;
+            transitions[s][0][s+1] = 0.7;
+            rewards[s][0][s+1] = 1.0;
+
+            transitions[s][1][s+1] = 1.0;
+            rewards[s][1][s+1] = 0.5;
+        }
+    }
+
+    SparseModel model(S, A, transitions, rewards, 0.9);
+
+    TopologicalValueIteration solver(1000000, 0.0000001);
+    const auto [bound, vfun, qfun] = solver(model);
+    BOOST_CHECK_EQUAL( solver.getComponentsNumber(), S );
+    BOOST_CHECK_EQUAL( solver.getLevelsNumber(), length );
+
+    AIToolbox::Executor::setDefault(4);
+    const auto [pbound, pvfun, pqfun] = solver(model);
+    AIToolbox::Executor::setDefault(1);
+
+    BOOST_CHECK_EQUAL( bound, pbound );
+    BOOST_CHECK( vfun.values == pvfun.values );
+    BOOST_CHECK( vfun.actions == pvfun.actions );
+    BOOST_CHECK( qfun == pqfun );
+
+    ValueIteration vi(1000000, 0.0000001);
+    const auto [viBound, viVFun, viQFun] = vi(model);
+    (void)viBound; (void)viQFun;
+
+    for ( size_t s = 0; s < S; ++s )
+        BOOST_CHECK_SMALL( vfun.values[s] - viVFun.values[s], 0.00001 );
+}
+
+BOOST_AUTO_TEST_CASE( zeroHorizon ) {
+    using namespace AIToolbox::MDP;
+
+    // A chain without self-loops, so that all but the last state are
+    // acyclic single-state components.
+    constexpr size_t S = 10, A = 2;
+    AIToolbox::Table3D transitions(boost::extents[S][A][S]);
+    AIToolbox::Table3D rewards(boost::extents[S][A][S]);
+
+    for ( size_t s = 0; s < S - 1; ++s ) {
+        transitions[s][0][s+1] = transitions[s][1][s+1] = 1.0;
+        rewards[s][0][s+1] = 1.0;
+        rewards[s][1][s+1] = 2.0;
+    }
+    transitions[S-1][0][S-1] = transitions[S-1][1][S-1] = 1.0;
+
+    SparseModel model(S, A, transitions, rewards, 0.9);
+
+    TopologicalValueIteration solver(0);
+    const auto [bound, vfun, qfun] = solver(model);
+    (void)bound;
+
+    ValueIteration vi(0);
+    const auto [viBound, viVFun, viQFun] = vi(model);
+    (void)viBound;
+
+    BOOST_CHECK( vfun.values == viVFun.values );
+    BOOST_CHECK( qfun == viQFun );
+}
+
+BOOST_AUTO_TEST_CASE( invalidTolerance ) {
+    using namespace AIToolbox::MDP;
+
+    BOOST_CHECK_THROW( TopologicalValueIteration(10, -0.1), std::invalid_argument );
+
+    TopologicalValueIteration solver(10);
+    BOOST_CHECK_THROW( solver.setTolerance(-1.0), std::invalid_argument );
+}
@@ -293,3 +293,68 @@ BOOST_AUTO_TEST_CASE( escapeToCornersNonEigen ) {
         BOOST_CHECK_EQUAL( qfun.row(s).maxCoeff(), values[s] );
     }
 }
+
+BOOST_AUTO_TEST_CASE( singlePrecisionModels ) {
+    using namespace AIToolbox::MDP;
+
+    GridWorld grid(4, 4);
+
+    Model model = makeCornerProblem(grid);
+    ModelT<float> fmodel(model);
+    SparseModelT<float> fsmodel(model);
+
+    ValueIteration solver(1000000, 0.001);
+
+    auto [bound, vfun, qfun] = solver(model);
+    auto [fbound, fvfun, fqfun] = solver(fmodel);
+    auto [fsbound, fsvfun, fsqfun] = solver(fsmodel);
+
+    BOOST_CHECK( fbound <= solver.getTolerance() );
+    BOOST_CHECK( fsbound <= solver.getTolerance() );
+
+    for ( size_t s = 0; s < model.getS(); ++s ) {
+        BOOST_CHECK_CLOSE( vfun.values[s], fvfun.values[s], 0.001 );
+        BOOST_CHECK_CLOSE( vfun.values[s], fsvfun.values[s], 0.001 );
+
+        for ( size_t a = 0; a < model.getA(); ++a ) {
+            BOOST_CHECK_CLOSE( qfun(s, a), fqfun(s, a), 0.001 );
+            BOOST_CHECK_CLOSE( qfun(s, a), fsqfun(s, a), 0.001 );
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( parallelBackups ) {
+    using namespace AIToolbox::MDP;
+
+    // A model big enough to be split among multiple blocks.
+    constexpr size_t S = 700, A = 3;
+    AIToolbox::Table3D transitions(boost::extents[S][A][S]);
+    AIToolbox::Table3D rewards(boost::extents[S][A][S]);
+    for ( size_t s = 0; s < S; ++s ) {
+        for ( size_t a = 0; a < A; ++a ) {
+            const size_t s1 = (s * (a + 2) + 1) % S;
+            transitions[s][a][s1] += 0.7;
+            transitions[s][a][s] += 0.3;
+            rewards[s][a][s1] = static_cast<double>(s1 % 7);
+        }
+    }
+    const Model model(S, A, transitions, rewards, 0.9);
+    const SparseModel sparseModel(model);
+
+    ValueIteration solver(1000000, 0.001);
+
+    const auto [bound, vfun, qfun] = solver(model);
+    const auto [sbound, svfun, sqfun] = solver(sparseModel);
+
+    AIToolbox::Executor::setDefault(4);
+    const auto [pbound, pvfun, pqfun] = solver(model);
+    const auto [psbound, psvfun, psqfun] = solver(sparseModel);
+    AIToolbox::Executor::setDefault(1);
+
+    BOOST_CHECK(pqfun.isApprox(qfun, 1e-9));
+    BOOST_CHECK(psqfun.isApprox(sqfun, 1e-9));
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(pvfun.actions), std::end(pvfun.actions),
+                                  std::begin(vfun.actions), std::end(vfun.actions));
+    (void)bound; (void)sbound; (void)pbound; (void)psbound;
+    (void)svfun; (void)psvfun;
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE POMDP_Evaluation
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/POMDP/Evaluation.hpp>
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
+#include <AIToolbox/POMDP/Algorithms/POMCP.hpp>
+#include <AIToolbox/POMDP/Policies/Policy.hpp>
+#include <AIToolbox/POMDP/Policies/PolicyGraph.hpp>
+#include <AIToolbox/Impl/Seeder.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Utils/TigerProblem.hpp"
+
+BOOST_AUTO_TEST_CASE( policy ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned horizon = 5;
+    constexpr size_t episodes = 5000;
+
+    IncrementalPruning solver(horizon, 0.0);
+    const auto vf = std::get<1>(solver(model));
+    Policy policy(model.getS(), model.getA(), model.getO(), vf);
+
+    Belief b(model.getS());
+    b.fill(1.0 / model.getS());
+
+    double truth = -std::numeric_limits<double>::infinity();
+    for ( const auto & entry : vf[horizon] )
+        truth = std::max(truth, entry.values.dot(b));
+
+    Executor e(4);
+    const auto results = evaluatePolicy(model, [&](unsigned) { return policy; }, b, episodes, horizon, e);
+
+    BOOST_CHECK_EQUAL(results.episodes, episodes);
+    BOOST_CHECK(results.confidence > 0.0);
+    // The mean is off by more than 5 standard errors with probability
+    // below 1e-6, whatever the seed.
+    const double stderror = results.stddev / std::sqrt(static_cast<double>(episodes));
+    BOOST_CHECK(std::fabs(results.mean - truth) < 5.0 * stderror);
+    BOOST_CHECK_EQUAL(results.meanSteps, horizon);
+}
+
+BOOST_AUTO_TEST_CASE( deterministic ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned horizon = 4;
+    IncrementalPruning solver(horizon, 0.0);
+    const auto vf = std::get<1>(solver(model));
+
+    Belief b(model.getS());
+    b.fill(1.0 / model.getS());
+
+    // PolicyGraph acts on the tracked belief of each episode.
+    const PolicyGraph graph(Policy(model.getS(), model.getA(), model.getO(), vf));
+
+    const auto run = [&]() {
+        Impl::Seeder::setRootSeed(7);
+        Executor e(3, true);
+        return evaluatePolicy(model, [&](unsigned) { return graph; }, b, 300, horizon, e).returns;
+    };
+
+    const auto r1 = run();
+    const auto r2 = run();
+    BOOST_CHECK(r1 == r2);
+}
+
+BOOST_AUTO_TEST_CASE( onlinePlanner ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    using TigerModel = decltype(makeTigerProblem());
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned workers = 2;
+    std::vector<TigerModel> copies(workers, model);
+
+    Belief b(model.getS());
+    b.fill(1.0 / model.getS());
+
+    Executor e(workers);
+    const auto results = evaluatePolicy(model, [&](unsigned w) {
+        return POMCP<TigerModel>(copies[w], 1000, 2000, 100.0);
+    }, b, 20, 3, e);
+
+    BOOST_CHECK_EQUAL(results.episodes, 20);
+    BOOST_CHECK_EQUAL(results.meanSteps, 3.0);
+    BOOST_CHECK(results.secondsPerStep > 0.0);
+}
@@ -0,0 +1,103 @@
+#define BOOST_TEST_MODULE POMDP_FixedModel
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/POMDP/FixedModel.hpp>
+#include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
+#include <AIToolbox/POMDP/Policies/Policy.hpp>
+
+#include "Utils/TigerProblem.hpp"
+
+using TigerModel = AIToolbox::POMDP::FixedModel<2, 3, 2>;
+
+BOOST_AUTO_TEST_CASE( eigen_model ) {
+    BOOST_CHECK(AIToolbox::POMDP::is_model_eigen_v<TigerModel>);
+}
+
+BOOST_AUTO_TEST_CASE( construction ) {
+    TigerModel m;
+
+    BOOST_CHECK_EQUAL(m.getS(), 2);
+    BOOST_CHECK_EQUAL(m.getA(), 3);
+    BOOST_CHECK_EQUAL(m.getO(), 2);
+
+    BOOST_CHECK_EQUAL(m.getTransitionProbability(0,0,0), 1.0);
+    BOOST_CHECK_EQUAL(m.getTransitionProbability(0,0,1), 0.0);
+
+    BOOST_CHECK_EQUAL(m.getObservationProbability(0,0,0), 1.0);
+    BOOST_CHECK_EQUAL(m.getObservationProbability(0,1,1), 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( copy_construction ) {
+    using namespace AIToolbox;
+
+    const auto model = makeTigerProblem();
+    const TigerModel copy(model);
+
+    for ( size_t s = 0; s < model.getS(); ++s )
+        for ( size_t a = 0; a < model.getA(); ++a ) {
+            for ( size_t s1 = 0; s1 < model.getS(); ++s1 ) {
+                BOOST_CHECK_EQUAL(model.getTransitionProbability(s, a, s1), copy.getTransitionProbability(s, a, s1));
+                BOOST_CHECK_EQUAL(model.getExpectedReward(s, a, s1), copy.getExpectedReward(s, a, s1));
+            }
+            for ( size_t o = 0; o < model.getO(); ++o )
+                BOOST_CHECK_EQUAL(model.getObservationProbability(s, a, o), copy.getObservationProbability(s, a, o));
+        }
+
+    BOOST_CHECK_THROW((POMDP::FixedModel<2, 3, 3>(model)), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( belief_update ) {
+    using namespace AIToolbox;
+
+    const auto model = makeTigerProblem();
+    const TigerModel fixed(model);
+
+    POMDP::Belief b(2); b << 0.3, 0.7;
+    POMDP::FixedBelief<2> fb(0.3, 0.7);
+
+    for ( size_t a = 0; a < model.getA(); ++a ) {
+        for ( size_t o = 0; o < model.getO(); ++o ) {
+            const POMDP::Belief truth = POMDP::updateBelief(model, b, a, o);
+            const POMDP::FixedBelief<2> result = POMDP::updateBelief(fixed, fb, a, o);
+
+            BOOST_CHECK(truth.isApprox(result));
+        }
+    }
+
+    // Fixed beliefs also work with dynamically sized models.
+    const POMDP::FixedBelief<2> result = POMDP::updateBeliefUnnormalized(model, fb, A_LISTEN, TIG_LEFT);
+    BOOST_CHECK(POMDP::updateBeliefUnnormalized(model, b, A_LISTEN, TIG_LEFT).isApprox(result));
+}
+
+BOOST_AUTO_TEST_CASE( solving ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+    const TigerModel fixed(model);
+
+    constexpr unsigned horizon = 10;
+    POMDP::IncrementalPruning solver(horizon, 0.0);
+
+    const auto vf  = std::get<1>(solver(model));
+    const auto fvf = std::get<1>(solver(fixed));
+
+    BOOST_CHECK_EQUAL(vf[horizon].size(), fvf[horizon].size());
+
+    POMDP::Policy p(model.getS(), model.getA(), model.getO(), fvf);
+
+    for ( double x = 0.0; x <= 1.0; x += 0.05 ) {
+        POMDP::Belief b(2); b << x, 1.0 - x;
+        POMDP::FixedBelief<2> fb(x, 1.0 - x);
+
+        BOOST_CHECK_EQUAL(p.sampleAction(b), p.sampleAction(fb));
+
+        const auto [a, id] = p.sampleAction(b, horizon);
+        const auto [fa, fid] = p.sampleAction(fb, horizon);
+        BOOST_CHECK_EQUAL(a, fa);
+        BOOST_CHECK_EQUAL(id, fid);
+    }
+}
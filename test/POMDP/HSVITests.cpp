@@ -0,0 +1,100 @@
+#define BOOST_TEST_MODULE POMDP_HSVI
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/HSVI.hpp>
+#include <AIToolbox/POMDP/Types.hpp>
+#include <AIToolbox/POMDP/SparseModel.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+
+#include "Utils/TigerProblem.hpp"
+
+BOOST_AUTO_TEST_CASE( discountedTiger ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    POMDP::Belief b(model.getS());
+    b.fill(0.5);
+
+    constexpr double epsilon = 0.1;
+    POMDP::HSVI solver(epsilon, 0.0001);
+    const auto [lb, ub, vlist] = solver(model, b);
+
+    BOOST_CHECK(lb <= ub);
+    BOOST_CHECK(ub - lb <= epsilon);
+    BOOST_CHECK(solver.getTrials() > 0);
+    BOOST_CHECK_CLOSE(solver.getUpperBound(b), ub, 0.0001);
+
+    // The lower bound must be achieved by the returned alpha vectors.
+    double best = -std::numeric_limits<double>::infinity();
+    for ( const auto & entry : vlist )
+        best = std::max(best, entry.values.dot(b));
+    BOOST_CHECK_CLOSE(best, lb, 0.0001);
+
+    // The optimal value at the uniform belief is about 19.37.
+    BOOST_CHECK(lb < 19.4);
+    BOOST_CHECK(ub > 19.35);
+}
+
+BOOST_AUTO_TEST_CASE( discountedTigerSparse ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+    POMDP::SparseModel<MDP::SparseModel> sparseModel(model);
+
+    POMDP::Belief b(model.getS());
+    b << 0.8, 0.2;
+
+    POMDP::HSVI solver(0.1, 0.0001);
+    const auto [lb, ub, vlist] = solver(model, b);
+    const auto [slb, sub, svlist] = solver(sparseModel, b);
+
+    BOOST_CHECK(sub - slb <= 0.1);
+    // Both are within epsilon of the optimal value.
+    BOOST_CHECK(std::fabs(lb - slb) <= 0.1);
+    BOOST_CHECK(std::fabs(ub - sub) <= 0.1);
+    (void)vlist; (void)svlist;
+}
+
+BOOST_AUTO_TEST_CASE( timeBudget ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.999);
+
+    POMDP::Belief b(model.getS());
+    b.fill(0.5);
+
+    // This precision cannot be reached quickly, so the budget stops the
+    // solver early.
+    POMDP::HSVI solver(0.000001, 0.0);
+    solver.setTimeBudget(std::chrono::milliseconds(200));
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto [lb, ub, vlist] = solver(model, b);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    BOOST_CHECK(lb <= ub);
+    BOOST_CHECK(elapsed.count() < 5.0);
+    BOOST_CHECK(vlist.size() > 0);
+}
+
+BOOST_AUTO_TEST_CASE( invalidArguments ) {
+    using namespace AIToolbox;
+
+    BOOST_CHECK_THROW(POMDP::HSVI(0.0), std::invalid_argument);
+    BOOST_CHECK_THROW(POMDP::HSVI(0.1, -1.0), std::invalid_argument);
+
+    auto model = makeTigerProblem();
+    model.setDiscount(1.0);
+
+    POMDP::Belief b(model.getS());
+    b.fill(0.5);
+
+    POMDP::HSVI solver(0.1);
+    BOOST_CHECK_THROW(solver(model, b), std::invalid_argument);
+}
@@ -302,3 +302,102 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizonSparse ) {
         BOOST_CHECK_EQUAL(values, truthValues);
     }
 }
+
+BOOST_AUTO_TEST_CASE( approximatePruning ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned horizon = 15;
+    constexpr double epsilon = 0.1;
+
+    POMDP::IncrementalPruning exactSolver(horizon, 0.0);
+    POMDP::IncrementalPruning approxSolver(horizon, 0.0, epsilon);
+    POMDP::IncrementalPruning mergeSolver(horizon, 0.0, epsilon, true);
+
+    BOOST_CHECK(!approxSolver.getMergeDuplicates());
+    BOOST_CHECK(mergeSolver.getMergeDuplicates());
+
+    const auto exact  = std::get<1>(exactSolver(model))[horizon];
+    const auto approx = std::get<1>(approxSolver(model))[horizon];
+    const auto merged = std::get<1>(mergeSolver(model))[horizon];
+
+    BOOST_CHECK(approx.size() < exact.size());
+    BOOST_CHECK(merged.size() < exact.size());
+
+    // Each timestep can lose at most epsilon, discounted.
+    double maxError = 0.0;
+    for ( unsigned t = 0; t < horizon; ++t )
+        maxError += epsilon * std::pow(model.getDiscount(), t);
+
+    const auto valueAt = [](const POMDP::Belief & b, const POMDP::VList & vl) {
+        double value;
+        const auto begin = boost::make_transform_iterator(std::begin(vl), POMDP::unwrap);
+        const auto end   = boost::make_transform_iterator(std::end  (vl), POMDP::unwrap);
+        findBestAtPoint(b, begin, end, &value);
+        return value;
+    };
+
+    for ( double x = 0.0; x <= 1.0; x += 0.01 ) {
+        POMDP::Belief b(2); b << x, 1.0 - x;
+
+        const double exactValue  = valueAt(b, exact);
+        const double approxValue = valueAt(b, approx);
+        const double mergedValue = valueAt(b, merged);
+
+        BOOST_CHECK(approxValue <= exactValue + 1e-9);
+        BOOST_CHECK(approxValue >= exactValue - maxError);
+
+        // Merging splits epsilon, so the bound is the same.
+        BOOST_CHECK(mergedValue <= exactValue + 1e-9);
+        BOOST_CHECK(mergedValue >= exactValue - maxError);
+    }
+
+    BOOST_CHECK_THROW(POMDP::IncrementalPruning(horizon, 0.0, -1.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( warmStart ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.75);
+
+    POMDP::IncrementalPruning solver(1000000, 0.01, 0.001);
+    const auto [oldVar, oldVf] = solver(model);
+    BOOST_CHECK(oldVar <= solver.getTolerance());
+    const auto witnesses = solver.getWitnessBeliefs();
+
+    // Listening becomes slightly more expensive, so the old solution is
+    // close to the new one.
+    auto rewards = model.getRewardFunction();
+    rewards.col(A_LISTEN).array() -= 0.05;
+    model.setRewardFunction(rewards);
+
+    const auto [coldVar, cold] = solver(model);
+    const auto [warmVar, warm] = solver(model, POMDP::ValueFunction{oldVf.back()}, witnesses);
+    BOOST_CHECK(coldVar <= solver.getTolerance());
+    BOOST_CHECK(warmVar <= solver.getTolerance());
+
+    // Both runs start from a single VList, so their sizes count the
+    // timesteps needed to converge.
+    BOOST_TEST_MESSAGE("Cold timesteps: " << cold.size() - 1 << ", warm timesteps: " << warm.size() - 1);
+    BOOST_CHECK(3 * (warm.size() - 1) < 2 * (cold.size() - 1));
+
+    // Both solutions are within tolerance of the optimal one.
+    const double discount = model.getDiscount();
+    const double bound = 2.0 * solver.getTolerance() * discount / (1.0 - discount);
+    for ( double x = 0.0; x <= 1.0; x += 0.05 ) {
+        POMDP::Belief b(2); b << x, 1.0 - x;
+        double coldValue, warmValue;
+        findBestAtPoint(b, boost::make_transform_iterator(std::begin(cold.back()), POMDP::unwrap),
+                           boost::make_transform_iterator(std::end  (cold.back()), POMDP::unwrap), &coldValue);
+        findBestAtPoint(b, boost::make_transform_iterator(std::begin(warm.back()), POMDP::unwrap),
+                           boost::make_transform_iterator(std::end  (warm.back()), POMDP::unwrap), &warmValue);
+        BOOST_CHECK_SMALL(coldValue - warmValue, bound);
+    }
+
+    // Warm-starts of the wrong size are rejected.
+    BOOST_CHECK_THROW(solver(model, POMDP::makeValueFunction(3)), std::invalid_argument);
+    BOOST_CHECK_THROW(solver(model, {}, {POMDP::Belief(3)}), std::invalid_argument);
+}
@@ -154,3 +154,41 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizon ) {
         BOOST_CHECK_EQUAL(values, truthValues);
     }
 }
+
+BOOST_AUTO_TEST_CASE( warmStart ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.75);
+
+    POMDP::LinearSupport solver(1000000, 0.01, 0.001);
+    const auto [oldVar, oldVf] = solver(model);
+    BOOST_CHECK(oldVar <= solver.getTolerance());
+    const auto witnesses = solver.getWitnessBeliefs();
+
+    // A slightly longer-sighted agent.
+    model.setDiscount(0.76);
+
+    const auto [coldVar, cold] = solver(model);
+    const auto [warmVar, warm] = solver(model, POMDP::ValueFunction{oldVf.back()}, witnesses);
+    BOOST_CHECK(coldVar <= solver.getTolerance());
+    BOOST_CHECK(warmVar <= solver.getTolerance());
+
+    BOOST_TEST_MESSAGE("Cold timesteps: " << cold.size() - 1 << ", warm timesteps: " << warm.size() - 1);
+    BOOST_CHECK(3 * (warm.size() - 1) < 2 * (cold.size() - 1));
+
+    // Both solutions are within tolerance of the optimal one.
+    const double discount = model.getDiscount();
+    const double bound = 2.0 * solver.getTolerance() * discount / (1.0 - discount);
+    for ( double x = 0.0; x <= 1.0; x += 0.05 ) {
+        POMDP::Belief b(2); b << x, 1.0 - x;
+        double coldValue, warmValue;
+        findBestAtPoint(b, boost::make_transform_iterator(std::begin(cold.back()), POMDP::unwrap),
+                           boost::make_transform_iterator(std::end  (cold.back()), POMDP::unwrap), &coldValue);
+        findBestAtPoint(b, boost::make_transform_iterator(std::begin(warm.back()), POMDP::unwrap),
+                           boost::make_transform_iterator(std::end  (warm.back()), POMDP::unwrap), &warmValue);
+        BOOST_CHECK_SMALL(coldValue - warmValue, bound);
+    }
+
+    BOOST_CHECK_THROW(solver(model, POMDP::makeValueFunction(4)), std::invalid_argument);
+}
@@ -100,3 +100,88 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizon ) {
             BOOST_CHECK_EQUAL(vlist[i].action, it->action);
     }
 }
+
+BOOST_AUTO_TEST_CASE( anytime ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.5);
+
+    const auto valueAt = [](const POMDP::Belief & b, const POMDP::VList & vl) {
+        double best = -std::numeric_limits<double>::infinity();
+        for ( const auto & entry : vl )
+            best = std::max(best, b.dot(entry.values));
+        return best;
+    };
+
+    constexpr double tolerance = 0.001;
+    POMDP::PBVI solver(100, 1000, tolerance);
+
+    // Without a budget, the anytime mode fills the belief set and converges.
+    const auto [variation, vf] = solver.anytime(model, std::chrono::seconds(0));
+    BOOST_CHECK(variation <= tolerance);
+    BOOST_CHECK_EQUAL(solver.getAnytimeBeliefs().size(), 100u);
+
+    // The exact solution for a long enough horizon is within maxError of
+    // the infinite horizon one.
+    constexpr unsigned horizon = 15;
+    POMDP::IncrementalPruning ipsolver(horizon, 0.0);
+    const auto [tvariation, tvf] = ipsolver(model);
+    (void)tvariation;
+
+    const auto ir = MDP::computeImmediateRewards(model);
+    const double maxError = std::pow(model.getDiscount(), horizon) * ir.cwiseAbs().maxCoeff() / (1.0 - model.getDiscount());
+
+    // Starting from a lower bound, the anytime mode can never go above
+    // the optimal values, and with a full belief set it gets close to them.
+    for ( unsigned i = 0; i <= 20; ++i ) {
+        const double p = i / 20.0;
+        POMDP::Belief b(2); b << p, 1.0 - p;
+        const auto value = valueAt(b, vf.back());
+        const auto exact = valueAt(b, tvf.back());
+        BOOST_CHECK(value <= exact + maxError + 1e-6);
+        BOOST_CHECK(value >= exact - maxError - 0.01);
+    }
+
+    // The lower bound start guarantees that backups never decrease the
+    // values of the beliefs in the set.
+    BOOST_REQUIRE(vf.size() >= 2);
+    const auto & last = vf.back(), & prev = vf[vf.size()-2];
+    for ( const auto & b : solver.getAnytimeBeliefs() )
+        BOOST_CHECK(valueAt(b, last) >= valueAt(b, prev) - 1e-9);
+
+    // With an expired budget we still get a usable ValueFunction.
+    const auto [bvariation, bvf] = solver.anytime(model, std::chrono::nanoseconds(1));
+    (void)bvariation;
+    BOOST_CHECK(bvf.size() >= 1);
+    BOOST_CHECK(bvf.back().size() >= 1);
+}
+
+BOOST_AUTO_TEST_CASE( parallelActions ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    POMDP::BeliefGenerator bGen(model);
+    const auto beliefs = bGen(100);
+
+    POMDP::PBVI solver(100, 10, 0.0);
+    const auto [variation, vf] = solver(model, beliefs);
+
+    // Each action is backed up on its own, so using more workers does not
+    // change the result.
+    Executor::setDefault(4);
+    const auto [pvariation, pvf] = solver(model, beliefs);
+    Executor::setDefault(1);
+
+    BOOST_REQUIRE_EQUAL(vf.size(), pvf.size());
+    for ( size_t i = 0; i < vf.size(); ++i ) {
+        BOOST_REQUIRE_EQUAL(vf[i].size(), pvf[i].size());
+        for ( size_t j = 0; j < vf[i].size(); ++j ) {
+            BOOST_CHECK(vf[i][j].values == pvf[i][j].values);
+            BOOST_CHECK_EQUAL(vf[i][j].action, pvf[i][j].action);
+        }
+    }
+    (void)variation; (void)pvariation;
+}
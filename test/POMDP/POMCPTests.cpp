@@ -127,3 +127,119 @@ BOOST_AUTO_TEST_CASE( sampleOneTime ) {
     // We make a,o the new head
     solver.sampleAction( 0, o, horizon-1);
 }
+
+BOOST_AUTO_TEST_CASE( batchedRollouts ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.85);
+
+    Matrix2D beliefs(3, 2);
+    beliefs << 0.5,     0.5,
+               1.0,     0.0,
+               0.02,    0.98;
+
+    unsigned maxHorizon = 4;
+
+    POMDP::IncrementalPruning groundTruth(maxHorizon, 0.0);
+    auto solution = groundTruth(model);
+    auto & vf = std::get<1>(solution);
+    POMDP::Policy p(model.getS(), model.getA(), model.getO(), vf);
+
+    for ( unsigned horizon = 1; horizon <= maxHorizon; ++horizon ) {
+        POMDP::POMCP solver(model, 1000, 10000, horizon * 10000.0);
+        solver.setBatchSize(32);
+        BOOST_CHECK_EQUAL(solver.getBatchSize(), 32u);
+
+        for ( auto i = 0; i < beliefs.rows(); ++i ) {
+            auto a = solver.sampleAction(beliefs.row(i), horizon);
+            auto trueA = p.sampleAction(beliefs.row(i), horizon);
+
+            BOOST_CHECK_EQUAL( std::get<0>(trueA), a);
+
+            // Particles are still added by each simulation.
+            unsigned particleCount = 0;
+            for ( auto & an : solver.getGraph().children )
+                for ( auto & bn : an.children )
+                    particleCount += bn.second.belief.size();
+            BOOST_CHECK(particleCount >= 10000u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( memoryBounds ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.85);
+
+    POMDP::Belief belief(2); belief.fill(0.5);
+
+    constexpr size_t maxParticles = 50, maxNodes = 30;
+    constexpr unsigned count = 5000, horizon = 10;
+
+    POMDP::POMCP solver(model, 1000, count, 10000.0);
+    solver.setMaxParticles(maxParticles);
+    solver.setMaxNodes(maxNodes);
+    BOOST_CHECK_EQUAL(solver.getMaxParticles(), maxParticles);
+    BOOST_CHECK_EQUAL(solver.getMaxNodes(), maxNodes);
+
+    const auto a = solver.sampleAction(belief, horizon);
+
+    // The tree respects the budget, and the tracked count is exact.
+    const auto stats = solver.getTreeStatistics();
+    BOOST_CHECK_EQUAL(stats.beliefNodes, solver.getNodesNumber());
+    BOOST_CHECK(stats.beliefNodes <= maxNodes);
+    BOOST_CHECK(stats.bytes > 0);
+
+    // All particle beliefs below the root are capped, even though many
+    // more particles reached them.
+    size_t reached = 0;
+    for ( const auto & an : solver.getGraph().children ) {
+        for ( const auto & [o, bn] : an.children ) {
+            BOOST_CHECK(bn.belief.size() <= maxParticles);
+            BOOST_CHECK(bn.belief.size() <= bn.particles);
+            reached += bn.particles;
+        }
+    }
+    BOOST_CHECK_EQUAL(reached, count);
+
+    // Advancing the root frees the budget of the pruned branches.
+    const auto & obs = solver.getGraph().children[a].children;
+    BOOST_REQUIRE(obs.size() > 0);
+    solver.sampleAction(a, obs.begin()->first, horizon - 1);
+    BOOST_CHECK_EQUAL(solver.getTreeStatistics().beliefNodes, solver.getNodesNumber());
+    BOOST_CHECK(solver.getNodesNumber() <= maxNodes);
+
+    // Without bounds the same search builds a bigger tree.
+    POMDP::POMCP unbounded(model, 1000, count, 10000.0);
+    unbounded.sampleAction(belief, horizon);
+    const auto ustats = unbounded.getTreeStatistics();
+    BOOST_CHECK(ustats.beliefNodes > maxNodes);
+    BOOST_CHECK(ustats.particles > stats.particles);
+}
+
+BOOST_AUTO_TEST_CASE( sparseBelief ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.85);
+
+    constexpr unsigned horizon = 3;
+    POMDP::IncrementalPruning groundTruth(horizon, 0.0);
+    const auto vf = std::get<1>(groundTruth(model));
+    POMDP::Policy p(model.getS(), model.getA(), model.getO(), vf);
+
+    // With a certain belief, only the known state is ever sampled.
+    for ( size_t s = 0; s < model.getS(); ++s ) {
+        POMDP::SparseBelief b(model.getS());
+        b.insert(s) = 1.0;
+
+        POMDP::POMCP solver(model, 1000, 10000, horizon * 10000.0);
+        const auto a = solver.sampleAction(b, horizon);
+
+        BOOST_CHECK_EQUAL(std::get<0>(p.sampleAction(b, horizon)), a);
+        for ( const auto particle : solver.getGraph().belief )
+            BOOST_CHECK_EQUAL(particle, s);
+    }
+}
@@ -0,0 +1,142 @@
+#define BOOST_TEST_MODULE POMDP_PolicyGraph
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
+#include <AIToolbox/POMDP/Policies/Policy.hpp>
+#include <AIToolbox/POMDP/Policies/PolicyGraph.hpp>
+#include <AIToolbox/POMDP/IO.hpp>
+#include <AIToolbox/Utils/Probability.hpp>
+#include <AIToolbox/Impl/Seeder.hpp>
+
+#include <sstream>
+
+#include "Utils/TigerProblem.hpp"
+
+BOOST_AUTO_TEST_CASE( followsPolicy ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned horizon = 8;
+    POMDP::IncrementalPruning solver(horizon, 0.0);
+    const auto vf = std::get<1>(solver(model));
+
+    POMDP::Policy policy(model.getS(), model.getA(), model.getO(), vf);
+    // Disable convergence detection to check the exact horizons.
+    POMDP::PolicyGraph graph(policy, -1.0);
+
+    BOOST_CHECK(!graph.isStationary());
+
+    size_t entries = 0;
+    for ( const auto & vl : vf ) entries += vl.size();
+    BOOST_CHECK(graph.getNodesNumber() < entries);
+
+    // Following the graph must produce the same actions as following the
+    // observation links in the policy.
+    RandomEngine rand(Impl::Seeder::getSeed());
+    for ( unsigned run = 0; run < 100; ++run ) {
+        const POMDP::Belief b = makeRandomProbability(model.getS(), rand);
+
+        auto [a, id] = policy.sampleAction(b, horizon);
+        auto node = graph.getStartNode(b);
+        BOOST_CHECK_EQUAL(graph.sampleAction(b), a);
+
+        size_t s = sampleProbability(model.getS(), b, rand);
+        for ( unsigned h = horizon; h > 0; --h ) {
+            BOOST_CHECK_EQUAL(graph.getAction(node), a);
+
+            const auto [s1, o, r] = model.sampleSOR(s, a);
+            (void)r;
+            s = s1;
+            node = graph.getNextNode(node, o);
+            if ( h > 1 )
+                std::tie(a, id) = policy.sampleAction(id, o, h - 1);
+        }
+        // After the horizon, we are in the terminal node.
+        BOOST_CHECK_EQUAL(graph.getAction(node), model.getA());
+    }
+}
+
+BOOST_AUTO_TEST_CASE( stationary ) {
+    using namespace AIToolbox;
+
+    // A ValueFunction which alternates actions 0 and 1 forever, regardless
+    // of observations, and which stops changing after horizon 1.
+    constexpr size_t S = 2, A = 2, O = 3, H = 20;
+    POMDP::ValueFunction vf = POMDP::makeValueFunction(S);
+    for ( size_t h = 1; h <= H; ++h ) {
+        POMDP::VList vl;
+        MDP::Values v0(S), v1(S);
+        v0 << 1.0, 0.0;
+        v1 << 0.0, 1.0;
+        vl.emplace_back(v0, 0, POMDP::VObs(O, 1));
+        vl.emplace_back(v1, 1, POMDP::VObs(O, 0));
+        vf.emplace_back(std::move(vl));
+    }
+
+    POMDP::Policy policy(S, A, O, vf);
+    POMDP::PolicyGraph graph(policy);
+
+    BOOST_CHECK(graph.isStationary());
+    BOOST_CHECK_EQUAL(graph.getNodesNumber(), 2u);
+
+    POMDP::Belief b(S); b << 0.9, 0.1;
+    auto node = graph.getStartNode(b);
+    for ( unsigned i = 0; i < 1000; ++i ) {
+        BOOST_CHECK_EQUAL(graph.getAction(node), i % 2);
+        node = graph.getNextNode(node, i % O);
+    }
+
+    // Without convergence detection all horizons are kept, but the
+    // minimization still merges them into a chain.
+    POMDP::PolicyGraph chain(policy, -1.0);
+    BOOST_CHECK(!chain.isStationary());
+    BOOST_CHECK_EQUAL(chain.getNodesNumber(), 2 * H + 1);
+}
+
+BOOST_AUTO_TEST_CASE( binaryFiles ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    POMDP::IncrementalPruning solver(5, 0.0);
+    const auto vf = std::get<1>(solver(model));
+    POMDP::Policy policy(model.getS(), model.getA(), model.getO(), vf);
+    POMDP::PolicyGraph graph(policy);
+
+    std::stringstream buffer;
+    BOOST_CHECK(writeBinary(buffer, graph));
+
+    POMDP::PolicyGraph loaded(model.getS(), model.getA(), model.getO());
+    BOOST_CHECK(readBinary(buffer, loaded));
+
+    BOOST_CHECK_EQUAL(loaded.getNodesNumber(), graph.getNodesNumber());
+    BOOST_CHECK_EQUAL(loaded.isStationary(), graph.isStationary());
+    for ( size_t n = 0; n < graph.getNodesNumber(); ++n ) {
+        BOOST_CHECK_EQUAL(loaded.getAction(n), graph.getAction(n));
+        for ( size_t o = 0; o < model.getO(); ++o )
+            BOOST_CHECK_EQUAL(loaded.getNextNode(n, o), graph.getNextNode(n, o));
+    }
+    for ( double p = 0.0; p <= 1.0; p += 0.05 ) {
+        POMDP::Belief b(2); b << p, 1.0 - p;
+        BOOST_CHECK_EQUAL(loaded.getStartNode(b), graph.getStartNode(b));
+    }
+
+    // Mismatched sizes and truncated data are rejected.
+    std::stringstream again;
+    writeBinary(again, graph);
+    POMDP::PolicyGraph wrong(model.getS(), model.getA() + 1, model.getO());
+    BOOST_CHECK(!readBinary(again, wrong));
+    BOOST_CHECK_EQUAL(wrong.getNodesNumber(), 1u);
+
+    std::stringstream full;
+    writeBinary(full, graph);
+    std::stringstream truncated(full.str().substr(0, full.str().size() - 8));
+    POMDP::PolicyGraph partial(model.getS(), model.getA(), model.getO());
+    BOOST_CHECK(!readBinary(truncated, partial));
+    BOOST_CHECK_EQUAL(partial.getNodesNumber(), 1u);
+}
@@ -0,0 +1,86 @@
+#define BOOST_TEST_MODULE POMDP_Projecter
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/POMDP/Algorithms/Utils/Projecter.hpp>
+#include <AIToolbox/POMDP/Model.hpp>
+#include <AIToolbox/POMDP/SparseModel.hpp>
+#include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+
+#include "Utils/TigerProblem.hpp"
+#include "Utils/OldPOMDPModel.hpp"
+
+BOOST_AUTO_TEST_CASE( eigenMatchesGeneric ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto problem = makeTigerProblem();
+    problem.setDiscount(0.95);
+    OldPOMDPModel<MDP::Model> oldProblem = problem;
+    SparseModel<MDP::SparseModel> sparseProblem = problem;
+
+    const size_t S = problem.getS(), A = problem.getA(), O = problem.getO();
+
+    VList w;
+    w.emplace_back((MDP::Values(S) << 1.0, -2.0).finished(), 0, VObs());
+    w.emplace_back((MDP::Values(S) << -10.0, 5.0).finished(), 1, VObs());
+    w.emplace_back((MDP::Values(S) << 3.0, 3.0).finished(), 2, VObs());
+
+    Projecter eigenProj(problem);
+    Projecter sparseProj(sparseProblem);
+    Projecter oldProj(oldProblem);
+
+    const auto p = eigenProj(w);
+    const auto sp = sparseProj(w);
+    const auto op = oldProj(w);
+
+    for ( size_t a = 0; a < A; ++a ) {
+        const auto row = eigenProj(w, a);
+        for ( size_t o = 0; o < O; ++o ) {
+            BOOST_REQUIRE_EQUAL(p[a][o].size(), w.size());
+            BOOST_REQUIRE_EQUAL(op[a][o].size(), w.size());
+            for ( size_t i = 0; i < w.size(); ++i ) {
+                BOOST_CHECK_EQUAL(p[a][o][i].action, a);
+                BOOST_CHECK_EQUAL(p[a][o][i].observations[0], i);
+                BOOST_CHECK_EQUAL(row[o][i].values, p[a][o][i].values);
+                for ( size_t s = 0; s < S; ++s ) {
+                    BOOST_CHECK_CLOSE(p[a][o][i].values[s], op[a][o][i].values[s], 0.000001);
+                    BOOST_CHECK_CLOSE(p[a][o][i].values[s], sp[a][o][i].values[s], 0.000001);
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE( parallelActions ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto problem = makeTigerProblem();
+    problem.setDiscount(0.95);
+
+    const size_t S = problem.getS(), A = problem.getA(), O = problem.getO();
+
+    VList w;
+    w.emplace_back((MDP::Values(S) << 1.0, -2.0).finished(), 0, VObs());
+    w.emplace_back((MDP::Values(S) << -10.0, 5.0).finished(), 1, VObs());
+
+    Projecter proj(problem);
+    const auto p = proj(w);
+
+    Executor::setDefault(4);
+    const auto pp = proj(w);
+    Executor::setDefault(1);
+
+    for ( size_t a = 0; a < A; ++a ) {
+        for ( size_t o = 0; o < O; ++o ) {
+            BOOST_REQUIRE_EQUAL(pp[a][o].size(), p[a][o].size());
+            for ( size_t i = 0; i < p[a][o].size(); ++i ) {
+                BOOST_CHECK_EQUAL(pp[a][o][i].action, a);
+                BOOST_CHECK(pp[a][o][i].values == p[a][o][i].values);
+            }
+        }
+    }
+}
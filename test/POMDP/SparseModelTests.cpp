@@ -5,6 +5,7 @@
 
 #include <AIToolbox/POMDP/IO.hpp>
 #include <AIToolbox/MDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
 #include <AIToolbox/POMDP/SparseModel.hpp>
 
 #include "Utils/TigerProblem.hpp"
@@ -128,3 +129,44 @@ BOOST_AUTO_TEST_CASE( files ) {
         std::remove(outputFilename.c_str());
     }
 }
+
+BOOST_AUTO_TEST_CASE( triplets ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    const size_t S = model.getS(), A = model.getA(), O = model.getO();
+
+    POMDP::SparseModel<MDP::SparseModel> sparse(O, S, A);
+
+    std::vector<SparseTriplets> of(A);
+    for ( size_t a = 0; a < A; ++a )
+        for ( size_t s1 = 0; s1 < S; ++s1 )
+            for ( size_t o = 0; o < O; ++o )
+                if ( model.getObservationProbability(s1, a, o) != 0.0 )
+                    of[a].emplace_back(s1, o, model.getObservationProbability(s1, a, o));
+
+    sparse.setObservationFunction(of);
+
+    // Sparse to sparse copies go through the fast path.
+    POMDP::SparseModel<MDP::SparseModel> copy(sparse);
+
+    for ( size_t s1 = 0; s1 < S; ++s1 )
+        for ( size_t a = 0; a < A; ++a )
+            for ( size_t o = 0; o < O; ++o ) {
+                BOOST_CHECK_EQUAL(model.getObservationProbability(s1, a, o), sparse.getObservationProbability(s1, a, o));
+                BOOST_CHECK_EQUAL(model.getObservationProbability(s1, a, o), copy.getObservationProbability(s1, a, o));
+            }
+
+    auto bad = of;
+    bad[0].emplace_back(0, O, 0.0);
+    BOOST_CHECK_THROW(sparse.setObservationFunction(bad), std::invalid_argument);
+
+    POMDP::SparseModel<MDP::SparseModel>::ObservationTable wrongSize(A, SparseMatrix2D(S + 1, O));
+    for ( auto & w : wrongSize )
+        for ( size_t s1 = 0; s1 < S + 1; ++s1 )
+            w.insert(s1, 0) = 1.0;
+    BOOST_CHECK_THROW(sparse.setObservationFunction(std::move(wrongSize)), std::invalid_argument);
+
+    of[0].pop_back();
+    BOOST_CHECK_THROW(sparse.setObservationFunction(of), std::invalid_argument);
+}
@@ -4,9 +4,14 @@
 #include <boost/test/unit_test.hpp>
 
 #include <AIToolbox/POMDP/Utils.hpp>
+#include <AIToolbox/Utils/Executor.hpp>
 #include "Utils/OldPOMDPModel.hpp"
 #include <AIToolbox/MDP/Model.hpp>
 #include <AIToolbox/POMDP/Model.hpp>
+#include <AIToolbox/MDP/SparseModel.hpp>
+#include <AIToolbox/POMDP/SparseModel.hpp>
+#include <AIToolbox/POMDP/Policies/Policy.hpp>
+#include <AIToolbox/POMDP/Algorithms/IncrementalPruning.hpp>
 
 #include "Utils/TigerProblem.hpp"
 
@@ -79,6 +84,98 @@ BOOST_AUTO_TEST_CASE( beliefUpdateUnnormalized ) {
     BOOST_CHECK(checkEqualProbability(resultEigen, solution));
 }
 
+BOOST_AUTO_TEST_CASE( sparseBeliefUpdate ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    // A ring of states, where each action moves forward by 0, 1 or 2
+    // states, and the observation is a noisy reading of the state modulo O.
+    constexpr size_t S = 40, A = 2, O = 3;
+
+    Table3D transitions(boost::extents[S][A][S]);
+    Table3D rewards(boost::extents[S][A][S]);
+    Table3D observations(boost::extents[S][A][O]);
+
+    for (size_t s = 0; s < S; ++s) {
+        for (size_t a = 0; a < A; ++a) {
+            transitions[s][a][(s + a) % S] += 0.6;
+            transitions[s][a][(s + a + 1) % S] += 0.4;
+            for (size_t s1 = 0; s1 < S; ++s1)
+                rewards[s][a][s1] = static_cast<double>(s % 7) - a;
+            for (size_t o = 0; o < O; ++o)
+                observations[s][a][o] = o == s % O ? 0.8 : 0.1;
+        }
+    }
+
+    Model<MDP::Model> dense(O, S, A);
+    dense.setTransitionFunction(transitions);
+    dense.setRewardFunction(rewards);
+    dense.setObservationFunction(observations);
+
+    SparseModel<MDP::SparseModel> sparse(dense);
+    OldPOMDPModel<MDP::Model> old = dense;
+
+    static_assert(!MDP::is_model_sparse_v<decltype(dense)>);
+    static_assert(MDP::is_model_sparse_v<decltype(sparse)>);
+    static_assert(!MDP::is_model_sparse_v<decltype(old)>);
+
+    SparseBelief b(S);
+    b.insert(3) = 0.5;
+    b.insert(17) = 0.25;
+    b.insert(39) = 0.25;
+    const Belief bDense = b.toDense();
+
+    for (size_t a = 0; a < A; ++a) {
+        const double reward = beliefExpectedReward(dense, bDense, a);
+        BOOST_CHECK(checkEqualGeneral(beliefExpectedReward(dense,  b, a), reward));
+        BOOST_CHECK(checkEqualGeneral(beliefExpectedReward(sparse, b, a), reward));
+        BOOST_CHECK(checkEqualGeneral(beliefExpectedReward(old,    b, a), reward));
+
+        for (size_t o = 0; o < O; ++o) {
+            const Belief solution = updateBelief(dense, bDense, a, o);
+
+            const auto rDense  = updateBelief(dense,  b, a, o);
+            const auto rSparse = updateBelief(sparse, b, a, o);
+            const auto rOld    = updateBelief(old,    b, a, o);
+
+            // Only the successors of the support are stored.
+            BOOST_CHECK(rSparse.nonZeros() <= 6);
+            BOOST_CHECK_EQUAL(rSparse.nonZeros(), rDense.nonZeros());
+
+            BOOST_CHECK(checkEqualProbability(Belief(rDense.toDense()),  solution));
+            BOOST_CHECK(checkEqualProbability(Belief(rSparse.toDense()), solution));
+            BOOST_CHECK(checkEqualProbability(Belief(rOld.toDense()),    solution));
+        }
+    }
+
+    // A belief with a wide support goes through the dense merge.
+    SparseBelief wide = Belief::Constant(S, 1.0 / S).sparseView();
+    const auto rWide = updateBelief(sparse, wide, 1, 2);
+    BOOST_CHECK(checkEqualProbability(Belief(rWide.toDense()), updateBelief(dense, Belief(wide.toDense()), 1, 2)));
+}
+
+BOOST_AUTO_TEST_CASE( sparseBeliefPolicy ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.95);
+
+    constexpr unsigned horizon = 5;
+    IncrementalPruning solver(horizon, 0.0);
+    const auto vf = std::get<1>(solver(model));
+    Policy policy(model.getS(), model.getA(), model.getO(), vf);
+
+    for (const double p : {0.0, 0.1, 0.3, 0.5, 0.8, 1.0}) {
+        Belief b(2); b << p, 1.0 - p;
+        const SparseBelief sb = b.sparseView();
+
+        BOOST_CHECK_EQUAL(policy.sampleAction(sb), policy.sampleAction(b));
+        for (unsigned h = 1; h <= horizon; ++h)
+            BOOST_CHECK(policy.sampleAction(sb, h) == policy.sampleAction(b, h));
+    }
+}
+
 BOOST_AUTO_TEST_CASE( beliefUpdatePartial ) {
     using namespace AIToolbox;
     using namespace AIToolbox::POMDP;
@@ -110,3 +207,46 @@ BOOST_AUTO_TEST_CASE( beliefUpdatePartial ) {
         BOOST_CHECK(checkEqualProbability(resultEigen2, partialEigen2));
     }
 }
+
+BOOST_AUTO_TEST_CASE( weakBound ) {
+    using namespace AIToolbox;
+    using namespace AIToolbox::POMDP;
+
+    constexpr size_t S = 5;
+    std::mt19937 rand(42);
+    std::uniform_real_distribution<double> dist(-10.0, 10.0);
+
+    const auto makeVList = [&](size_t n) {
+        VList retval;
+        for (size_t i = 0; i < n; ++i) {
+            MDP::Values v(S);
+            for (size_t s = 0; s < S; ++s) v[s] = dist(rand);
+            retval.emplace_back(std::move(v), 0, VObs());
+        }
+        return retval;
+    };
+
+    // Large enough to span multiple blocks.
+    const auto oldV = makeVList(150);
+    const auto newV = makeVList(100);
+
+    double truth = 0.0;
+    for (const auto & newVE : newV) {
+        double closest = std::numeric_limits<double>::infinity();
+        for (const auto & oldVE : oldV)
+            closest = std::min(closest, (newVE.values - oldVE.values).cwiseAbs().maxCoeff());
+        truth = std::max(truth, closest);
+    }
+
+    BOOST_CHECK_EQUAL(weakBoundDistance(oldV, newV), truth);
+    BOOST_CHECK_EQUAL(weakBoundDistance(oldV, oldV), 0.0);
+    BOOST_CHECK_EQUAL(weakBoundDistance(VList(), newV), 0.0);
+
+    // Chunks of the new VList run in parallel, the result must not change.
+    const auto bigNewV = makeVList(500);
+    const double sequential = weakBoundDistance(oldV, bigNewV);
+    Executor::setDefault(4);
+    BOOST_CHECK_EQUAL(weakBoundDistance(oldV, bigNewV), sequential);
+    BOOST_CHECK_EQUAL(weakBoundDistance(oldV, newV), truth);
+    Executor::setDefault(1);
+}
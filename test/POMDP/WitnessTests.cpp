@@ -151,3 +151,49 @@ BOOST_AUTO_TEST_CASE( undiscountedHorizon ) {
         BOOST_CHECK_EQUAL(values, truthValues);
     }
 }
+
+BOOST_AUTO_TEST_CASE( warmStart ) {
+    using namespace AIToolbox;
+
+    auto model = makeTigerProblem();
+    model.setDiscount(0.75);
+
+    POMDP::Witness solver(25, 0.0, 0.001);
+    const auto [oldVar, oldVf] = solver(model);
+    const auto witnesses = solver.getWitnessBeliefs();
+
+    // The tiger becomes a bit more dangerous.
+    auto rewards = model.getRewardFunction();
+    rewards(TIG_LEFT, A_LEFT) -= 0.5;
+    rewards(TIG_RIGHT, A_RIGHT) -= 0.5;
+    model.setRewardFunction(rewards);
+
+    const auto [refVar, ref] = solver(model, POMDP::ValueFunction{oldVf.back()}, witnesses);
+
+    const auto maxError = [&](const POMDP::VList & vl) {
+        double error = 0.0;
+        for ( double x = 0.0; x <= 1.0; x += 0.05 ) {
+            POMDP::Belief b(2); b << x, 1.0 - x;
+            double value, refValue;
+            findBestAtPoint(b, boost::make_transform_iterator(std::begin(vl), POMDP::unwrap),
+                               boost::make_transform_iterator(std::end  (vl), POMDP::unwrap), &value);
+            findBestAtPoint(b, boost::make_transform_iterator(std::begin(ref.back()), POMDP::unwrap),
+                               boost::make_transform_iterator(std::end  (ref.back()), POMDP::unwrap), &refValue);
+            error = std::max(error, std::abs(value - refValue));
+        }
+        return error;
+    };
+
+    // Starting from the old solution, a few timesteps are closer to the
+    // new one than twice as many from scratch.
+    solver.setHorizon(10);
+    const auto [coldVar, cold] = solver(model);
+    solver.setHorizon(5);
+    const auto [warmVar, warm] = solver(model, POMDP::ValueFunction{oldVf.back()}, witnesses);
+
+    const double coldError = maxError(cold.back()), warmError = maxError(warm.back());
+    BOOST_TEST_MESSAGE("Cold error: " << coldError << ", warm error: " << warmError);
+    BOOST_CHECK(warmError < coldError);
+
+    BOOST_CHECK_THROW(solver(model, {}, {POMDP::Belief(1)}), std::invalid_argument);
+}
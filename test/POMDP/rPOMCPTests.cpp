@@ -126,3 +126,56 @@ BOOST_AUTO_TEST_CASE( max_belief ) {
         BOOST_CHECK_EQUAL(solver.sampleAction(beliefs.row(i), 2), solutions[i]);
     }
 }
+
+BOOST_AUTO_TEST_CASE( track_belief ) {
+    using namespace AIToolbox::POMDP;
+
+    TrackBelief<false> sparse;
+    // Few, spread states stay sorted in the small vector.
+    for ( size_t s : {900, 3, 500, 3, 42, 900, 3} )
+        sparse.add(s);
+
+    BOOST_CHECK(!sparse.isDense());
+    BOOST_CHECK_EQUAL(sparse.size(), 4u);
+
+    std::vector<std::pair<size_t, unsigned>> found;
+    sparse.forEach([&](size_t s, const auto & p) { found.emplace_back(s, p.N); });
+    const std::vector<std::pair<size_t, unsigned>> expected{{3, 3}, {42, 1}, {500, 1}, {900, 2}};
+    BOOST_CHECK(found == expected);
+
+    // A large, dense support switches to direct indexing without losing counts.
+    TrackBelief<true> dense;
+    constexpr size_t S = 50;
+    for ( unsigned i = 0; i < 3; ++i )
+        for ( size_t s = 0; s < S; ++s )
+            dense.add(s);
+
+    BOOST_CHECK(dense.isDense());
+    BOOST_CHECK_EQUAL(dense.size(), S);
+
+    size_t visited = 0;
+    dense.forEach([&](size_t s, const auto & p) {
+        BOOST_CHECK_EQUAL(s, visited++);
+        BOOST_CHECK_EQUAL(p.N, 3u);
+    });
+    BOOST_CHECK_EQUAL(visited, S);
+
+    // A far away state goes back to the sorted vector, rather than growing
+    // the array to its index.
+    dense.add(1000000);
+    BOOST_CHECK(!dense.isDense());
+    BOOST_CHECK_EQUAL(dense.size(), S + 1);
+
+    visited = 0;
+    dense.forEach([&](size_t s, const auto & p) {
+        if ( visited == S ) {
+            BOOST_CHECK_EQUAL(s, 1000000u);
+            BOOST_CHECK_EQUAL(p.N, 1u);
+        } else {
+            BOOST_CHECK_EQUAL(s, visited);
+            BOOST_CHECK_EQUAL(p.N, 3u);
+        }
+        ++visited;
+    });
+    BOOST_CHECK_EQUAL(visited, S + 1);
+}
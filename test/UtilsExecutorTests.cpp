@@ -0,0 +1,148 @@
+#define BOOST_TEST_MODULE UtilsExecutor
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/Utils/Executor.hpp>
+#include <AIToolbox/Impl/Seeder.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+BOOST_AUTO_TEST_CASE( single_threaded ) {
+    using namespace AIToolbox;
+
+    Executor e;
+    BOOST_CHECK_EQUAL(e.getConcurrency(), 1);
+
+    // Everything runs inline and in order.
+    std::vector<size_t> order;
+    e.parallelFor(3, 10, [&](size_t i){ order.push_back(i); });
+
+    std::vector<size_t> expected(7);
+    std::iota(std::begin(expected), std::end(expected), 3);
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(order), std::end(order), std::begin(expected), std::end(expected));
+}
+
+BOOST_AUTO_TEST_CASE( parallel_for ) {
+    using namespace AIToolbox;
+
+    for ( const bool deterministic : {false, true} ) {
+        Executor e(4, deterministic);
+        BOOST_CHECK_EQUAL(e.getConcurrency(), 4);
+
+        std::vector<unsigned> counts(10000, 0);
+        e.parallelFor(0, counts.size(), [&](size_t i){ ++counts[i]; }, 7);
+
+        for ( auto c : counts )
+            BOOST_CHECK_EQUAL(c, 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( nested_groups ) {
+    using namespace AIToolbox;
+
+    Executor e(3);
+    std::atomic<size_t> sum(0);
+
+    Executor::TaskGroup outer(e);
+    for ( size_t i = 0; i < 20; ++i ) {
+        outer.run([&e, &sum, i]{
+            Executor::TaskGroup inner(e);
+            for ( size_t j = 0; j < 10; ++j )
+                inner.run([&sum, i, j]{ sum += i * 10 + j; });
+            inner.wait();
+        });
+    }
+    outer.wait();
+
+    BOOST_CHECK_EQUAL(sum.load(), 199 * 200 / 2);
+}
+
+BOOST_AUTO_TEST_CASE( exceptions ) {
+    using namespace AIToolbox;
+
+    Executor e(2);
+    BOOST_CHECK_THROW(
+        e.parallelFor(0, 100, [](size_t i){ if ( i == 42 ) throw std::runtime_error("fail"); }),
+        std::runtime_error
+    );
+
+    // The Executor is still usable afterwards.
+    std::atomic<size_t> count(0);
+    e.parallelFor(0, 100, [&](size_t){ ++count; });
+    BOOST_CHECK_EQUAL(count.load(), 100);
+}
+
+BOOST_AUTO_TEST_CASE( concurrent_callers ) {
+    using namespace AIToolbox;
+
+    for ( const bool deterministic : {false, true} ) {
+        Executor e(3, deterministic);
+
+        // Each external thread sees its own work as worker 0, and never
+        // runs the work of the other, so per-call state indexed by worker
+        // is never used by two threads at once.
+        std::atomic<size_t> overlaps(0), count(0);
+        RandomEngine * engines[2];
+        const auto caller = [&](const unsigned id) {
+            engines[id] = &e.getRandomEngine();
+            for ( unsigned k = 0; k < 200; ++k ) {
+                std::vector<std::atomic<unsigned>> busy(e.getConcurrency());
+                e.parallelFor(0, 64, [&](size_t, const unsigned w) {
+                    if ( busy[w]++ ) ++overlaps;
+                    std::this_thread::yield();
+                    --busy[w];
+                    ++count;
+                }, 1);
+            }
+        };
+        std::thread t0(caller, 0), t1(caller, 1);
+        t0.join();
+        t1.join();
+
+        BOOST_CHECK_EQUAL(overlaps.load(), 0);
+        BOOST_CHECK_EQUAL(count.load(), 2 * 200 * 64);
+        BOOST_CHECK(engines[0] != engines[1]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE( deterministic_random ) {
+    using namespace AIToolbox;
+
+    const auto run = [] {
+        Impl::Seeder::setRootSeed(12345);
+        Executor e(4, true);
+
+        std::vector<unsigned> values(1000);
+        e.parallelFor(0, values.size(), [&](size_t i){
+            values[i] = std::uniform_int_distribution<unsigned>(0, 1000000)(e.getRandomEngine());
+        });
+        return values;
+    };
+
+    const auto v1 = run();
+    const auto v2 = run();
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(v1), std::end(v1), std::begin(v2), std::end(v2));
+}
+
+BOOST_AUTO_TEST_CASE( default_executor ) {
+    using namespace AIToolbox;
+
+    auto old = Executor::getDefault();
+    BOOST_CHECK_EQUAL(old->getConcurrency(), 1);
+
+    // Replacing the default does not destroy an Executor still in use.
+    Executor::setDefault(3);
+    auto current = Executor::getDefault();
+    BOOST_CHECK_EQUAL(current->getConcurrency(), 3);
+
+    std::atomic<size_t> count(0);
+    old->parallelFor(0, 100, [&](size_t){ ++count; });
+    current->parallelFor(0, 100, [&](size_t){ ++count; });
+    BOOST_CHECK_EQUAL(count.load(), 200);
+
+    Executor::setDefault(1);
+    BOOST_CHECK_EQUAL(Executor::getDefault()->getConcurrency(), 1);
+}
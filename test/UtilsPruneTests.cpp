@@ -83,3 +83,113 @@ BOOST_AUTO_TEST_CASE( dominationPrune ) {
                                       std::begin(d), test);
     }
 }
+
+BOOST_AUTO_TEST_CASE( nearlyDominatedPrune ) {
+    using namespace AIToolbox;
+
+    std::vector<Vector> data {
+        (Vector(2) <<  -1.0000 ,  -1.0000).finished(),
+        (Vector(2) <<  -1.0500 ,  -0.9500).finished(),
+        (Vector(2) << -100.000 ,  10.0000).finished(),
+        (Vector(2) << -100.000 ,  10.0800).finished(),
+        (Vector(2) <<  10.0000 , -100.000).finished(),
+    };
+
+    std::vector<Vector> solution {
+        (Vector(2) <<  -1.0000 ,  -1.0000).finished(),
+        (Vector(2) << -100.000 ,  10.0000).finished(),
+        (Vector(2) <<  10.0000 , -100.000).finished(),
+    };
+
+    auto test = extractNearlyDominated(2, 0.1, std::begin(data), std::end(data));
+    auto comparer = [](const auto & lhs, const auto & rhs) {
+        return veccmp(lhs, rhs) < 0;
+    };
+
+    std::sort(std::begin(solution), std::end(solution), comparer);
+    std::sort(std::begin(data), test, comparer);
+    BOOST_CHECK_EQUAL_COLLECTIONS(std::begin(solution), std::end(solution),
+                                  std::begin(data), test);
+}
+
+BOOST_AUTO_TEST_CASE( approximatePrune ) {
+    using namespace AIToolbox;
+
+    const std::vector<Vector> data {
+        (Vector(2) <<   7.5975 , -96.9025).finished(),
+        (Vector(2) <<   6.03   , -16.96).finished(),
+        (Vector(2) <<   7.29576, -28.3518).finished(),
+        (Vector(2) <<   4.01968,  -9.78738).finished(),
+        (Vector(2) << -96.9025 ,   7.5975).finished(),
+        (Vector(2) << -84.8053 ,   5.88762).finished(),
+        (Vector(2) << -16.96   ,   6.03).finished(),
+        (Vector(2) <<  -4.86282,   4.32012).finished(),
+        (Vector(2) <<   5.88762, -84.8053).finished(),
+        (Vector(2) <<   4.32012,  -4.86282).finished(),
+        (Vector(2) <<   5.58587, -16.2546).finished(),
+        (Vector(2) <<   2.3098 ,   2.3098).finished(),
+        (Vector(2) << -28.3518 ,   7.29576).finished(),
+        (Vector(2) << -16.2546 ,   5.58587).finished(),
+    };
+
+    const auto valueAt = [](double x, auto begin, auto end) {
+        const Vector b = (Vector(2) << x, 1.0 - x).finished();
+        double value;
+        findBestAtPoint(b, begin, end, &value);
+        return value;
+    };
+
+    auto exact = data;
+    const auto exactEnd = Pruner(2)(std::begin(exact), std::end(exact));
+
+    for ( const bool merge : {false, true} ) {
+        constexpr double epsilon = 0.5;
+
+        auto approx = data;
+        const auto approxEnd = Pruner(2, epsilon, merge)(std::begin(approx), std::end(approx));
+
+        BOOST_CHECK(std::distance(std::begin(approx), approxEnd) < std::distance(std::begin(exact), exactEnd));
+
+        for ( double x = 0.0; x <= 1.0; x += 0.01 ) {
+            const double exactValue  = valueAt(x, std::begin(exact), exactEnd);
+            const double approxValue = valueAt(x, std::begin(approx), approxEnd);
+
+            BOOST_CHECK(approxValue <= exactValue + 1e-9);
+            BOOST_CHECK(approxValue >= exactValue - epsilon - 1e-9);
+        }
+    }
+
+    BOOST_CHECK_THROW(Pruner(2, -1.0), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE( seedPoints ) {
+    using namespace AIToolbox;
+
+    const std::vector<Vector> data {
+        (Vector(2) <<   7.5975 , -96.9025).finished(),
+        (Vector(2) <<   6.03   , -16.96).finished(),
+        (Vector(2) <<   4.01968,  -9.78738).finished(),
+        (Vector(2) << -96.9025 ,   7.5975).finished(),
+        (Vector(2) <<  -4.86282,   4.32012).finished(),
+        (Vector(2) <<   4.32012,  -4.86282).finished(),
+        (Vector(2) <<   2.3098 ,   2.3098).finished(),
+        (Vector(2) <<   1.0    ,   1.0).finished(),
+    };
+
+    Pruner prune(2);
+    auto first = data;
+    const auto firstEnd = prune(std::begin(first), std::end(first));
+    const auto witnesses = prune.getWitnessPoints();
+    BOOST_CHECK(witnesses.size() > 0);
+
+    // Seeding with the witnesses of the same set keeps the same vectors.
+    prune.setSeedPoints(witnesses);
+    auto second = data;
+    const auto secondEnd = prune(std::begin(second), std::end(second));
+
+    BOOST_CHECK_EQUAL(std::distance(std::begin(first), firstEnd), std::distance(std::begin(second), secondEnd));
+    for ( auto it = std::begin(first); it != firstEnd; ++it )
+        BOOST_CHECK(std::find(std::begin(second), secondEnd, *it) != secondEnd);
+
+    BOOST_CHECK_THROW(prune.setSeedPoints({Vector(3)}), std::invalid_argument);
+}
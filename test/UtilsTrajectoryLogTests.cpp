@@ -0,0 +1,275 @@
+#define BOOST_TEST_MODULE UtilsTrajectoryLog
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MAIN
+#include <boost/test/unit_test.hpp>
+
+#include <AIToolbox/Utils/TrajectoryLog.hpp>
+#include <AIToolbox/MDP/Experience.hpp>
+#include <AIToolbox/MDP/SparseExperience.hpp>
+#include <AIToolbox/MDP/Algorithms/QLearning.hpp>
+
+#include <filesystem>
+#include <random>
+#include <thread>
+#include <tuple>
+
+namespace {
+    struct TempFile {
+        // Each file lives in its own directory with a random suffix, so
+        // that concurrent runs of the tests do not step on each other.
+        TempFile(const std::string & name) {
+            std::random_device rd;
+            do dir = std::filesystem::temp_directory_path() / (name + "-" + std::to_string(rd()));
+            while ( !std::filesystem::create_directory(dir) );
+            path = (dir / name).string();
+        }
+        ~TempFile() { std::filesystem::remove_all(dir); }
+
+        std::filesystem::path dir;
+        std::string path;
+    };
+
+    using Record = std::tuple<size_t, size_t, size_t, double>;
+
+    std::vector<Record> makeTrajectory(const size_t S, const size_t A, const size_t n) {
+        std::mt19937 rnd(1);
+        std::uniform_int_distribution<size_t> sd(0, S - 1), ad(0, A - 1);
+
+        std::vector<Record> retval;
+        size_t s = sd(rnd);
+        for ( size_t i = 0; i < n; ++i ) {
+            const size_t a = ad(rnd), s1 = sd(rnd);
+            const double r = s1 == 0 ? 10.0 : -1.0;
+            retval.emplace_back(s, a, s1, r);
+            // Every so often, a new episode starts.
+            s = i % 50 == 49 ? sd(rnd) : s1;
+        }
+        return retval;
+    }
+}
+
+BOOST_AUTO_TEST_CASE( roundtrip ) {
+    using namespace AIToolbox;
+
+    constexpr size_t S = 300, A = 5;
+    const auto trajectory = makeTrajectory(S, A, 1000);
+
+    TempFile file("aitoolbox-trajectory-roundtrip.log");
+    {
+        TrajectoryWriter writer(file.path, false, 64);
+        auto appender = writer.makeAppender();
+        for ( const auto & [s, a, s1, r] : trajectory )
+            appender.record(s, a, s1, r);
+
+        BOOST_CHECK_THROW(appender.record(0, 0, 0, 0, 0.0), std::invalid_argument);
+    }
+
+    // The integers and repeated rewards are compressed.
+    BOOST_CHECK(std::filesystem::file_size(file.path) < trajectory.size() * 6);
+
+    TrajectoryReader reader(file.path);
+    BOOST_CHECK(!reader.hasObservations());
+
+    TrajectoryBlock block;
+    size_t i = 0, blocks = 0;
+    while ( reader.readBlock(&block) ) {
+        ++blocks;
+        BOOST_CHECK(block.observations.empty());
+        for ( size_t j = 0; j < block.size(); ++j, ++i ) {
+            const auto & [s, a, s1, r] = trajectory[i];
+            BOOST_CHECK_EQUAL(block.states[j], s);
+            BOOST_CHECK_EQUAL(block.actions[j], a);
+            BOOST_CHECK_EQUAL(block.nextStates[j], s1);
+            BOOST_CHECK_EQUAL(block.rewards[j], r);
+        }
+    }
+    BOOST_CHECK_EQUAL(i, trajectory.size());
+    BOOST_CHECK_EQUAL(blocks, (trajectory.size() + 63) / 64);
+    BOOST_CHECK(!reader.isTruncated());
+}
+
+BOOST_AUTO_TEST_CASE( replay ) {
+    using namespace AIToolbox;
+
+    constexpr size_t S = 20, A = 3;
+    const auto trajectory = makeTrajectory(S, A, 2000);
+
+    TempFile file("aitoolbox-trajectory-replay.log");
+    {
+        TrajectoryWriter writer(file.path, false, 100);
+        auto appender = writer.makeAppender();
+        for ( const auto & [s, a, s1, r] : trajectory )
+            appender.record(s, a, s1, r);
+    }
+
+    MDP::Experience exp(S, A), truthExp(S, A);
+    MDP::SparseExperience sexp(S, A);
+    MDP::QLearning ql(S, A, 0.9, 0.1), truthQl(S, A, 0.9, 0.1);
+    for ( const auto & [s, a, s1, r] : trajectory ) {
+        truthExp.record(s, a, s1, r);
+        truthQl.stepUpdateQ(s, a, s1, r);
+    }
+
+    BOOST_CHECK_EQUAL(TrajectoryReader(file.path).replay(exp), trajectory.size());
+    BOOST_CHECK_EQUAL(TrajectoryReader(file.path).replay(sexp), trajectory.size());
+    BOOST_CHECK_EQUAL(TrajectoryReader(file.path).replay(ql), trajectory.size());
+
+    double sum = 0.0;
+    TrajectoryReader(file.path).replay([&](size_t, size_t, size_t, double r) { sum += r; });
+
+    double truthSum = 0.0;
+    for ( size_t s = 0; s < S; ++s ) {
+        for ( size_t a = 0; a < A; ++a ) {
+            BOOST_CHECK_EQUAL(exp.getVisitsSum(s, a), truthExp.getVisitsSum(s, a));
+            BOOST_CHECK_EQUAL(sexp.getVisitsSum(s, a), truthExp.getVisitsSum(s, a));
+            BOOST_CHECK_EQUAL(exp.getRewardSum(s, a), truthExp.getRewardSum(s, a));
+            BOOST_CHECK_EQUAL(ql.getQFunction()(s, a), truthQl.getQFunction()(s, a));
+            truthSum += truthExp.getRewardSum(s, a);
+        }
+    }
+    BOOST_CHECK_CLOSE(sum, truthSum, 0.000001);
+}
+
+BOOST_AUTO_TEST_CASE( observations ) {
+    using namespace AIToolbox;
+
+    TempFile file("aitoolbox-trajectory-observations.log");
+    {
+        TrajectoryWriter writer(file.path, true, 2);
+        auto appender = writer.makeAppender();
+        appender.record(0, 1, 2, 3, 0.5);
+        appender.record(2, 0, 1, 0, 0.5);
+        appender.record(4, 2, 4, 1, -2.0);
+
+        BOOST_CHECK_THROW(appender.record(0, 0, 0, 0.0), std::invalid_argument);
+    }
+    // The observations setting of an existing log cannot change.
+    BOOST_CHECK_THROW(TrajectoryWriter(file.path, false), std::invalid_argument);
+
+    TrajectoryReader reader(file.path);
+    BOOST_CHECK(reader.hasObservations());
+
+    std::vector<std::tuple<size_t, size_t, size_t, size_t, double>> records;
+    reader.replay([&](size_t s, size_t a, size_t s1, size_t o, double r) { records.emplace_back(s, a, s1, o, r); });
+
+    BOOST_REQUIRE_EQUAL(records.size(), 3);
+    BOOST_CHECK(records[0] == std::make_tuple(0, 1, 2, 3, 0.5));
+    BOOST_CHECK(records[1] == std::make_tuple(2, 0, 1, 0, 0.5));
+    BOOST_CHECK(records[2] == std::make_tuple(4, 2, 4, 1, -2.0));
+}
+
+BOOST_AUTO_TEST_CASE( concurrentAppenders ) {
+    using namespace AIToolbox;
+
+    constexpr size_t threads = 4, records = 5000;
+
+    TempFile file("aitoolbox-trajectory-threads.log");
+    {
+        TrajectoryWriter writer(file.path, false, 128);
+
+        std::vector<std::thread> workers;
+        for ( size_t t = 0; t < threads; ++t ) {
+            workers.emplace_back([&writer, t]() {
+                auto appender = writer.makeAppender();
+                // Each thread logs its own id as the action.
+                for ( size_t i = 0; i < records; ++i )
+                    appender.record(i, t, i + 1, static_cast<double>(i));
+            });
+        }
+        for ( auto & w : workers ) w.join();
+    }
+
+    // The records of each thread are all there, in order.
+    std::vector<size_t> next(threads, 0);
+    TrajectoryReader reader(file.path);
+    const auto n = reader.replay([&](size_t s, size_t a, size_t s1, double r) {
+        BOOST_REQUIRE(a < threads);
+        BOOST_CHECK_EQUAL(s, next[a]);
+        BOOST_CHECK_EQUAL(s1, next[a] + 1);
+        BOOST_CHECK_EQUAL(r, static_cast<double>(next[a]));
+        ++next[a];
+    });
+
+    BOOST_CHECK_EQUAL(n, threads * records);
+    for ( auto c : next )
+        BOOST_CHECK_EQUAL(c, records);
+}
+
+BOOST_AUTO_TEST_CASE( appendAndCorruption ) {
+    using namespace AIToolbox;
+
+    TempFile file("aitoolbox-trajectory-append.log");
+    {
+        TrajectoryWriter writer(file.path, false, 10);
+        auto appender = writer.makeAppender();
+        for ( size_t i = 0; i < 25; ++i )
+            appender.record(i, 0, i + 1, 1.0);
+    }
+    {
+        TrajectoryWriter writer(file.path, false, 10);
+        auto appender = writer.makeAppender();
+        for ( size_t i = 25; i < 30; ++i )
+            appender.record(i, 0, i + 1, 1.0);
+    }
+    BOOST_CHECK_EQUAL(TrajectoryReader(file.path).replay([](size_t, size_t, size_t, double){}), 30);
+
+    // An interrupted write leaves an incomplete block, which is ignored
+    // when reading, and removed when appending.
+    const auto size = std::filesystem::file_size(file.path);
+    std::filesystem::resize_file(file.path, size - 3);
+    {
+        TrajectoryReader reader(file.path);
+        BOOST_CHECK_EQUAL(reader.replay([](size_t, size_t, size_t, double){}), 25);
+        BOOST_CHECK(reader.isTruncated());
+    }
+    {
+        TrajectoryWriter writer(file.path, false, 10);
+        writer.makeAppender().record(100, 1, 101, 2.0);
+    }
+    {
+        TrajectoryReader reader(file.path);
+        size_t last = 0;
+        BOOST_CHECK_EQUAL(reader.replay([&](size_t s, size_t, size_t, double){ last = s; }), 26);
+        BOOST_CHECK_EQUAL(last, 100);
+        BOOST_CHECK(!reader.isTruncated());
+    }
+
+    // Corrupted data is detected by the checksums.
+    {
+        std::fstream f(file.path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(40);
+        f.put(0x55);
+    }
+    TrajectoryReader reader(file.path);
+    BOOST_CHECK_THROW(reader.replay([](size_t, size_t, size_t, double){}), std::runtime_error);
+
+    // Other files are rejected.
+    TempFile other("aitoolbox-trajectory-other.log");
+    std::ofstream(other.path) << "not a trajectory log";
+    BOOST_CHECK_THROW(TrajectoryReader{other.path}, std::runtime_error);
+    BOOST_CHECK_THROW(TrajectoryWriter{other.path}, std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE( invalidUse ) {
+    using namespace AIToolbox;
+
+    TempFile file("aitoolbox-trajectory-invalid.log");
+
+    // Blocks must have a size that fits in their header.
+    BOOST_CHECK_THROW(TrajectoryWriter(file.path, false, 0), std::invalid_argument);
+    BOOST_CHECK_THROW(TrajectoryWriter(file.path, false, 100000000), std::invalid_argument);
+
+    TrajectoryWriter writer(file.path, false, 10);
+    auto appender = writer.makeAppender();
+    appender.record(0, 0, 1, 1.0);
+
+    // A moved-from Appender can't record, but its destruction is safe.
+    auto other = std::move(appender);
+    BOOST_CHECK_THROW(appender.record(1, 0, 2, 1.0), std::runtime_error);
+    BOOST_CHECK_THROW(appender.record(1, 0, 2, 0, 1.0), std::runtime_error);
+    other.record(1, 0, 2, 1.0);
+    other.flush();
+    writer.flush();
+
+    BOOST_CHECK_EQUAL(TrajectoryReader(file.path).replay([](size_t, size_t, size_t, double){}), 2);
+}